@@ -0,0 +1,278 @@
+#pragma once
+
+#include "price_ladder.hpp"
+#include "../common/types.hpp"
+#include "../common/symbol_table.hpp"
+#include "../spsc/ring_buffer.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace hft {
+namespace book {
+
+/**
+ * Market-by-price level delta
+ *
+ * Applied in order, deltas keep a consumer's top-N array per side equal
+ * to the book's:
+ * - Insert at i:  shift levels i.. down one, drop anything past N
+ * - Update at i:  replace quantity / order count of level i
+ * - Delete at i:  remove level i, shift levels below it up
+ */
+struct LevelDelta {
+    enum class Action : uint8_t {
+        Insert = 0,
+        Update = 1,
+        Delete = 2
+    };
+
+    Price price = 0;
+    uint64_t quantity = 0;
+    Timestamp timestamp = 0;
+    uint32_t order_count = 0;
+    StockLocate stock_locate = 0;
+    Action action = Action::Update;
+    Side side = Side::Buy;
+    uint8_t level = 0;          // 0 = best
+};
+
+static_assert(sizeof(LevelDelta) == 40, "LevelDelta layout changed");
+
+/**
+ * Incremental top-N depth feed
+ *
+ * Keeps the last emitted top-N levels of each side of each book and,
+ * after every book change, diffs the book's current top N against them
+ * and pushes only the differences. Order events that do not touch the
+ * top N (most of them on a busy name) produce no output at all.
+ *
+ * Runs on the book engine's thread; the delta ring is the hand-off to a
+ * downstream consumer thread.
+ */
+class DepthFeed {
+public:
+    static constexpr size_t MAX_LEVELS = 64;
+    using DeltaBuffer = spsc::RingBuffer<LevelDelta, 65536>;
+
+    DepthFeed(size_t levels, DeltaBuffer& output)
+        : levels_(levels == 0 ? 1 : (levels > MAX_LEVELS ? MAX_LEVELS : levels))
+        , output_(output)
+        , snapshots_(SymbolTable::MAX_LOCATES) {}
+
+    DepthFeed(const DepthFeed&) = delete;
+    DepthFeed& operator=(const DepthFeed&) = delete;
+
+    /**
+     * Diff a book against its last emitted state and push the deltas
+     * Returns the number of deltas generated
+     */
+    template <typename Book>
+    size_t update(const Book& book, Timestamp ts) {
+        auto& snapshot = snapshots_[book.locate()];
+        if (!snapshot) {
+            snapshot = std::make_unique<Snapshot>(levels_);
+        }
+
+        ++stats_.book_updates;
+        size_t emitted = 0;
+        emitted += diff_side(book.bids(), Side::Buy, snapshot->bids, book.locate(), ts);
+        emitted += diff_side(book.asks(), Side::Sell, snapshot->asks, book.locate(), ts);
+        return emitted;
+    }
+
+    /**
+     * Block on a full ring instead of dropping deltas
+     * Only appropriate for replay - a live feed cannot wait
+     */
+    void set_backpressure(bool enabled) { backpressure_ = enabled; }
+
+    size_t levels() const { return levels_; }
+
+    // Statistics
+    struct Stats {
+        uint64_t book_updates = 0;      // Book changes examined
+        uint64_t deltas_emitted = 0;
+        uint64_t deltas_dropped = 0;    // Delta ring full
+        uint64_t inserts = 0;
+        uint64_t updates = 0;
+        uint64_t deletes = 0;
+    };
+
+    const Stats& get_stats() const { return stats_; }
+
+private:
+    struct SideLevels {
+        explicit SideLevels(size_t n) : levels(new PriceLevel[n]()), count(0) {}
+        std::unique_ptr<PriceLevel[]> levels;
+        size_t count;
+    };
+
+    struct Snapshot {
+        explicit Snapshot(size_t n) : bids(n), asks(n) {}
+        SideLevels bids;
+        SideLevels asks;
+    };
+
+    /**
+     * Merge the previous and current top N, best price first
+     *
+     * Tracks the consumer's array as it evolves: the current levels
+     * already emitted (pos of them) followed by the unvisited previous
+     * levels, truncated to N. A previous level pushed past N by an insert
+     * is gone on the consumer side, so it is re-inserted rather than
+     * updated, and its delete is not sent.
+     */
+    template <typename Levels>
+    size_t diff_side(const Levels& side_levels, Side side, SideLevels& prev,
+                     StockLocate locate, Timestamp ts) {
+        PriceLevel current[MAX_LEVELS];
+        size_t count = 0;
+        side_levels.for_each([&](const PriceLevel& lvl) {
+            current[count++] = lvl;
+            return count < levels_;
+        });
+
+        const bool bid = side == Side::Buy;
+        auto better = [bid](Price a, Price b) { return bid ? a > b : a < b; };
+
+        size_t emitted = 0;
+        size_t i = 0;               // Next current level
+        size_t j = 0;               // Next previous level
+        size_t pos = 0;             // Consumer index of the next level
+        size_t len = prev.count;    // Consumer array length
+
+        while (i < count || j < prev.count) {
+            const PriceLevel* old_lvl = j < prev.count ? &prev.levels[j] : nullptr;
+            const PriceLevel* new_lvl = i < count ? &current[i] : nullptr;
+
+            if (old_lvl && (!new_lvl || better(old_lvl->price, new_lvl->price))) {
+                // Previous level is gone
+                if (pos < len) {
+                    emit(LevelDelta::Action::Delete, side, pos, *old_lvl, locate, ts);
+                    --len;
+                    ++emitted;
+                }
+                ++j;
+            } else if (!old_lvl || better(new_lvl->price, old_lvl->price)) {
+                // New level
+                emit(LevelDelta::Action::Insert, side, pos, *new_lvl, locate, ts);
+                len = len < levels_ ? len + 1 : levels_;
+                ++emitted;
+                ++pos;
+                ++i;
+            } else {
+                // Same price in both
+                if (pos >= len) {
+                    emit(LevelDelta::Action::Insert, side, pos, *new_lvl, locate, ts);
+                    ++len;
+                    ++emitted;
+                } else if (old_lvl->quantity != new_lvl->quantity ||
+                           old_lvl->order_count != new_lvl->order_count) {
+                    emit(LevelDelta::Action::Update, side, pos, *new_lvl, locate, ts);
+                    ++emitted;
+                }
+                ++pos;
+                ++i;
+                ++j;
+            }
+        }
+
+        for (size_t k = 0; k < count; ++k) {
+            prev.levels[k] = current[k];
+        }
+        prev.count = count;
+        return emitted;
+    }
+
+    void emit(LevelDelta::Action action, Side side, size_t level, const PriceLevel& lvl,
+              StockLocate locate, Timestamp ts) {
+        LevelDelta delta;
+        delta.action = action;
+        delta.side = side;
+        delta.level = static_cast<uint8_t>(level);
+        delta.stock_locate = locate;
+        delta.order_count = lvl.order_count;
+        delta.price = lvl.price;
+        delta.quantity = lvl.quantity;
+        delta.timestamp = ts;
+
+        switch (action) {
+            case LevelDelta::Action::Insert: ++stats_.inserts; break;
+            case LevelDelta::Action::Update: ++stats_.updates; break;
+            case LevelDelta::Action::Delete: ++stats_.deletes; break;
+        }
+
+        if (backpressure_) {
+            output_.push(delta);
+            ++stats_.deltas_emitted;
+            return;
+        }
+
+        if (output_.try_push(delta)) {
+            ++stats_.deltas_emitted;
+        } else {
+            ++stats_.deltas_dropped;
+        }
+    }
+
+    size_t levels_;
+    DeltaBuffer& output_;
+    std::vector<std::unique_ptr<Snapshot>> snapshots_;  // Indexed by stock locate
+    bool backpressure_ = false;
+    Stats stats_;
+};
+
+/**
+ * Consumer-side top-N book rebuilt from LevelDelta messages
+ * Useful for downstream consumers and for verifying a feed.
+ */
+class DepthBook {
+public:
+    explicit DepthBook(size_t levels)
+        : levels_(levels) {}
+
+    void apply(const LevelDelta& delta) {
+        std::vector<PriceLevel>& side = delta.side == Side::Buy ? bids_ : asks_;
+        size_t i = delta.level;
+
+        PriceLevel lvl;
+        lvl.price = delta.price;
+        lvl.quantity = delta.quantity;
+        lvl.order_count = delta.order_count;
+
+        switch (delta.action) {
+            case LevelDelta::Action::Insert:
+                if (i <= side.size()) {
+                    side.insert(side.begin() + i, lvl);
+                    if (side.size() > levels_) {
+                        side.pop_back();
+                    }
+                }
+                break;
+            case LevelDelta::Action::Update:
+                if (i < side.size()) {
+                    side[i] = lvl;
+                }
+                break;
+            case LevelDelta::Action::Delete:
+                if (i < side.size()) {
+                    side.erase(side.begin() + i);
+                }
+                break;
+        }
+    }
+
+    const std::vector<PriceLevel>& bids() const { return bids_; }
+    const std::vector<PriceLevel>& asks() const { return asks_; }
+
+private:
+    size_t levels_;
+    std::vector<PriceLevel> bids_;
+    std::vector<PriceLevel> asks_;
+};
+
+} // namespace book
+} // namespace hft
@@ -0,0 +1,396 @@
+#pragma once
+
+#include "order_table.hpp"
+#include "price_ladder.hpp"
+#include "top_of_book.hpp"
+#include "depth_feed.hpp"
+#include "../common/types.hpp"
+#include "../common/symbol_table.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace hft {
+namespace book {
+
+/**
+ * A resting order, as tracked by the book engine
+ *
+ * ITCH Execute/Cancel/Delete/Replace messages only carry the order
+ * reference number, so every order remembers its instrument, side and
+ * price. The instrument is kept as a locate code, which indexes the
+ * engine's book table directly.
+ */
+struct Order {
+    OrderRef ref = 0;
+    Price price = 0;
+    Quantity quantity = 0;
+    Side side = Side::Buy;
+    StockLocate locate = 0;
+};
+
+/**
+ * Per-symbol limit order book (bid and ask sides)
+ *
+ * Levels are aggregated by price. Individual orders live in the
+ * BookEngine's order table; the book only tracks per-level totals.
+ *
+ * LevelStorage selects the per-side container (see price_ladder.hpp):
+ * LadderLevelStorage for the dense tick ladder, MapLevelStorage for the
+ * std::map reference implementation.
+ */
+template <typename LevelStorage>
+class BasicOrderBook {
+public:
+    using BidLevels = typename LevelStorage::template side_type<true>;
+    using AskLevels = typename LevelStorage::template side_type<false>;
+
+    explicit BasicOrderBook(const StockSymbol& stock = {}, StockLocate locate = 0)
+        : stock_(stock)
+        , locate_(locate)
+        , last_update_(0) {}
+
+    // Add displayed shares at a price level
+    void add(Side side, Price price, Quantity qty) {
+        if (side == Side::Buy) {
+            bids_.add(price, qty);
+        } else {
+            asks_.add(price, qty);
+        }
+    }
+
+    // Remove shares from a price level
+    // order_removed is true when the order leaves the book entirely
+    void reduce(Side side, Price price, Quantity qty, bool order_removed) {
+        if (side == Side::Buy) {
+            bids_.reduce(price, qty, order_removed);
+        } else {
+            asks_.reduce(price, qty, order_removed);
+        }
+    }
+
+    // Best prices (nullptr if the side is empty)
+    const PriceLevel* best_bid() const { return bids_.best(); }
+    const PriceLevel* best_ask() const { return asks_.best(); }
+
+    // Level lookup by price (nullptr if no orders rest at that price)
+    const PriceLevel* level(Side side, Price price) const {
+        return side == Side::Buy ? bids_.find(price) : asks_.find(price);
+    }
+
+    size_t bid_depth() const { return bids_.depth(); }
+    size_t ask_depth() const { return asks_.depth(); }
+    bool empty() const { return bids_.empty() && asks_.empty(); }
+
+    const BidLevels& bids() const { return bids_; }
+    const AskLevels& asks() const { return asks_; }
+
+    const StockSymbol& stock() const { return stock_; }
+    StockLocate locate() const { return locate_; }
+    Timestamp last_update() const { return last_update_; }
+    void set_last_update(Timestamp ts) { last_update_ = ts; }
+
+private:
+    StockSymbol stock_;
+    StockLocate locate_;
+    Timestamp last_update_;
+    BidLevels bids_;
+    AskLevels asks_;
+};
+
+/**
+ * Market-by-order book engine
+ *
+ * Applies every NormalizedMessage that affects displayed liquidity to
+ * per-symbol books. Runs on the consumer core, so it is single-threaded
+ * and performs no locking.
+ *
+ * Books are indexed directly by stock locate code, and the engine keeps
+ * the day's SymbolTable from StockDirectory messages, so no symbol is
+ * hashed or compared on the hot path. LevelStorage is passed through to
+ * every book; BookEngine is the dense-ladder instantiation.
+ *
+ * Orders live in a pre-sized OrderTable: node memory is allocated once
+ * at construction and recycled through a free list, so the hot path
+ * never touches the heap for order bookkeeping.
+ *
+ * Derived feeds (TopOfBookTable, DepthFeed) are optional and are updated
+ * on the same thread after every book change.
+ *
+ * Message handling:
+ * - StockDirectory:               register locate -> symbol
+ * - AddOrder / AddOrderMPID:      insert order, add shares to its level
+ * - OrderExecuted(WithPrice):     reduce order by executed shares
+ * - OrderCancel:                  reduce order by cancelled shares
+ * - OrderDelete:                  remove order
+ * - OrderReplace:                 remove original, insert new order with
+ *                                 the original side and symbol
+ * - Trade (non-cross):            non-displayed liquidity, book unchanged
+ */
+template <typename LevelStorage>
+class BasicBookEngine {
+public:
+    using Book = BasicOrderBook<LevelStorage>;
+
+    // Default arena size: peak simultaneously resting orders on a busy day
+    static constexpr size_t DEFAULT_MAX_ORDERS = 1 << 22;
+
+    explicit BasicBookEngine(size_t max_orders = DEFAULT_MAX_ORDERS)
+        : orders_(max_orders)
+        , books_(SymbolTable::MAX_LOCATES)
+        , book_count_(0) {}
+
+    // Non-copyable (owns large preallocated tables)
+    BasicBookEngine(const BasicBookEngine&) = delete;
+    BasicBookEngine& operator=(const BasicBookEngine&) = delete;
+
+    /**
+     * Apply a normalized message to the books
+     * Returns true if a book changed
+     */
+    bool apply(const NormalizedMessage& msg) {
+        switch (msg.type()) {
+            case MessageType::AddOrder:
+            case MessageType::AddOrderMPID:
+                return on_add(msg);
+
+            case MessageType::OrderExecuted:
+            case MessageType::OrderExecutedWithPrice:
+                ++stats_.executions;
+                return on_reduce(msg.order_ref(), msg.executed_quantity(), msg.timestamp());
+
+            case MessageType::OrderCancel:
+                ++stats_.cancels;
+                return on_reduce(msg.order_ref(), msg.quantity(), msg.timestamp());
+
+            case MessageType::OrderDelete:
+                ++stats_.deletes;
+                return on_delete(msg.order_ref(), msg.timestamp());
+
+            case MessageType::OrderReplace:
+                return on_replace(msg);
+
+            case MessageType::Trade:
+                ++stats_.trades;
+                return false;
+
+            case MessageType::StockDirectory:
+                symbols_.add(msg.stock_locate(), msg.stock(), msg.quantity());
+                return false;
+
+            default:
+                ++stats_.ignored;
+                return false;
+        }
+    }
+
+    // Find the book for a locate code (nullptr if no orders were ever added)
+    const Book* find_book(StockLocate locate) const {
+        return books_[locate].get();
+    }
+
+    // Find the book for a symbol (cold path: resolves the locate by scan)
+    const Book* find_book(const StockSymbol& stock) const {
+        StockLocate locate = symbols_.locate_of(stock);
+        return locate == 0 ? nullptr : find_book(locate);
+    }
+
+    const SymbolTable& symbols() const { return symbols_; }
+
+    /**
+     * Attach a top-of-book table to publish into after every book change
+     * The table must outlive the engine; nullptr detaches
+     */
+    void set_top_of_book(TopOfBookTable* table) { top_of_book_ = table; }
+
+    /**
+     * Attach a market-by-price depth feed, diffed after every book change
+     * The feed must outlive the engine; nullptr detaches
+     */
+    void set_depth_feed(DepthFeed* feed) { depth_feed_ = feed; }
+
+    // Find a resting order (nullptr if unknown)
+    const Order* find_order(OrderRef ref) const {
+        return orders_.find(ref);
+    }
+
+    size_t order_count() const { return orders_.size(); }
+    size_t book_count() const { return book_count_; }
+
+    // Statistics
+    struct Stats {
+        uint64_t adds = 0;
+        uint64_t executions = 0;
+        uint64_t cancels = 0;
+        uint64_t deletes = 0;
+        uint64_t replaces = 0;
+        uint64_t trades = 0;
+        uint64_t unknown_orders = 0;    // Reference not found in order table
+        uint64_t duplicate_orders = 0;  // Add for a reference already resting
+        uint64_t table_full = 0;        // Add dropped because the arena is exhausted
+        uint64_t ignored = 0;           // Messages that never affect a book
+    };
+
+    const Stats& get_stats() const { return stats_; }
+
+    // Drop all orders and books (e.g. at start of a new session)
+    void clear() {
+        orders_.clear();
+        for (auto& book : books_) {
+            book.reset();
+        }
+        book_count_ = 0;
+        symbols_.clear();
+        stats_ = Stats{};
+    }
+
+private:
+    Book& book_for(StockLocate locate) {
+        auto& slot = books_[locate];
+        if (!slot) {
+            // Adds carry only the locate: a book created before its
+            // StockDirectory message (e.g. late join) has a blank symbol
+            slot = std::make_unique<Book>(symbols_.symbol(locate), locate);
+            ++book_count_;
+        }
+        return *slot;
+    }
+
+    bool insert_order(OrderRef ref, Book& book, Side side, Price price,
+                      Quantity qty, Timestamp ts) {
+        auto [node, inserted] = orders_.try_emplace(ref);
+        if (!inserted) {
+            if (node) {
+                ++stats_.duplicate_orders;
+            } else {
+                ++stats_.table_full;
+            }
+            return false;
+        }
+
+        Order& order = *node;
+        order.ref = ref;
+        order.price = price;
+        order.quantity = qty;
+        order.side = side;
+        order.locate = book.locate();
+
+        book.add(side, price, qty);
+        book.set_last_update(ts);
+        return true;
+    }
+
+    bool on_add(const NormalizedMessage& msg) {
+        ++stats_.adds;
+        Book& book = book_for(msg.stock_locate());
+        if (!insert_order(msg.order_ref(), book, msg.side(), msg.price(), msg.quantity(), msg.timestamp())) {
+            return false;
+        }
+        on_book_change(book, msg.timestamp());
+        return true;
+    }
+
+    bool on_reduce(OrderRef ref, Quantity qty, Timestamp ts) {
+        Order* node = orders_.find(ref);
+        if (!node) {
+            ++stats_.unknown_orders;
+            return false;
+        }
+
+        Order& order = *node;
+        const bool removed = qty >= order.quantity;
+        const Quantity delta = removed ? order.quantity : qty;
+
+        Book& book = *books_[order.locate];
+        book.reduce(order.side, order.price, delta, removed);
+        book.set_last_update(ts);
+
+        if (removed) {
+            orders_.erase(ref);
+        } else {
+            order.quantity -= delta;
+        }
+        on_book_change(book, ts);
+        return true;
+    }
+
+    bool on_delete(OrderRef ref, Timestamp ts) {
+        Order* node = orders_.find(ref);
+        if (!node) {
+            ++stats_.unknown_orders;
+            return false;
+        }
+
+        Book& book = *books_[node->locate];
+        book.reduce(node->side, node->price, node->quantity, true);
+        book.set_last_update(ts);
+        orders_.erase(ref);
+        on_book_change(book, ts);
+        return true;
+    }
+
+    bool on_replace(const NormalizedMessage& msg) {
+        ++stats_.replaces;
+
+        Order* node = orders_.find(msg.order_ref());
+        if (!node) {
+            ++stats_.unknown_orders;
+            return false;
+        }
+
+        // Replacement keeps the side and symbol of the original order
+        Book& book = *books_[node->locate];
+        const Side side = node->side;
+
+        book.reduce(side, node->price, node->quantity, true);
+        orders_.erase(msg.order_ref());
+
+        insert_order(msg.new_order_ref(), book, side, msg.price(), msg.quantity(), msg.timestamp());
+        book.set_last_update(msg.timestamp());
+        on_book_change(book, msg.timestamp());
+        return true;
+    }
+
+    // Fan a book change out to the attached derived feeds
+    void on_book_change(const Book& book, Timestamp ts) {
+        if (top_of_book_) {
+            publish_top(book, ts);
+        }
+        if (depth_feed_) {
+            depth_feed_->update(book, ts);
+        }
+    }
+
+    // Publish the book's BBO to the top-of-book table
+    void publish_top(const Book& book, Timestamp ts) {
+        TopOfBook top;
+        if (const PriceLevel* bid = book.best_bid()) {
+            top.bid_price = bid->price;
+            top.bid_quantity = bid->quantity;
+            top.bid_orders = bid->order_count;
+        }
+        if (const PriceLevel* ask = book.best_ask()) {
+            top.ask_price = ask->price;
+            top.ask_quantity = ask->quantity;
+            top.ask_orders = ask->order_count;
+        }
+        top.timestamp = ts;
+        top_of_book_->publish(book.locate(), top);
+    }
+
+    OrderTable<Order> orders_;
+    SymbolTable symbols_;
+    std::vector<std::unique_ptr<Book>> books_;  // Indexed by stock locate
+    size_t book_count_;
+    TopOfBookTable* top_of_book_ = nullptr;
+    DepthFeed* depth_feed_ = nullptr;
+    Stats stats_;
+};
+
+// Default book: dense tick ladder per side
+using OrderBook = BasicOrderBook<LadderLevelStorage>;
+using BookEngine = BasicBookEngine<LadderLevelStorage>;
+
+} // namespace book
+} // namespace hft
@@ -0,0 +1,235 @@
+#pragma once
+
+#include "../common/types.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace hft {
+namespace book {
+
+/**
+ * Fixed-capacity node arena with an index free list
+ *
+ * All nodes are allocated once at construction. allocate()/release()
+ * only push and pop indices, so there is no heap traffic on the hot path
+ * and node addresses stay stable for the lifetime of the pool.
+ */
+template <typename Node>
+class NodePool {
+public:
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    explicit NodePool(size_t capacity)
+        : capacity_(static_cast<uint32_t>(capacity))
+        , nodes_(new Node[capacity]())
+        , free_list_(new uint32_t[capacity])
+        , free_count_(static_cast<uint32_t>(capacity)) {
+        // Hand out low indices first so a quiet day stays in few pages
+        for (uint32_t i = 0; i < capacity_; ++i) {
+            free_list_[i] = capacity_ - 1 - i;
+        }
+    }
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    // Returns INVALID_INDEX when the pool is exhausted
+    uint32_t allocate() noexcept {
+        if (free_count_ == 0) {
+            return INVALID_INDEX;
+        }
+        return free_list_[--free_count_];
+    }
+
+    void release(uint32_t index) noexcept {
+        free_list_[free_count_++] = index;
+    }
+
+    Node& operator[](uint32_t index) noexcept { return nodes_[index]; }
+    const Node& operator[](uint32_t index) const noexcept { return nodes_[index]; }
+
+    size_t capacity() const noexcept { return capacity_; }
+    size_t in_use() const noexcept { return capacity_ - free_count_; }
+
+    void clear() noexcept {
+        for (uint32_t i = 0; i < capacity_; ++i) {
+            free_list_[i] = capacity_ - 1 - i;
+        }
+        free_count_ = capacity_;
+    }
+
+private:
+    uint32_t capacity_;
+    std::unique_ptr<Node[]> nodes_;
+    std::unique_ptr<uint32_t[]> free_list_;
+    uint32_t free_count_;
+};
+
+/**
+ * Open-addressing order reference table
+ *
+ * Maps 64-bit ITCH order reference numbers to arena-backed nodes.
+ *
+ * Design:
+ * - Linear probing over a power-of-2 slot array, kept at most half full
+ * - Fibonacci hashing: ITCH references are assigned sequentially, and a
+ *   multiplicative hash spreads consecutive keys across the table
+ * - Backward-shift deletion, so no tombstones accumulate over the day
+ * - Each slot is 16 bytes (key + node index), four slots per cache line
+ *
+ * Capacity is the maximum number of simultaneously resting orders, not
+ * the number of adds in a day: deleted nodes go back to the free list.
+ */
+template <typename Node>
+class OrderTable {
+public:
+    explicit OrderTable(size_t max_orders)
+        : pool_(max_orders)
+        , slot_count_(slot_count_for(max_orders))
+        , mask_(slot_count_ - 1)
+        , shift_(64 - log2(slot_count_))
+        , slots_(new Slot[slot_count_]())
+        , size_(0) {}
+
+    OrderTable(const OrderTable&) = delete;
+    OrderTable& operator=(const OrderTable&) = delete;
+
+    /**
+     * Find the node for a reference (nullptr if not present)
+     */
+    Node* find(OrderRef ref) noexcept {
+        size_t i = home_slot(ref);
+        while (true) {
+            const Slot& slot = slots_[i];
+            if (slot.index == EMPTY) {
+                return nullptr;
+            }
+            if (slot.key == ref) {
+                return &pool_[slot.index];
+            }
+            i = (i + 1) & mask_;
+        }
+    }
+
+    const Node* find(OrderRef ref) const noexcept {
+        return const_cast<OrderTable*>(this)->find(ref);
+    }
+
+    /**
+     * Insert a reference if it is not already present
+     * Returns {node, true} on insert, {existing, false} if present,
+     * and {nullptr, false} if the arena is exhausted
+     */
+    std::pair<Node*, bool> try_emplace(OrderRef ref) noexcept {
+        size_t i = home_slot(ref);
+        while (true) {
+            Slot& slot = slots_[i];
+            if (slot.index == EMPTY) {
+                break;
+            }
+            if (slot.key == ref) {
+                return {&pool_[slot.index], false};
+            }
+            i = (i + 1) & mask_;
+        }
+
+        uint32_t index = pool_.allocate();
+        if (index == NodePool<Node>::INVALID_INDEX) {
+            return {nullptr, false};
+        }
+
+        slots_[i].key = ref;
+        slots_[i].index = index;
+        ++size_;
+        return {&pool_[index], true};
+    }
+
+    /**
+     * Remove a reference and return its node to the arena
+     * Returns false if the reference was not present
+     */
+    bool erase(OrderRef ref) noexcept {
+        size_t i = home_slot(ref);
+        while (true) {
+            Slot& slot = slots_[i];
+            if (slot.index == EMPTY) {
+                return false;
+            }
+            if (slot.key == ref) {
+                break;
+            }
+            i = (i + 1) & mask_;
+        }
+
+        pool_.release(slots_[i].index);
+        --size_;
+
+        // Backward-shift: pull later entries of the probe run into the hole
+        size_t hole = i;
+        size_t j = (i + 1) & mask_;
+        while (slots_[j].index != EMPTY) {
+            size_t home = home_slot(slots_[j].key);
+            // Entry at j may move to hole if its home is not in (hole, j]
+            if (((j - home) & mask_) >= ((j - hole) & mask_)) {
+                slots_[hole] = slots_[j];
+                hole = j;
+            }
+            j = (j + 1) & mask_;
+        }
+        slots_[hole].index = EMPTY;
+        return true;
+    }
+
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return pool_.capacity(); }
+    size_t slot_count() const noexcept { return slot_count_; }
+
+    void clear() noexcept {
+        for (size_t i = 0; i < slot_count_; ++i) {
+            slots_[i].index = EMPTY;
+        }
+        pool_.clear();
+        size_ = 0;
+    }
+
+private:
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+
+    struct Slot {
+        OrderRef key = 0;
+        uint32_t index = EMPTY;
+    };
+
+    static size_t slot_count_for(size_t max_orders) {
+        size_t n = 16;
+        while (n < max_orders * 2) {
+            n <<= 1;
+        }
+        return n;
+    }
+
+    static unsigned log2(size_t n) {
+        unsigned bits = 0;
+        while ((size_t{1} << bits) < n) {
+            ++bits;
+        }
+        return bits;
+    }
+
+    size_t home_slot(OrderRef ref) const noexcept {
+        return static_cast<size_t>((ref * 0x9E3779B97F4A7C15ULL) >> shift_);
+    }
+
+    NodePool<Node> pool_;
+    size_t slot_count_;
+    size_t mask_;
+    unsigned shift_;
+    std::unique_ptr<Slot[]> slots_;
+    size_t size_;
+};
+
+} // namespace book
+} // namespace hft
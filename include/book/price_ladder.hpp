@@ -0,0 +1,415 @@
+#pragma once
+
+#include "../common/types.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <type_traits>
+
+namespace hft {
+namespace book {
+
+/**
+ * Aggregated state of a single price level
+ */
+struct PriceLevel {
+    Price price = 0;
+    uint64_t quantity = 0;      // Sum of displayed shares at this price
+    uint32_t order_count = 0;   // Number of resting orders at this price
+};
+
+// Ordering of one book side: best price first
+template <bool IsBid>
+using LevelOrder = std::conditional_t<IsBid, std::greater<Price>, std::less<Price>>;
+
+/**
+ * Tree-based level storage for one side of a book
+ *
+ * Simple and unbounded, but every add/remove of a level allocates and
+ * every lookup walks the tree. Kept as the reference implementation and
+ * as a fallback for instruments with very wide books.
+ *
+ * Side storage interface (shared with LadderLevels):
+ * - add(price, qty)                    one more order at price
+ * - reduce(price, qty, order_removed)  remove shares (and maybe the order)
+ * - best() / find(price)               nullptr if absent
+ * - for_each(f)                        best to worst, stops when f returns false
+ */
+template <bool IsBid>
+class MapLevels {
+public:
+    void add(Price price, Quantity qty) {
+        PriceLevel& lvl = levels_[price];
+        lvl.price = price;
+        lvl.quantity += qty;
+        ++lvl.order_count;
+    }
+
+    void reduce(Price price, Quantity qty, bool order_removed) {
+        auto it = levels_.find(price);
+        if (it == levels_.end()) {
+            return;
+        }
+
+        PriceLevel& lvl = it->second;
+        lvl.quantity = (qty >= lvl.quantity) ? 0 : lvl.quantity - qty;
+        if (order_removed && lvl.order_count > 0) {
+            --lvl.order_count;
+        }
+
+        if (lvl.order_count == 0) {
+            levels_.erase(it);
+        }
+    }
+
+    const PriceLevel* best() const {
+        return levels_.empty() ? nullptr : &levels_.begin()->second;
+    }
+
+    const PriceLevel* find(Price price) const {
+        auto it = levels_.find(price);
+        return it == levels_.end() ? nullptr : &it->second;
+    }
+
+    template <typename F>
+    void for_each(F&& f) const {
+        for (const auto& entry : levels_) {
+            if (!f(entry.second)) {
+                return;
+            }
+        }
+    }
+
+    size_t depth() const { return levels_.size(); }
+    bool empty() const { return levels_.empty(); }
+    void clear() { levels_.clear(); }
+
+private:
+    std::map<Price, PriceLevel, LevelOrder<IsBid>> levels_;
+};
+
+/**
+ * Dense price-ladder level storage for one side of a book
+ *
+ * Levels live in a contiguous array indexed by tick offset from a base
+ * price, so add/reduce/find on the hot path is an index computation and
+ * one cache line. A two-level bitmap (one summary word over up to 64
+ * occupancy words) makes the best-price scan two count-leading/trailing-
+ * zero instructions.
+ *
+ * Window management:
+ * - The window covers Window ticks of Tick each (default: 256 x $0.01)
+ * - It is centred with room to improve: the best bid sits at 3/4 of the
+ *   window and the best ask at 1/4
+ * - An add better than the window, an add to an empty window, or a run
+ *   of RECENTER_MISSES consecutive on-tick adds outside the window (the
+ *   market walked away) moves the window; levels that fall outside
+ *   migrate to overflow
+ * - Levels worse than the window, and off-tick prices (e.g. sub-penny
+ *   quotes), live in an ordered overflow map
+ *
+ * best() and for_each() merge the window with the overflow map, so the
+ * result is exact regardless of where the window currently sits.
+ */
+template <bool IsBid, Price Tick = PRICE_SCALE / 100, size_t Window = 256>
+class LadderLevels {
+    static_assert(Tick > 0, "Tick must be positive");
+    static_assert(Window % 64 == 0 && Window <= 64 * 64,
+                  "Window must be a multiple of 64, at most 4096 ticks");
+
+public:
+    static constexpr Price TICK = Tick;
+    static constexpr size_t WINDOW = Window;
+    static constexpr uint32_t RECENTER_MISSES = 16;
+
+    void add(Price price, Quantity qty) {
+        int64_t idx = window_index_for_add(price);
+        if (idx < 0) {
+            PriceLevel& lvl = overflow_[price];
+            lvl.price = price;
+            lvl.quantity += qty;
+            ++lvl.order_count;
+            return;
+        }
+
+        PriceLevel& lvl = levels_[idx];
+        if (lvl.order_count == 0) {
+            lvl.price = price;
+            lvl.quantity = 0;
+            occupy(static_cast<size_t>(idx));
+        }
+        lvl.quantity += qty;
+        ++lvl.order_count;
+    }
+
+    void reduce(Price price, Quantity qty, bool order_removed) {
+        int64_t idx = window_index(price);
+        if (idx < 0) {
+            reduce_overflow(price, qty, order_removed);
+            return;
+        }
+
+        PriceLevel& lvl = levels_[idx];
+        if (lvl.order_count == 0) {
+            return;
+        }
+
+        lvl.quantity = (qty >= lvl.quantity) ? 0 : lvl.quantity - qty;
+        if (order_removed) {
+            --lvl.order_count;
+        }
+
+        if (lvl.order_count == 0) {
+            vacate(static_cast<size_t>(idx));
+            // Keep the touch in the dense window
+            if (window_levels_ == 0 && !overflow_.empty()) {
+                recenter(overflow_.begin()->first / Tick);
+            }
+        }
+    }
+
+    const PriceLevel* best() const {
+        int idx = first_index();
+        const PriceLevel* dense = idx < 0 ? nullptr : &levels_[idx];
+        const PriceLevel* sparse = overflow_.empty() ? nullptr : &overflow_.begin()->second;
+
+        if (!dense) return sparse;
+        if (!sparse) return dense;
+        return better(sparse->price, dense->price) ? sparse : dense;
+    }
+
+    const PriceLevel* find(Price price) const {
+        int64_t idx = window_index(price);
+        if (idx >= 0) {
+            const PriceLevel& lvl = levels_[idx];
+            return lvl.order_count == 0 ? nullptr : &lvl;
+        }
+        auto it = overflow_.find(price);
+        return it == overflow_.end() ? nullptr : &it->second;
+    }
+
+    template <typename F>
+    void for_each(F&& f) const {
+        int idx = first_index();
+        auto it = overflow_.begin();
+
+        while (idx >= 0 || it != overflow_.end()) {
+            bool take_dense = idx >= 0 &&
+                (it == overflow_.end() || !better(it->first, levels_[idx].price));
+            if (take_dense) {
+                if (!f(levels_[idx])) {
+                    return;
+                }
+                idx = next_index(idx);
+            } else {
+                if (!f(it->second)) {
+                    return;
+                }
+                ++it;
+            }
+        }
+    }
+
+    size_t depth() const { return window_levels_ + overflow_.size(); }
+    bool empty() const { return window_levels_ == 0 && overflow_.empty(); }
+
+    void clear() {
+        levels_.fill(PriceLevel{});
+        bits_.fill(0);
+        summary_ = 0;
+        window_levels_ = 0;
+        overflow_.clear();
+        base_ = 0;
+        misses_ = 0;
+    }
+
+    // Diagnostics
+    Price window_low() const { return base_ * Tick; }
+    Price window_high() const { return (base_ + static_cast<int64_t>(Window) - 1) * Tick; }
+    size_t window_depth() const { return window_levels_; }
+    size_t overflow_depth() const { return overflow_.size(); }
+    uint64_t recenters() const { return recenters_; }
+
+private:
+    static constexpr size_t WORDS = Window / 64;
+
+    static bool better(Price a, Price b) {
+        return IsBid ? a > b : a < b;
+    }
+
+    // Window slot for a price, or -1 if off-tick or outside the window
+    int64_t window_index(Price price) const {
+        if (price % Tick != 0) {
+            return -1;
+        }
+        int64_t idx = price / Tick - base_;
+        return (idx >= 0 && idx < static_cast<int64_t>(Window)) ? idx : -1;
+    }
+
+    // As window_index, but may move the window to keep the touch dense
+    int64_t window_index_for_add(Price price) {
+        if (price % Tick != 0) {
+            return -1;
+        }
+        int64_t tick = price / Tick;
+        int64_t idx = tick - base_;
+        if (idx >= 0 && idx < static_cast<int64_t>(Window)) {
+            misses_ = 0;
+            return idx;
+        }
+
+        bool improves = IsBid ? idx >= static_cast<int64_t>(Window) : idx < 0;
+        if (window_levels_ == 0 || improves || ++misses_ >= RECENTER_MISSES) {
+            recenter(tick);
+            return tick - base_;
+        }
+        return -1;
+    }
+
+    /**
+     * Move the window so that the given tick sits at the touch anchor
+     * Dense levels are spilled to overflow, then any on-tick overflow
+     * levels inside the new window are pulled back in.
+     */
+    void recenter(int64_t tick) {
+        ++recenters_;
+        misses_ = 0;
+
+        for (int idx = first_index(); idx >= 0; idx = next_index(idx)) {
+            overflow_.emplace(levels_[idx].price, levels_[idx]);
+            levels_[idx] = PriceLevel{};
+        }
+        bits_.fill(0);
+        summary_ = 0;
+        window_levels_ = 0;
+
+        constexpr int64_t anchor = IsBid ? static_cast<int64_t>(Window * 3 / 4)
+                                         : static_cast<int64_t>(Window / 4);
+        base_ = tick - anchor;
+
+        // Overflow is ordered best-first; walk the slice inside the window
+        const Price low = window_low();
+        const Price high = window_high();
+        auto it = overflow_.lower_bound(IsBid ? high : low);
+        while (it != overflow_.end() && (IsBid ? it->first >= low : it->first <= high)) {
+            int64_t idx = window_index(it->first);
+            if (idx < 0) {
+                ++it;   // Off-tick price stays in overflow
+                continue;
+            }
+            levels_[idx] = it->second;
+            occupy(static_cast<size_t>(idx));
+            it = overflow_.erase(it);
+        }
+    }
+
+    void reduce_overflow(Price price, Quantity qty, bool order_removed) {
+        auto it = overflow_.find(price);
+        if (it == overflow_.end()) {
+            return;
+        }
+
+        PriceLevel& lvl = it->second;
+        lvl.quantity = (qty >= lvl.quantity) ? 0 : lvl.quantity - qty;
+        if (order_removed && lvl.order_count > 0) {
+            --lvl.order_count;
+        }
+        if (lvl.order_count == 0) {
+            overflow_.erase(it);
+        }
+    }
+
+    void occupy(size_t idx) {
+        bits_[idx / 64] |= uint64_t{1} << (idx % 64);
+        summary_ |= uint64_t{1} << (idx / 64);
+        ++window_levels_;
+    }
+
+    void vacate(size_t idx) {
+        uint64_t& word = bits_[idx / 64];
+        word &= ~(uint64_t{1} << (idx % 64));
+        if (word == 0) {
+            summary_ &= ~(uint64_t{1} << (idx / 64));
+        }
+        --window_levels_;
+    }
+
+    // Best occupied slot (highest for bids, lowest for asks), -1 if none
+    int first_index() const {
+        if (summary_ == 0) {
+            return -1;
+        }
+        if (IsBid) {
+            int w = 63 - __builtin_clzll(summary_);
+            return w * 64 + 63 - __builtin_clzll(bits_[w]);
+        }
+        int w = __builtin_ctzll(summary_);
+        return w * 64 + __builtin_ctzll(bits_[w]);
+    }
+
+    // Next occupied slot after idx in best-to-worst order, -1 if none
+    int next_index(int idx) const {
+        if (IsBid) {
+            if (idx == 0) {
+                return -1;
+            }
+            int from = idx - 1;
+            int w = from / 64;
+            int b = from % 64;
+            uint64_t word = bits_[w] & (b == 63 ? ~uint64_t{0} : ((uint64_t{1} << (b + 1)) - 1));
+            if (word) {
+                return w * 64 + 63 - __builtin_clzll(word);
+            }
+            uint64_t rest = summary_ & ((uint64_t{1} << w) - 1);
+            if (!rest) {
+                return -1;
+            }
+            int w2 = 63 - __builtin_clzll(rest);
+            return w2 * 64 + 63 - __builtin_clzll(bits_[w2]);
+        }
+
+        int from = idx + 1;
+        if (from >= static_cast<int>(Window)) {
+            return -1;
+        }
+        int w = from / 64;
+        uint64_t word = bits_[w] & (~uint64_t{0} << (from % 64));
+        if (word) {
+            return w * 64 + __builtin_ctzll(word);
+        }
+        uint64_t rest = (w + 1 < 64) ? summary_ & (~uint64_t{0} << (w + 1)) : 0;
+        if (!rest) {
+            return -1;
+        }
+        int w2 = __builtin_ctzll(rest);
+        return w2 * 64 + __builtin_ctzll(bits_[w2]);
+    }
+
+    std::array<PriceLevel, Window> levels_{};
+    std::array<uint64_t, WORDS> bits_{};
+    uint64_t summary_ = 0;
+    size_t window_levels_ = 0;
+    int64_t base_ = 0;          // Tick number of levels_[0]
+    uint32_t misses_ = 0;       // Consecutive on-tick adds outside the window
+    uint64_t recenters_ = 0;
+    std::map<Price, PriceLevel, LevelOrder<IsBid>> overflow_;
+};
+
+/**
+ * Level storage policies for BasicOrderBook
+ */
+struct MapLevelStorage {
+    template <bool IsBid>
+    using side_type = MapLevels<IsBid>;
+};
+
+struct LadderLevelStorage {
+    template <bool IsBid>
+    using side_type = LadderLevels<IsBid>;
+};
+
+} // namespace book
+} // namespace hft
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "../common/types.hpp"
+#include "../common/symbol_table.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+namespace hft {
+namespace book {
+
+/**
+ * Best bid/offer for one instrument (plain value snapshot)
+ * A price of 0 with size 0 means the side is empty.
+ */
+struct TopOfBook {
+    Price bid_price = 0;
+    Price ask_price = 0;
+    uint64_t bid_quantity = 0;
+    uint64_t ask_quantity = 0;
+    uint32_t bid_orders = 0;
+    uint32_t ask_orders = 0;
+    Timestamp timestamp = 0;    // ITCH timestamp of the last top change
+};
+
+/**
+ * Seqlock-protected top-of-book record
+ *
+ * One writer (the book engine on the consumer core), any number of
+ * readers on any thread. Readers never block the writer and never write
+ * to the line, so adding readers only costs the writer the coherence
+ * miss of re-acquiring the line after a read.
+ *
+ * Protocol:
+ * - Writer bumps seq to odd, stores the fields, bumps seq to even
+ * - Reader loads seq (acquire), copies the fields, fences, reloads seq;
+ *   an odd or changed sequence means the copy may be torn, so retry
+ *
+ * Fields are relaxed atomics so concurrent access is race-free; on
+ * x86-64 they compile to plain loads and stores. The record fills
+ * exactly one cache line so neighbouring instruments never false-share.
+ */
+class alignas(CACHE_LINE_SIZE) SeqlockTopOfBook {
+public:
+    void store(const TopOfBook& tob) noexcept {
+        uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        bid_price_.store(tob.bid_price, std::memory_order_relaxed);
+        ask_price_.store(tob.ask_price, std::memory_order_relaxed);
+        bid_quantity_.store(tob.bid_quantity, std::memory_order_relaxed);
+        ask_quantity_.store(tob.ask_quantity, std::memory_order_relaxed);
+        orders_.store(pack_orders(tob.bid_orders, tob.ask_orders), std::memory_order_relaxed);
+        timestamp_.store(tob.timestamp, std::memory_order_relaxed);
+
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * Single attempt at a consistent copy
+     * Returns false if a write was in progress or overlapped the copy
+     */
+    bool try_load(TopOfBook& out) const noexcept {
+        uint64_t before = seq_.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+
+        out.bid_price = bid_price_.load(std::memory_order_relaxed);
+        out.ask_price = ask_price_.load(std::memory_order_relaxed);
+        out.bid_quantity = bid_quantity_.load(std::memory_order_relaxed);
+        out.ask_quantity = ask_quantity_.load(std::memory_order_relaxed);
+        uint64_t orders = orders_.load(std::memory_order_relaxed);
+        out.bid_orders = static_cast<uint32_t>(orders >> 32);
+        out.ask_orders = static_cast<uint32_t>(orders);
+        out.timestamp = timestamp_.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return seq_.load(std::memory_order_relaxed) == before;
+    }
+
+    /**
+     * Consistent copy, retrying while the writer is active
+     * Returns the number of retries (0 on an uncontended read)
+     */
+    uint32_t load(TopOfBook& out) const noexcept {
+        uint32_t retries = 0;
+        while (!try_load(out)) {
+            ++retries;
+#if defined(__x86_64__) || defined(_M_X64)
+            __builtin_ia32_pause();
+#endif
+        }
+        return retries;
+    }
+
+    // Writer-side check: does the record already hold this top?
+    // Only meaningful on the writer thread (no concurrent stores)
+    bool same_top(const TopOfBook& tob) const noexcept {
+        return bid_price_.load(std::memory_order_relaxed) == tob.bid_price &&
+               ask_price_.load(std::memory_order_relaxed) == tob.ask_price &&
+               bid_quantity_.load(std::memory_order_relaxed) == tob.bid_quantity &&
+               ask_quantity_.load(std::memory_order_relaxed) == tob.ask_quantity &&
+               orders_.load(std::memory_order_relaxed) == pack_orders(tob.bid_orders, tob.ask_orders);
+    }
+
+    // Even sequence number; 0 means never published
+    uint64_t version() const noexcept { return seq_.load(std::memory_order_acquire); }
+
+private:
+    static uint64_t pack_orders(uint32_t bid, uint32_t ask) noexcept {
+        return (static_cast<uint64_t>(bid) << 32) | ask;
+    }
+
+    std::atomic<uint64_t> seq_{0};
+    std::atomic<Price> bid_price_{0};
+    std::atomic<Price> ask_price_{0};
+    std::atomic<uint64_t> bid_quantity_{0};
+    std::atomic<uint64_t> ask_quantity_{0};
+    std::atomic<uint64_t> orders_{0};
+    std::atomic<Timestamp> timestamp_{0};
+};
+
+static_assert(sizeof(SeqlockTopOfBook) == CACHE_LINE_SIZE,
+              "SeqlockTopOfBook must occupy exactly one cache line");
+
+/**
+ * Locate-indexed table of seqlock top-of-book records
+ *
+ * The book engine publishes into it after every change that moves the
+ * top of a book; strategy threads read any locate without going through
+ * the SPSC ring or taking a lock.
+ */
+class TopOfBookTable {
+public:
+    TopOfBookTable()
+        : slots_(new SeqlockTopOfBook[SymbolTable::MAX_LOCATES]) {}
+
+    TopOfBookTable(const TopOfBookTable&) = delete;
+    TopOfBookTable& operator=(const TopOfBookTable&) = delete;
+
+    /**
+     * Publish a new top (writer thread only)
+     * Returns false if the top was unchanged and nothing was written,
+     * so level changes behind the touch cost readers nothing
+     */
+    bool publish(StockLocate locate, const TopOfBook& tob) noexcept {
+        SeqlockTopOfBook& slot = slots_[locate];
+        if (slot.version() != 0 && slot.same_top(tob)) {
+            return false;
+        }
+        slot.store(tob);
+        ++publishes_;
+        return true;
+    }
+
+    /**
+     * Read the current top for a locate (any thread)
+     * Returns false if nothing was ever published for it
+     */
+    bool read(StockLocate locate, TopOfBook& out) const noexcept {
+        const SeqlockTopOfBook& slot = slots_[locate];
+        if (slot.version() == 0) {
+            return false;
+        }
+        slot.load(out);
+        return true;
+    }
+
+    const SeqlockTopOfBook& slot(StockLocate locate) const noexcept { return slots_[locate]; }
+
+    // Writer-side count of records written
+    uint64_t publishes() const noexcept { return publishes_; }
+
+private:
+    std::unique_ptr<SeqlockTopOfBook[]> slots_;
+    uint64_t publishes_ = 0;
+};
+
+} // namespace book
+} // namespace hft
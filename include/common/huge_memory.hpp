@@ -0,0 +1,226 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <cstdlib>
+#include <cstring>
+#else
+#include <cstdlib>
+#endif
+
+namespace hft {
+
+/**
+ * Page-aligned, optionally hugepage-backed and NUMA-bound memory
+ *
+ * Used for large structures allocated once at startup (ring storage).
+ * Allocation order, first success wins:
+ * 1. 1 GB hugepages (regions of at least 1 GB)
+ * 2. 2 MB hugepages (hugetlbfs pool, see scripts/setup_dpdk_env.sh)
+ * 3. Normal pages with a transparent hugepage hint
+ *
+ * The NUMA policy is applied before any page is touched, then every page
+ * is faulted in up front so the hot path never takes a page fault.
+ * Freed with munmap on destruction.
+ */
+
+enum class PageBacking : uint8_t {
+    Huge1G,
+    Huge2M,
+    Transparent,   // Normal mapping with MADV_HUGEPAGE; kernel may promote
+    Normal
+};
+
+inline const char* page_backing_name(PageBacking backing) {
+    switch (backing) {
+        case PageBacking::Huge1G:      return "1GB hugepages";
+        case PageBacking::Huge2M:      return "2MB hugepages";
+        case PageBacking::Transparent: return "transparent hugepages";
+        case PageBacking::Normal:      return "4KB pages";
+    }
+    return "unknown";
+}
+
+struct MemoryOptions {
+    bool huge_pages = true;  // Try hugetlbfs pages before normal pages
+    int numa_node = -1;      // Bind to this node (-1 = first-touch default)
+};
+
+/**
+ * NUMA node a CPU belongs to, or -1 if unknown
+ * Reads /sys/devices/system/cpu/cpuN/nodeM, so no libnuma dependency
+ */
+inline int numa_node_of_cpu(int cpu) {
+#ifdef __linux__
+    char path[64];
+    std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d", cpu);
+    DIR* dir = opendir(path);
+    if (!dir) {
+        return -1;
+    }
+    int node = -1;
+    while (dirent* entry = readdir(dir)) {
+        if (std::strncmp(entry->d_name, "node", 4) == 0 &&
+            entry->d_name[4] >= '0' && entry->d_name[4] <= '9') {
+            node = std::atoi(entry->d_name + 4);
+            break;
+        }
+    }
+    closedir(dir);
+    return node;
+#else
+    (void)cpu;
+    return -1;
+#endif
+}
+
+class HugePageBuffer {
+public:
+    static constexpr size_t SMALL_PAGE = 4096;
+    static constexpr size_t HUGE_2M = size_t{2} << 20;
+    static constexpr size_t HUGE_1G = size_t{1} << 30;
+
+    HugePageBuffer() = default;
+
+    // Throws std::bad_alloc if even a normal mapping fails
+    explicit HugePageBuffer(size_t bytes, const MemoryOptions& options = {}) {
+        allocate(bytes, options);
+    }
+
+    ~HugePageBuffer() { release(); }
+
+    HugePageBuffer(const HugePageBuffer&) = delete;
+    HugePageBuffer& operator=(const HugePageBuffer&) = delete;
+
+    HugePageBuffer(HugePageBuffer&& other) noexcept { swap(other); }
+    HugePageBuffer& operator=(HugePageBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            swap(other);
+        }
+        return *this;
+    }
+
+    void* data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+    PageBacking backing() const noexcept { return backing_; }
+    bool numa_bound() const noexcept { return numa_bound_; }
+
+private:
+    void allocate(size_t bytes, const MemoryOptions& options) {
+#ifdef __linux__
+        if (options.huge_pages) {
+#ifdef MAP_HUGE_1GB
+            if (bytes >= HUGE_1G &&
+                try_map(round_up(bytes, HUGE_1G), MAP_HUGETLB | MAP_HUGE_1GB)) {
+                backing_ = PageBacking::Huge1G;
+            }
+#endif
+            if (!data_ && try_map(round_up(bytes, HUGE_2M), MAP_HUGETLB)) {
+                backing_ = PageBacking::Huge2M;
+            }
+        }
+
+        if (!data_) {
+            // Round to 2 MB anyway so THP can back the whole region
+            const size_t length = round_up(bytes, options.huge_pages ? HUGE_2M : SMALL_PAGE);
+            if (!try_map(length, 0)) {
+                throw std::bad_alloc();
+            }
+            backing_ = PageBacking::Normal;
+#ifdef MADV_HUGEPAGE
+            if (options.huge_pages && madvise(data_, size_, MADV_HUGEPAGE) == 0) {
+                backing_ = PageBacking::Transparent;
+            }
+#endif
+        }
+
+        if (options.numa_node >= 0) {
+            numa_bound_ = bind_to_node(options.numa_node);
+        }
+
+        // Fault every page in now, on the bound node
+        for (size_t offset = 0; offset < size_; offset += SMALL_PAGE) {
+            static_cast<volatile uint8_t*>(data_)[offset] = 0;
+        }
+#else
+        (void)options;
+        size_ = round_up(bytes, SMALL_PAGE);
+        data_ = std::aligned_alloc(SMALL_PAGE, size_);
+        if (!data_) {
+            throw std::bad_alloc();
+        }
+        backing_ = PageBacking::Normal;
+#endif
+    }
+
+#ifdef __linux__
+    bool try_map(size_t length, int extra_flags) noexcept {
+        void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+        if (p == MAP_FAILED) {
+            return false;
+        }
+        data_ = p;
+        size_ = length;
+        return true;
+    }
+
+    // mbind(MPOL_BIND) through the raw syscall; values from <linux/mempolicy.h>
+    bool bind_to_node(int node) noexcept {
+#ifdef SYS_mbind
+        constexpr int MPOL_BIND_MODE = 2;
+        constexpr size_t MASK_BITS = 1024;
+        if (node >= static_cast<int>(MASK_BITS)) {
+            return false;
+        }
+        unsigned long mask[MASK_BITS / (8 * sizeof(unsigned long))] = {};
+        mask[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+        return syscall(SYS_mbind, data_, size_, MPOL_BIND_MODE, mask, MASK_BITS + 1, 0) == 0;
+#else
+        (void)node;
+        return false;
+#endif
+    }
+#endif
+
+    void release() noexcept {
+        if (!data_) {
+            return;
+        }
+#ifdef __linux__
+        munmap(data_, size_);
+#else
+        std::free(data_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    void swap(HugePageBuffer& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(backing_, other.backing_);
+        std::swap(numa_bound_, other.numa_bound_);
+    }
+
+    static constexpr size_t round_up(size_t bytes, size_t page) noexcept {
+        return (bytes + page - 1) & ~(page - 1);
+    }
+
+    void* data_ = nullptr;
+    size_t size_ = 0;
+    PageBacking backing_ = PageBacking::Normal;
+    bool numa_bound_ = false;
+};
+
+} // namespace hft
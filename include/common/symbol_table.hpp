@@ -0,0 +1,108 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+namespace hft {
+
+/**
+ * Dense stock-locate indexed symbol table
+ *
+ * Every ITCH message carries a 2-byte stock locate code, assigned per day
+ * by the StockDirectory ('R') messages at the start of the session. A flat
+ * 65536-entry table keyed by locate turns instrument resolution into a
+ * single array index: no symbol compares or hashing on the hot path.
+ *
+ * Locate 0 is never assigned by NASDAQ and is treated as "no instrument".
+ */
+class SymbolTable {
+public:
+    static constexpr size_t MAX_LOCATES = 65536;
+
+    struct Entry {
+        StockSymbol symbol{};
+        uint32_t round_lot_size = 0;
+        char market_category = ' ';
+        bool valid = false;
+    };
+
+    SymbolTable()
+        : entries_(new Entry[MAX_LOCATES]())
+        , count_(0) {}
+
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    /**
+     * Register (or re-register) a locate code
+     * Returns false for locate 0
+     */
+    bool add(StockLocate locate, const StockSymbol& symbol,
+             uint32_t round_lot_size = 0, char market_category = ' ') {
+        if (locate == 0) {
+            return false;
+        }
+
+        Entry& entry = entries_[locate];
+        if (!entry.valid) {
+            ++count_;
+        }
+        entry.symbol = symbol;
+        entry.round_lot_size = round_lot_size;
+        entry.market_category = market_category;
+        entry.valid = true;
+        return true;
+    }
+
+    // Entry for a locate code (nullptr if never registered)
+    const Entry* find(StockLocate locate) const noexcept {
+        const Entry& entry = entries_[locate];
+        return entry.valid ? &entry : nullptr;
+    }
+
+    bool contains(StockLocate locate) const noexcept {
+        return entries_[locate].valid;
+    }
+
+    // Symbol for a locate code (all spaces if unknown)
+    StockSymbol symbol(StockLocate locate) const noexcept {
+        const Entry& entry = entries_[locate];
+        if (entry.valid) {
+            return entry.symbol;
+        }
+        StockSymbol blank;
+        blank.fill(' ');
+        return blank;
+    }
+
+    /**
+     * Reverse lookup: symbol -> locate (0 if not found)
+     * Linear scan - for configuration and display only, never the hot path
+     */
+    StockLocate locate_of(const StockSymbol& symbol) const noexcept {
+        for (size_t i = 1; i < MAX_LOCATES; ++i) {
+            if (entries_[i].valid && entries_[i].symbol == symbol) {
+                return static_cast<StockLocate>(i);
+            }
+        }
+        return 0;
+    }
+
+    size_t size() const noexcept { return count_; }
+
+    void clear() noexcept {
+        for (size_t i = 0; i < MAX_LOCATES; ++i) {
+            entries_[i] = Entry{};
+        }
+        count_ = 0;
+    }
+
+private:
+    std::unique_ptr<Entry[]> entries_;
+    size_t count_;
+};
+
+} // namespace hft
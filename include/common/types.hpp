@@ -20,6 +20,9 @@ using OrderRef = uint64_t;
 // Stock symbol (8 characters, space-padded)
 using StockSymbol = std::array<char, 8>;
 
+// Stock locate code (per-day instrument index assigned by StockDirectory)
+using StockLocate = uint16_t;
+
 // Timestamp in nanoseconds since midnight
 using Timestamp = uint64_t;
 
@@ -59,31 +62,113 @@ enum class MessageType : uint8_t {
     OperationalHalt = 19
 };
 
-// Normalized order message for downstream consumers
-struct NormalizedMessage {
-    MessageType type;
-    Timestamp timestamp;
-    OrderRef order_ref;
-    StockSymbol stock;
-    Side side;
-    Price price;
-    Quantity quantity;
-    Quantity executed_quantity;
-    OrderRef new_order_ref;  // For replace messages
-
-    // Default constructor
-    NormalizedMessage()
-        : type(MessageType::Unknown)
-        , timestamp(0)
-        , order_ref(0)
-        , stock{}
-        , side(Side::Buy)
-        , price(0)
-        , quantity(0)
-        , executed_quantity(0)
-        , new_order_ref(0) {}
+/**
+ * Normalized order message for downstream consumers (32 bytes)
+ *
+ * Two records per cache line: the 65536-slot ring is 2 MB and a push
+ * writes half a line. Layout:
+ *   [0, 8)    timestamp (48 bits) | type (8) | side (8)
+ *   [8, 16)   order reference (48 bits) | stock locate (16)
+ *   [16, 32)  per-type payload:
+ *     Add / AddMPID / Trade:      price, shares
+ *     OrderExecuted(WithPrice):   price (WithPrice only), executed shares
+ *     OrderCancel:                cancelled shares
+ *     OrderReplace:               price, shares, new order reference
+ *     StockDirectory:             round lot size, symbol
+ *
+ * The instrument is identified by locate; only StockDirectory carries the
+ * symbol. Prices are kept in ITCH's 4-decimal units and widened to Price
+ * on read. Timestamps are nanoseconds since midnight (< 2^47) and order
+ * references are day-unique counters, so 48 bits hold either. A wider
+ * reference cannot be represented: normalizers check order_ref_fits() and
+ * drop the message rather than publish one that would collide in the
+ * books. The setters clamp to MAX_ORDER_REF and return false as a last
+ * line of defence.
+ */
+struct alignas(32) NormalizedMessage {
+    static constexpr uint64_t MASK_48 = (1ULL << 48) - 1;
+    static constexpr OrderRef MAX_ORDER_REF = MASK_48;
+
+    static constexpr bool order_ref_fits(OrderRef ref) { return ref <= MAX_ORDER_REF; }
+
+    // ITCH price units (1e-4) to Price units (1e-6)
+    static constexpr Price ITCH_PRICE_MULTIPLIER = PRICE_SCALE / 10'000;
+
+    NormalizedMessage() = default;
+
+    MessageType type() const { return static_cast<MessageType>((header_ >> 48) & 0xFF); }
+    Timestamp timestamp() const { return header_ & MASK_48; }
+    Side side() const { return static_cast<Side>(static_cast<char>(header_ >> 56)); }
+    OrderRef order_ref() const { return ref_locate_ & MASK_48; }
+    StockLocate stock_locate() const { return static_cast<StockLocate>(ref_locate_ >> 48); }
+
+    Price price() const { return static_cast<Price>(payload_.price) * ITCH_PRICE_MULTIPLIER; }
+    uint32_t itch_price() const { return payload_.price; }
+    Quantity quantity() const { return payload_.quantity; }
+    Quantity executed_quantity() const { return payload_.quantity; }
+    OrderRef new_order_ref() const { return payload_.extra.new_order_ref; }
+
+    StockSymbol stock() const {
+        StockSymbol sym;
+        for (size_t i = 0; i < sym.size(); ++i) {
+            sym[i] = payload_.extra.stock[i];
+        }
+        return sym;
+    }
+
+    void set_type(MessageType type) {
+        header_ = (header_ & ~(0xFFULL << 48)) | (static_cast<uint64_t>(type) << 48);
+    }
+    void set_timestamp(Timestamp ts) { header_ = (header_ & ~MASK_48) | (ts & MASK_48); }
+    void set_side(Side side) {
+        header_ = (header_ & ~(0xFFULL << 56)) |
+                  (static_cast<uint64_t>(static_cast<uint8_t>(side)) << 56);
+    }
+    bool set_order_ref(OrderRef ref) {
+        const bool fits = order_ref_fits(ref);
+        ref_locate_ = (ref_locate_ & ~MASK_48) | (fits ? ref : MAX_ORDER_REF);
+        return fits;
+    }
+    void set_stock_locate(StockLocate locate) {
+        ref_locate_ = (ref_locate_ & MASK_48) | (static_cast<uint64_t>(locate) << 48);
+    }
+
+    // Price must be a whole number of ITCH ticks (1e-4)
+    void set_price(Price price) { payload_.price = static_cast<uint32_t>(price / ITCH_PRICE_MULTIPLIER); }
+    void set_itch_price(uint32_t price) { payload_.price = price; }
+    void set_quantity(Quantity qty) { payload_.quantity = qty; }
+    void set_executed_quantity(Quantity qty) { payload_.quantity = qty; }
+    bool set_new_order_ref(OrderRef ref) {
+        const bool fits = order_ref_fits(ref);
+        payload_.extra.new_order_ref = fits ? ref : MAX_ORDER_REF;
+        return fits;
+    }
+
+    void set_stock(const StockSymbol& sym) {
+        for (size_t i = 0; i < sym.size(); ++i) {
+            payload_.extra.stock[i] = sym[i];
+        }
+    }
+
+private:
+    union Extra {
+        OrderRef new_order_ref;     // OrderReplace
+        char stock[8];              // StockDirectory
+    };
+
+    struct Payload {
+        uint32_t price = 0;         // ITCH 4-decimal units
+        Quantity quantity = 0;      // Shares / executed / cancelled / round lot
+        Extra extra = {0};
+    };
+
+    uint64_t header_ = static_cast<uint64_t>(static_cast<uint8_t>(Side::Buy)) << 56;
+    uint64_t ref_locate_ = 0;
+    Payload payload_;
 };
 
+static_assert(sizeof(NormalizedMessage) == 32, "NormalizedMessage must be 32 bytes");
+
 // Cache line size for preventing false sharing
 #ifdef __cpp_lib_hardware_interference_size
     constexpr size_t CACHE_LINE_SIZE = std::hardware_destructive_interference_size;
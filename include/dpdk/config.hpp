@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../spsc/wait_strategy.hpp"
+
 #include <cstdint>
 #include <cstddef>
 #include <string>
@@ -65,6 +67,51 @@ struct Config {
     bool pin_to_core = true;
     int producer_core_id = PRODUCER_CORE;
     int consumer_core_id = CONSUMER_CORE;
+
+    // Order book settings
+    // Arena size for simultaneously resting orders (preallocated at startup)
+    size_t max_orders = 1 << 22;
+
+    // Market-by-price depth feed: levels per side (0 = disabled)
+    size_t depth_levels = 0;
+
+    // Normalized message ring slots (rounded up to a power of 2); size it
+    // for the opening-cross burst
+    size_t ring_capacity = 1 << 16;
+
+    // Map the ring from hugepages (falls back to normal pages)
+    bool huge_pages = true;
+
+    // Time every N-th message through the ring for queueing-delay stats
+    // (0 = off)
+    size_t ring_delay_sample = 1024;
+
+    // Export the normalized stream to /dev/shm/<name> for other processes
+    // (empty = off); readers attach with spsc::MessageShmReader
+    std::string shm_name;
+    size_t shm_capacity = 1 << 20;
+
+    // Redundant A/B feed: UDP destination port of line B (0 = single line)
+    // Other MoldUDP64 packets are line A; each sequence is delivered once
+    uint16_t line_b_port = 0;
+
+    // Request lost messages from a MoldUDP64 rewinder at this IPv4 address
+    // (port 0 = off); see moldudp64::RetransmitClient
+    std::string rewinder_host = "127.0.0.1";
+    uint16_t rewinder_port = 0;
+
+    // MoldUDP64 sessions tracked at once (channels, plus one per rollover
+    // still draining); the least recently active is dropped beyond this
+    size_t max_sessions = 8;
+
+    // Hold packets behind MoldUDP64 gaps and deliver in sequence order
+    // (0 = off; packets past a gap are parsed as they arrive)
+    size_t reorder_packets = 0;
+    uint64_t reorder_hold_ns = 50'000'000;
+
+    // How the ring consumer (and a back-pressured producer) waits when idle
+    // Block parks the thread on a futex; the others keep the core busy
+    spsc::WaitMode wait_mode = spsc::WaitMode::SpinPause;
 };
 
 // Network header sizes for offset calculations
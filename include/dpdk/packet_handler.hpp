@@ -5,13 +5,17 @@
 #include "../common/endian.hpp"
 #include "../moldudp64/header.hpp"
 #include "../moldudp64/session.hpp"
+#include "../moldudp64/arbiter.hpp"
 #include "../itch5/parser.hpp"
 #include "../spsc/ring_buffer.hpp"
+#include "../spsc/byte_ring.hpp"
 
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
 #include <functional>
 #include <atomic>
+#include <memory>
 
 // Forward declarations for DPDK types
 // These would be included from DPDK headers in actual build
@@ -48,30 +52,64 @@ namespace dpdk {
  * The key optimization is casting pointers directly to struct types,
  * avoiding memcpy operations.
  *
+ * The handler is its own ITCH parser handler: the parser calls the
+ * on_* normalizers below directly, with no std::function in between.
+ *
+ * MoldUDP64 packets go through a SessionManager, so several channels, or
+ * a session and its rollover successor, are tracked side by side.
+ *
  * Thread model:
  * - Producer thread: Calls process_mbuf() from DPDK poll loop
  * - Consumer thread: Reads from ring buffer for downstream processing
  */
+/**
+ * Raw passthrough record: one MoldUDP64 packet's message blocks
+ *
+ * Written to the raw byte ring as this header followed by the original
+ * blocks (2-byte big-endian length + ITCH message, repeated), so a
+ * consumer can decode them with itch5::BasicParser::parse_buffer.
+ */
+struct RawPacketHeader {
+    SequenceNumber first_sequence;
+    uint16_t message_count;
+    uint16_t reserved[3];
+};
+
+static_assert(sizeof(RawPacketHeader) == 16, "RawPacketHeader layout changed");
+
 class PacketHandler {
 public:
-    using MessageBuffer = spsc::RingBuffer<NormalizedMessage, 65536>;
+    using MessageBuffer = spsc::MessageBuffer;
+    using RawBuffer = spsc::ByteRing<1 << 22>;  // 4 MB of raw packets
 
-    explicit PacketHandler(MessageBuffer& output_buffer)
+    explicit PacketHandler(MessageBuffer& output_buffer,
+                           size_t max_sessions = moldudp64::SessionManager::DEFAULT_MAX_SESSIONS)
         : output_buffer_(output_buffer)
+        , parser_(*this)
+        , sessions_(max_sessions)
         , running_(false)
         , packets_processed_(0)
         , bytes_processed_(0)
         , invalid_packets_(0) {
 
-        // Set up ITCH parser callbacks
-        setup_parser_callbacks();
-
-        // Set up MoldUDP64 session callback
-        session_.set_message_callback(
-            [this](const uint8_t* data, uint16_t length, SequenceNumber seq) {
-                parse_itch_message(data, length);
-            }
-        );
+        // Hand each MoldUDP64 packet's message blocks to the parser in one
+        // call; handlers decode straight into ring slots, published once
+        // per packet. Every session slot shares the one parser and ring.
+        sessions_.configure([this](moldudp64::Session& session) {
+            session.set_packet_callback(
+                [this](const uint8_t* blocks, size_t length, uint16_t count, SequenceNumber seq) {
+                    if (raw_output_) {
+                        forward_raw(blocks, length, count, seq);
+                        if (!normalize_) {
+                            return static_cast<size_t>(count);
+                        }
+                    }
+                    size_t parsed = parser_.parse_buffer(blocks, length, count).blocks;
+                    flush_pending();
+                    return parsed;
+                }
+            );
+        });
     }
 
     /**
@@ -126,7 +164,7 @@ public:
         size_t payload_len = mbuf->pkt_len - offset;
 
         // Process MoldUDP64 packet
-        if (!session_.process_packet(pkt_data + offset, payload_len)) {
+        if (!sessions_.process_packet(pkt_data + offset, payload_len)) {
             ++invalid_packets_;
             return false;
         }
@@ -141,38 +179,63 @@ public:
      * Process raw packet data (for PCAP playback or testing)
      */
     bool process_raw_packet(const uint8_t* data, size_t len) {
-        if (len < header_sizes::TOTAL_MIN) {
+        size_t offset;
+        if (!find_udp_payload(data, len, offset)) {
             ++invalid_packets_;
             return false;
         }
 
-        size_t offset = 0;
+        // Process MoldUDP64 packet
+        size_t payload_len = len - offset;
+        if (!sessions_.process_packet(data + offset, payload_len)) {
+            ++invalid_packets_;
+            return false;
+        }
 
-        // Parse Ethernet header
-        const auto* eth = reinterpret_cast<const EthernetHeader*>(data);
-        offset += sizeof(EthernetHeader);
+        ++packets_processed_;
+        bytes_processed_ += len;
 
-        if (endian::ntoh16(eth->ether_type) != ETHER_TYPE_IPV4) {
+        return true;
+    }
+
+    /**
+     * Process a raw packet received on one of the redundant A/B lines
+     * With arbitration enabled, only the first copy of each packet reaches
+     * its session; the other copy is counted and dropped. Each session is
+     * arbitrated in its own window, so interleaved channels never share
+     * one. Without arbitration this is process_raw_packet().
+     */
+    bool process_line_packet(moldudp64::Line line, const uint8_t* data, size_t len,
+                             uint64_t arrival_ns) {
+        if (!sessions_.arbitration_enabled()) {
+            return process_raw_packet(data, len);
+        }
+
+        size_t offset;
+        if (!find_udp_payload(data, len, offset)) {
             ++invalid_packets_;
             return false;
         }
 
-        // Parse IPv4 header
-        const auto* ip = reinterpret_cast<const IPv4Header*>(data + offset);
-        uint8_t ip_hdr_len = get_ip_header_length(ip);
-        offset += ip_hdr_len;
-
-        if (ip->protocol != IP_PROTO_UDP) {
+        // Route first: the verdict comes from this session's own arbiter
+        moldudp64::Session* session = sessions_.route(data + offset, len - offset);
+        if (!session) {
             ++invalid_packets_;
             return false;
         }
 
-        // Skip UDP header
-        offset += sizeof(UDPHeader);
+        switch (sessions_.current_arbiter()->arbitrate(line, data + offset, len - offset, arrival_ns)) {
+            case moldudp64::LineArbiter::Verdict::Deliver:
+                break;
+            case moldudp64::LineArbiter::Verdict::Invalid:
+                ++invalid_packets_;
+                return false;
+            default:
+                // The other line already delivered it
+                return true;
+        }
 
-        // Process MoldUDP64 packet
-        size_t payload_len = len - offset;
-        if (!session_.process_packet(data + offset, payload_len)) {
+        if (!session->process_packet(data + offset, len - offset)) {
             ++invalid_packets_;
             return false;
         }
@@ -184,32 +247,48 @@ public:
     }
 
     /**
-     * Process raw ITCH binary data (for file-based testing)
-     * This is for processing raw ITCH files without network headers
+     * Deduplicate the A and B lines in process_line_packet()
+     * window: messages of history per session for late copies and
+     * cross-line gap fills; every session slot gets one, allocated here
      */
-    size_t process_itch_file_data(const uint8_t* data, size_t len) {
-        size_t offset = 0;
-        size_t messages_processed = 0;
+    void enable_arbitration(size_t window = moldudp64::LineArbiter::DEFAULT_WINDOW) {
+        sessions_.enable_arbitration(window);
+    }
 
-        while (offset + 2 < len) {  // Need at least 2 bytes for length
-            // ITCH file format: 2-byte big-endian length prefix
-            uint16_t msg_len = endian::read_be16(data + offset);
-            offset += 2;
+    bool arbitration_enabled() const { return sessions_.arbitration_enabled(); }
 
-            if (offset + msg_len > len) {
-                break;  // Incomplete message
-            }
+    // Arbiter of the last routed session; nullptr unless enable_arbitration was called
+    const moldudp64::LineArbiter* get_arbiter() const { return sessions_.current_arbiter(); }
 
-            // Parse the ITCH message
-            size_t parsed = parser_.parse_message(data + offset, msg_len);
-            if (parsed > 0) {
-                ++messages_processed;
-            }
+    // One line's arbitration counters over every session
+    moldudp64::LineArbiter::LineStats get_line_stats(moldudp64::Line line) const {
+        return sessions_.get_line_stats(line);
+    }
 
-            offset += msg_len;
+    /**
+     * UDP destination port of an Ethernet/IPv4/UDP frame, for telling the
+     * lines apart in a capture; false if the frame is not UDP
+     */
+    static bool udp_destination_port(const uint8_t* data, size_t len, uint16_t& port) {
+        size_t offset;
+        if (!find_udp_payload(data, len, offset)) {
+            return false;
         }
+        const auto* udp = reinterpret_cast<const UDPHeader*>(data + offset - sizeof(UDPHeader));
+        port = endian::ntoh16(udp->dst_port);
+        return true;
+    }
 
-        return messages_processed;
+    /**
+     * Process raw ITCH binary data (for file-based testing)
+     * This is for processing raw ITCH files without network headers
+     */
+    size_t process_itch_file_data(const uint8_t* data, size_t len) {
+        // ITCH file format: 2-byte big-endian length prefix per message,
+        // the same framing as MoldUDP64 message blocks
+        size_t parsed = parser_.parse_buffer(data, len).messages;
+        flush_pending();
+        return parsed;
     }
 
     // Control
@@ -217,6 +296,22 @@ public:
     void stop() { running_.store(false, std::memory_order_release); }
     bool is_running() const { return running_.load(std::memory_order_acquire); }
 
+    /**
+     * Block on a full ring instead of dropping messages
+     * Only appropriate for file/PCAP replay - a live feed cannot wait
+     */
+    void set_backpressure(bool enabled) { backpressure_ = enabled; }
+
+    /**
+     * Also forward each MoldUDP64 packet's raw message blocks to a byte
+     * ring (nullptr to stop). With normalize = false the ITCH parser is
+     * skipped entirely and decoding is left to the raw consumers.
+     */
+    void set_raw_output(RawBuffer* ring, bool normalize = true) {
+        raw_output_ = ring;
+        normalize_ = normalize || ring == nullptr;
+    }
+
     // Statistics
     struct Stats {
         uint64_t packets_processed;
@@ -224,7 +319,10 @@ public:
         uint64_t invalid_packets;
         uint64_t messages_pushed;
         uint64_t buffer_full_count;
-        itch5::Parser::Stats parser_stats;
+        uint64_t raw_packets_forwarded;
+        uint64_t raw_bytes_forwarded;
+        uint64_t raw_full_count;
+        itch5::ParserStats parser_stats;
         moldudp64::Session::Stats session_stats;
     };
 
@@ -235,121 +333,313 @@ public:
         s.invalid_packets = invalid_packets_;
         s.messages_pushed = messages_pushed_;
         s.buffer_full_count = buffer_full_count_;
+        s.raw_packets_forwarded = raw_packets_forwarded_;
+        s.raw_bytes_forwarded = raw_bytes_forwarded_;
+        s.raw_full_count = raw_full_count_;
         s.parser_stats = parser_.get_stats();
-        s.session_stats = session_.get_stats();
+        s.session_stats = sessions_.get_session_stats();
         return s;
     }
 
-    // Access to session for gap detection
-    const moldudp64::Session& get_session() const { return session_; }
-    bool has_gaps() const { return session_.has_gaps(); }
+    // Access to sessions for gap detection; get_session() is the one the
+    // last packet went to
+    const moldudp64::Session& get_session() const { return sessions_.current(); }
+    moldudp64::Session& get_session() { return sessions_.current(); }
+    const moldudp64::SessionManager& get_sessions() const { return sessions_; }
+    moldudp64::SessionManager& get_sessions() { return sessions_; }
 
-private:
-    void setup_parser_callbacks() {
-        // Add Order callback
-        parser_.set_add_order_callback(
-            [this](const itch5::AddOrder* msg, Timestamp ts, Price price, Quantity qty) {
-                NormalizedMessage norm;
-                norm.type = MessageType::AddOrder;
-                norm.timestamp = ts;
-                norm.order_ref = endian::ntoh64(msg->order_reference_number);
-                std::memcpy(norm.stock.data(), msg->stock, 8);
-                norm.side = (msg->buy_sell_indicator == 'B') ? Side::Buy : Side::Sell;
-                norm.price = price;
-                norm.quantity = qty;
-
-                push_message(norm);
-            }
-        );
+    // Parse packets in sequence order, holding them across gaps
+    void enable_reordering(const moldudp64::ReorderConfig& config) {
+        sessions_.configure([&](moldudp64::Session& session) { session.enable_reordering(config); });
+    }
+    bool has_gaps() const { return sessions_.has_gaps(); }
+
+    // ITCH handlers, dispatched statically by parser_
+    // Public so the parser can detect them; not meant to be called directly
+    void on_add_order(const itch5::AddOrder* msg, Timestamp ts, Price price, Quantity qty) {
+        const OrderRef ref = endian::ntoh64(msg->order_reference_number);
+        if (!order_ref_fits(ref)) {
+            return;
+        }
+        NormalizedMessage* norm = claim_message();
+        if (!norm) {
+            return;
+        }
 
-        // Order Executed callback
-        parser_.set_order_executed_callback(
-            [this](const itch5::OrderExecuted* msg, Timestamp ts) {
-                NormalizedMessage norm;
-                norm.type = MessageType::OrderExecuted;
-                norm.timestamp = ts;
-                norm.order_ref = endian::ntoh64(msg->order_reference_number);
-                norm.executed_quantity = endian::ntoh32(msg->executed_shares);
+        norm->set_type(MessageType::AddOrder);
+        norm->set_stock_locate(endian::ntoh16(msg->stock_locate));
+        norm->set_timestamp(ts);
+        norm->set_order_ref(ref);
+        norm->set_side((msg->buy_sell_indicator == 'B') ? Side::Buy : Side::Sell);
+        norm->set_price(price);
+        norm->set_quantity(qty);
+    }
 
-                push_message(norm);
-            }
-        );
+    void on_add_order_mpid(const itch5::AddOrderMPID* msg, Timestamp ts, Price price, Quantity qty) {
+        const OrderRef ref = endian::ntoh64(msg->order_reference_number);
+        if (!order_ref_fits(ref)) {
+            return;
+        }
+        NormalizedMessage* norm = claim_message();
+        if (!norm) {
+            return;
+        }
+
+        norm->set_type(MessageType::AddOrderMPID);
+        norm->set_stock_locate(endian::ntoh16(msg->stock_locate));
+        norm->set_timestamp(ts);
+        norm->set_order_ref(ref);
+        norm->set_side((msg->buy_sell_indicator == 'B') ? Side::Buy : Side::Sell);
+        norm->set_price(price);
+        norm->set_quantity(qty);
+    }
 
-        // Order Delete callback
-        parser_.set_order_delete_callback(
-            [this](const itch5::OrderDelete* msg, Timestamp ts) {
-                NormalizedMessage norm;
-                norm.type = MessageType::OrderDelete;
-                norm.timestamp = ts;
-                norm.order_ref = endian::ntoh64(msg->order_reference_number);
+    void on_order_executed(const itch5::OrderExecuted* msg, Timestamp ts) {
+        const OrderRef ref = endian::ntoh64(msg->order_reference_number);
+        if (!order_ref_fits(ref)) {
+            return;
+        }
+        NormalizedMessage* norm = claim_message();
+        if (!norm) {
+            return;
+        }
 
-                push_message(norm);
-            }
-        );
+        norm->set_type(MessageType::OrderExecuted);
+        norm->set_stock_locate(endian::ntoh16(msg->stock_locate));
+        norm->set_timestamp(ts);
+        norm->set_order_ref(ref);
+        norm->set_executed_quantity(endian::ntoh32(msg->executed_shares));
+    }
 
-        // Order Cancel callback
-        parser_.set_order_cancel_callback(
-            [this](const itch5::OrderCancel* msg, Timestamp ts) {
-                NormalizedMessage norm;
-                norm.type = MessageType::OrderCancel;
-                norm.timestamp = ts;
-                norm.order_ref = endian::ntoh64(msg->order_reference_number);
-                norm.quantity = endian::ntoh32(msg->cancelled_shares);
+    void on_order_executed_with_price(const itch5::OrderExecutedWithPrice* msg, Timestamp ts, Price price) {
+        const OrderRef ref = endian::ntoh64(msg->order_reference_number);
+        if (!order_ref_fits(ref)) {
+            return;
+        }
+        NormalizedMessage* norm = claim_message();
+        if (!norm) {
+            return;
+        }
 
-                push_message(norm);
-            }
-        );
+        norm->set_type(MessageType::OrderExecutedWithPrice);
+        norm->set_stock_locate(endian::ntoh16(msg->stock_locate));
+        norm->set_timestamp(ts);
+        norm->set_order_ref(ref);
+        norm->set_executed_quantity(endian::ntoh32(msg->executed_shares));
+        norm->set_price(price);
+    }
+
+    void on_order_delete(const itch5::OrderDelete* msg, Timestamp ts) {
+        const OrderRef ref = endian::ntoh64(msg->order_reference_number);
+        if (!order_ref_fits(ref)) {
+            return;
+        }
+        NormalizedMessage* norm = claim_message();
+        if (!norm) {
+            return;
+        }
+
+        norm->set_type(MessageType::OrderDelete);
+        norm->set_stock_locate(endian::ntoh16(msg->stock_locate));
+        norm->set_timestamp(ts);
+        norm->set_order_ref(ref);
+    }
+
+    void on_order_cancel(const itch5::OrderCancel* msg, Timestamp ts) {
+        const OrderRef ref = endian::ntoh64(msg->order_reference_number);
+        if (!order_ref_fits(ref)) {
+            return;
+        }
+        NormalizedMessage* norm = claim_message();
+        if (!norm) {
+            return;
+        }
+
+        norm->set_type(MessageType::OrderCancel);
+        norm->set_stock_locate(endian::ntoh16(msg->stock_locate));
+        norm->set_timestamp(ts);
+        norm->set_order_ref(ref);
+        norm->set_quantity(endian::ntoh32(msg->cancelled_shares));
+    }
+
+    void on_order_replace(const itch5::OrderReplace* msg, Timestamp ts, Price price, Quantity qty) {
+        const OrderRef ref = endian::ntoh64(msg->original_order_reference_number);
+        const OrderRef new_ref = endian::ntoh64(msg->new_order_reference_number);
+        if (!order_ref_fits(ref) || !order_ref_fits(new_ref)) {
+            return;
+        }
+        NormalizedMessage* norm = claim_message();
+        if (!norm) {
+            return;
+        }
+
+        norm->set_type(MessageType::OrderReplace);
+        norm->set_stock_locate(endian::ntoh16(msg->stock_locate));
+        norm->set_timestamp(ts);
+        norm->set_order_ref(ref);
+        norm->set_new_order_ref(new_ref);
+        norm->set_price(price);
+        norm->set_quantity(qty);
+    }
+
+    void on_trade(const itch5::Trade* msg, Timestamp ts, Price price, Quantity qty) {
+        const OrderRef ref = endian::ntoh64(msg->order_reference_number);
+        if (!order_ref_fits(ref)) {
+            return;
+        }
+        NormalizedMessage* norm = claim_message();
+        if (!norm) {
+            return;
+        }
+
+        norm->set_type(MessageType::Trade);
+        norm->set_stock_locate(endian::ntoh16(msg->stock_locate));
+        norm->set_timestamp(ts);
+        norm->set_order_ref(ref);
+        norm->set_side((msg->buy_sell_indicator == 'B') ? Side::Buy : Side::Sell);
+        norm->set_price(price);
+        norm->set_quantity(qty);
+    }
+
+    // Stock Directory: the consumer builds its locate table from these
+    void on_stock_directory(const itch5::StockDirectory* msg, Timestamp ts) {
+        NormalizedMessage* norm = claim_message();
+        if (!norm) {
+            return;
+        }
+
+        norm->set_type(MessageType::StockDirectory);
+        norm->set_stock_locate(endian::ntoh16(msg->stock_locate));
+        norm->set_timestamp(ts);
+        StockSymbol stock;
+        std::memcpy(stock.data(), msg->stock, 8);
+        norm->set_stock(stock);
+        norm->set_quantity(endian::ntoh32(msg->round_lot_size));
+    }
 
-        // Order Replace callback
-        parser_.set_order_replace_callback(
-            [this](const itch5::OrderReplace* msg, Timestamp ts, Price price, Quantity qty) {
-                NormalizedMessage norm;
-                norm.type = MessageType::OrderReplace;
-                norm.timestamp = ts;
-                norm.order_ref = endian::ntoh64(msg->original_order_reference_number);
-                norm.new_order_ref = endian::ntoh64(msg->new_order_reference_number);
-                norm.price = price;
-                norm.quantity = qty;
-
-                push_message(norm);
+private:
+    // A reference wider than NormalizedMessage holds would collide with
+    // others in the books; the message is dropped and counted instead
+    bool order_ref_fits(OrderRef ref) {
+        if (NormalizedMessage::order_ref_fits(ref)) {
+            return true;
+        }
+        parser_.count_order_ref_overflow();
+        return false;
+    }
+
+    /**
+     * Claim the next ring slot and clear it for the caller to fill in place
+     * Returns nullptr if the ring is full and the message must be dropped
+     *
+     * Slots stay unpublished until flush_pending(), once per packet; a
+     * long file chunk is also published every PUBLISH_INTERVAL messages.
+     */
+    NormalizedMessage* claim_message() {
+        if (pending_count_ == PUBLISH_INTERVAL) {
+            flush_pending();
+        }
+
+        NormalizedMessage* slot = output_buffer_.try_claim();
+        if (!slot) {
+            // Let the consumer see what is already written before waiting
+            flush_pending();
+
+            if (!backpressure_) {
+                ++buffer_full_count_;
+                // In production, might want to log or handle this differently
+                return nullptr;
             }
-        );
 
-        // Trade callback
-        parser_.set_trade_callback(
-            [this](const itch5::Trade* msg, Timestamp ts, Price price, Quantity qty) {
-                NormalizedMessage norm;
-                norm.type = MessageType::Trade;
-                norm.timestamp = ts;
-                norm.order_ref = endian::ntoh64(msg->order_reference_number);
-                std::memcpy(norm.stock.data(), msg->stock, 8);
-                norm.side = (msg->buy_sell_indicator == 'B') ? Side::Buy : Side::Sell;
-                norm.price = price;
-                norm.quantity = qty;
-
-                push_message(norm);
+            // Replay mode: never drop, wait for the consumer instead
+            for (uint32_t iteration = 0; !(slot = output_buffer_.try_claim()); ++iteration) {
+                output_buffer_.wait_writable(iteration);
             }
-        );
+        }
+
+        // The slot holds a message from the previous lap
+        *slot = NormalizedMessage();
+        ++pending_count_;
+        ++messages_pushed_;
+        return slot;
     }
 
-    void parse_itch_message(const uint8_t* data, uint16_t length) {
-        parser_.parse_message(data, length);
+    // Publish every message claimed since the last flush with one index update
+    void flush_pending() {
+        if (pending_count_ == 0) {
+            return;
+        }
+        output_buffer_.commit();
+        pending_count_ = 0;
     }
 
-    void push_message(const NormalizedMessage& msg) {
-        if (!output_buffer_.try_push(msg)) {
-            ++buffer_full_count_;
-            // In production, might want to log or handle this differently
-        } else {
-            ++messages_pushed_;
+    // Copy a packet's message blocks into the raw ring as one record
+    void forward_raw(const uint8_t* blocks, size_t length, uint16_t count, SequenceNumber seq) {
+        const size_t record_length = sizeof(RawPacketHeader) + length;
+
+        uint8_t* record = raw_output_->try_claim(record_length);
+        if (!record) {
+            if (!backpressure_ || record_length > RawBuffer::MAX_RECORD_SIZE) {
+                ++raw_full_count_;
+                return;
+            }
+            while (!(record = raw_output_->try_claim(record_length))) {
+#if defined(__x86_64__) || defined(_M_X64)
+                __builtin_ia32_pause();
+#endif
+            }
         }
+
+        RawPacketHeader header{};
+        header.first_sequence = seq;
+        header.message_count = count;
+        std::memcpy(record, &header, sizeof(header));
+        std::memcpy(record + sizeof(header), blocks, length);
+        raw_output_->commit();
+
+        ++raw_packets_forwarded_;
+        raw_bytes_forwarded_ += length;
     }
 
+    // Offset of the UDP payload in an Ethernet/IPv4/UDP frame
+    static bool find_udp_payload(const uint8_t* data, size_t len, size_t& offset) {
+        if (len < header_sizes::TOTAL_MIN) {
+            return false;
+        }
+
+        // Parse Ethernet header
+        const auto* eth = reinterpret_cast<const EthernetHeader*>(data);
+        offset = sizeof(EthernetHeader);
+
+        if (endian::ntoh16(eth->ether_type) != ETHER_TYPE_IPV4) {
+            return false;
+        }
+
+        // Parse IPv4 header
+        const auto* ip = reinterpret_cast<const IPv4Header*>(data + offset);
+        offset += get_ip_header_length(ip);
+
+        if (ip->protocol != IP_PROTO_UDP) {
+            return false;
+        }
+
+        // Skip UDP header
+        offset += sizeof(UDPHeader);
+        return offset <= len;
+    }
+
+    // Longest run of claimed messages held back from the consumer
+    static constexpr size_t PUBLISH_INTERVAL = 128;
+
     MessageBuffer& output_buffer_;
-    itch5::Parser parser_;
-    moldudp64::Session session_;
+    itch5::BasicParser<PacketHandler> parser_;
+    size_t pending_count_ = 0;  // Claimed, not yet committed
+    RawBuffer* raw_output_ = nullptr;
+    bool normalize_ = true;
+    moldudp64::SessionManager sessions_;
 
     std::atomic<bool> running_;
+    bool backpressure_ = false;
 
     // Statistics
     uint64_t packets_processed_ = 0;
@@ -357,6 +647,9 @@ private:
     uint64_t invalid_packets_ = 0;
     uint64_t messages_pushed_ = 0;
     uint64_t buffer_full_count_ = 0;
+    uint64_t raw_packets_forwarded_ = 0;
+    uint64_t raw_bytes_forwarded_ = 0;
+    uint64_t raw_full_count_ = 0;
 };
 
 } // namespace dpdk
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 #include <array>
 
 namespace hft {
@@ -340,34 +341,138 @@ static_assert(sizeof(RPII) == 20, "RPII must be 20 bytes");
 
 #pragma pack(pop)
 
-// Get message size based on message type (for validation)
-inline size_t get_message_size(char msg_type) {
-    switch (msg_type) {
-        case msg_type::SystemEvent:              return sizeof(SystemEvent);
-        case msg_type::StockDirectory:           return sizeof(StockDirectory);
-        case msg_type::StockTradingAction:       return sizeof(StockTradingAction);
-        case msg_type::RegSHORestriction:        return sizeof(RegSHORestriction);
-        case msg_type::MarketParticipantPosition: return sizeof(MarketParticipantPosition);
-        case msg_type::MWCBDecline:              return sizeof(MWCBDecline);
-        case msg_type::MWCBStatus:               return sizeof(MWCBStatus);
-        case msg_type::IPOQuotingPeriod:         return sizeof(IPOQuotingPeriod);
-        case msg_type::LULDAuctionCollar:        return sizeof(LULDAuctionCollar);
-        case msg_type::OperationalHalt:          return sizeof(OperationalHalt);
-        case msg_type::AddOrder:                 return sizeof(AddOrder);
-        case msg_type::AddOrderMPID:             return sizeof(AddOrderMPID);
-        case msg_type::OrderExecuted:            return sizeof(OrderExecuted);
-        case msg_type::OrderExecutedWithPrice:   return sizeof(OrderExecutedWithPrice);
-        case msg_type::OrderCancel:              return sizeof(OrderCancel);
-        case msg_type::OrderDelete:              return sizeof(OrderDelete);
-        case msg_type::OrderReplace:             return sizeof(OrderReplace);
-        case msg_type::Trade:                    return sizeof(Trade);
-        case msg_type::CrossTrade:               return sizeof(CrossTrade);
-        case msg_type::BrokenTrade:              return sizeof(BrokenTrade);
-        case msg_type::NOII:                     return sizeof(NOII);
-        case msg_type::RPII:                     return sizeof(RPII);
-        default:                                 return 0;
+/**
+ * Dense per-type index: handler index for dispatch and slot in the
+ * per-type counter array. Unknown is 0 so a zeroed descriptor is invalid.
+ */
+enum class MessageKind : uint8_t {
+    Unknown = 0,
+    SystemEvent,
+    StockDirectory,
+    StockTradingAction,
+    RegSHORestriction,
+    MarketParticipantPosition,
+    MWCBDecline,
+    MWCBStatus,
+    IPOQuotingPeriod,
+    LULDAuctionCollar,
+    OperationalHalt,
+    AddOrder,
+    AddOrderMPID,
+    OrderExecuted,
+    OrderExecutedWithPrice,
+    OrderCancel,
+    OrderDelete,
+    OrderReplace,
+    Trade,
+    CrossTrade,
+    BrokenTrade,
+    NOII,
+    RPII,
+    Count
+};
+
+constexpr size_t MESSAGE_KIND_COUNT = static_cast<size_t>(MessageKind::Count);
+
+// Broad message category
+enum class MessageCategory : uint8_t {
+    Unknown = 0,
+    System,         // S
+    Reference,      // R H Y L V W K J h - stock and market state
+    Order,          // A F E C X D U - visible book changes
+    Trade,          // P Q B - non-displayed and cross executions
+    Imbalance       // I N
+};
+
+/**
+ * Per-type message descriptor, one entry per possible type byte
+ * size == 0 marks a type byte that is not part of ITCH 5.0.
+ */
+struct MessageDescriptor {
+    uint8_t size = 0;                                   // Expected message length
+    MessageKind kind = MessageKind::Unknown;            // Handler index / stats slot
+    MessageCategory category = MessageCategory::Unknown;
+    char type = 0;                                      // Type byte ('A', 'E', ...)
+};
+
+static_assert(sizeof(MessageDescriptor) == 4, "MessageDescriptor should stay 4 bytes");
+
+namespace detail {
+
+constexpr std::array<MessageDescriptor, 256> make_message_table() {
+    std::array<MessageDescriptor, 256> table{};
+
+    struct Entry {
+        char type;
+        size_t size;
+        MessageKind kind;
+        MessageCategory category;
+    };
+
+    constexpr Entry entries[] = {
+        {msg_type::SystemEvent,               sizeof(SystemEvent),               MessageKind::SystemEvent,               MessageCategory::System},
+        {msg_type::StockDirectory,            sizeof(StockDirectory),            MessageKind::StockDirectory,            MessageCategory::Reference},
+        {msg_type::StockTradingAction,        sizeof(StockTradingAction),        MessageKind::StockTradingAction,        MessageCategory::Reference},
+        {msg_type::RegSHORestriction,         sizeof(RegSHORestriction),         MessageKind::RegSHORestriction,         MessageCategory::Reference},
+        {msg_type::MarketParticipantPosition, sizeof(MarketParticipantPosition), MessageKind::MarketParticipantPosition, MessageCategory::Reference},
+        {msg_type::MWCBDecline,               sizeof(MWCBDecline),               MessageKind::MWCBDecline,               MessageCategory::Reference},
+        {msg_type::MWCBStatus,                sizeof(MWCBStatus),                MessageKind::MWCBStatus,                MessageCategory::Reference},
+        {msg_type::IPOQuotingPeriod,          sizeof(IPOQuotingPeriod),          MessageKind::IPOQuotingPeriod,          MessageCategory::Reference},
+        {msg_type::LULDAuctionCollar,         sizeof(LULDAuctionCollar),         MessageKind::LULDAuctionCollar,         MessageCategory::Reference},
+        {msg_type::OperationalHalt,           sizeof(OperationalHalt),           MessageKind::OperationalHalt,           MessageCategory::Reference},
+        {msg_type::AddOrder,                  sizeof(AddOrder),                  MessageKind::AddOrder,                  MessageCategory::Order},
+        {msg_type::AddOrderMPID,              sizeof(AddOrderMPID),              MessageKind::AddOrderMPID,              MessageCategory::Order},
+        {msg_type::OrderExecuted,             sizeof(OrderExecuted),             MessageKind::OrderExecuted,             MessageCategory::Order},
+        {msg_type::OrderExecutedWithPrice,    sizeof(OrderExecutedWithPrice),    MessageKind::OrderExecutedWithPrice,    MessageCategory::Order},
+        {msg_type::OrderCancel,               sizeof(OrderCancel),               MessageKind::OrderCancel,               MessageCategory::Order},
+        {msg_type::OrderDelete,               sizeof(OrderDelete),               MessageKind::OrderDelete,               MessageCategory::Order},
+        {msg_type::OrderReplace,              sizeof(OrderReplace),              MessageKind::OrderReplace,              MessageCategory::Order},
+        {msg_type::Trade,                     sizeof(Trade),                     MessageKind::Trade,                     MessageCategory::Trade},
+        {msg_type::CrossTrade,                sizeof(CrossTrade),                MessageKind::CrossTrade,                MessageCategory::Trade},
+        {msg_type::BrokenTrade,               sizeof(BrokenTrade),               MessageKind::BrokenTrade,               MessageCategory::Trade},
+        {msg_type::NOII,                      sizeof(NOII),                      MessageKind::NOII,                      MessageCategory::Imbalance},
+        {msg_type::RPII,                      sizeof(RPII),                      MessageKind::RPII,                      MessageCategory::Imbalance},
+    };
+
+    for (const Entry& e : entries) {
+        MessageDescriptor& d = table[static_cast<uint8_t>(e.type)];
+        d.size = static_cast<uint8_t>(e.size);
+        d.kind = e.kind;
+        d.category = e.category;
+        d.type = e.type;
     }
+    return table;
+}
+
+} // namespace detail
+
+// Descriptor table indexed by the message type byte
+inline constexpr std::array<MessageDescriptor, 256> MESSAGE_TABLE = detail::make_message_table();
+
+// Descriptor for a type byte (single indexed load)
+constexpr const MessageDescriptor& describe_message(char msg_type) {
+    return MESSAGE_TABLE[static_cast<uint8_t>(msg_type)];
 }
 
+// Get message size based on message type (for validation), 0 if unknown
+constexpr size_t get_message_size(char msg_type) {
+    return describe_message(msg_type).size;
+}
+
+// Descriptor for a kind (reverse lookup, cold path)
+inline const MessageDescriptor* find_descriptor(MessageKind kind) {
+    for (const MessageDescriptor& d : MESSAGE_TABLE) {
+        if (d.kind == kind && d.size != 0) {
+            return &d;
+        }
+    }
+    return nullptr;
+}
+
+static_assert(get_message_size(msg_type::AddOrder) == 36, "AddOrder table entry");
+static_assert(get_message_size('Z') == 0, "Unassigned type bytes must be unknown");
+static_assert(describe_message(msg_type::OrderDelete).kind == MessageKind::OrderDelete,
+              "OrderDelete table entry");
+
 } // namespace itch5
 } // namespace hft
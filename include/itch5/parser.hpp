@@ -4,9 +4,13 @@
 #include "../common/types.hpp"
 #include "../common/endian.hpp"
 
+#include <array>
 #include <cstring>
+#include <cstdint>
 #include <functional>
 #include <cstdio>
+#include <type_traits>
+#include <utility>
 
 namespace hft {
 namespace itch5 {
@@ -20,23 +24,118 @@ using OrderCancelCallback = std::function<void(const OrderCancel*, Timestamp)>;
 using OrderDeleteCallback = std::function<void(const OrderDelete*, Timestamp)>;
 using OrderReplaceCallback = std::function<void(const OrderReplace*, Timestamp, Price, Quantity)>;
 using TradeCallback = std::function<void(const Trade*, Timestamp, Price, Quantity)>;
+using StockDirectoryCallback = std::function<void(const StockDirectory*, Timestamp)>;
+
+/**
+ * Parser statistics (shared by every parser variant)
+ *
+ * One flat counter per MessageKind, bumped with a single indexed add.
+ * Slot 0 (MessageKind::Unknown) counts type bytes not in ITCH 5.0.
+ * The named accessors aggregate the slots the way the feed reports them.
+ */
+struct ParserStats {
+    uint64_t total_messages = 0;    // Complete messages of a known type
+    std::array<uint64_t, MESSAGE_KIND_COUNT> by_type{};
+    uint64_t order_ref_overflows = 0;   // Messages dropped on normalize: reference wider than 48 bits
+
+    uint64_t count(MessageKind kind) const { return by_type[static_cast<size_t>(kind)]; }
+
+    uint64_t add_orders() const {
+        return count(MessageKind::AddOrder) + count(MessageKind::AddOrderMPID);
+    }
+    uint64_t order_executed() const {
+        return count(MessageKind::OrderExecuted) + count(MessageKind::OrderExecutedWithPrice);
+    }
+    uint64_t order_cancelled() const { return count(MessageKind::OrderCancel); }
+    uint64_t order_deleted() const { return count(MessageKind::OrderDelete); }
+    uint64_t order_replaced() const { return count(MessageKind::OrderReplace); }
+    uint64_t trades() const { return count(MessageKind::Trade); }
+    uint64_t unknown_messages() const { return count(MessageKind::Unknown); }
+    uint64_t other_messages() const {
+        return total_messages - add_orders() - order_executed() - order_cancelled() -
+               order_deleted() - order_replaced() - trades();
+    }
+};
 
-// Zero-copy ITCH 5.0 parser
-// This parser casts raw memory directly to message structs without copying
-// It handles endianness conversion on the fly
-class Parser {
+/**
+ * Result of parsing a run of length-prefixed message blocks
+ */
+struct BatchResult {
+    size_t messages = 0;        // Messages parsed (known type, complete)
+    size_t blocks = 0;          // Length-prefixed blocks walked, parsed or skipped
+    size_t consumed = 0;        // Offset of the first block not consumed
+};
+
+namespace detail {
+
+// Detection idiom: Op<H> is well-formed iff the handler has the method
+template <typename H, template <typename> class Op, typename = void>
+struct detect : std::false_type {};
+
+template <typename H, template <typename> class Op>
+struct detect<H, Op, std::void_t<Op<H>>> : std::true_type {};
+
+template <typename H>
+using on_add_order_t = decltype(std::declval<H&>().on_add_order(
+    std::declval<const AddOrder*>(), Timestamp{}, Price{}, Quantity{}));
+template <typename H>
+using on_add_order_mpid_t = decltype(std::declval<H&>().on_add_order_mpid(
+    std::declval<const AddOrderMPID*>(), Timestamp{}, Price{}, Quantity{}));
+template <typename H>
+using on_order_executed_t = decltype(std::declval<H&>().on_order_executed(
+    std::declval<const OrderExecuted*>(), Timestamp{}));
+template <typename H>
+using on_order_executed_with_price_t = decltype(std::declval<H&>().on_order_executed_with_price(
+    std::declval<const OrderExecutedWithPrice*>(), Timestamp{}, Price{}));
+template <typename H>
+using on_order_cancel_t = decltype(std::declval<H&>().on_order_cancel(
+    std::declval<const OrderCancel*>(), Timestamp{}));
+template <typename H>
+using on_order_delete_t = decltype(std::declval<H&>().on_order_delete(
+    std::declval<const OrderDelete*>(), Timestamp{}));
+template <typename H>
+using on_order_replace_t = decltype(std::declval<H&>().on_order_replace(
+    std::declval<const OrderReplace*>(), Timestamp{}, Price{}, Quantity{}));
+template <typename H>
+using on_trade_t = decltype(std::declval<H&>().on_trade(
+    std::declval<const Trade*>(), Timestamp{}, Price{}, Quantity{}));
+template <typename H>
+using on_stock_directory_t = decltype(std::declval<H&>().on_stock_directory(
+    std::declval<const StockDirectory*>(), Timestamp{}));
+
+} // namespace detail
+
+/**
+ * Zero-copy ITCH 5.0 parser with compile-time handler dispatch
+ *
+ * Casts raw memory directly to message structs without copying and
+ * handles endianness conversion on the fly. Each decoded message is
+ * passed straight to a member function of Handler, so the calls are
+ * direct and inlinable - no type erasure and no per-message null check.
+ *
+ * Handler implements any subset of:
+ *   on_add_order(const AddOrder*, Timestamp, Price, Quantity)
+ *   on_add_order_mpid(const AddOrderMPID*, Timestamp, Price, Quantity)
+ *   on_order_executed(const OrderExecuted*, Timestamp)
+ *   on_order_executed_with_price(const OrderExecutedWithPrice*, Timestamp, Price)
+ *   on_order_cancel(const OrderCancel*, Timestamp)
+ *   on_order_delete(const OrderDelete*, Timestamp)
+ *   on_order_replace(const OrderReplace*, Timestamp, Price, Quantity)
+ *   on_trade(const Trade*, Timestamp, Price, Quantity)
+ *   on_stock_directory(const StockDirectory*, Timestamp)
+ *
+ * Types the handler does not implement are counted but not decoded;
+ * the check happens at compile time.
+ *
+ * The handler is held by reference and must outlive the parser.
+ */
+template <typename Handler>
+class BasicParser {
 public:
-    Parser() = default;
+    using Stats = ParserStats;
 
-    // Set callbacks for message types
-    void set_add_order_callback(AddOrderCallback cb) { add_order_cb_ = std::move(cb); }
-    void set_add_order_mpid_callback(AddOrderMPIDCallback cb) { add_order_mpid_cb_ = std::move(cb); }
-    void set_order_executed_callback(OrderExecutedCallback cb) { order_executed_cb_ = std::move(cb); }
-    void set_order_executed_with_price_callback(OrderExecutedWithPriceCallback cb) { order_executed_with_price_cb_ = std::move(cb); }
-    void set_order_cancel_callback(OrderCancelCallback cb) { order_cancel_cb_ = std::move(cb); }
-    void set_order_delete_callback(OrderDeleteCallback cb) { order_delete_cb_ = std::move(cb); }
-    void set_order_replace_callback(OrderReplaceCallback cb) { order_replace_cb_ = std::move(cb); }
-    void set_trade_callback(TradeCallback cb) { trade_cb_ = std::move(cb); }
+    explicit BasicParser(Handler& handler)
+        : handler_(handler) {}
 
     // Parse a single ITCH message from raw memory (zero-copy)
     // Returns the number of bytes consumed, or 0 on error
@@ -44,113 +143,121 @@ public:
     size_t parse_message(const uint8_t* data, size_t len) {
         if (len < 1) return 0;
 
-        char msg_type = static_cast<char>(data[0]);
-        size_t expected_size = get_message_size(msg_type);
+        // One indexed load validates the type and selects the handler
+        const MessageDescriptor& desc = describe_message(static_cast<char>(data[0]));
 
-        if (expected_size == 0) {
+        if (desc.size == 0) {
             // Unknown message type - skip it
-            // In production, you'd log this
+            ++stats_.by_type[0];
             return 0;
         }
 
-        if (len < expected_size) {
+        if (len < desc.size) {
             // Incomplete message
             return 0;
         }
 
+        ++stats_.by_type[static_cast<size_t>(desc.kind)];
+        ++stats_.total_messages;
+
         // Zero-copy: cast directly to struct pointer
-        // The struct is packed, so this is safe
-        switch (msg_type) {
-            case msg_type::AddOrder:
+        // The struct is packed, so this is safe. The kinds are dense, so
+        // this switch compiles to a jump table indexed by desc.kind.
+        switch (desc.kind) {
+            case MessageKind::AddOrder:
                 parse_add_order(reinterpret_cast<const AddOrder*>(data));
                 break;
 
-            case msg_type::AddOrderMPID:
+            case MessageKind::AddOrderMPID:
                 parse_add_order_mpid(reinterpret_cast<const AddOrderMPID*>(data));
                 break;
 
-            case msg_type::OrderExecuted:
+            case MessageKind::OrderExecuted:
                 parse_order_executed(reinterpret_cast<const OrderExecuted*>(data));
                 break;
 
-            case msg_type::OrderExecutedWithPrice:
+            case MessageKind::OrderExecutedWithPrice:
                 parse_order_executed_with_price(reinterpret_cast<const OrderExecutedWithPrice*>(data));
                 break;
 
-            case msg_type::OrderCancel:
+            case MessageKind::OrderCancel:
                 parse_order_cancel(reinterpret_cast<const OrderCancel*>(data));
                 break;
 
-            case msg_type::OrderDelete:
+            case MessageKind::OrderDelete:
                 parse_order_delete(reinterpret_cast<const OrderDelete*>(data));
                 break;
 
-            case msg_type::OrderReplace:
+            case MessageKind::OrderReplace:
                 parse_order_replace(reinterpret_cast<const OrderReplace*>(data));
                 break;
 
-            case msg_type::Trade:
+            case MessageKind::Trade:
                 parse_trade(reinterpret_cast<const Trade*>(data));
                 break;
 
-            // Non-order messages - count but don't process for now
-            case msg_type::SystemEvent:
-            case msg_type::StockDirectory:
-            case msg_type::StockTradingAction:
-            case msg_type::RegSHORestriction:
-            case msg_type::MarketParticipantPosition:
-            case msg_type::MWCBDecline:
-            case msg_type::MWCBStatus:
-            case msg_type::IPOQuotingPeriod:
-            case msg_type::LULDAuctionCollar:
-            case msg_type::OperationalHalt:
-            case msg_type::CrossTrade:
-            case msg_type::BrokenTrade:
-            case msg_type::NOII:
-            case msg_type::RPII:
-                ++stats_.other_messages;
+            case MessageKind::StockDirectory:
+                parse_stock_directory(reinterpret_cast<const StockDirectory*>(data));
                 break;
 
+            // Non-order messages - counted above, not processed for now
             default:
-                ++stats_.unknown_messages;
                 break;
         }
 
-        ++stats_.total_messages;
-        return expected_size;
+        return desc.size;
     }
 
-    // Convert normalized message to downstream format
-    // This can be used to push to the ring buffer
-    static NormalizedMessage normalize_add_order(const AddOrder* msg) {
-        NormalizedMessage norm;
-        norm.type = MessageType::AddOrder;
-        norm.timestamp = endian::read_be48(msg->timestamp);
-        norm.order_ref = endian::ntoh64(msg->order_reference_number);
-        std::memcpy(norm.stock.data(), msg->stock, 8);
-        norm.side = (msg->buy_sell_indicator == 'B') ? Side::Buy : Side::Sell;
-        norm.price = convert_price(endian::ntoh32(msg->price));
-        norm.quantity = endian::ntoh32(msg->shares);
-        return norm;
-    }
+    /**
+     * Parse a run of 2-byte big-endian length-prefixed message blocks
+     *
+     * This is both the ITCH file framing and the MoldUDP64 message block
+     * framing, so one call covers a whole packet payload or file chunk.
+     * Blocks ahead of the cursor are prefetched; dispatch stays in this
+     * loop instead of paying a call per message from the caller.
+     *
+     * Stops after max_messages blocks or at the first incomplete block;
+     * result.consumed is where the next call should resume.
+     */
+    BatchResult parse_buffer(const uint8_t* data, size_t len,
+                             size_t max_messages = SIZE_MAX) {
+        BatchResult result;
+        size_t offset = 0;
+
+        while (result.blocks < max_messages && offset + sizeof(uint16_t) <= len) {
+            uint16_t msg_len = endian::read_be16(data + offset);
+            size_t body = offset + sizeof(uint16_t);
+            if (body + msg_len > len) {
+                break;  // Incomplete block: leave it for the next call
+            }
+
+#if defined(__GNUC__) || defined(__clang__)
+            if (body + PREFETCH_DISTANCE < len) {
+                __builtin_prefetch(data + body + PREFETCH_DISTANCE);
+            }
+#endif
+
+            if (parse_message(data + body, msg_len) > 0) {
+                ++result.messages;
+            }
+            ++result.blocks;
+            offset = body + msg_len;
+        }
 
-    // Statistics
-    struct Stats {
-        uint64_t total_messages = 0;
-        uint64_t add_orders = 0;
-        uint64_t order_executed = 0;
-        uint64_t order_deleted = 0;
-        uint64_t order_cancelled = 0;
-        uint64_t order_replaced = 0;
-        uint64_t trades = 0;
-        uint64_t other_messages = 0;
-        uint64_t unknown_messages = 0;
-    };
+        result.consumed = offset;
+        return result;
+    }
 
     const Stats& get_stats() const { return stats_; }
     void reset_stats() { stats_ = Stats{}; }
 
-private:
+    // For normalizers: a reference NormalizedMessage could not hold
+    void count_order_ref_overflow() { ++stats_.order_ref_overflows; }
+
+    // Bytes ahead of the parse cursor to prefetch (four cache lines,
+    // roughly three average ITCH messages)
+    static constexpr size_t PREFETCH_DISTANCE = 4 * CACHE_LINE_SIZE;
+
     // Convert ITCH price (4 decimal places) to our internal format (6 decimal places)
     static Price convert_price(uint32_t itch_price) {
         // ITCH uses 4 decimal places, we use 6
@@ -158,79 +265,122 @@ private:
         return static_cast<Price>(itch_price) * 100;
     }
 
+private:
+    template <template <typename> class Op>
+    static constexpr bool handles = detail::detect<Handler, Op>::value;
+
     void parse_add_order(const AddOrder* msg) {
-        ++stats_.add_orders;
-        if (add_order_cb_) {
+        if constexpr (handles<detail::on_add_order_t>) {
             Timestamp ts = endian::read_be48(msg->timestamp);
             Price price = convert_price(endian::ntoh32(msg->price));
             Quantity qty = endian::ntoh32(msg->shares);
-            add_order_cb_(msg, ts, price, qty);
+            handler_.on_add_order(msg, ts, price, qty);
         }
     }
 
     void parse_add_order_mpid(const AddOrderMPID* msg) {
-        ++stats_.add_orders;
-        if (add_order_mpid_cb_) {
+        if constexpr (handles<detail::on_add_order_mpid_t>) {
             Timestamp ts = endian::read_be48(msg->timestamp);
             Price price = convert_price(endian::ntoh32(msg->price));
             Quantity qty = endian::ntoh32(msg->shares);
-            add_order_mpid_cb_(msg, ts, price, qty);
+            handler_.on_add_order_mpid(msg, ts, price, qty);
         }
     }
 
     void parse_order_executed(const OrderExecuted* msg) {
-        ++stats_.order_executed;
-        if (order_executed_cb_) {
+        if constexpr (handles<detail::on_order_executed_t>) {
             Timestamp ts = endian::read_be48(msg->timestamp);
-            order_executed_cb_(msg, ts);
+            handler_.on_order_executed(msg, ts);
         }
     }
 
     void parse_order_executed_with_price(const OrderExecutedWithPrice* msg) {
-        ++stats_.order_executed;
-        if (order_executed_with_price_cb_) {
+        if constexpr (handles<detail::on_order_executed_with_price_t>) {
             Timestamp ts = endian::read_be48(msg->timestamp);
             Price price = convert_price(endian::ntoh32(msg->execution_price));
-            order_executed_with_price_cb_(msg, ts, price);
+            handler_.on_order_executed_with_price(msg, ts, price);
         }
     }
 
     void parse_order_cancel(const OrderCancel* msg) {
-        ++stats_.order_cancelled;
-        if (order_cancel_cb_) {
+        if constexpr (handles<detail::on_order_cancel_t>) {
             Timestamp ts = endian::read_be48(msg->timestamp);
-            order_cancel_cb_(msg, ts);
+            handler_.on_order_cancel(msg, ts);
         }
     }
 
     void parse_order_delete(const OrderDelete* msg) {
-        ++stats_.order_deleted;
-        if (order_delete_cb_) {
+        if constexpr (handles<detail::on_order_delete_t>) {
             Timestamp ts = endian::read_be48(msg->timestamp);
-            order_delete_cb_(msg, ts);
+            handler_.on_order_delete(msg, ts);
         }
     }
 
     void parse_order_replace(const OrderReplace* msg) {
-        ++stats_.order_replaced;
-        if (order_replace_cb_) {
+        if constexpr (handles<detail::on_order_replace_t>) {
             Timestamp ts = endian::read_be48(msg->timestamp);
             Price price = convert_price(endian::ntoh32(msg->price));
             Quantity qty = endian::ntoh32(msg->shares);
-            order_replace_cb_(msg, ts, price, qty);
+            handler_.on_order_replace(msg, ts, price, qty);
         }
     }
 
     void parse_trade(const Trade* msg) {
-        ++stats_.trades;
-        if (trade_cb_) {
+        if constexpr (handles<detail::on_trade_t>) {
             Timestamp ts = endian::read_be48(msg->timestamp);
             Price price = convert_price(endian::ntoh32(msg->price));
             Quantity qty = endian::ntoh32(msg->shares);
-            trade_cb_(msg, ts, price, qty);
+            handler_.on_trade(msg, ts, price, qty);
+        }
+    }
+
+    void parse_stock_directory(const StockDirectory* msg) {
+        if constexpr (handles<detail::on_stock_directory_t>) {
+            Timestamp ts = endian::read_be48(msg->timestamp);
+            handler_.on_stock_directory(msg, ts);
         }
     }
 
+    Handler& handler_;
+
+    // Statistics
+    Stats stats_;
+};
+
+/**
+ * Handler that forwards to runtime-settable std::function callbacks
+ * Unset callbacks are skipped with a null check per message.
+ */
+class CallbackHandler {
+public:
+    void on_add_order(const AddOrder* msg, Timestamp ts, Price price, Quantity qty) {
+        if (add_order_cb_) add_order_cb_(msg, ts, price, qty);
+    }
+    void on_add_order_mpid(const AddOrderMPID* msg, Timestamp ts, Price price, Quantity qty) {
+        if (add_order_mpid_cb_) add_order_mpid_cb_(msg, ts, price, qty);
+    }
+    void on_order_executed(const OrderExecuted* msg, Timestamp ts) {
+        if (order_executed_cb_) order_executed_cb_(msg, ts);
+    }
+    void on_order_executed_with_price(const OrderExecutedWithPrice* msg, Timestamp ts, Price price) {
+        if (order_executed_with_price_cb_) order_executed_with_price_cb_(msg, ts, price);
+    }
+    void on_order_cancel(const OrderCancel* msg, Timestamp ts) {
+        if (order_cancel_cb_) order_cancel_cb_(msg, ts);
+    }
+    void on_order_delete(const OrderDelete* msg, Timestamp ts) {
+        if (order_delete_cb_) order_delete_cb_(msg, ts);
+    }
+    void on_order_replace(const OrderReplace* msg, Timestamp ts, Price price, Quantity qty) {
+        if (order_replace_cb_) order_replace_cb_(msg, ts, price, qty);
+    }
+    void on_trade(const Trade* msg, Timestamp ts, Price price, Quantity qty) {
+        if (trade_cb_) trade_cb_(msg, ts, price, qty);
+    }
+    void on_stock_directory(const StockDirectory* msg, Timestamp ts) {
+        if (stock_directory_cb_) stock_directory_cb_(msg, ts);
+    }
+
     // Callbacks
     AddOrderCallback add_order_cb_;
     AddOrderMPIDCallback add_order_mpid_cb_;
@@ -240,9 +390,76 @@ private:
     OrderDeleteCallback order_delete_cb_;
     OrderReplaceCallback order_replace_cb_;
     TradeCallback trade_cb_;
+    StockDirectoryCallback stock_directory_cb_;
+};
 
-    // Statistics
-    Stats stats_;
+/**
+ * Zero-copy ITCH 5.0 parser with std::function callbacks
+ *
+ * Adapter over BasicParser<CallbackHandler> for callers that want to
+ * install callbacks at runtime. Hot paths should use BasicParser with a
+ * concrete handler instead.
+ */
+class Parser {
+public:
+    using Stats = ParserStats;
+
+    Parser()
+        : parser_(callbacks_) {}
+
+    Parser(const Parser&) = delete;
+    Parser& operator=(const Parser&) = delete;
+
+    // Set callbacks for message types
+    void set_add_order_callback(AddOrderCallback cb) { callbacks_.add_order_cb_ = std::move(cb); }
+    void set_add_order_mpid_callback(AddOrderMPIDCallback cb) { callbacks_.add_order_mpid_cb_ = std::move(cb); }
+    void set_order_executed_callback(OrderExecutedCallback cb) { callbacks_.order_executed_cb_ = std::move(cb); }
+    void set_order_executed_with_price_callback(OrderExecutedWithPriceCallback cb) { callbacks_.order_executed_with_price_cb_ = std::move(cb); }
+    void set_order_cancel_callback(OrderCancelCallback cb) { callbacks_.order_cancel_cb_ = std::move(cb); }
+    void set_order_delete_callback(OrderDeleteCallback cb) { callbacks_.order_delete_cb_ = std::move(cb); }
+    void set_order_replace_callback(OrderReplaceCallback cb) { callbacks_.order_replace_cb_ = std::move(cb); }
+    void set_trade_callback(TradeCallback cb) { callbacks_.trade_cb_ = std::move(cb); }
+    void set_stock_directory_callback(StockDirectoryCallback cb) { callbacks_.stock_directory_cb_ = std::move(cb); }
+
+    // Parse a single ITCH message from raw memory (zero-copy)
+    // Returns the number of bytes consumed, or 0 on error
+    size_t parse_message(const uint8_t* data, size_t len) {
+        return parser_.parse_message(data, len);
+    }
+
+    // Parse a run of length-prefixed message blocks (see BasicParser)
+    BatchResult parse_buffer(const uint8_t* data, size_t len,
+                             size_t max_messages = SIZE_MAX) {
+        return parser_.parse_buffer(data, len, max_messages);
+    }
+
+    // Convert normalized message to downstream format
+    // This can be used to push to the ring buffer. Returns false, leaving
+    // norm untouched, for an order reference wider than 48 bits (counted in
+    // order_ref_overflows): the message must be dropped
+    bool normalize_add_order(const AddOrder* msg, NormalizedMessage& norm) {
+        const OrderRef ref = endian::ntoh64(msg->order_reference_number);
+        if (!NormalizedMessage::order_ref_fits(ref)) {
+            parser_.count_order_ref_overflow();
+            return false;
+        }
+        norm = NormalizedMessage();
+        norm.set_type(MessageType::AddOrder);
+        norm.set_stock_locate(endian::ntoh16(msg->stock_locate));
+        norm.set_timestamp(endian::read_be48(msg->timestamp));
+        norm.set_order_ref(ref);
+        norm.set_side((msg->buy_sell_indicator == 'B') ? Side::Buy : Side::Sell);
+        norm.set_price(BasicParser<CallbackHandler>::convert_price(endian::ntoh32(msg->price)));
+        norm.set_quantity(endian::ntoh32(msg->shares));
+        return true;
+    }
+
+    const Stats& get_stats() const { return parser_.get_stats(); }
+    void reset_stats() { parser_.reset_stats(); }
+
+private:
+    CallbackHandler callbacks_;
+    BasicParser<CallbackHandler> parser_;
 };
 
 } // namespace itch5
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "header.hpp"
+#include "../common/types.hpp"
+#include "../common/endian.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace hft {
+namespace moldudp64 {
+
+// The two redundant multicast lines carrying one MoldUDP64 stream
+enum class Line : uint8_t {
+    A = 0,
+    B = 1
+};
+
+inline const char* line_name(Line line) {
+    return line == Line::A ? "A" : "B";
+}
+
+/**
+ * A/B line arbitration in front of a Session
+ *
+ * NASDAQ sends every MoldUDP64 packet on two lines with identical
+ * sequencing. The arbiter sees each copy and lets exactly one through:
+ * - First arrival wins; the later copy is a Duplicate
+ * - A packet below the delivered high-water mark that was never delivered
+ *   fills a gap from the other line, with no retransmission round trip
+ * - Packets further back than the window are Stale and dropped
+ *
+ * Delivered packets are remembered in a direct-mapped window indexed by
+ * first sequence (window is in messages, so packets inside it never
+ * collide). A verdict is a header read, one window slot and a few
+ * compares; arrival_ns comes from the caller (NIC or PCAP timestamp), so
+ * no clock is read here.
+ *
+ * Heartbeats and end-of-session packets carry no messages and always pass.
+ *
+ * Window slots are tagged with a generation in the top 16 bits, so
+ * restart() (a new session in the same arbiter) invalidates them all
+ * without touching the window.
+ */
+class LineArbiter {
+public:
+    static constexpr size_t DEFAULT_WINDOW = 1 << 16;
+
+    enum class Verdict : uint8_t {
+        Deliver,     // First copy: hand to the session
+        Duplicate,   // Already delivered from the other line
+        Stale,       // Older than the window
+        Invalid      // Not a MoldUDP64 packet
+    };
+
+    struct LineStats {
+        uint64_t packets = 0;
+        uint64_t wins = 0;           // Delivered first from this line
+        uint64_t gap_fills = 0;      // Wins behind the high-water mark
+        uint64_t duplicates = 0;     // Lost the race
+        uint64_t stale = 0;
+        uint64_t missed_messages = 0;  // Sequence jumps seen on this line alone
+        uint64_t skew_samples = 0;     // Duplicates timed against the winner
+        uint64_t skew_total_ns = 0;
+        uint64_t skew_max_ns = 0;
+
+        double win_rate() const {
+            return packets ? static_cast<double>(wins) / static_cast<double>(packets) : 0.0;
+        }
+        double mean_skew_ns() const {
+            return skew_samples ? static_cast<double>(skew_total_ns) / static_cast<double>(skew_samples) : 0.0;
+        }
+    };
+
+    // window: messages of history kept (rounded up to a power of 2)
+    explicit LineArbiter(size_t window = DEFAULT_WINDOW) {
+        size_t slots = 2;
+        while (slots < window) {
+            slots <<= 1;
+        }
+        mask_ = slots - 1;
+        window_ = std::make_unique<Entry[]>(slots);
+    }
+
+    LineArbiter(const LineArbiter&) = delete;
+    LineArbiter& operator=(const LineArbiter&) = delete;
+
+    /**
+     * Decide whether a packet (MoldUDP64 header onward) should reach the session
+     */
+    Verdict arbitrate(Line line, const uint8_t* data, size_t len, uint64_t arrival_ns) {
+        LineStats& stats = stats_[static_cast<size_t>(line)];
+        if (len < sizeof(Header)) {
+            return Verdict::Invalid;
+        }
+        ++stats.packets;
+
+        const SequenceNumber seq = endian::read_be64(data + 10);
+        const uint16_t count = endian::read_be16(data + 18);
+
+        if (count == 0 || seq == END_OF_SESSION) {
+            return Verdict::Deliver;
+        }
+
+        // This line's own continuity
+        SequenceNumber& line_next = line_next_[static_cast<size_t>(line)];
+        if (seq > line_next && line_next != 0) {
+            stats.missed_messages += seq - line_next;
+        }
+        if (seq + count > line_next) {
+            line_next = seq + count;
+        }
+
+        Entry& entry = window_[seq & mask_];
+        const uint64_t tag = seq ^ generation_;
+
+        if (seq >= next_) {
+            // Common case: new high-water mark
+            entry.first_seq = tag;
+            entry.arrival_ns = arrival_ns;
+            next_ = seq + count;
+            ++stats.wins;
+            return Verdict::Deliver;
+        }
+
+        if (next_ - seq > mask_) {
+            ++stats.stale;
+            return Verdict::Stale;
+        }
+
+        if (entry.first_seq == tag) {
+            ++stats.duplicates;
+            if (arrival_ns >= entry.arrival_ns) {
+                const uint64_t skew = arrival_ns - entry.arrival_ns;
+                ++stats.skew_samples;
+                stats.skew_total_ns += skew;
+                if (skew > stats.skew_max_ns) {
+                    stats.skew_max_ns = skew;
+                }
+            }
+            return Verdict::Duplicate;
+        }
+
+        // Behind the mark and never delivered: the other line lost it
+        entry.first_seq = tag;
+        entry.arrival_ns = arrival_ns;
+        ++stats.wins;
+        ++stats.gap_fills;
+        return Verdict::Deliver;
+    }
+
+    const LineStats& stats(Line line) const { return stats_[static_cast<size_t>(line)]; }
+
+    // One past the highest sequence delivered
+    SequenceNumber next_sequence() const { return next_; }
+    size_t window() const { return mask_ + 1; }
+
+    void reset() {
+        std::memset(static_cast<void*>(window_.get()), 0, (mask_ + 1) * sizeof(Entry));
+        generation_ = 0;
+        next_ = 0;
+        line_next_[0] = line_next_[1] = 0;
+        stats_[0] = stats_[1] = LineStats{};
+    }
+
+    /**
+     * Follow a new session from sequence 1; stats keep accumulating
+     * O(1): bumps the window generation (the window is only cleared when
+     * the 16-bit generation wraps)
+     */
+    void restart() {
+        generation_ += GENERATION_STEP;
+        if (generation_ == 0) {
+            std::memset(static_cast<void*>(window_.get()), 0, (mask_ + 1) * sizeof(Entry));
+        }
+        next_ = 0;
+        line_next_[0] = line_next_[1] = 0;
+    }
+
+private:
+    // Sequences stay far below 2^48, so tagged values never collide
+    static constexpr uint64_t GENERATION_STEP = 1ULL << 48;
+
+    struct Entry {
+        uint64_t first_seq = 0;   // Sequence ^ generation; 0 = empty (MoldUDP64 starts at 1)
+        uint64_t arrival_ns = 0;
+    };
+
+    std::unique_ptr<Entry[]> window_;
+    uint64_t generation_ = 0;
+    size_t mask_ = 0;
+    SequenceNumber next_ = 0;
+    SequenceNumber line_next_[2] = {0, 0};
+    LineStats stats_[2];
+};
+
+} // namespace moldudp64
+} // namespace hft
@@ -0,0 +1,421 @@
+#pragma once
+
+#include "../common/types.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace hft {
+namespace moldudp64 {
+
+/**
+ * Gap information for retransmission requests
+ */
+struct Gap {
+    SequenceNumber start;       // First missing sequence number
+    SequenceNumber end;         // Last missing sequence number (inclusive)
+    uint64_t detected_at_ns;    // When the gap was detected (for timeout)
+};
+
+/**
+ * Set of missing sequence ranges
+ *
+ * Gaps are kept disjoint and non-adjacent in a treap keyed by start, with
+ * nodes in a fixed arena linked by 32-bit index (no allocation after
+ * construction). Expected O(log n) in the number of open gaps for:
+ * - add(): merges with overlapping or adjacent gaps
+ * - fill(): trims, removes, or splits a gap filled in the middle
+ * - is_missing(): one descent
+ *
+ * When the arena is full a new gap is merged into the nearest existing
+ * one. That over-reports what is missing (a retransmission re-requests
+ * messages already seen) but never reports a missing message as present;
+ * overflows() counts it.
+ */
+class GapSet {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+    explicit GapSet(size_t capacity = DEFAULT_CAPACITY)
+        : nodes_(std::make_unique<Node[]>(capacity + 1))  // Slot 0 is the null link
+        , capacity_(capacity) {}
+
+    /**
+     * Record [gap.start, gap.end] as missing
+     * A merged gap keeps the earliest detection time
+     */
+    void add(const Gap& gap) {
+        if (gap.end < gap.start) {
+            return;
+        }
+
+        // Common case: touches no other gap
+        uint32_t pred, succ;
+        locate(gap.start, pred, succ);
+        if ((!pred || nodes_[pred].gap.end + 1 < gap.start) &&
+            (!succ || nodes_[succ].gap.start > gap.end + 1)) {
+            const uint32_t node = allocate();
+            if (node) {
+                nodes_[node].gap = gap;
+                missing_ += gap.end - gap.start + 1;
+                root_ = insert(root_, node);
+                return;
+            }
+        }
+
+        Gap merged = gap;
+        uint32_t left, right, absorbed;
+        split(root_, merged.start, left, right);
+
+        // A gap ending at or just before the start extends in place (its
+        // key does not change)
+        uint32_t prev = max_node(left);
+        if (prev && nodes_[prev].gap.end + 1 >= merged.start) {
+            const Gap& p = nodes_[prev].gap;
+            missing_ -= p.end - p.start + 1;
+            merged.start = p.start;
+            merged.end = std::max(merged.end, p.end);
+            merged.detected_at_ns = std::min(merged.detected_at_ns, p.detected_at_ns);
+        } else {
+            prev = 0;
+        }
+
+        // Gaps starting inside the range or just past it are absorbed
+        split(right, merged.end + 2, absorbed, right);
+        absorb(absorbed, merged);
+        release_tree(absorbed);
+
+        uint32_t node = prev ? prev : allocate();
+        if (!node) {
+            // Arena full: widen the nearest gap to cover this one
+            ++overflows_;
+            node = max_node(left);
+            if (node) {
+                missing_ -= nodes_[node].gap.end - nodes_[node].gap.start + 1;
+                merged.start = nodes_[node].gap.start;
+            } else if ((node = min_node(right)) != 0) {
+                missing_ -= nodes_[node].gap.end - nodes_[node].gap.start + 1;
+                merged.end = nodes_[node].gap.end;
+            } else {
+                // No storage at all
+                return;
+            }
+            merged.detected_at_ns = std::min(merged.detected_at_ns, nodes_[node].gap.detected_at_ns);
+            nodes_[node].gap = merged;
+            missing_ += merged.end - merged.start + 1;
+            root_ = merge(left, right);
+            return;
+        }
+
+        nodes_[node].gap = merged;
+        missing_ += merged.end - merged.start + 1;
+        root_ = prev ? merge(left, right) : merge(merge(left, node), right);
+    }
+
+    /**
+     * Mark [start, end] as received
+     * Returns the number of sequences that were missing
+     */
+    SequenceNumber fill(SequenceNumber start, SequenceNumber end) {
+        if (end < start || !root_) {
+            return 0;
+        }
+        SequenceNumber filled = 0;
+
+        // Common case: the range meets at most one gap, the one starting at
+        // or before it; trims happen in place (the order cannot change)
+        uint32_t pred, succ;
+        locate(start, pred, succ);
+        if (!succ || nodes_[succ].gap.start > end) {
+            if (!pred || nodes_[pred].gap.end < start) {
+                return 0;
+            }
+            Gap& p = nodes_[pred].gap;
+            if (p.start == start && p.end <= end) {
+                filled = p.end - p.start + 1;
+                root_ = erase(root_, p.start);
+            } else if (p.start == start) {
+                filled = end - start + 1;
+                p.start = end + 1;
+            } else if (p.end <= end) {
+                filled = p.end - start + 1;
+                p.end = start - 1;
+            } else {
+                // Filled in the middle: the part after the range is a new gap
+                const uint32_t tail = allocate();
+                if (!tail) {
+                    // Arena full: leave the gap whole (still reported missing)
+                    ++overflows_;
+                    return 0;
+                }
+                nodes_[tail].gap = Gap{end + 1, p.end, p.detected_at_ns};
+                filled = end - start + 1;
+                p.end = start - 1;
+                root_ = insert(root_, tail);
+            }
+            missing_ -= filled;
+            return filled;
+        }
+
+        // Spans several gaps: cut out the range and rejoin
+        uint32_t left, right, covered;
+        split(root_, start, left, right);
+
+        // A gap starting before the range may run into it, or past it
+        uint32_t tail = 0;
+        const uint32_t prev = max_node(left);
+        if (prev && nodes_[prev].gap.end >= start) {
+            Gap& p = nodes_[prev].gap;
+            if (p.end > end) {
+                // Filled in the middle: split off the part after the range
+                tail = allocate();
+                if (!tail) {
+                    // Arena full: leave the gap whole (still reported missing)
+                    ++overflows_;
+                    root_ = merge(left, right);
+                    return 0;
+                }
+                nodes_[tail].gap = Gap{end + 1, p.end, p.detected_at_ns};
+                filled += end - start + 1;
+            } else {
+                filled += p.end - start + 1;
+            }
+            p.end = start - 1;
+        }
+
+        // Gaps starting inside the range; the last may run past it
+        split(right, end + 1, covered, right);
+        const uint32_t last = max_node(covered);
+        if (last && nodes_[last].gap.end > end) {
+            Gap& g = nodes_[last].gap;
+            filled += end - g.start + 1;
+            g.start = end + 1;
+            split(covered, g.start, covered, tail);
+        }
+        filled += total_length(covered);
+        release_tree(covered);
+
+        missing_ -= filled;
+        root_ = merge(merge(left, tail), right);
+        return filled;
+    }
+
+    bool is_missing(SequenceNumber seq) const {
+        uint32_t t = root_;
+        uint32_t best = 0;
+        while (t) {
+            if (nodes_[t].gap.start <= seq) {
+                best = t;
+                t = nodes_[t].right;
+            } else {
+                t = nodes_[t].left;
+            }
+        }
+        return best && seq <= nodes_[best].gap.end;
+    }
+
+    // Lowest gap; the set must not be empty
+    const Gap& front() const { return nodes_[min_node(root_)].gap; }
+
+    // Visit the gaps in sequence order
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        visit(root_, fn);
+    }
+
+    std::vector<Gap> to_vector() const {
+        std::vector<Gap> gaps;
+        gaps.reserve(size_);
+        for_each([&](const Gap& gap) { gaps.push_back(gap); });
+        return gaps;
+    }
+
+    bool empty() const { return root_ == 0; }
+    size_t size() const { return size_; }                 // Open gaps
+    SequenceNumber missing() const { return missing_; }   // Sequences across all gaps
+    size_t capacity() const { return capacity_; }
+    uint64_t overflows() const { return overflows_; }
+
+    void clear() {
+        root_ = 0;
+        free_ = 0;
+        next_unused_ = 1;
+        size_ = 0;
+        missing_ = 0;
+        overflows_ = 0;
+    }
+
+private:
+    struct Node {
+        Gap gap;
+        uint32_t left;
+        uint32_t right;
+        uint32_t priority;
+    };
+
+    uint32_t allocate() {
+        uint32_t index;
+        if (free_) {
+            index = free_;
+            free_ = nodes_[index].left;
+        } else if (next_unused_ <= capacity_) {
+            index = next_unused_++;
+        } else {
+            return 0;
+        }
+        // xorshift32: heap priorities keep the tree balanced in expectation
+        seed_ ^= seed_ << 13;
+        seed_ ^= seed_ >> 17;
+        seed_ ^= seed_ << 5;
+        nodes_[index].left = 0;
+        nodes_[index].right = 0;
+        nodes_[index].priority = seed_;
+        ++size_;
+        return index;
+    }
+
+    void release_tree(uint32_t t) {
+        if (!t) {
+            return;
+        }
+        release_tree(nodes_[t].left);
+        release_tree(nodes_[t].right);
+        nodes_[t].left = free_;
+        free_ = t;
+        --size_;
+    }
+
+    // pred: last gap starting at or before seq; succ: first one after it
+    void locate(SequenceNumber seq, uint32_t& pred, uint32_t& succ) const {
+        pred = succ = 0;
+        uint32_t t = root_;
+        while (t) {
+            if (nodes_[t].gap.start <= seq) {
+                pred = t;
+                t = nodes_[t].right;
+            } else {
+                succ = t;
+                t = nodes_[t].left;
+            }
+        }
+    }
+
+    uint32_t insert(uint32_t t, uint32_t node) {
+        if (!t) {
+            return node;
+        }
+        if (nodes_[node].priority > nodes_[t].priority) {
+            split(t, nodes_[node].gap.start, nodes_[node].left, nodes_[node].right);
+            return node;
+        }
+        if (nodes_[node].gap.start < nodes_[t].gap.start) {
+            nodes_[t].left = insert(nodes_[t].left, node);
+        } else {
+            nodes_[t].right = insert(nodes_[t].right, node);
+        }
+        return t;
+    }
+
+    // Remove the gap starting at key (which must exist)
+    uint32_t erase(uint32_t t, SequenceNumber key) {
+        if (nodes_[t].gap.start == key) {
+            const uint32_t rest = merge(nodes_[t].left, nodes_[t].right);
+            nodes_[t].left = free_;
+            free_ = t;
+            --size_;
+            return rest;
+        }
+        if (key < nodes_[t].gap.start) {
+            nodes_[t].left = erase(nodes_[t].left, key);
+        } else {
+            nodes_[t].right = erase(nodes_[t].right, key);
+        }
+        return t;
+    }
+
+    // left gets the gaps starting before key, right the rest
+    void split(uint32_t t, SequenceNumber key, uint32_t& left, uint32_t& right) {
+        if (!t) {
+            left = right = 0;
+        } else if (nodes_[t].gap.start < key) {
+            split(nodes_[t].right, key, nodes_[t].right, right);
+            left = t;
+        } else {
+            split(nodes_[t].left, key, left, nodes_[t].left);
+            right = t;
+        }
+    }
+
+    // Every gap in left starts before every gap in right
+    uint32_t merge(uint32_t left, uint32_t right) {
+        if (!left || !right) {
+            return left ? left : right;
+        }
+        if (nodes_[left].priority > nodes_[right].priority) {
+            nodes_[left].right = merge(nodes_[left].right, right);
+            return left;
+        }
+        nodes_[right].left = merge(left, nodes_[right].left);
+        return right;
+    }
+
+    uint32_t min_node(uint32_t t) const {
+        while (t && nodes_[t].left) {
+            t = nodes_[t].left;
+        }
+        return t;
+    }
+
+    uint32_t max_node(uint32_t t) const {
+        while (t && nodes_[t].right) {
+            t = nodes_[t].right;
+        }
+        return t;
+    }
+
+    void absorb(uint32_t t, Gap& merged) {
+        if (!t) {
+            return;
+        }
+        const Gap& g = nodes_[t].gap;
+        missing_ -= g.end - g.start + 1;
+        merged.end = std::max(merged.end, g.end);
+        merged.detected_at_ns = std::min(merged.detected_at_ns, g.detected_at_ns);
+        absorb(nodes_[t].left, merged);
+        absorb(nodes_[t].right, merged);
+    }
+
+    SequenceNumber total_length(uint32_t t) const {
+        if (!t) {
+            return 0;
+        }
+        const Gap& g = nodes_[t].gap;
+        return g.end - g.start + 1 + total_length(nodes_[t].left) + total_length(nodes_[t].right);
+    }
+
+    template<typename Fn>
+    void visit(uint32_t t, Fn& fn) const {
+        if (!t) {
+            return;
+        }
+        visit(nodes_[t].left, fn);
+        fn(nodes_[t].gap);
+        visit(nodes_[t].right, fn);
+    }
+
+    std::unique_ptr<Node[]> nodes_;
+    size_t capacity_;
+    uint32_t root_ = 0;
+    uint32_t free_ = 0;           // Released nodes, linked through left
+    uint32_t next_unused_ = 1;    // Slots never handed out start here
+    uint32_t seed_ = 2463534242u;
+    size_t size_ = 0;
+    SequenceNumber missing_ = 0;
+    uint64_t overflows_ = 0;
+};
+
+} // namespace moldudp64
+} // namespace hft
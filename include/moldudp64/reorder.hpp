@@ -0,0 +1,144 @@
+#pragma once
+
+#include "../common/types.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace hft {
+namespace moldudp64 {
+
+/**
+ * Reorder budget for a Session
+ *
+ * A gap is abandoned (its messages skipped, later packets released) when
+ * either the slab runs out of slots or the packet right after the gap
+ * has waited max_hold_ns. With max_packets == 0 nothing is held: every
+ * gap is abandoned as soon as a packet past it arrives.
+ */
+struct ReorderConfig {
+    size_t max_packets = 1024;          // Slab slots, one packet each
+    uint64_t max_hold_ns = 50'000'000;  // 50 ms, roughly one rewinder round trip
+};
+
+/**
+ * Packets held back behind a MoldUDP64 gap
+ *
+ * A preallocated slab of fixed-size packet slots plus an index of the
+ * occupied slots sorted by first sequence number. hold() copies the
+ * packet's message blocks into a free slot; front()/pop_front() hand them
+ * back lowest sequence first. No allocation after construction.
+ *
+ * Held packets are few and usually arrive in sequence order, so the
+ * sorted index is a vector with binary-search insert, which appends in
+ * the common case. Popping advances a front offset instead of erasing,
+ * so a drain is linear.
+ */
+class ReorderBuffer {
+public:
+    static constexpr size_t SLOT_SIZE = 2048;
+
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        SequenceNumber first_seq;
+        uint64_t arrival_ns;
+        uint16_t message_count;
+        uint16_t length;        // Bytes of message blocks in data
+        uint8_t data[SLOT_SIZE - 24];
+
+        SequenceNumber end_seq() const { return first_seq + message_count; }
+    };
+    static_assert(sizeof(Slot) == SLOT_SIZE, "Slot should fill its 2 KB");
+
+    // Largest run of message blocks a slot can hold
+    static constexpr size_t MAX_PAYLOAD = sizeof(Slot::data);
+
+    explicit ReorderBuffer(size_t max_packets)
+        : capacity_(max_packets)
+        , slots_(new Slot[max_packets]) {
+        free_.reserve(max_packets);
+        order_.reserve(max_packets);
+        for (size_t i = max_packets; i-- > 0; ) {
+            free_.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    ReorderBuffer(const ReorderBuffer&) = delete;
+    ReorderBuffer& operator=(const ReorderBuffer&) = delete;
+
+    enum class HoldResult : uint8_t {
+        Held,
+        Duplicate,   // A packet starting at the same sequence is already held
+        Full,        // No free slot
+        TooLarge     // Blocks exceed MAX_PAYLOAD
+    };
+
+    HoldResult hold(SequenceNumber first_seq, const uint8_t* blocks, size_t length,
+                    uint16_t message_count, uint64_t now_ns) {
+        if (length > MAX_PAYLOAD) {
+            return HoldResult::TooLarge;
+        }
+
+        if (order_.size() == capacity_ && front_ > 0) {
+            // Reclaim the popped prefix before the index outgrows its reserve
+            order_.erase(order_.begin(), order_.begin() + front_);
+            front_ = 0;
+        }
+
+        auto pos = std::lower_bound(order_.begin() + front_, order_.end(), first_seq,
+            [this](uint32_t slot, SequenceNumber seq) { return slots_[slot].first_seq < seq; });
+        if (pos != order_.end() && slots_[*pos].first_seq == first_seq) {
+            return HoldResult::Duplicate;
+        }
+        if (free_.empty()) {
+            return HoldResult::Full;
+        }
+
+        const uint32_t index = free_.back();
+        free_.pop_back();
+        Slot& slot = slots_[index];
+        slot.first_seq = first_seq;
+        slot.arrival_ns = now_ns;
+        slot.message_count = message_count;
+        slot.length = static_cast<uint16_t>(length);
+        std::memcpy(slot.data, blocks, length);
+
+        order_.insert(pos, index);
+        return HoldResult::Held;
+    }
+
+    // Lowest-sequence held packet; only valid when !empty()
+    const Slot& front() const { return slots_[order_[front_]]; }
+
+    void pop_front() {
+        free_.push_back(order_[front_]);
+        if (++front_ == order_.size()) {
+            order_.clear();
+            front_ = 0;
+        }
+    }
+
+    void clear() {
+        for (size_t i = front_; i < order_.size(); ++i) {
+            free_.push_back(order_[i]);
+        }
+        order_.clear();
+        front_ = 0;
+    }
+
+    bool empty() const { return order_.size() == front_; }
+    size_t size() const { return order_.size() - front_; }
+    size_t capacity() const { return capacity_; }
+
+private:
+    size_t capacity_;
+    std::unique_ptr<Slot[]> slots_;
+    std::vector<uint32_t> free_;    // Free slot indices (stack)
+    std::vector<uint32_t> order_;   // Held slot indices, by first_seq
+    size_t front_ = 0;              // First live entry of order_
+};
+
+} // namespace moldudp64
+} // namespace hft
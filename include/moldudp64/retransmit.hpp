@@ -0,0 +1,642 @@
+#pragma once
+
+#include "header.hpp"
+#include "session.hpp"
+#include "../common/types.hpp"
+#include "../common/endian.hpp"
+#include "../spsc/ring_buffer.hpp"
+#include "../spsc/byte_ring.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace hft {
+namespace moldudp64 {
+
+/**
+ * MoldUDP64 retransmission request
+ *
+ * Same 20 bytes as a downstream header: session, first sequence wanted,
+ * message count wanted. The rewinder answers with an ordinary downstream
+ * packet starting at that sequence, holding as many messages as fit.
+ */
+using RequestPacket = Header;
+
+inline void encode_request(const std::array<char, 10>& session, SequenceNumber seq,
+                           uint16_t count, uint8_t* out) {
+    std::memcpy(out, session.data(), 10);
+    const uint64_t seq_be = endian::hton64(seq);
+    const uint16_t count_be = endian::hton16(count);
+    std::memcpy(out + 10, &seq_be, 8);
+    std::memcpy(out + 18, &count_be, 2);
+}
+
+struct RetransmitConfig {
+    std::string host = "127.0.0.1";     // Rewinder address (IPv4)
+    uint16_t port = 0;
+    uint32_t max_requests_per_sec = 2000;
+    uint32_t request_burst = 16;        // Token bucket depth
+    uint16_t max_request_count = 512;   // Messages asked for per request
+    uint64_t coalesce_distance = 32;    // Merge unsent gaps this close
+    uint64_t retry_ns = 20'000'000;     // Re-request after 20 ms without progress
+    uint32_t max_attempts = 5;          // Then give the range up
+    uint64_t poll_interval_ns = 100'000;  // Longest the recovery thread sleeps
+    size_t max_sessions = 8;            // Sessions with ranges outstanding at once
+};
+
+/**
+ * Token bucket capping the request rate
+ *
+ * A planner owns one, or several planners share one so the cap holds
+ * across all of their sessions.
+ */
+class RequestRate {
+public:
+    explicit RequestRate(const RetransmitConfig& config)
+        : max_requests_per_sec_(config.max_requests_per_sec)
+        , burst_(config.request_burst)
+        , tokens_(config.request_burst) {}
+
+    // Whether a request may be sent at now_ns
+    bool ready(uint64_t now_ns) {
+        refill(now_ns);
+        return tokens_ > 0;
+    }
+
+    // Spend a token; only after ready() returned true
+    void take() { --tokens_; }
+
+private:
+    void refill(uint64_t now_ns) {
+        if (last_refill_ns_ == 0) {
+            last_refill_ns_ = now_ns;
+            return;
+        }
+        const uint64_t elapsed = now_ns - last_refill_ns_;
+        const uint64_t earned = elapsed * max_requests_per_sec_ / 1'000'000'000ULL;
+        if (earned > 0) {
+            tokens_ = static_cast<uint32_t>(std::min<uint64_t>(tokens_ + earned, burst_));
+            last_refill_ns_ += earned * 1'000'000'000ULL / max_requests_per_sec_;
+        }
+    }
+
+    uint32_t max_requests_per_sec_;
+    uint32_t burst_;
+    uint32_t tokens_;
+    uint64_t last_refill_ns_ = 0;
+};
+
+/**
+ * Decides which retransmission requests to send and when
+ *
+ * Keeps the outstanding missing ranges sorted by start:
+ * - Gaps that have not been requested yet merge with neighbours within
+ *   coalesce_distance, so a burst of small gaps costs one request
+ * - Responses trim or split ranges; any progress makes the remainder due
+ *   again at once (a rewinder answers with one packet, so a large range
+ *   takes several round trips)
+ * - A range with no progress is re-requested every retry_ns, and dropped
+ *   after max_attempts
+ * - A token bucket caps the request rate (its own, or a RequestRate shared
+ *   with other planners)
+ *
+ * Single-threaded; owned by the recovery thread. Outstanding ranges are
+ * few, so a sorted vector is enough.
+ */
+class RequestPlanner {
+public:
+    struct Request {
+        SequenceNumber start;
+        uint16_t count;
+    };
+
+    explicit RequestPlanner(const RetransmitConfig& config)
+        : config_(config)
+        , rate_(config) {}
+
+    // Missing range [start, end], inclusive
+    void add(SequenceNumber start, SequenceNumber end) {
+        size_t i = 0;
+        while (i < ranges_.size() && ranges_[i].end < start) {
+            ++i;
+        }
+
+        // Insert only the parts not already outstanding
+        SequenceNumber cursor = start;
+        while (cursor <= end) {
+            if (i == ranges_.size() || end < ranges_[i].start) {
+                insert(i, cursor, end);
+                break;
+            }
+            if (cursor < ranges_[i].start) {
+                const SequenceNumber before = ranges_[i].start - 1;
+                insert(i, cursor, before);
+                ++i;
+            }
+            cursor = ranges_[i].end + 1;
+            ++i;
+        }
+        coalesce();
+    }
+
+    // Messages [start, end] arrived
+    void fill(SequenceNumber start, SequenceNumber end) {
+        for (size_t i = 0; i < ranges_.size(); ) {
+            Range& range = ranges_[i];
+            if (range.end < start) {
+                ++i;
+                continue;
+            }
+            if (range.start > end) {
+                break;
+            }
+
+            if (start <= range.start && end >= range.end) {
+                ranges_.erase(ranges_.begin() + static_cast<ptrdiff_t>(i));
+                continue;
+            }
+
+            // Progress: whatever is left is due again
+            range.attempts = 0;
+            if (start > range.start && end < range.end) {
+                Range tail{end + 1, range.end, 0, 0};
+                range.end = start - 1;
+                ranges_.insert(ranges_.begin() + static_cast<ptrdiff_t>(i) + 1, tail);
+                return;
+            }
+            if (start <= range.start) {
+                range.start = end + 1;
+            } else {
+                range.end = start - 1;
+            }
+            ++i;
+        }
+    }
+
+    /**
+     * The next request to send at now_ns, if any is due and the rate
+     * limit allows it
+     */
+    bool next(uint64_t now_ns, Request& out) { return next(now_ns, out, rate_); }
+
+    // As above, drawing on a shared rate limit
+    bool next(uint64_t now_ns, Request& out, RequestRate& rate) {
+        if (!rate.ready(now_ns)) {
+            return false;
+        }
+
+        for (size_t i = 0; i < ranges_.size(); ) {
+            Range& range = ranges_[i];
+            if (range.attempts > 0 && now_ns - range.sent_ns < config_.retry_ns) {
+                ++i;
+                continue;
+            }
+            if (range.attempts >= config_.max_attempts) {
+                abandoned_ += range.end - range.start + 1;
+                ranges_.erase(ranges_.begin() + static_cast<ptrdiff_t>(i));
+                continue;
+            }
+
+            if (range.attempts > 0) {
+                ++retries_;
+            }
+            ++range.attempts;
+            range.sent_ns = now_ns;
+            rate.take();
+
+            const uint64_t missing = range.end - range.start + 1;
+            out.start = range.start;
+            out.count = static_cast<uint16_t>(std::min<uint64_t>(missing, config_.max_request_count));
+            return true;
+        }
+        return false;
+    }
+
+    size_t outstanding_ranges() const { return ranges_.size(); }
+    bool idle() const { return ranges_.empty(); }
+    uint64_t retries() const { return retries_; }
+    uint64_t abandoned_messages() const { return abandoned_; }
+
+private:
+    struct Range {
+        SequenceNumber start;
+        SequenceNumber end;         // Inclusive
+        uint64_t sent_ns;
+        uint32_t attempts;          // Requests since the last progress
+    };
+
+    void insert(size_t index, SequenceNumber start, SequenceNumber end) {
+        ranges_.insert(ranges_.begin() + static_cast<ptrdiff_t>(index), Range{start, end, 0, 0});
+    }
+
+    // Merge neighbouring ranges that have not been requested yet; a range
+    // already in flight is never widened
+    void coalesce() {
+        size_t out = 0;
+        for (size_t i = 1; i < ranges_.size(); ++i) {
+            Range& last = ranges_[out];
+            const Range& next = ranges_[i];
+            if (last.attempts == 0 && next.attempts == 0 &&
+                next.start - last.end <= config_.coalesce_distance + 1) {
+                last.end = next.end;
+            } else {
+                ranges_[++out] = next;
+            }
+        }
+        if (!ranges_.empty()) {
+            ranges_.resize(out + 1);
+        }
+    }
+
+    RetransmitConfig config_;
+    std::vector<Range> ranges_;
+    RequestRate rate_;
+    uint64_t retries_ = 0;
+    uint64_t abandoned_ = 0;
+};
+
+/**
+ * Gap recovery off the hot path
+ *
+ * The producer thread only hands gaps over (request(), or attach() to
+ * wire a Session's GapCallback) and applies responses (poll()); both are
+ * SPSC ring operations. A recovery thread does everything else:
+ * - Plans coalesced requests with one RequestPlanner per session id, all
+ *   under one shared rate limit
+ * - Sends them over UDP to the rewinder, each with its range's session
+ *   id, taking the sessions in turn, and receives the responses
+ * - Queues each response packet for poll(), which feeds it to
+ *   Session::process_retransmission on the producer thread, so the
+ *   Session stays single-threaded
+ *
+ * Interleaved channels recover side by side: a gap on one session leaves
+ * the others' ranges alone. A session's ranges are dropped only when it
+ * is released (release(), wired by attach() to the SessionManager
+ * evicting it or to its end-of-session), or when max_sessions planners
+ * are busy and it is the one that saw a gap least recently.
+ *
+ * The recovery thread sleeps in ppoll(2) between events (at most
+ * poll_interval_ns, which bounds how long a new gap waits to be seen), so
+ * it does not need a dedicated core.
+ */
+class RetransmitClient {
+public:
+    using ResponseBuffer = spsc::ByteRing<1 << 20>;
+
+    struct Stats {
+        uint64_t gaps_received;
+        uint64_t requests_sent;
+        uint64_t retries;
+        uint64_t responses_received;
+        uint64_t messages_recovered;
+        uint64_t messages_abandoned;
+        uint64_t responses_dropped;     // Response ring full
+        uint64_t send_errors;
+    };
+
+    explicit RetransmitClient(const RetransmitConfig& config)
+        : config_(config) {}
+
+    ~RetransmitClient() { stop(); }
+
+    RetransmitClient(const RetransmitClient&) = delete;
+    RetransmitClient& operator=(const RetransmitClient&) = delete;
+
+    /**
+     * Open the socket and start the recovery thread
+     * Returns false if the rewinder address is invalid or the socket fails
+     */
+    bool start() {
+        if (running_.load(std::memory_order_acquire)) {
+            return true;
+        }
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(config_.port);
+        if (inet_pton(AF_INET, config_.host.c_str(), &addr.sin_addr) != 1) {
+            return false;
+        }
+        fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+        if (fd_ < 0) {
+            return false;
+        }
+        if (connect(fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+
+        running_.store(true, std::memory_order_release);
+        thread_ = std::thread([this] { run(); });
+        return true;
+    }
+
+    void stop() {
+        running_.store(false, std::memory_order_release);
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    /**
+     * Route a Session's gaps to this client (producer thread)
+     * Replaces the session's GapCallback and EndCallback; its ranges are
+     * released at end-of-session
+     */
+    void attach(Session& session) {
+        session.set_gap_callback([this, &session](const Gap& gap) {
+            request(session.get_session_id(), gap);
+        });
+        session.set_end_callback([this](const std::array<char, 10>& id) {
+            release(id);
+        });
+    }
+
+    /**
+     * Attach every slot of a SessionManager (producer thread), and release
+     * a session's ranges when the manager evicts it
+     * Replaces the manager's EvictCallback
+     */
+    void attach(SessionManager& sessions) {
+        sessions.configure([this](Session& session) { attach(session); });
+        sessions.set_evict_callback([this](const Session& session) {
+            release(session.get_session_id());
+        });
+    }
+
+    /**
+     * Queue a gap for recovery (producer thread)
+     * Returns false if the gap queue is full; the gap is lost to this client
+     */
+    bool request(const std::array<char, 10>& session, const Gap& gap) noexcept {
+        return gaps_.try_push(PendingGap{session, gap.start, gap.end, false});
+    }
+
+    /**
+     * Stop recovering a session (producer thread): its outstanding ranges
+     * are dropped once the gaps queued before this are planned
+     * Returns false if the gap queue is full; the ranges then run out
+     * their retries
+     */
+    bool release(const std::array<char, 10>& session) noexcept {
+        return gaps_.try_push(PendingGap{session, 0, 0, true});
+    }
+
+    /**
+     * Apply received retransmissions to the session (producer thread)
+     * Returns the number of response packets applied
+     */
+    size_t poll(Session& session) {
+        size_t applied = 0;
+        while (auto record = responses_.front()) {
+            Header header;
+            if (HeaderParser::parse(record.data, record.length, header)) {
+                const size_t offset = HeaderParser::get_messages_offset();
+                session.process_retransmission(header.sequence_number, record.data + offset,
+                                               record.length - offset, header.message_count);
+                ++applied;
+            }
+            responses_.release();
+        }
+        return applied;
+    }
+
+    /**
+     * Apply received retransmissions, each to the session named in its
+     * header (producer thread); responses for unknown sessions are dropped
+     * Returns the number of response packets applied
+     */
+    size_t poll(SessionManager& sessions) {
+        size_t applied = 0;
+        while (auto record = responses_.front()) {
+            Header header;
+            if (HeaderParser::parse(record.data, record.length, header)) {
+                std::array<char, 10> id;
+                std::memcpy(id.data(), header.session, id.size());
+                if (Session* session = sessions.find(id)) {
+                    const size_t offset = HeaderParser::get_messages_offset();
+                    session->process_retransmission(header.sequence_number, record.data + offset,
+                                                    record.length - offset, header.message_count);
+                    ++applied;
+                }
+            }
+            responses_.release();
+        }
+        return applied;
+    }
+
+    // Written by the recovery thread; approximate while it runs
+    Stats get_stats() const {
+        return {gaps_received_.load(std::memory_order_relaxed),
+                requests_sent_.load(std::memory_order_relaxed),
+                retries_.load(std::memory_order_relaxed),
+                responses_received_.load(std::memory_order_relaxed),
+                messages_recovered_.load(std::memory_order_relaxed),
+                messages_abandoned_.load(std::memory_order_relaxed),
+                responses_dropped_.load(std::memory_order_relaxed),
+                send_errors_.load(std::memory_order_relaxed)};
+    }
+
+    // Nothing left to request or in flight
+    bool idle() const { return idle_.load(std::memory_order_acquire) && gaps_.empty(); }
+
+private:
+    struct PendingGap {
+        std::array<char, 10> session;
+        SequenceNumber start;
+        SequenceNumber end;
+        bool release;               // Drop the session's ranges instead
+    };
+
+    // One session's outstanding ranges (recovery thread)
+    struct SessionPlanner {
+        std::array<char, 10> session;
+        RequestPlanner planner;
+        uint64_t last_gap_ns;
+    };
+
+    static constexpr size_t MAX_DATAGRAM = 65536;
+
+    void run() {
+        std::vector<uint8_t> datagram(MAX_DATAGRAM);
+        uint8_t request[sizeof(RequestPacket)];
+        const timespec interval{static_cast<time_t>(config_.poll_interval_ns / 1'000'000'000ULL),
+                                static_cast<long>(config_.poll_interval_ns % 1'000'000'000ULL)};
+        RequestRate rate(config_);
+        planners_.reserve(std::max<size_t>(config_.max_sessions, 1));
+
+        while (running_.load(std::memory_order_acquire)) {
+            // New gaps from the producer
+            while (auto gap = gaps_.try_pop()) {
+                if (gap->release) {
+                    retire(gap->session);
+                    continue;
+                }
+                planner_for(gap->session).add(gap->start, gap->end);
+                gaps_received_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            // Responses from the rewinder
+            ssize_t n;
+            while ((n = recv(fd_, datagram.data(), datagram.size(), MSG_DONTWAIT)) > 0) {
+                handle_response(datagram.data(), static_cast<size_t>(n));
+            }
+
+            // Requests that are due, one session after another
+            const uint64_t now = now_ns();
+            RequestPlanner::Request next;
+            bool sent = true;
+            while (sent) {
+                sent = false;
+                for (SessionPlanner& p : planners_) {
+                    if (!p.planner.next(now, next, rate)) {
+                        continue;
+                    }
+                    encode_request(p.session, next.start, next.count, request);
+                    if (send(fd_, request, sizeof(request), 0) == static_cast<ssize_t>(sizeof(request))) {
+                        requests_sent_.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        send_errors_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    sent = true;
+                }
+            }
+
+            uint64_t retries = retired_retries_;
+            uint64_t abandoned = retired_abandoned_;
+            bool idle = true;
+            for (const SessionPlanner& p : planners_) {
+                retries += p.planner.retries();
+                abandoned += p.planner.abandoned_messages();
+                idle = idle && p.planner.idle();
+            }
+            retries_.store(retries, std::memory_order_relaxed);
+            messages_abandoned_.store(abandoned, std::memory_order_relaxed);
+            idle_.store(idle, std::memory_order_release);
+
+            // Sleep until a response arrives; wake often enough to pick up
+            // new gaps and retries
+            pollfd pfd{fd_, POLLIN, 0};
+            ppoll(&pfd, 1, &interval, nullptr);
+        }
+    }
+
+    /**
+     * The session's planner, created on its first gap
+     * With max_sessions planners in use, the one that saw a gap least
+     * recently (an idle one first) makes room
+     */
+    RequestPlanner& planner_for(const std::array<char, 10>& session) {
+        const uint64_t now = now_ns();
+        for (SessionPlanner& p : planners_) {
+            if (p.session == session) {
+                p.last_gap_ns = now;
+                return p.planner;
+            }
+        }
+        if (planners_.size() >= std::max<size_t>(config_.max_sessions, 1)) {
+            size_t victim = 0;
+            for (size_t i = 1; i < planners_.size(); ++i) {
+                const SessionPlanner& p = planners_[i];
+                const SessionPlanner& v = planners_[victim];
+                if (p.planner.idle() != v.planner.idle() ? p.planner.idle()
+                                                         : p.last_gap_ns < v.last_gap_ns) {
+                    victim = i;
+                }
+            }
+            retire(planners_[victim].session);
+        }
+        planners_.push_back(SessionPlanner{session, RequestPlanner(config_), now});
+        return planners_.back().planner;
+    }
+
+    SessionPlanner* find_planner(const char* session) {
+        for (SessionPlanner& p : planners_) {
+            if (std::memcmp(p.session.data(), session, p.session.size()) == 0) {
+                return &p;
+            }
+        }
+        return nullptr;
+    }
+
+    // Drop a session's planner, keeping its counters in the totals
+    void retire(const std::array<char, 10>& session) {
+        for (size_t i = 0; i < planners_.size(); ++i) {
+            if (planners_[i].session == session) {
+                retired_retries_ += planners_[i].planner.retries();
+                retired_abandoned_ += planners_[i].planner.abandoned_messages();
+                planners_.erase(planners_.begin() + static_cast<ptrdiff_t>(i));
+                return;
+            }
+        }
+    }
+
+    void handle_response(const uint8_t* data, size_t len) {
+        Header header;
+        if (!HeaderParser::parse(data, len, header) || header.message_count == 0 ||
+            HeaderParser::is_end_of_session(header)) {
+            return;
+        }
+        responses_received_.fetch_add(1, std::memory_order_relaxed);
+
+        // Only count it filled once the producer is sure to see it
+        if (!responses_.try_push(data, len)) {
+            responses_dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (SessionPlanner* p = find_planner(header.session)) {
+            p->planner.fill(header.sequence_number, header.sequence_number + header.message_count - 1);
+        }
+        messages_recovered_.fetch_add(header.message_count, std::memory_order_relaxed);
+    }
+
+    static uint64_t now_ns() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    RetransmitConfig config_;
+    int fd_ = -1;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> idle_{true};
+
+    spsc::RingBuffer<PendingGap, 1024> gaps_;     // Producer -> recovery thread
+    ResponseBuffer responses_;                    // Recovery thread -> producer
+
+    // Recovery thread only
+    std::vector<SessionPlanner> planners_;
+    uint64_t retired_retries_ = 0;
+    uint64_t retired_abandoned_ = 0;
+
+    std::atomic<uint64_t> gaps_received_{0};
+    std::atomic<uint64_t> requests_sent_{0};
+    std::atomic<uint64_t> retries_{0};
+    std::atomic<uint64_t> responses_received_{0};
+    std::atomic<uint64_t> messages_recovered_{0};
+    std::atomic<uint64_t> messages_abandoned_{0};
+    std::atomic<uint64_t> responses_dropped_{0};
+    std::atomic<uint64_t> send_errors_{0};
+};
+
+} // namespace moldudp64
+} // namespace hft
@@ -0,0 +1,280 @@
+#pragma once
+
+#include "header.hpp"
+#include "../common/types.hpp"
+#include "../common/endian.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace hft {
+namespace moldudp64 {
+
+/**
+ * Local MoldUDP64 rewinder for testing gap recovery on one box
+ *
+ * Holds a whole session's messages in memory, in wire form (2-byte
+ * big-endian length prefix per message, as in MoldUDP64 and ITCH files),
+ * and answers retransmission requests on a loopback UDP port with one
+ * downstream packet of up to max_payload bytes, like the exchange's
+ * rewinder.
+ *
+ * Load it from an ITCH file or a PCAP of the feed, or add messages
+ * directly. build_packet() also produces the live stream, so a benchmark
+ * can replay it with injected loss and recover from the same data.
+ */
+class Rewinder {
+public:
+    static constexpr size_t DEFAULT_MAX_PAYLOAD = 1400;   // Fits a 1500-byte MTU
+
+    explicit Rewinder(const char* session = "REWINDER") {
+        std::memset(session_.data(), ' ', session_.size());
+        std::memcpy(session_.data(), session, std::min(std::strlen(session), session_.size()));
+    }
+
+    ~Rewinder() { stop(); }
+
+    Rewinder(const Rewinder&) = delete;
+    Rewinder& operator=(const Rewinder&) = delete;
+
+    // Append the next message (sequence message_count() + 1)
+    void add_message(const uint8_t* data, uint16_t length) {
+        offsets_.push_back(blocks_.size());
+        blocks_.push_back(static_cast<uint8_t>(length >> 8));
+        blocks_.push_back(static_cast<uint8_t>(length & 0xFF));
+        blocks_.insert(blocks_.end(), data, data + length);
+    }
+
+    /**
+     * Load an ITCH 5.0 file (length-prefixed messages)
+     * Returns false if the file cannot be read
+     */
+    bool load_itch_file(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        uint8_t prefix[2];
+        std::vector<uint8_t> message;
+        while (file.read(reinterpret_cast<char*>(prefix), 2)) {
+            const uint16_t length = endian::read_be16(prefix);
+            message.resize(length);
+            if (!file.read(reinterpret_cast<char*>(message.data()), length)) {
+                break;
+            }
+            add_message(message.data(), length);
+        }
+        return true;
+    }
+
+    /**
+     * Load a PCAP of the MoldUDP64 feed (Ethernet/IPv4/UDP)
+     * Takes the session id from the first packet; packets are added in
+     * sequence order and repeats (e.g. the B line) are skipped
+     */
+    bool load_pcap_file(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        uint8_t global_header[24];
+        if (!file.read(reinterpret_cast<char*>(global_header), sizeof(global_header))) {
+            return false;
+        }
+        uint32_t magic;
+        std::memcpy(&magic, global_header, 4);
+        const bool swap_bytes = magic == 0xd4c3b2a1;
+        if (!swap_bytes && magic != 0xa1b2c3d4) {
+            return false;
+        }
+
+        bool have_session = false;
+        uint8_t record_header[16];
+        std::vector<uint8_t> frame;
+        while (file.read(reinterpret_cast<char*>(record_header), sizeof(record_header))) {
+            uint32_t incl_len;
+            std::memcpy(&incl_len, record_header + 8, 4);
+            if (swap_bytes) {
+                incl_len = __builtin_bswap32(incl_len);
+            }
+            frame.resize(incl_len);
+            if (!file.read(reinterpret_cast<char*>(frame.data()), incl_len)) {
+                break;
+            }
+
+            // Ethernet (14) / IPv4 (IHL) / UDP (8)
+            if (incl_len < 14 + 20 + 8 + sizeof(Header) || frame[12] != 0x08 || frame[13] != 0x00 ||
+                frame[14 + 9] != 17) {
+                continue;
+            }
+            const size_t offset = 14 + (frame[14] & 0x0F) * 4 + 8;
+            Header header;
+            if (offset > incl_len || !HeaderParser::parse(frame.data() + offset, incl_len - offset, header)) {
+                continue;
+            }
+            if (header.message_count == 0 || HeaderParser::is_end_of_session(header)) {
+                continue;
+            }
+            if (!have_session) {
+                std::memcpy(session_.data(), header.session, session_.size());
+                have_session = true;
+            }
+            add_packet(header.sequence_number, header.message_count,
+                       frame.data() + offset + sizeof(Header), incl_len - offset - sizeof(Header));
+        }
+        return true;
+    }
+
+    /**
+     * Build the downstream packet starting at first_seq: as many whole
+     * messages as fit in max_payload bytes of blocks, at most max_count
+     * Returns the message count (0 if first_seq is past the end)
+     */
+    uint16_t build_packet(SequenceNumber first_seq, uint16_t max_count, size_t max_payload,
+                          std::vector<uint8_t>& out) const {
+        out.resize(sizeof(Header));
+        std::memcpy(out.data(), session_.data(), session_.size());
+
+        uint16_t count = 0;
+        size_t begin = 0;
+        size_t end = 0;
+        if (first_seq >= 1 && first_seq <= offsets_.size()) {
+            begin = offsets_[first_seq - 1];
+            end = begin;
+            while (count < max_count && first_seq + count <= offsets_.size()) {
+                const size_t next = block_end(first_seq + count);
+                if (next - begin > max_payload && count > 0) {
+                    break;
+                }
+                end = next;
+                ++count;
+            }
+        }
+
+        const uint64_t seq_be = endian::hton64(first_seq);
+        const uint16_t count_be = endian::hton16(count);
+        std::memcpy(out.data() + 10, &seq_be, 8);
+        std::memcpy(out.data() + 18, &count_be, 2);
+        out.insert(out.end(), blocks_.begin() + static_cast<ptrdiff_t>(begin),
+                   blocks_.begin() + static_cast<ptrdiff_t>(end));
+        return count;
+    }
+
+    /**
+     * Serve requests on 127.0.0.1:port from a background thread
+     * port 0 picks a free port; see port(). Returns false on socket errors.
+     */
+    bool start(uint16_t port = 0, size_t max_payload = DEFAULT_MAX_PAYLOAD) {
+        stop();
+        fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+        if (fd_ < 0) {
+            return false;
+        }
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t addr_len = sizeof(addr);
+        if (bind(fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 ||
+            getsockname(fd_, reinterpret_cast<sockaddr*>(&addr), &addr_len) != 0) {
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+        port_ = ntohs(addr.sin_port);
+        max_payload_ = max_payload;
+
+        running_.store(true, std::memory_order_release);
+        thread_ = std::thread([this] { serve(); });
+        return true;
+    }
+
+    void stop() {
+        running_.store(false, std::memory_order_release);
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    uint16_t port() const { return port_; }
+    size_t message_count() const { return offsets_.size(); }
+    const std::array<char, 10>& session() const { return session_; }
+    uint64_t requests_served() const { return requests_served_.load(std::memory_order_relaxed); }
+
+private:
+    void add_packet(SequenceNumber seq, uint16_t count, const uint8_t* blocks, size_t length) {
+        size_t offset = 0;
+        for (uint16_t i = 0; i < count && offset + 2 <= length; ++i) {
+            const uint16_t msg_len = endian::read_be16(blocks + offset);
+            if (offset + 2 + msg_len > length) {
+                break;
+            }
+            // Only the next missing message extends the store
+            if (seq + i == offsets_.size() + 1) {
+                add_message(blocks + offset + 2, msg_len);
+            }
+            offset += 2 + msg_len;
+        }
+    }
+
+    // Byte offset one past message seq's block
+    size_t block_end(SequenceNumber seq) const {
+        return seq < offsets_.size() ? offsets_[seq] : blocks_.size();
+    }
+
+    void serve() {
+        uint8_t request[64];
+        std::vector<uint8_t> response;
+        while (running_.load(std::memory_order_acquire)) {
+            pollfd pfd{fd_, POLLIN, 0};
+            if (::poll(&pfd, 1, 10) <= 0) {
+                continue;
+            }
+            sockaddr_in from{};
+            socklen_t from_len = sizeof(from);
+            const ssize_t n = recvfrom(fd_, request, sizeof(request), 0,
+                                       reinterpret_cast<sockaddr*>(&from), &from_len);
+            Header header;
+            if (n <= 0 || !HeaderParser::parse(request, static_cast<size_t>(n), header) ||
+                std::memcmp(header.session, session_.data(), session_.size()) != 0) {
+                continue;
+            }
+            build_packet(header.sequence_number, header.message_count, max_payload_, response);
+            sendto(fd_, response.data(), response.size(), 0,
+                   reinterpret_cast<const sockaddr*>(&from), from_len);
+            requests_served_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    std::array<char, 10> session_;
+    std::vector<uint8_t> blocks_;     // Every message, length-prefixed
+    std::vector<size_t> offsets_;     // Block offset of sequence i + 1
+
+    int fd_ = -1;
+    uint16_t port_ = 0;
+    size_t max_payload_ = DEFAULT_MAX_PAYLOAD;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> requests_served_{0};
+};
+
+} // namespace moldudp64
+} // namespace hft
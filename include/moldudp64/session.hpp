@@ -1,28 +1,24 @@
 #pragma once
 
 #include "header.hpp"
+#include "arbiter.hpp"
+#include "gap_set.hpp"
+#include "reorder.hpp"
 #include "../common/types.hpp"
 #include "../common/endian.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <memory>
 #include <vector>
-#include <deque>
 #include <optional>
 
 namespace hft {
 namespace moldudp64 {
 
-/**
- * Gap information for retransmission requests
- */
-struct Gap {
-    SequenceNumber start;       // First missing sequence number
-    SequenceNumber end;         // Last missing sequence number (inclusive)
-    uint64_t detected_at_ns;    // When the gap was detected (for timeout)
-};
-
 /**
  * Session state
  */
@@ -43,10 +39,26 @@ enum class SessionState {
  * - Heartbeat processing
  * - Session state management
  *
+ * Outstanding gaps live in a GapSet: a retransmission or late packet
+ * trims, removes or splits them in O(log n) however many are open.
+ *
  * Architecture note:
  * Retransmission requests should be handled on a separate thread/connection
  * to avoid stalling the critical path. This class only detects gaps and
  * marks the session as stale.
+ *
+ * In-order delivery (enable_reordering):
+ * - By default packets past a gap are delivered at once and duplicates
+ *   are delivered again
+ * - With reordering on, delivery follows a cursor: packets ahead of a gap
+ *   are copied into a ReorderBuffer and released in sequence order once
+ *   the gap fills, live or through process_retransmission(); duplicates
+ *   and already-delivered prefixes are dropped
+ * - A gap that outlives the budget (slab full, or max_hold_ns) is
+ *   abandoned: its messages are counted as skipped and delivery resumes
+ *   at the next held packet
+ * - With no gap outstanding the only extra work per packet is comparing
+ *   its sequence with the cursor; the clock is read only while holding
  */
 class Session {
 public:
@@ -56,6 +68,14 @@ public:
     // Callback for each message in a packet
     using MessageCallback = std::function<void(const uint8_t* data, uint16_t length, SequenceNumber seq)>;
 
+    // Callback for the first end-of-session packet
+    using EndCallback = std::function<void(const std::array<char, 10>& session_id)>;
+
+    // Callback for a whole packet's message blocks (length-prefixed, in order)
+    // Returns the number of messages it processed
+    using PacketCallback = std::function<size_t(const uint8_t* blocks, size_t length,
+                                                uint16_t message_count, SequenceNumber first_seq)>;
+
     explicit Session(std::array<char, 10> session_id = {})
         : session_id_(session_id)
         , expected_sequence_(1)  // First sequence number is typically 1
@@ -93,11 +113,19 @@ public:
         // Handle special packet types
         if (HeaderParser::is_heartbeat(header)) {
             ++heartbeats_received_;
+            if (reorder_ && !reorder_->empty()) {
+                expire_held(now_ns());
+            }
             return true;
         }
 
         if (HeaderParser::is_end_of_session(header)) {
-            state_ = SessionState::EndOfSession;
+            if (state_ != SessionState::EndOfSession) {
+                state_ = SessionState::EndOfSession;
+                if (end_callback_) {
+                    end_callback_(session_id_);
+                }
+            }
             return true;
         }
 
@@ -109,7 +137,7 @@ public:
             gap.end = header.sequence_number - 1;
             gap.detected_at_ns = 0;  // Caller should set this
 
-            pending_gaps_.push_back(gap);
+            pending_gaps_.add(gap);
             ++gaps_detected_;
             state_ = SessionState::Stale;
 
@@ -119,41 +147,20 @@ public:
         } else if (header.sequence_number < expected_sequence_) {
             // Duplicate or old packet - could be retransmission
             // Check if this fills a gap
-            check_gap_fill(header.sequence_number,
-                          header.sequence_number + header.message_count - 1);
+            pending_gaps_.fill(header.sequence_number,
+                               header.sequence_number + header.message_count - 1);
 
             // Still process the messages (might be retransmission)
         }
 
         // Process messages in the packet
-        if (message_callback_) {
-            size_t offset = HeaderParser::get_messages_offset();
-            SequenceNumber current_seq = header.sequence_number;
-
-            for (uint16_t i = 0; i < header.message_count; ++i) {
-                if (offset + sizeof(MessageBlock) > len) {
-                    // Truncated packet
-                    break;
-                }
-
-                uint16_t msg_len = HeaderParser::read_message_length(data + offset);
-                offset += sizeof(MessageBlock);
-
-                if (offset + msg_len > len) {
-                    // Message extends past packet boundary
-                    break;
-                }
-
-                // Invoke callback with message data
-                message_callback_(data + offset, msg_len, current_seq);
-                ++messages_received_;
-
-                offset += msg_len;
-                ++current_seq;
-            }
+        const size_t offset = HeaderParser::get_messages_offset();
+        if (reorder_) {
+            deliver_in_order(header.sequence_number, data + offset, len - offset,
+                             header.message_count, true);
         } else {
-            // Just count messages without processing
-            messages_received_ += header.message_count;
+            messages_received_ += deliver(header.sequence_number, data + offset, len - offset,
+                                          header.message_count);
         }
 
         // Update expected sequence number
@@ -173,26 +180,19 @@ public:
     /**
      * Process retransmission response
      * This should be called when gap-fill data arrives
+     *
+     * A response can cover messages that already arrived (a coalesced
+     * request spans the packets between its gaps, and a late answer to a
+     * re-request repeats one); only those still missing are delivered.
      */
     void process_retransmission(SequenceNumber start_seq, const uint8_t* data, size_t len,
                                 uint16_t message_count) {
-        check_gap_fill(start_seq, start_seq + message_count - 1);
-
         // Process the retransmitted messages
-        if (message_callback_) {
-            size_t offset = 0;
-            SequenceNumber current_seq = start_seq;
-
-            for (uint16_t i = 0; i < message_count && offset < len; ++i) {
-                uint16_t msg_len = HeaderParser::read_message_length(data + offset);
-                offset += sizeof(MessageBlock);
-
-                if (offset + msg_len > len) break;
-
-                message_callback_(data + offset, msg_len, current_seq);
-                offset += msg_len;
-                ++current_seq;
-            }
+        if (reorder_) {
+            pending_gaps_.fill(start_seq, start_seq + message_count - 1);
+            deliver_in_order(start_seq, data, len, message_count, false);
+        } else {
+            deliver_missing(start_seq, data, len, message_count);
         }
 
         // Check if session can transition back to active
@@ -204,12 +204,44 @@ public:
     // Set callbacks
     void set_gap_callback(GapCallback cb) { gap_callback_ = std::move(cb); }
     void set_message_callback(MessageCallback cb) { message_callback_ = std::move(cb); }
+    void set_end_callback(EndCallback cb) { end_callback_ = std::move(cb); }
+
+    // Packet-level delivery; takes precedence over the per-message callback
+    void set_packet_callback(PacketCallback cb) { packet_callback_ = std::move(cb); }
+
+    /**
+     * Deliver strictly in sequence order, holding packets across gaps
+     * Call before the first packet; allocates the reorder slab
+     */
+    void enable_reordering(const ReorderConfig& config = {}) {
+        reorder_config_ = config;
+        reorder_ = std::make_unique<ReorderBuffer>(config.max_packets);
+    }
+
+    /**
+     * Abandon a gap whose hold budget has run out (reordering only)
+     * process_packet checks this itself; call it from a timer too if the
+     * line can go quiet while packets are held
+     */
+    void expire_held(uint64_t now_ns) {
+        if (reorder_ && !reorder_->empty() &&
+            now_ns >= reorder_->front().arrival_ns + reorder_config_.max_hold_ns) {
+            skip_to_held();
+            release_held();
+        }
+    }
 
     // Getters
     SessionState get_state() const { return state_; }
+    const std::array<char, 10>& get_session_id() const { return session_id_; }
     SequenceNumber get_expected_sequence() const { return expected_sequence_; }
-    const std::vector<Gap>& get_pending_gaps() const { return pending_gaps_; }
+
+    // Next sequence to hand to the callbacks (reordering only)
+    SequenceNumber get_delivery_sequence() const { return delivery_sequence_; }
+    size_t held_packets() const { return reorder_ ? reorder_->size() : 0; }
+    const GapSet& get_pending_gaps() const { return pending_gaps_; }
     bool has_gaps() const { return !pending_gaps_.empty(); }
+    bool is_missing(SequenceNumber seq) const { return pending_gaps_.is_missing(seq); }
 
     // Statistics
     struct Stats {
@@ -217,10 +249,17 @@ public:
         uint64_t messages_received;
         uint64_t gaps_detected;
         uint64_t heartbeats_received;
+        uint64_t packets_held = 0;        // Buffered behind a gap (reordering)
+        uint64_t duplicates_dropped = 0;  // Packets already fully delivered
+        uint64_t gaps_abandoned = 0;      // Hold budget ran out
+        uint64_t messages_skipped = 0;    // Lost with abandoned gaps
+        uint64_t gap_overflows = 0;       // Gaps widened: GapSet full
     };
 
     Stats get_stats() const {
-        return {packets_received_, messages_received_, gaps_detected_, heartbeats_received_};
+        return {packets_received_, messages_received_, gaps_detected_, heartbeats_received_,
+                packets_held_, duplicates_dropped_, gaps_abandoned_, messages_skipped_,
+                pending_gaps_.overflows()};
     }
 
     // Reset session state (for reuse)
@@ -232,6 +271,14 @@ public:
         messages_received_ = 0;
         gaps_detected_ = 0;
         heartbeats_received_ = 0;
+        delivery_sequence_ = 1;
+        packets_held_ = 0;
+        duplicates_dropped_ = 0;
+        gaps_abandoned_ = 0;
+        messages_skipped_ = 0;
+        if (reorder_) {
+            reorder_->clear();
+        }
     }
 
     // Check if session is healthy (no gaps)
@@ -240,80 +287,584 @@ public:
     }
 
 private:
-    void check_gap_fill(SequenceNumber start, SequenceNumber end) {
-        // Check if this range fills any pending gaps
-        for (auto it = pending_gaps_.begin(); it != pending_gaps_.end(); ) {
-            if (start <= it->start && end >= it->end) {
-                // Gap completely filled
-                it = pending_gaps_.erase(it);
-            } else if (start <= it->start && end >= it->start) {
-                // Gap partially filled from the start
-                it->start = end + 1;
-                if (it->start > it->end) {
-                    it = pending_gaps_.erase(it);
-                } else {
-                    ++it;
-                }
-            } else if (start <= it->end && end >= it->end) {
-                // Gap partially filled from the end
-                it->end = start - 1;
-                if (it->start > it->end) {
-                    it = pending_gaps_.erase(it);
-                } else {
-                    ++it;
+    /**
+     * Hand message blocks to the packet or message callback
+     * Returns the number of messages delivered
+     */
+    size_t deliver(SequenceNumber first_seq, const uint8_t* blocks, size_t len, uint16_t count) {
+        if (packet_callback_) {
+            // One call for the whole packet; the callee walks the blocks
+            return packet_callback_(blocks, len, count, first_seq);
+        }
+        if (!message_callback_) {
+            // Just count messages without processing
+            return count;
+        }
+
+        size_t offset = 0;
+        SequenceNumber current_seq = first_seq;
+        size_t delivered = 0;
+        for (uint16_t i = 0; i < count; ++i) {
+            if (offset + sizeof(MessageBlock) > len) {
+                // Truncated packet
+                break;
+            }
+
+            uint16_t msg_len = HeaderParser::read_message_length(blocks + offset);
+            offset += sizeof(MessageBlock);
+
+            if (offset + msg_len > len) {
+                // Message extends past packet boundary
+                break;
+            }
+
+            // Invoke callback with message data
+            message_callback_(blocks + offset, msg_len, current_seq);
+            ++delivered;
+
+            offset += msg_len;
+            ++current_seq;
+        }
+        return delivered;
+    }
+
+    /**
+     * Deliver the messages of a packet that are still in a pending gap, in
+     * runs, then mark the packet's range received
+     * Returns the number of messages delivered
+     */
+    size_t deliver_missing(SequenceNumber first_seq, const uint8_t* blocks, size_t len, uint16_t count) {
+        size_t delivered = 0;
+        size_t offset = 0;
+        size_t run_offset = 0;
+        uint16_t run_count = 0;
+        SequenceNumber seq = first_seq;
+        for (uint16_t i = 0; i < count && offset + sizeof(MessageBlock) <= len; ++i, ++seq) {
+            if (pending_gaps_.is_missing(seq)) {
+                if (run_count == 0) {
+                    run_offset = offset;
                 }
-            } else {
-                ++it;
+                ++run_count;
+            } else if (run_count > 0) {
+                delivered += deliver(seq - run_count, blocks + run_offset, offset - run_offset, run_count);
+                run_count = 0;
             }
+            offset += sizeof(MessageBlock) + HeaderParser::read_message_length(blocks + offset);
+            offset = std::min(offset, len);
+        }
+        if (run_count > 0) {
+            delivered += deliver(seq - run_count, blocks + run_offset, offset - run_offset, run_count);
         }
+
+        pending_gaps_.fill(first_seq, first_seq + count - 1);
+        return delivered;
+    }
+
+    // Deliver the messages of a packet from delivery_sequence_ on, skipping
+    // a prefix that was already delivered
+    void deliver_from_cursor(SequenceNumber first_seq, const uint8_t* blocks, size_t len,
+                             uint16_t count, bool live) {
+        size_t offset = 0;
+        uint16_t skip = static_cast<uint16_t>(delivery_sequence_ - first_seq);
+        for (uint16_t i = 0; i < skip && offset + sizeof(MessageBlock) <= len; ++i) {
+            offset += sizeof(MessageBlock) + HeaderParser::read_message_length(blocks + offset);
+        }
+        if (offset > len) {
+            offset = len;
+        }
+
+        const size_t delivered = deliver(delivery_sequence_, blocks + offset, len - offset,
+                                         static_cast<uint16_t>(count - skip));
+        if (live) {
+            messages_received_ += delivered;
+        }
+        delivery_sequence_ = first_seq + count;
+    }
+
+    // Reordering path for live packets and retransmissions
+    void deliver_in_order(SequenceNumber first_seq, const uint8_t* blocks, size_t len,
+                          uint16_t count, bool live) {
+        const SequenceNumber end = first_seq + count;
+
+        // Steady state: the next packet, nothing held
+        if (first_seq == delivery_sequence_ && reorder_->empty()) {
+            deliver_from_cursor(first_seq, blocks, len, count, live);
+            return;
+        }
+
+        if (end <= delivery_sequence_) {
+            ++duplicates_dropped_;
+            return;
+        }
+
+        if (first_seq <= delivery_sequence_) {
+            // Fills the gap at the cursor
+            deliver_from_cursor(first_seq, blocks, len, count, live);
+            release_held();
+            if (reorder_->empty()) {
+                return;
+            }
+            expire_held(now_ns());
+        } else {
+            // One clock read for both the arrival stamp and the expiry check
+            const uint64_t now = now_ns();
+            hold(first_seq, blocks, len, count, live, now);
+            expire_held(now);
+        }
+    }
+
+    // Buffer a packet ahead of the cursor, abandoning gaps if the slab is full
+    void hold(SequenceNumber first_seq, const uint8_t* blocks, size_t len, uint16_t count,
+              bool live, uint64_t now) {
+        while (true) {
+            switch (reorder_->hold(first_seq, blocks, len, count, now)) {
+                case ReorderBuffer::HoldResult::Held:
+                    ++packets_held_;
+                    return;
+                case ReorderBuffer::HoldResult::Duplicate:
+                    ++duplicates_dropped_;
+                    return;
+                case ReorderBuffer::HoldResult::Full:
+                    if (reorder_->empty()) {
+                        // No slots at all (max_packets == 0): nothing to
+                        // give up but this gap
+                        abandon_until(first_seq);
+                        deliver_from_cursor(first_seq, blocks, len, count, live);
+                        return;
+                    }
+                    // Over budget: give up on the oldest gap and retry
+                    skip_to_held();
+                    release_held();
+                    if (first_seq <= delivery_sequence_) {
+                        deliver_in_order(first_seq, blocks, len, count, live);
+                        return;
+                    }
+                    break;
+                case ReorderBuffer::HoldResult::TooLarge:
+                    // Cannot buffer it: skip straight to it
+                    abandon_until(first_seq);
+                    deliver_from_cursor(first_seq, blocks, len, count, live);
+                    release_held();
+                    return;
+            }
+        }
+    }
+
+    // Release held packets that are now contiguous with the cursor
+    // (counted as live; a retransmission is only held if it overtook the gap fill)
+    void release_held() {
+        while (!reorder_->empty()) {
+            const ReorderBuffer::Slot& slot = reorder_->front();
+            if (slot.first_seq > delivery_sequence_) {
+                break;
+            }
+            if (slot.end_seq() > delivery_sequence_) {
+                deliver_from_cursor(slot.first_seq, slot.data, slot.length, slot.message_count, true);
+            }
+            reorder_->pop_front();
+        }
+    }
+
+    // Abandon the gap in front of the oldest held packet
+    void skip_to_held() {
+        if (!reorder_->empty()) {
+            abandon_until(reorder_->front().first_seq);
+        }
+    }
+
+    void abandon_until(SequenceNumber seq) {
+        if (seq <= delivery_sequence_) {
+            return;
+        }
+        messages_skipped_ += seq - delivery_sequence_;
+        ++gaps_abandoned_;
+        pending_gaps_.fill(delivery_sequence_, seq - 1);
+        delivery_sequence_ = seq;
+        if (state_ == SessionState::Stale && pending_gaps_.empty()) {
+            state_ = SessionState::Active;
+        }
+    }
+
+    static uint64_t now_ns() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
     }
 
     std::array<char, 10> session_id_;
     SequenceNumber expected_sequence_;
     SessionState state_;
-    std::vector<Gap> pending_gaps_;
+    GapSet pending_gaps_;
 
     // Statistics
     uint64_t packets_received_;
     uint64_t messages_received_;
     uint64_t gaps_detected_;
     uint64_t heartbeats_received_;
+    uint64_t packets_held_ = 0;
+    uint64_t duplicates_dropped_ = 0;
+    uint64_t gaps_abandoned_ = 0;
+    uint64_t messages_skipped_ = 0;
+
+    // In-order delivery (null unless enable_reordering was called)
+    std::unique_ptr<ReorderBuffer> reorder_;
+    ReorderConfig reorder_config_;
+    SequenceNumber delivery_sequence_ = 1;
 
     // Callbacks
     GapCallback gap_callback_;
     MessageCallback message_callback_;
+    EndCallback end_callback_;
+    PacketCallback packet_callback_;
+};
+
+/**
+ * A MoldUDP64 session id packed into two integers
+ * Compared and hashed without touching it as a string
+ */
+struct SessionKey {
+    uint64_t high = 0;  // Bytes 0-7
+    uint16_t low = 0;   // Bytes 8-9
+
+    static SessionKey from(const void* id) {
+        SessionKey key;
+        std::memcpy(&key.high, id, 8);
+        std::memcpy(&key.low, static_cast<const uint8_t*>(id) + 8, 2);
+        return key;
+    }
+
+    static SessionKey from(const std::array<char, 10>& id) { return from(id.data()); }
+
+    // One branch: both halves are folded before the test
+    bool operator==(const SessionKey& other) const {
+        return ((high ^ other.high) | static_cast<uint64_t>(low ^ other.low)) == 0;
+    }
+    bool operator!=(const SessionKey& other) const { return !(*this == other); }
+
+    // Multiplicative hash; take the top bits
+    uint64_t hash() const {
+        return (high ^ (static_cast<uint64_t>(low) << 48) ^ (static_cast<uint64_t>(low) >> 3))
+               * 0x9E3779B97F4A7C15ULL;
+    }
 };
 
 /**
  * Multi-session manager for handling multiple MoldUDP64 streams
+ *
+ * Each session id (one per channel, and a new one at every rollover) gets
+ * its own Session, so sequence tracking, gaps and reordering never mix.
+ * - Sessions live in a fixed slab of slots, each aligned to its own cache
+ *   lines so one stream's counters never share a line with another's
+ * - Every slot is constructed up front; a new session id takes a free
+ *   slot with a reset(), so rollover allocates nothing on the packet path
+ * - Ids are looked up as packed integers in an open-addressed table
+ * - route() first compares against the session of the previous packet:
+ *   on a single stream, or a burst from one channel, that is the only
+ *   branch taken
+ *
+ * When every slot is in use, a new id evicts the session that was least
+ * recently switched to. configure() applies callbacks and reordering to
+ * every slot, used or not, so call it before the first packet.
+ *
+ * With enable_arbitration() each slot also owns a LineArbiter, so the A/B
+ * copies of interleaved channels are deduplicated against their own
+ * session's window. A slot taken by a new session restarts its arbiter in
+ * O(1).
  */
 class SessionManager {
 public:
+    static constexpr size_t DEFAULT_MAX_SESSIONS = 8;
+
+    struct Stats {
+        uint64_t sessions_created;  // Including the first
+        uint64_t switches;          // Packets for a different session than the last
+        uint64_t evictions;         // Sessions dropped to make room
+        uint64_t invalid_packets;   // Too short to carry a session id
+    };
+
+    // Called with a session about to be dropped for a new one
+    using EvictCallback = std::function<void(const Session&)>;
+
+    explicit SessionManager(size_t max_sessions = DEFAULT_MAX_SESSIONS)
+        : max_sessions_(max_sessions ? max_sessions : 1)
+        , slots_(std::make_unique<Slot[]>(max_sessions_)) {
+        size_t buckets = 4;
+        while (buckets < max_sessions_ * 2) {
+            buckets <<= 1;
+        }
+        buckets_.assign(buckets, Bucket{});
+        mask_ = buckets - 1;
+        shift_ = 64;
+        for (size_t b = buckets; b > 1; b >>= 1) {
+            --shift_;
+        }
+    }
+
+    SessionManager(const SessionManager&) = delete;
+    SessionManager& operator=(const SessionManager&) = delete;
+
+    /**
+     * Session for a MoldUDP64 packet (header onward), created on first sight
+     * Returns nullptr only if the packet is too short for a session id
+     */
+    Session* route(const uint8_t* data, size_t len) {
+        if (len < sizeof(Header)) {
+            ++invalid_packets_;
+            return nullptr;
+        }
+        const SessionKey key = SessionKey::from(data);
+        if (current_ && key == current_key_) {
+            return &current_->session;
+        }
+        return &switch_to(key);
+    }
+
+    /**
+     * Route a packet to its session and process it there
+     */
+    bool process_packet(const uint8_t* data, size_t len) {
+        Session* session = route(data, len);
+        return session && session->process_packet(data, len);
+    }
+
     // Get or create session by session ID
     Session& get_session(const std::array<char, 10>& session_id) {
-        // For simplicity, we use a single session
-        // In production, you'd want to track multiple sessions
-        (void)session_id;  // Suppress unused warning
+        return switch_to(SessionKey::from(session_id));
+    }
+
+    // Existing session, or nullptr
+    Session* find(const std::array<char, 10>& session_id) {
+        const uint32_t slot = lookup(SessionKey::from(session_id));
+        return slot == EMPTY ? nullptr : &slots_[slot].session;
+    }
+
+    /**
+     * The session the last packet went to (the first slot before any)
+     */
+    Session& current() { return current_ ? current_->session : slots_[0].session; }
+    const Session& current() const { return current_ ? current_->session : slots_[0].session; }
+
+    /**
+     * Give every slot its own A/B line arbiter (allocated here, once)
+     * window: messages of history per session
+     */
+    void enable_arbitration(size_t window = LineArbiter::DEFAULT_WINDOW) {
+        for (size_t i = 0; i < max_sessions_; ++i) {
+            slots_[i].arbiter = std::make_unique<LineArbiter>(window);
+        }
+    }
+
+    bool arbitration_enabled() const { return slots_[0].arbiter != nullptr; }
+
+    // Arbiter of the session the last packet was routed to (nullptr if off)
+    LineArbiter* current_arbiter() { return current_ ? current_->arbiter.get() : nullptr; }
+    const LineArbiter* current_arbiter() const { return current_ ? current_->arbiter.get() : nullptr; }
+
+    /**
+     * One line's arbitration counters summed over every slot, including
+     * sessions since evicted; skew_max_ns is the largest seen
+     */
+    LineArbiter::LineStats get_line_stats(Line line) const {
+        LineArbiter::LineStats total;
+        for (size_t i = 0; i < max_sessions_; ++i) {
+            if (!slots_[i].arbiter) {
+                continue;
+            }
+            const LineArbiter::LineStats& s = slots_[i].arbiter->stats(line);
+            total.packets += s.packets;
+            total.wins += s.wins;
+            total.gap_fills += s.gap_fills;
+            total.duplicates += s.duplicates;
+            total.stale += s.stale;
+            total.missed_messages += s.missed_messages;
+            total.skew_samples += s.skew_samples;
+            total.skew_total_ns += s.skew_total_ns;
+            total.skew_max_ns = std::max(total.skew_max_ns, s.skew_max_ns);
+        }
+        return total;
+    }
+
+    void set_evict_callback(EvictCallback cb) { evict_callback_ = std::move(cb); }
 
-        if (sessions_.empty()) {
-            sessions_.emplace_back(session_id);
+    /**
+     * Apply fn(Session&) to every slot, in use or not
+     */
+    template<typename Fn>
+    void configure(Fn&& fn) {
+        for (size_t i = 0; i < max_sessions_; ++i) {
+            fn(slots_[i].session);
+        }
+    }
+
+    // Apply fn(const Session&) to the sessions in use
+    template<typename Fn>
+    void for_each_session(Fn&& fn) const {
+        for (size_t i = 0; i < max_sessions_; ++i) {
+            if (slots_[i].live) {
+                fn(slots_[i].session);
+            }
         }
-        return sessions_.back();
     }
 
     // Get all sessions with gaps (for monitoring)
     std::vector<const Session*> get_stale_sessions() const {
         std::vector<const Session*> stale;
-        for (const auto& session : sessions_) {
+        for_each_session([&](const Session& session) {
             if (session.get_state() == SessionState::Stale) {
                 stale.push_back(&session);
             }
-        }
+        });
         return stale;
     }
 
+    bool has_gaps() const {
+        bool gaps = false;
+        for_each_session([&](const Session& session) { gaps |= session.has_gaps(); });
+        return gaps;
+    }
+
+    // Counters summed over the sessions in use
+    Session::Stats get_session_stats() const {
+        Session::Stats total{0, 0, 0, 0};
+        for_each_session([&](const Session& session) {
+            const Session::Stats s = session.get_stats();
+            total.packets_received += s.packets_received;
+            total.messages_received += s.messages_received;
+            total.gaps_detected += s.gaps_detected;
+            total.heartbeats_received += s.heartbeats_received;
+            total.packets_held += s.packets_held;
+            total.duplicates_dropped += s.duplicates_dropped;
+            total.gaps_abandoned += s.gaps_abandoned;
+            total.messages_skipped += s.messages_skipped;
+            total.gap_overflows += s.gap_overflows;
+        });
+        return total;
+    }
+
+    Stats get_stats() const { return {sessions_created_, switches_, evictions_, invalid_packets_}; }
+
+    size_t size() const { return live_count_; }
+    size_t capacity() const { return max_sessions_; }
+
 private:
-    std::deque<Session> sessions_;
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+
+    // One session per slot, never sharing a cache line with its neighbours
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        Session session;
+        std::unique_ptr<LineArbiter> arbiter;   // Only with enable_arbitration
+        SessionKey key;
+        uint64_t last_switch = 0;   // switches_ when it last became current
+        bool live = false;
+    };
+
+    struct Bucket {
+        SessionKey key;
+        uint32_t slot = EMPTY;
+    };
+
+    // Off the common path: a packet for a different session than the last
+    Session& switch_to(const SessionKey& key) {
+        uint32_t slot = lookup(key);
+        if (slot == EMPTY) {
+            slot = claim_slot();
+            Slot& s = slots_[slot];
+            s.session.reset();
+            if (s.arbiter) {
+                s.arbiter->restart();
+            }
+            s.key = key;
+            s.live = true;
+            ++live_count_;
+            ++sessions_created_;
+            insert(key, slot);
+        }
+        Slot& s = slots_[slot];
+        if (&s != current_) {
+            ++switches_;
+            s.last_switch = switches_;
+            current_ = &s;
+            current_key_ = key;
+        }
+        return s.session;
+    }
+
+    uint32_t lookup(const SessionKey& key) const {
+        for (size_t b = key.hash() >> shift_; ; b = (b + 1) & mask_) {
+            const Bucket& bucket = buckets_[b];
+            if (bucket.slot == EMPTY || bucket.key == key) {
+                return bucket.slot;
+            }
+        }
+    }
+
+    void insert(const SessionKey& key, uint32_t slot) {
+        size_t b = key.hash() >> shift_;
+        while (buckets_[b].slot != EMPTY) {
+            b = (b + 1) & mask_;
+        }
+        buckets_[b] = Bucket{key, slot};
+    }
+
+    // Backward-shift deletion keeps every probe chain unbroken
+    void erase(const SessionKey& key) {
+        size_t b = key.hash() >> shift_;
+        while (!(buckets_[b].key == key)) {
+            b = (b + 1) & mask_;
+        }
+        size_t hole = b;
+        for (size_t next = (hole + 1) & mask_; buckets_[next].slot != EMPTY; next = (next + 1) & mask_) {
+            const size_t home = buckets_[next].key.hash() >> shift_;
+            // Move it back unless its home lies cyclically in (hole, next]
+            if (((next - home) & mask_) >= ((next - hole) & mask_)) {
+                buckets_[hole] = buckets_[next];
+                hole = next;
+            }
+        }
+        buckets_[hole] = Bucket{};
+    }
+
+    // A free slot, or the least recently switched-to session's
+    uint32_t claim_slot() {
+        uint32_t victim = 0;
+        for (uint32_t i = 0; i < max_sessions_; ++i) {
+            if (!slots_[i].live) {
+                return i;
+            }
+            if (slots_[i].last_switch < slots_[victim].last_switch) {
+                victim = i;
+            }
+        }
+        if (evict_callback_) {
+            evict_callback_(slots_[victim].session);
+        }
+        erase(slots_[victim].key);
+        slots_[victim].live = false;
+        --live_count_;
+        ++evictions_;
+        if (current_ == &slots_[victim]) {
+            current_ = nullptr;
+        }
+        return victim;
+    }
+
+    // Hot: read on every packet
+    Slot* current_ = nullptr;
+    SessionKey current_key_;
+
+    size_t max_sessions_;
+    std::unique_ptr<Slot[]> slots_;
+    std::vector<Bucket> buckets_;
+    size_t mask_ = 0;
+    unsigned shift_ = 64;
+    size_t live_count_ = 0;
+
+    // Statistics
+    uint64_t sessions_created_ = 0;
+    uint64_t switches_ = 0;
+    uint64_t evictions_ = 0;
+    uint64_t invalid_packets_ = 0;
+
+    EvictCallback evict_callback_;
 };
 
 } // namespace moldudp64
@@ -0,0 +1,285 @@
+#pragma once
+
+#include "../common/types.hpp"
+
+#include <atomic>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace hft {
+namespace spsc {
+
+/**
+ * Single-Producer Multi-Consumer Broadcast Ring (disruptor-style)
+ *
+ * One writer publishes a sequence of items; every registered consumer
+ * sees every item, each at its own pace. Unlike RingBuffer an item is
+ * not removed by reading it: a slot is reused only when the producer
+ * laps it.
+ *
+ * Sequencing:
+ * - published_ counts items published (release store by the producer)
+ * - Each consumer owns a cursor on its own cache line: the sequence of
+ *   the next item it will read
+ * - Item s lives in slot s & (Capacity - 1)
+ *
+ * Overflow modes:
+ * - Gated: the producer may not run more than Capacity items ahead of
+ *   the slowest registered consumer. It caches that minimum and only
+ *   rescans the cursors when the cached value says full, like
+ *   RingBuffer's cached tail.
+ * - Overwrite: the producer never waits. A consumer that falls more than
+ *   Capacity behind is flagged (try_read returns Lagged), its overrun
+ *   count is bumped by the items it lost and it resumes at the oldest
+ *   item still in the ring. The producer announces each slot in claimed_
+ *   before writing it, so a reader can tell when a copy raced with a
+ *   write (seqlock-style) and discard it.
+ *
+ * Consumers should be registered before the producer starts; a consumer
+ * added later joins at the current head.
+ */
+template <typename T, size_t Capacity, size_t MaxConsumers = 8>
+class BroadcastRing {
+    static_assert(Capacity > 0, "Capacity must be positive");
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+    static_assert(MaxConsumers > 0, "Need at least one consumer slot");
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable for lock-free operations");
+
+public:
+    enum class Mode : uint8_t {
+        Gated,      // Producer waits for the slowest consumer
+        Overwrite   // Producer never waits; lagging consumers are flagged
+    };
+
+    enum class ReadResult : uint8_t {
+        Ok,
+        Empty,      // Nothing new
+        Lagged      // Items were overwritten before this consumer read them
+    };
+
+    static constexpr size_t INVALID_CONSUMER = static_cast<size_t>(-1);
+
+    explicit BroadcastRing(Mode mode = Mode::Gated)
+        : mode_(mode) {
+        for (size_t i = 0; i < Capacity; ++i) {
+            new (&buffer_[i]) T{};
+        }
+    }
+
+    // Non-copyable and non-movable (contains atomics)
+    BroadcastRing(const BroadcastRing&) = delete;
+    BroadcastRing& operator=(const BroadcastRing&) = delete;
+    BroadcastRing(BroadcastRing&&) = delete;
+    BroadcastRing& operator=(BroadcastRing&&) = delete;
+
+    /**
+     * Register a consumer, starting at the current head
+     * Returns its id, or INVALID_CONSUMER if all slots are taken
+     */
+    size_t add_consumer() noexcept {
+        for (size_t id = 0; id < MaxConsumers; ++id) {
+            ConsumerCursor& c = consumers_[id];
+            bool expected = false;
+            if (c.active.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                const uint64_t head = published_.load(std::memory_order_acquire);
+                c.cursor.store(head, std::memory_order_release);
+                c.cached_published = head;
+                c.overruns.store(0, std::memory_order_relaxed);
+                return id;
+            }
+        }
+        return INVALID_CONSUMER;
+    }
+
+    /**
+     * Unregister a consumer; the producer stops gating on it
+     */
+    void remove_consumer(size_t id) noexcept {
+        consumers_[id].active.store(false, std::memory_order_release);
+    }
+
+    /**
+     * Reserve the slot for the next item (Producer only)
+     * Returns nullptr in Gated mode if the slowest consumer is Capacity
+     * items behind; never fails in Overwrite mode
+     */
+    T* try_claim() noexcept {
+        const uint64_t seq = write_seq_;
+
+        if (mode_ == Mode::Gated) {
+            if (seq - cached_gate_ >= Capacity) {
+                cached_gate_ = min_cursor(seq);
+                if (seq - cached_gate_ >= Capacity) {
+                    return nullptr;  // Slowest consumer still needs this slot
+                }
+            }
+        } else {
+            // Announce the write before touching the slot; pairs with the
+            // acquire fence in try_read
+            claimed_.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        write_seq_ = seq + 1;
+        return &buffer_[seq & (Capacity - 1)];
+    }
+
+    /**
+     * Publish every slot claimed since the last commit (Producer only)
+     */
+    void commit() noexcept {
+        published_.store(write_seq_, std::memory_order_release);
+    }
+
+    /**
+     * Copy one item in and publish it (Producer only)
+     * Returns false in Gated mode if the slowest consumer is a full ring behind
+     */
+    bool try_publish(const T& item) noexcept {
+        T* slot = try_claim();
+        if (!slot) {
+            return false;
+        }
+        *slot = item;
+        commit();
+        return true;
+    }
+
+    /**
+     * Publish, spinning until the slowest consumer makes room (Producer only)
+     */
+    void publish(const T& item) noexcept {
+        while (!try_publish(item)) {
+#if defined(__x86_64__) || defined(_M_X64)
+            __builtin_ia32_pause();
+#endif
+        }
+    }
+
+    /**
+     * Copy out the consumer's next item and advance its cursor
+     * Called only from that consumer's thread
+     */
+    ReadResult try_read(size_t id, T& out) noexcept {
+        ConsumerCursor& c = consumers_[id];
+        const uint64_t seq = c.cursor.load(std::memory_order_relaxed);
+
+        if (seq == c.cached_published) {
+            c.cached_published = published_.load(std::memory_order_acquire);
+            if (seq == c.cached_published) {
+                return ReadResult::Empty;
+            }
+        }
+
+        if (mode_ == Mode::Overwrite) {
+            if (c.cached_published - seq > Capacity) {
+                return skip_lost(c, seq);
+            }
+
+            out = buffer_[seq & (Capacity - 1)];
+
+            // If the producer has started on the item one lap ahead, the
+            // copy may be torn
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (claimed_.load(std::memory_order_relaxed) > seq + Capacity) {
+                return skip_lost(c, seq);
+            }
+        } else {
+            out = buffer_[seq & (Capacity - 1)];
+        }
+
+        c.cursor.store(seq + 1, std::memory_order_release);
+        return ReadResult::Ok;
+    }
+
+    /**
+     * Items the consumer lost to overwrites (Overwrite mode)
+     */
+    uint64_t overruns(size_t id) const noexcept {
+        return consumers_[id].overruns.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Items published so far
+     */
+    uint64_t published() const noexcept {
+        return published_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Items the consumer has yet to read (snapshot; may exceed Capacity
+     * for a lagging consumer in Overwrite mode)
+     */
+    uint64_t backlog(size_t id) const noexcept {
+        return published_.load(std::memory_order_acquire) -
+               consumers_[id].cursor.load(std::memory_order_acquire);
+    }
+
+    Mode mode() const noexcept { return mode_; }
+
+    static constexpr size_t capacity() noexcept { return Capacity; }
+    static constexpr size_t max_consumers() noexcept { return MaxConsumers; }
+
+private:
+    // One consumer's state, on its own cache line
+    struct alignas(CACHE_LINE_SIZE) ConsumerCursor {
+        std::atomic<uint64_t> cursor{0};        // Next sequence to read
+        std::atomic<bool> active{false};
+        std::atomic<uint64_t> overruns{0};      // Written by the consumer only
+        uint64_t cached_published = 0;          // Consumer's last view of published_
+    };
+
+    // Slowest active cursor, or seq itself if no consumer is registered
+    uint64_t min_cursor(uint64_t seq) const noexcept {
+        uint64_t gate = seq;
+        for (const ConsumerCursor& c : consumers_) {
+            if (c.active.load(std::memory_order_acquire)) {
+                const uint64_t cursor = c.cursor.load(std::memory_order_acquire);
+                if (cursor < gate) {
+                    gate = cursor;
+                }
+            }
+        }
+        return gate;
+    }
+
+    // Jump a lagging consumer to the oldest item that is safe to read
+    ReadResult skip_lost(ConsumerCursor& c, uint64_t seq) noexcept {
+        // Leave a one-lap margin behind the producer's newest claim
+        const uint64_t claimed = claimed_.load(std::memory_order_relaxed);
+        const uint64_t oldest = claimed > Capacity ? claimed - Capacity + 1 : 0;
+        uint64_t resume = oldest > seq ? oldest : seq + 1;
+        if (resume > c.cached_published) {
+            resume = c.cached_published;
+        }
+
+        c.overruns.store(c.overruns.load(std::memory_order_relaxed) + (resume - seq),
+                         std::memory_order_relaxed);
+        c.cursor.store(resume, std::memory_order_release);
+        return ReadResult::Lagged;
+    }
+
+    // Read-only after construction; kept off the producer's written line
+    const Mode mode_;
+
+    // Item storage
+    alignas(CACHE_LINE_SIZE) std::array<T, Capacity> buffer_;
+
+    // Published sequence (only written by producer, read by every consumer)
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> published_{0};
+
+    // Last sequence claimed + 1, written before the slot (Overwrite mode)
+    std::atomic<uint64_t> claimed_{0};
+
+    // Producer-private state on its own line
+    alignas(CACHE_LINE_SIZE) uint64_t write_seq_ = 0;
+    uint64_t cached_gate_ = 0;     // Producer's last view of the slowest cursor
+
+    std::array<ConsumerCursor, MaxConsumers> consumers_;
+};
+
+} // namespace spsc
+} // namespace hft
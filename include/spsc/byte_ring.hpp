@@ -0,0 +1,219 @@
+#pragma once
+
+#include "../common/types.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace hft {
+namespace spsc {
+
+/**
+ * Lock-Free SPSC Ring of Variable-Length Byte Records
+ *
+ * For consumers that want the original wire bytes (e.g. raw ITCH message
+ * blocks) instead of the fixed-size, lossy NormalizedMessage.
+ *
+ * Record layout:
+ * - An 8-byte RecordHeader (payload length, flags) followed by the payload
+ * - Every record starts on a cache line boundary; its footprint is the
+ *   header plus payload rounded up to CACHE_LINE_SIZE
+ * - A record never straddles the end of the buffer: if it does not fit in
+ *   the space left before the end, the producer writes a wrap marker
+ *   there and the record starts at offset 0
+ *
+ * head_ and tail_ are free-running byte positions (never masked), so
+ * used space is simply head - tail. Same synchronization as RingBuffer:
+ * release store of the owner's index, acquire load of the peer's, each
+ * side caching its last view of the peer's index.
+ *
+ * A single record may use at most half the buffer, so a wrap marker plus
+ * the record always fits once the ring drains.
+ */
+template <size_t Capacity>
+class ByteRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+    static_assert(Capacity >= 4 * CACHE_LINE_SIZE, "Capacity must hold several cache lines");
+
+public:
+    struct RecordHeader {
+        uint32_t length;    // Payload bytes
+        uint32_t flags;
+    };
+
+    static constexpr uint32_t FLAG_WRAP = 1;    // Skip to the start of the buffer
+    static constexpr size_t HEADER_SIZE = sizeof(RecordHeader);
+    static constexpr size_t MAX_RECORD_SIZE = Capacity / 2 - HEADER_SIZE;
+
+    // A record as seen by the consumer, valid until release()
+    struct Record {
+        const uint8_t* data = nullptr;
+        size_t length = 0;
+
+        explicit operator bool() const { return data != nullptr; }
+    };
+
+    ByteRing() : head_(0), write_pos_(0), cached_tail_(0), tail_(0), cached_head_(0) {}
+
+    // Non-copyable and non-movable (contains atomics)
+    ByteRing(const ByteRing&) = delete;
+    ByteRing& operator=(const ByteRing&) = delete;
+    ByteRing(ByteRing&&) = delete;
+    ByteRing& operator=(ByteRing&&) = delete;
+
+    /**
+     * Reserve a record of length payload bytes (Producer only)
+     * Returns a pointer to the payload to fill in place, nullptr if there
+     * is not enough free space (or length exceeds MAX_RECORD_SIZE)
+     *
+     * The record is invisible to the consumer until commit(); several
+     * records may be claimed before one commit() publishes them all.
+     */
+    uint8_t* try_claim(size_t length) noexcept {
+        if (length > MAX_RECORD_SIZE) {
+            return nullptr;
+        }
+
+        const size_t footprint = record_footprint(length);
+        const size_t offset = write_pos_ & (Capacity - 1);
+        const size_t skip = footprint > Capacity - offset ? Capacity - offset : 0;
+
+        if (write_pos_ + skip + footprint - cached_tail_ > Capacity) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (write_pos_ + skip + footprint - cached_tail_ > Capacity) {
+                return nullptr;  // Not enough space
+            }
+        }
+
+        if (skip != 0) {
+            header_at(offset)->length = 0;
+            header_at(offset)->flags = FLAG_WRAP;
+            write_pos_ += skip;
+        }
+
+        RecordHeader* header = header_at(write_pos_ & (Capacity - 1));
+        header->length = static_cast<uint32_t>(length);
+        header->flags = 0;
+        write_pos_ += footprint;
+        return reinterpret_cast<uint8_t*>(header) + HEADER_SIZE;
+    }
+
+    /**
+     * Publish every record claimed since the last commit (Producer only)
+     */
+    void commit() noexcept {
+        head_.store(write_pos_, std::memory_order_release);
+    }
+
+    /**
+     * Copy one record in and publish it (Producer only)
+     * Returns false if there is not enough free space
+     */
+    bool try_push(const void* data, size_t length) noexcept {
+        uint8_t* payload = try_claim(length);
+        if (!payload) {
+            return false;
+        }
+        std::memcpy(payload, data, length);
+        commit();
+        return true;
+    }
+
+    /**
+     * Oldest unread record, read in place (Consumer only)
+     * Returns an empty Record if the ring is empty
+     */
+    Record front() noexcept {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+
+        if (tail == cached_head_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail == cached_head_) {
+                return Record{};
+            }
+        }
+
+        const RecordHeader* header = header_at(tail & (Capacity - 1));
+        if (header->flags & FLAG_WRAP) {
+            // A wrap marker is always published together with the record
+            // after it, so the record at offset 0 is ready
+            tail += Capacity - (tail & (Capacity - 1));
+            tail_.store(tail, std::memory_order_release);
+            header = header_at(0);
+        }
+
+        Record record;
+        record.data = reinterpret_cast<const uint8_t*>(header) + HEADER_SIZE;
+        record.length = header->length;
+        return record;
+    }
+
+    /**
+     * Hand the record returned by front() back to the producer (Consumer only)
+     * Only valid after front() returned a record
+     */
+    void release() noexcept {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const RecordHeader* header = header_at(tail & (Capacity - 1));
+        tail_.store(tail + record_footprint(header->length), std::memory_order_release);
+    }
+
+    /**
+     * Check if the ring is empty
+     * Note: This is a snapshot - may change immediately after return
+     */
+    bool empty() const noexcept {
+        return head_.load(std::memory_order_acquire) ==
+               tail_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Bytes in use, including headers, padding and wrap markers
+     * Note: This is a snapshot - may change immediately after return
+     */
+    size_t used_bytes() const noexcept {
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        return head_.load(std::memory_order_acquire) - tail;
+    }
+
+    static constexpr size_t capacity() noexcept {
+        return Capacity;
+    }
+
+    // Buffer bytes a record of length payload bytes occupies
+    static constexpr size_t record_footprint(size_t length) noexcept {
+        return (HEADER_SIZE + length + CACHE_LINE_SIZE - 1) & ~(CACHE_LINE_SIZE - 1);
+    }
+
+private:
+    RecordHeader* header_at(size_t offset) noexcept {
+        return reinterpret_cast<RecordHeader*>(buffer_ + offset);
+    }
+
+    const RecordHeader* header_at(size_t offset) const noexcept {
+        return reinterpret_cast<const RecordHeader*>(buffer_ + offset);
+    }
+
+    // Record storage, cache-line aligned so every record start is too
+    alignas(CACHE_LINE_SIZE) uint8_t buffer_[Capacity];
+
+    // Published producer position (only written by producer)
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_;
+
+    // Next byte to claim; runs ahead of head_ by the uncommitted claims
+    size_t write_pos_;
+
+    // Producer's last view of tail_
+    size_t cached_tail_;
+
+    // Consumer position (only written by consumer)
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_;
+
+    // Consumer's last view of head_
+    size_t cached_head_;
+};
+
+} // namespace spsc
+} // namespace hft
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "../common/types.hpp"
+
+#include <atomic>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <type_traits>
+
+namespace hft {
+namespace spsc {
+
+/**
+ * Lock-Free Bounded Multi-Producer Single-Consumer Queue
+ *
+ * For merging several producer cores (RSS queues, A/B channels) into the
+ * one book-building consumer without polling a ring per producer.
+ *
+ * Per-slot sequence numbers (Vyukov's bounded queue):
+ * - Slot i starts with sequence i
+ * - A producer claims position p by CAS on enqueue_pos_ when the slot's
+ *   sequence equals p, writes the item, then stores sequence p + 1
+ *   (release): the slot is now readable at p
+ * - The consumer reads position p when the slot's sequence is p + 1,
+ *   then stores p + Capacity (release): the slot is free for the
+ *   producer one lap later
+ *
+ * Producers only contend on enqueue_pos_; a producer that claimed a slot
+ * but has not finished writing it holds up the consumer at that slot
+ * only, never the other producers. The consumer side needs no atomics
+ * beyond the slot sequences, so its read position is a plain member.
+ */
+template <typename T, size_t Capacity>
+class MpscQueue {
+    static_assert(Capacity > 1, "Capacity must be at least 2");
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable for lock-free operations");
+
+public:
+    MpscQueue() : enqueue_pos_(0), dequeue_pos_(0) {
+        for (size_t i = 0; i < Capacity; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+            new (&slots_[i].data) T{};
+        }
+    }
+
+    // Non-copyable and non-movable (contains atomics)
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+    MpscQueue(MpscQueue&&) = delete;
+    MpscQueue& operator=(MpscQueue&&) = delete;
+
+    /**
+     * Try to push an item (any producer thread)
+     * Returns true on success, false if the queue is full
+     * Lock-free: a failed CAS means another producer made progress
+     */
+    bool try_push(const T& item) noexcept {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+        while (true) {
+            Slot& slot = slots_[pos & (Capacity - 1)];
+            const size_t seq = slot.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+            if (diff == 0) {
+                // Slot is free at this lap; race the other producers for it
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.data = item;
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+                // CAS failure reloaded pos
+            } else if (diff < 0) {
+                return false;  // Consumer has not freed this slot yet: full
+            } else {
+                // Another producer took pos; catch up
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Push an item, spinning until space is available (any producer thread)
+     */
+    void push(const T& item) noexcept {
+        while (!try_push(item)) {
+#if defined(__x86_64__) || defined(_M_X64)
+            __builtin_ia32_pause();
+#endif
+        }
+    }
+
+    /**
+     * Oldest item, read in place (Consumer only)
+     * Returns nullptr if the queue is empty or the producer that claimed
+     * the next position has not finished writing it
+     */
+    const T* front() noexcept {
+        const Slot& slot = slots_[dequeue_pos_ & (Capacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1) {
+            return nullptr;
+        }
+        return &slot.data;
+    }
+
+    /**
+     * Hand the item returned by front() back to the producers (Consumer only)
+     * Only valid after front() returned non-null
+     */
+    void release() noexcept {
+        Slot& slot = slots_[dequeue_pos_ & (Capacity - 1)];
+        slot.sequence.store(dequeue_pos_ + Capacity, std::memory_order_release);
+        ++dequeue_pos_;
+    }
+
+    /**
+     * Try to pop an item (Consumer only)
+     * Returns the item on success, std::nullopt if nothing is ready
+     */
+    std::optional<T> try_pop() noexcept {
+        const T* item = front();
+        if (!item) {
+            return std::nullopt;
+        }
+        T copy = *item;
+        release();
+        return copy;
+    }
+
+    /**
+     * Pop up to max_count ready items (Consumer only)
+     * Returns number of items actually popped; stops at the first slot
+     * that is not ready
+     */
+    size_t try_pop_batch(T* items, size_t max_count) noexcept {
+        size_t popped = 0;
+        while (popped < max_count) {
+            const T* item = front();
+            if (!item) {
+                break;
+            }
+            items[popped++] = *item;
+            release();
+        }
+        return popped;
+    }
+
+    /**
+     * Check if the queue is empty
+     * Note: This is a snapshot - may change immediately after return
+     * (Consumer only: reads the consumer's position)
+     */
+    bool empty() const noexcept {
+        return enqueue_pos_.load(std::memory_order_acquire) == dequeue_pos_;
+    }
+
+    static constexpr size_t capacity() noexcept {
+        return Capacity;
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    // Slot storage
+    alignas(CACHE_LINE_SIZE) std::array<Slot, Capacity> slots_;
+
+    // Next position to claim (shared by all producers)
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueue_pos_;
+
+    // Next position to read (consumer only)
+    alignas(CACHE_LINE_SIZE) size_t dequeue_pos_;
+};
+
+} // namespace spsc
+} // namespace hft
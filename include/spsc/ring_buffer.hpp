@@ -1,10 +1,15 @@
 #pragma once
 
 #include "../common/types.hpp"
+#include "../common/huge_memory.hpp"
+#include "wait_strategy.hpp"
 
 #include <atomic>
 #include <array>
+#include <chrono>
 #include <cstddef>
+#include <cstring>
+#include <memory>
 #include <new>
 #include <type_traits>
 #include <optional>
@@ -12,6 +17,82 @@
 namespace hft {
 namespace spsc {
 
+// Capacity argument selecting storage sized at construction time
+constexpr size_t DYNAMIC_CAPACITY = 0;
+
+namespace detail {
+
+/**
+ * Slot storage for RingBuffer
+ * Compile-time capacity: in-object array, mask is a constant
+ */
+template <typename T, size_t Capacity>
+class RingSlots {
+public:
+    T& operator[](size_t index) noexcept { return slots_[index]; }
+    const T& operator[](size_t index) const noexcept { return slots_[index]; }
+    static constexpr size_t mask() noexcept { return Capacity - 1; }
+
+private:
+    std::array<T, Capacity> slots_;
+};
+
+/**
+ * Run-time capacity: hugepage-backed mapping, NUMA-bound and prefaulted
+ * (see huge_memory.hpp). Read-only after construction, so the mask can
+ * sit next to the pointer without contention.
+ */
+template <typename T>
+class RingSlots<T, DYNAMIC_CAPACITY> {
+public:
+    RingSlots(size_t capacity, const MemoryOptions& memory)
+        : memory_(capacity * sizeof(T), memory)
+        , slots_(static_cast<T*>(memory_.data()))
+        , mask_(capacity - 1) {}
+
+    T& operator[](size_t index) noexcept { return slots_[index]; }
+    const T& operator[](size_t index) const noexcept { return slots_[index]; }
+    size_t mask() const noexcept { return mask_; }
+
+    const HugePageBuffer& memory() const noexcept { return memory_; }
+
+private:
+    HugePageBuffer memory_;
+    T* slots_;
+    size_t mask_;
+};
+
+// Smallest power of 2 >= n (n >= 2)
+constexpr size_t round_up_pow2(size_t n) noexcept {
+    size_t p = 2;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+} // namespace detail
+
+/**
+ * Ring occupancy and queueing-delay snapshot
+ *
+ * produced/consumed are totals since construction; the rest is sampled
+ * and only approximate while the ring is running.
+ */
+struct RingStats {
+    uint64_t produced = 0;          // Items ever published
+    uint64_t consumed = 0;          // Items ever released back to the producer
+    uint64_t backlog = 0;           // produced - consumed at the snapshot
+    uint64_t high_water_mark = 0;   // Largest backlog the consumer has seen
+    uint64_t delay_samples = 0;     // Sampled items timed through the ring
+    uint64_t delay_total_ns = 0;    // Sum of their enqueue-to-dequeue delays
+    uint64_t delay_max_ns = 0;
+
+    double mean_delay_ns() const {
+        return delay_samples ? static_cast<double>(delay_total_ns) / delay_samples : 0.0;
+    }
+};
+
 /**
  * Lock-Free Single-Producer Single-Consumer (SPSC) Ring Buffer
  *
@@ -29,19 +110,61 @@ namespace spsc {
  * False Sharing Prevention:
  * - head_ and tail_ are on separate cache lines (64 bytes apart)
  * - This prevents cache line ping-pong between CPU cores
+ *
+ * Sequences:
+ * - head_ and tail_ are free-running 64-bit counts of items published and
+ *   released; a slot index is seq & mask. Occupancy is head_ - tail_,
+ *   and the totals double as throughput counters
+ * - One slot always stays empty (full at capacity - 1), as before
+ *
+ * Cached indices:
+ * - The producer keeps its last view of tail_ next to head_, the consumer
+ *   its last view of head_ next to tail_
+ * - The other side's index is only loaded when the cached copy says full
+ *   (producer) or empty (consumer), so in steady state each side touches
+ *   the other's cache line once per lap instead of once per item
+ *
+ * Lag metrics (stats()):
+ * - The consumer records the backlog each time it reloads head_, which
+ *   gives the high-water mark at no extra shared-memory traffic
+ * - With enable_delay_sampling(n), every n-th item is stamped when
+ *   claimed and timed when released: the queueing delay through the ring
+ *
+ * Waiting:
+ * - push()/pop() and wait_readable()/wait_writable() back off through the
+ *   WaitStrategy policy (see wait_strategy.hpp)
+ * - Publishing calls notify() on the peer's strategy only when the
+ *   strategy can park (NOTIFIES), so spinning policies add nothing to the
+ *   fast path
+ *
+ * Storage:
+ * - Capacity > 0: slots live inside the object, capacity is fixed at
+ *   compile time
+ * - Capacity == DYNAMIC_CAPACITY: capacity is given to the constructor
+ *   (rounded up to a power of 2) and slots are mapped from hugepages,
+ *   bound to a NUMA node, falling back to normal pages
  */
-template <typename T, size_t Capacity>
+template <typename T, size_t Capacity, typename WaitStrategy = SpinPauseWait>
 class RingBuffer {
-    static_assert(Capacity > 0, "Capacity must be positive");
     static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
     static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable for lock-free operations");
 
 public:
-    RingBuffer() : head_(0), tail_(0) {
-        // Zero-initialize the buffer
-        for (size_t i = 0; i < Capacity; ++i) {
-            new (&buffer_[i]) T{};
-        }
+    template <size_t C = Capacity, std::enable_if_t<C != DYNAMIC_CAPACITY, int> = 0>
+    RingBuffer() : head_(0), write_seq_(0), cached_tail_(0), tail_(0), cached_head_(0) {
+        init_slots();
+    }
+
+    /**
+     * Ring sized at run time (DYNAMIC_CAPACITY only)
+     * capacity is rounded up to a power of 2; one slot stays empty
+     * Throws std::bad_alloc if the storage cannot be mapped
+     */
+    template <size_t C = Capacity, std::enable_if_t<C == DYNAMIC_CAPACITY, int> = 0>
+    explicit RingBuffer(size_t capacity, const MemoryOptions& memory = {})
+        : buffer_(detail::round_up_pow2(capacity), memory)
+        , head_(0), write_seq_(0), cached_tail_(0), tail_(0), cached_head_(0) {
+        init_slots();
     }
 
     // Non-copyable and non-movable (contains atomics)
@@ -56,76 +179,266 @@ public:
      * Wait-free: completes in bounded number of steps
      */
     bool try_push(const T& item) noexcept {
-        const size_t current_head = head_.load(std::memory_order_relaxed);
-        const size_t next_head = increment(current_head);
-
-        // Check if buffer is full
-        // We need to load tail with acquire to synchronize with consumer's release
-        if (next_head == tail_.load(std::memory_order_acquire)) {
+        T* slot = try_claim();
+        if (!slot) {
             return false;  // Buffer is full
         }
 
-        // Write the data
-        buffer_[current_head] = item;
+        // Write the data, then publish it (and any earlier claims)
+        *slot = item;
+        commit();
+        return true;
+    }
+
+    /**
+     * Reserve the next free slot for writing in place (Producer only)
+     * Returns nullptr if buffer is full
+     *
+     * The slot still holds whatever was last written there; the caller
+     * must fill every field it cares about. Claimed slots are invisible
+     * to the consumer until commit(). Several slots may be claimed before
+     * one commit() publishes them all.
+     */
+    T* try_claim() noexcept {
+        const uint64_t seq = write_seq_;
+
+        // Check if buffer is full against the cached tail first; only
+        // reload the consumer's index (acquire, pairs with its release)
+        // when the cached copy says there is no room
+        if (seq - cached_tail_ == mask()) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (seq - cached_tail_ == mask()) {
+                return nullptr;  // Buffer is full
+            }
+        }
 
-        // Update head with release semantics
-        // This ensures the data write is visible to consumer before head update
-        head_.store(next_head, std::memory_order_release);
+        stamp_enqueue(seq, 1);
+        write_seq_ = seq + 1;
+        return &buffer_[seq & mask()];
+    }
 
-        return true;
+    /**
+     * Publish every slot claimed since the last commit (Producer only)
+     * Release store: the slot writes are visible before the new head
+     */
+    void commit() noexcept {
+        head_.store(write_seq_, std::memory_order_release);
+        notify_readable();
     }
 
     /**
-     * Push an item, spinning until space is available (Producer only)
-     * Use with caution - can burn CPU cycles
+     * Push an item, waiting until space is available (Producer only)
+     * How the wait spends the core is up to WaitStrategy
      */
     void push(const T& item) noexcept {
-        while (!try_push(item)) {
-            // Spin - in production, might want to add pause instruction
-            // or yield after N iterations
-#if defined(__x86_64__) || defined(_M_X64)
-            __builtin_ia32_pause();
-#endif
+        for (uint32_t iteration = 0; !try_push(item); ++iteration) {
+            wait_writable(iteration);
         }
     }
 
+    /**
+     * Back off once while the ring is full (Producer only)
+     * iteration counts consecutive failed attempts; reset it on progress.
+     * Uncommitted claims must be committed first or a parked consumer
+     * will never free a slot.
+     */
+    void wait_writable(uint32_t iteration) noexcept {
+        writable_wait_.wait(iteration, tail_, write_seq_ - mask());
+    }
+
     /**
      * Try to pop an item from the buffer (Consumer only)
      * Returns the item on success, std::nullopt if buffer is empty
      * Wait-free: completes in bounded number of steps
      */
     std::optional<T> try_pop() noexcept {
-        const size_t current_tail = tail_.load(std::memory_order_relaxed);
-
-        // Check if buffer is empty
-        // We need to load head with acquire to synchronize with producer's release
-        if (current_tail == head_.load(std::memory_order_acquire)) {
-            return std::nullopt;  // Buffer is empty
+        const uint64_t current_tail = tail_.load(std::memory_order_relaxed);
+
+        // Check if buffer is empty against the cached head first; only
+        // reload the producer's index (acquire, pairs with its release)
+        // when the cached copy says there is nothing to read
+        if (current_tail == cached_head_) {
+            refresh_head(current_tail);
+            if (current_tail == cached_head_) {
+                return std::nullopt;  // Buffer is empty
+            }
         }
 
         // Read the data
-        T item = buffer_[current_tail];
+        T item = buffer_[current_tail & mask()];
 
         // Update tail with release semantics
         // This ensures the data read is complete before tail update
-        tail_.store(increment(current_tail), std::memory_order_release);
+        record_dequeue(current_tail, 1);
+        tail_.store(current_tail + 1, std::memory_order_release);
+        notify_writable();
 
         return item;
     }
 
     /**
-     * Pop an item, spinning until data is available (Consumer only)
-     * Use with caution - can burn CPU cycles
+     * Oldest unread item, read in place (Consumer only)
+     * Returns nullptr if buffer is empty
+     *
+     * The slot stays owned by the consumer until release(); the producer
+     * cannot overwrite it in the meantime.
+     */
+    const T* front() noexcept {
+        const uint64_t current_tail = tail_.load(std::memory_order_relaxed);
+
+        if (current_tail == cached_head_) {
+            refresh_head(current_tail);
+            if (current_tail == cached_head_) {
+                return nullptr;  // Buffer is empty
+            }
+        }
+
+        return &buffer_[current_tail & mask()];
+    }
+
+    /**
+     * Run of unread items, read in place (Consumer only)
+     * Points first at the oldest and returns how many follow it
+     * contiguously, at most max_count (0 if buffer is empty)
+     *
+     * The run stops at the wrap; the next call returns the rest. Hand the
+     * slots back with release(n), one tail_ store for the whole run.
+     */
+    size_t front_batch(const T*& first, size_t max_count) noexcept {
+        const uint64_t current_tail = tail_.load(std::memory_order_relaxed);
+
+        size_t ready = static_cast<size_t>(cached_head_ - current_tail);
+        if (ready < max_count) {
+            refresh_head(current_tail);
+            ready = static_cast<size_t>(cached_head_ - current_tail);
+        }
+
+        const size_t index = current_tail & mask();
+        const size_t to_wrap = capacity() - index;
+        size_t n = max_count < ready ? max_count : ready;
+        n = n < to_wrap ? n : to_wrap;
+        first = &buffer_[index];
+        return n;
+    }
+
+    /**
+     * Hand the item returned by front() back to the producer (Consumer only)
+     * Only valid after front() returned non-null
+     */
+    void release() noexcept { release(1); }
+
+    /**
+     * Hand back the oldest n items read in place (Consumer only)
+     * n must not exceed what front_batch() returned
+     */
+    void release(size_t n) noexcept {
+        const uint64_t current_tail = tail_.load(std::memory_order_relaxed);
+        record_dequeue(current_tail, n);
+        tail_.store(current_tail + n, std::memory_order_release);
+        notify_writable();
+    }
+
+    /**
+     * Pop an item, waiting until data is available (Consumer only)
+     * How the wait spends the core is up to WaitStrategy
      */
     T pop() noexcept {
-        while (true) {
+        for (uint32_t iteration = 0;; ++iteration) {
             if (auto item = try_pop()) {
                 return *item;
             }
-#if defined(__x86_64__) || defined(_M_X64)
-            __builtin_ia32_pause();
-#endif
+            wait_readable(iteration);
+        }
+    }
+
+    /**
+     * Back off once while the ring is empty (Consumer only)
+     * iteration counts consecutive empty polls; reset it on progress
+     */
+    void wait_readable(uint32_t iteration) noexcept {
+        readable_wait_.wait(iteration, head_, tail_.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * Strategy the consumer waits on (producer notifies it)
+     * Exposed for runtime reconfiguration and wake_all() on shutdown
+     */
+    WaitStrategy& readable_wait() noexcept { return readable_wait_; }
+    const WaitStrategy& readable_wait() const noexcept { return readable_wait_; }
+
+    // Strategy the producer waits on (consumer notifies it)
+    WaitStrategy& writable_wait() noexcept { return writable_wait_; }
+    const WaitStrategy& writable_wait() const noexcept { return writable_wait_; }
+
+    /**
+     * Push up to count items in one operation (Producer only)
+     * Returns number of items actually pushed (0 if buffer is full)
+     *
+     * Free space is computed once, the run is copied in at most two
+     * segments (before and after the wrap) and head_ is published with a
+     * single release store, so the consumer sees all of them at once
+     * (after any slots still claimed through try_claim()).
+     */
+    size_t try_push_batch(const T* items, size_t count) noexcept {
+        const uint64_t current_head = write_seq_;
+
+        size_t space = free_space(current_head, cached_tail_);
+        if (space < count) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            space = free_space(current_head, cached_tail_);
+        }
+
+        const size_t n = count < space ? count : space;
+        if (n == 0) {
+            return 0;
+        }
+
+        const size_t index = current_head & mask();
+        const size_t first = n < capacity() - index ? n : capacity() - index;
+        std::memcpy(&buffer_[index], items, first * sizeof(T));
+        if (n > first) {
+            std::memcpy(&buffer_[0], items + first, (n - first) * sizeof(T));
         }
+
+        stamp_enqueue(current_head, n);
+        write_seq_ = current_head + n;
+        head_.store(write_seq_, std::memory_order_release);
+        notify_readable();
+        return n;
+    }
+
+    /**
+     * Pop up to max_count items in one operation (Consumer only)
+     * Returns number of items actually popped (0 if buffer is empty)
+     *
+     * Copies out in at most two segments and frees the slots with a
+     * single release store of tail_.
+     */
+    size_t try_pop_batch(T* items, size_t max_count) noexcept {
+        const uint64_t current_tail = tail_.load(std::memory_order_relaxed);
+
+        size_t ready = static_cast<size_t>(cached_head_ - current_tail);
+        if (ready < max_count) {
+            refresh_head(current_tail);
+            ready = static_cast<size_t>(cached_head_ - current_tail);
+        }
+
+        const size_t n = max_count < ready ? max_count : ready;
+        if (n == 0) {
+            return 0;
+        }
+
+        const size_t index = current_tail & mask();
+        const size_t first = n < capacity() - index ? n : capacity() - index;
+        std::memcpy(items, &buffer_[index], first * sizeof(T));
+        if (n > first) {
+            std::memcpy(items + first, &buffer_[0], (n - first) * sizeof(T));
+        }
+
+        record_dequeue(current_tail, n);
+        tail_.store(current_tail + n, std::memory_order_release);
+        notify_writable();
+        return n;
     }
 
     /**
@@ -133,13 +446,14 @@ public:
      * Returns the item on success, std::nullopt if buffer is empty
      */
     std::optional<T> peek() const noexcept {
-        const size_t current_tail = tail_.load(std::memory_order_relaxed);
+        const uint64_t current_tail = tail_.load(std::memory_order_relaxed);
 
-        if (current_tail == head_.load(std::memory_order_acquire)) {
+        if (current_tail == cached_head_ &&
+            current_tail == head_.load(std::memory_order_acquire)) {
             return std::nullopt;
         }
 
-        return buffer_[current_tail];
+        return buffer_[current_tail & mask()];
     }
 
     /**
@@ -156,8 +470,7 @@ public:
      * Note: This is a snapshot - may change immediately after return
      */
     bool full() const noexcept {
-        return increment(head_.load(std::memory_order_acquire)) ==
-               tail_.load(std::memory_order_acquire);
+        return size() == mask();
     }
 
     /**
@@ -165,96 +478,212 @@ public:
      * Note: This is a snapshot - may change immediately after return
      */
     size_t size() const noexcept {
-        const size_t head = head_.load(std::memory_order_acquire);
-        const size_t tail = tail_.load(std::memory_order_acquire);
-
-        if (head >= tail) {
-            return head - tail;
-        } else {
-            return Capacity - tail + head;
-        }
+        // Load tail first: head only grows, so head - tail cannot underflow
+        const uint64_t tail = tail_.load(std::memory_order_acquire);
+        const uint64_t head = head_.load(std::memory_order_acquire);
+        return static_cast<size_t>(head - tail);
     }
 
     /**
      * Get the capacity of the buffer
      */
-    static constexpr size_t capacity() noexcept {
-        return Capacity;
+    constexpr size_t capacity() const noexcept {
+        return mask() + 1;
     }
 
     /**
      * Get available space in the buffer
      */
     size_t available() const noexcept {
-        return Capacity - size() - 1;  // -1 because we can't fill completely
+        return capacity() - size() - 1;  // -1 because we can't fill completely
+    }
+
+    /**
+     * Items ever published / released (monotonic, any thread)
+     */
+    uint64_t produced() const noexcept { return head_.load(std::memory_order_acquire); }
+    uint64_t consumed() const noexcept { return tail_.load(std::memory_order_acquire); }
+
+    /**
+     * Time every interval-th item through the ring (interval rounded up to
+     * a power of 2; 0 turns sampling off). Call before the producer and
+     * consumer start: the stamp array is allocated here.
+     */
+    void enable_delay_sampling(size_t interval) {
+        if (interval == 0) {
+            enqueue_ns_.reset();
+            return;
+        }
+        size_t rounded = 1;
+        while (rounded < interval) {
+            rounded <<= 1;
+        }
+        sample_mask_ = rounded - 1;
+        enqueue_ns_.reset(new uint64_t[capacity()]());
+    }
+
+    /**
+     * Occupancy and delay snapshot; cheap, callable from any thread
+     */
+    RingStats stats() const noexcept {
+        RingStats s;
+        s.consumed = tail_.load(std::memory_order_acquire);
+        s.produced = head_.load(std::memory_order_acquire);
+        s.backlog = s.produced - s.consumed;
+        s.high_water_mark = high_water_mark_.load(std::memory_order_relaxed);
+        s.delay_samples = delay_samples_.load(std::memory_order_relaxed);
+        s.delay_total_ns = delay_total_ns_.load(std::memory_order_relaxed);
+        s.delay_max_ns = delay_max_ns_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    /**
+     * Backing memory of a run-time sized ring (DYNAMIC_CAPACITY only)
+     */
+    template <size_t C = Capacity, std::enable_if_t<C == DYNAMIC_CAPACITY, int> = 0>
+    const HugePageBuffer& memory() const noexcept {
+        return buffer_.memory();
     }
 
 private:
-    // Efficient modulo for power-of-2 capacity
-    static constexpr size_t increment(size_t index) noexcept {
-        return (index + 1) & (Capacity - 1);
+    // Zero-initialize the buffer (for mapped storage, after it is NUMA-bound)
+    void init_slots() noexcept {
+        for (size_t i = 0; i < capacity(); ++i) {
+            new (&buffer_[i]) T{};
+        }
     }
 
-    // Buffer storage
-    // Aligned to cache line to prevent false sharing with adjacent data
-    alignas(CACHE_LINE_SIZE) std::array<T, Capacity> buffer_;
+    // Constant for compile-time capacity, one load otherwise
+    constexpr size_t mask() const noexcept {
+        return buffer_.mask();
+    }
 
-    // Producer index (only written by producer, read by consumer)
-    // Aligned to separate cache line to prevent false sharing with tail_
-    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_;
+    // Slots the producer may fill; one slot always stays empty
+    constexpr size_t free_space(uint64_t head, uint64_t tail) const noexcept {
+        return mask() - static_cast<size_t>(head - tail);
+    }
 
-    // Padding to ensure tail_ is on a different cache line
-    char padding_[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    // Reload head_ and record the backlog it reveals (Consumer only)
+    void refresh_head(uint64_t current_tail) noexcept {
+        cached_head_ = head_.load(std::memory_order_acquire);
+        const uint64_t backlog = cached_head_ - current_tail;
+        if (backlog > high_water_mark_.load(std::memory_order_relaxed)) {
+            high_water_mark_.store(backlog, std::memory_order_relaxed);
+        }
+    }
 
-    // Consumer index (only written by consumer, read by producer)
-    // On its own cache line due to alignas
-    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_;
-};
+    static uint64_t now_ns() noexcept {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
 
-/**
- * Batch operations for higher throughput
- * These can amortize the cost of atomic operations over multiple items
- */
-template <typename T, size_t Capacity>
-class BatchRingBuffer : public RingBuffer<T, Capacity> {
-public:
-    using Base = RingBuffer<T, Capacity>;
+    // First sampled sequence in [seq, seq + n), or seq + n if none
+    uint64_t first_sample(uint64_t seq, size_t n) const noexcept {
+        const uint64_t sample = (seq + sample_mask_) & ~static_cast<uint64_t>(sample_mask_);
+        return sample < seq + n ? sample : seq + n;
+    }
 
-    /**
-     * Try to push multiple items at once
-     * Returns number of items actually pushed
-     */
-    size_t try_push_batch(const T* items, size_t count) noexcept {
-        size_t pushed = 0;
-        for (size_t i = 0; i < count; ++i) {
-            if (!Base::try_push(items[i])) {
-                break;
-            }
-            ++pushed;
+    // Stamp the sampled sequences among n claimed from seq (Producer only)
+    void stamp_enqueue(uint64_t seq, size_t n) noexcept {
+        if (!enqueue_ns_) {
+            return;
+        }
+        const uint64_t end = seq + n;
+        uint64_t sample = first_sample(seq, n);
+        if (sample == end) {
+            return;
+        }
+        const uint64_t now = now_ns();
+        for (; sample < end; sample += sample_mask_ + 1) {
+            enqueue_ns_[sample & mask()] = now;
         }
-        return pushed;
     }
 
-    /**
-     * Try to pop multiple items at once
-     * Returns number of items actually popped
-     */
-    size_t try_pop_batch(T* items, size_t max_count) noexcept {
-        size_t popped = 0;
-        for (size_t i = 0; i < max_count; ++i) {
-            if (auto item = Base::try_pop()) {
-                items[i] = *item;
-                ++popped;
-            } else {
-                break;
-            }
+    // Time the sampled sequences among n released from seq (Consumer only)
+    void record_dequeue(uint64_t seq, size_t n) noexcept {
+        if (!enqueue_ns_) {
+            return;
+        }
+        const uint64_t end = seq + n;
+        uint64_t sample = first_sample(seq, n);
+        if (sample == end) {
+            return;
+        }
+        const uint64_t now = now_ns();
+        uint64_t samples = delay_samples_.load(std::memory_order_relaxed);
+        uint64_t total = delay_total_ns_.load(std::memory_order_relaxed);
+        uint64_t max = delay_max_ns_.load(std::memory_order_relaxed);
+        for (; sample < end; sample += sample_mask_ + 1) {
+            const uint64_t delay = now - enqueue_ns_[sample & mask()];
+            ++samples;
+            total += delay;
+            max = delay > max ? delay : max;
+        }
+        delay_samples_.store(samples, std::memory_order_relaxed);
+        delay_total_ns_.store(total, std::memory_order_relaxed);
+        delay_max_ns_.store(max, std::memory_order_relaxed);
+    }
+
+    // Wake a parked consumer after head_ moves; free for spinning policies
+    void notify_readable() noexcept {
+        if constexpr (WaitStrategy::NOTIFIES) {
+            readable_wait_.notify();
         }
-        return popped;
     }
+
+    // Wake a parked producer after tail_ moves
+    void notify_writable() noexcept {
+        if constexpr (WaitStrategy::NOTIFIES) {
+            writable_wait_.notify();
+        }
+    }
+
+    // Buffer storage (in-object array, or pointer into mapped memory)
+    // Aligned to cache line to prevent false sharing with adjacent data
+    alignas(CACHE_LINE_SIZE) detail::RingSlots<T, Capacity> buffer_;
+
+    // Enqueue stamps per slot when delay sampling is on (null otherwise);
+    // set up before the threads start, then read-only apart from the stamps
+    std::unique_ptr<uint64_t[]> enqueue_ns_;
+    size_t sample_mask_ = 0;
+
+    // Producer sequence: items published (only written by producer, read by consumer)
+    // Aligned to separate cache line to prevent false sharing with tail_
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head_;
+
+    // Next sequence to claim; runs ahead of head_ by the uncommitted claims
+    // (producer only, shares head_'s line)
+    uint64_t write_seq_;
+
+    // Producer's last view of tail_ (producer only, shares head_'s line)
+    uint64_t cached_tail_;
+
+    // Consumer sequence: items released (only written by consumer, read by producer)
+    // On its own cache line due to alignas
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> tail_;
+
+    // Consumer's last view of head_ (consumer only, shares tail_'s line)
+    uint64_t cached_head_;
+
+    // Lag metrics, written by the consumer only (relaxed; read by stats())
+    std::atomic<uint64_t> high_water_mark_{0};
+    std::atomic<uint64_t> delay_samples_{0};
+    std::atomic<uint64_t> delay_total_ns_{0};
+    std::atomic<uint64_t> delay_max_ns_{0};
+
+    // Wait state per side, off both index lines: parking writes it, the
+    // peer's notify() only reads it while nobody is parked
+    alignas(CACHE_LINE_SIZE) WaitStrategy readable_wait_;
+    alignas(CACHE_LINE_SIZE) WaitStrategy writable_wait_;
 };
 
-// Type alias for common message buffer size (64K entries)
-using MessageBuffer = RingBuffer<NormalizedMessage, 65536>;
+// Batch operations now live on RingBuffer itself
+template <typename T, size_t Capacity>
+using BatchRingBuffer = RingBuffer<T, Capacity>;
+
+// Normalized message ring, sized at startup (Config::ring_capacity)
+// Wait mode is chosen at run time so idle hours can park the consumer
+using MessageBuffer = RingBuffer<NormalizedMessage, DYNAMIC_CAPACITY, RuntimeWait>;
 
 } // namespace spsc
 } // namespace hft
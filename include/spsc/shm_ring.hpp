@@ -0,0 +1,353 @@
+#pragma once
+
+#include "../common/types.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hft {
+namespace spsc {
+
+/**
+ * Shared-memory broadcast ring for out-of-process consumers
+ *
+ * The feed handler publishes into a named POSIX shared memory segment
+ * (/dev/shm/<name>); strategy processes attach with ShmRingReader and
+ * read the same items. Uses BroadcastRing's Overwrite protocol:
+ * - Readers map the segment PROT_READ and keep their cursor in process,
+ *   so any number can attach and none can corrupt the ring or stall the
+ *   writer (a crashed or stopped reader costs nothing)
+ * - The writer never waits; a reader that falls more than a lap behind
+ *   gets Lagged, its overrun count grows and it resumes at the oldest
+ *   item still intact
+ * - The writer announces each slot in claimed before writing it, so a
+ *   reader detects a copy torn by a concurrent write and discards it
+ *
+ * Segment layout: ShmRingHeader (versioned, two cache lines), then
+ * capacity slots of T. The writer stores magic last, so a reader never
+ * sees a half-initialized header.
+ */
+
+constexpr uint64_t SHM_RING_MAGIC = 0x474E495248435449ULL;  // "ITCHRING" little-endian
+constexpr uint32_t SHM_RING_VERSION = 1;
+
+struct ShmRingHeader {
+    // Layout description (written once before magic)
+    std::atomic<uint64_t> magic;
+    uint32_t version;
+    uint32_t slot_size;         // sizeof(T) the writer was built with
+    uint64_t capacity;          // Slots, power of 2
+    uint64_t data_offset;       // Byte offset of slot 0 from the header
+    int32_t writer_pid;
+    std::atomic<uint32_t> closed;  // Set when the writer shuts down
+
+    // Writer cursors, on their own line
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> published;  // Items published
+    std::atomic<uint64_t> claimed;   // Last sequence claimed + 1
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "Cross-process atomics must be lock-free");
+
+/**
+ * Writer side, owned by the feed handler (single producer)
+ *
+ * create() replaces any stale segment of the same name; the segment is
+ * unlinked when the writer is destroyed, and attached readers keep their
+ * mapping until they detach.
+ */
+template <typename T>
+class ShmRingWriter {
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable to cross processes");
+
+public:
+    ShmRingWriter() = default;
+    ~ShmRingWriter() { close(); }
+
+    ShmRingWriter(const ShmRingWriter&) = delete;
+    ShmRingWriter& operator=(const ShmRingWriter&) = delete;
+
+    /**
+     * Create /dev/shm/<name> with capacity slots (rounded up to a power of 2)
+     * name must start with '/'. Returns false if the segment cannot be
+     * created or mapped.
+     */
+    bool create(const std::string& name, size_t capacity) {
+        close();
+
+        size_t slots = 2;
+        while (slots < capacity) {
+            slots <<= 1;
+        }
+        const size_t data_offset = (sizeof(ShmRingHeader) + CACHE_LINE_SIZE - 1) & ~(CACHE_LINE_SIZE - 1);
+        const size_t length = data_offset + slots * sizeof(T);
+
+        shm_unlink(name.c_str());
+        const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        if (ftruncate(fd, static_cast<off_t>(length)) != 0) {
+            ::close(fd);
+            shm_unlink(name.c_str());
+            return false;
+        }
+        void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            shm_unlink(name.c_str());
+            return false;
+        }
+
+        // ftruncate zero-filled the segment, so cursors and slots start at 0
+        name_ = name;
+        base_ = p;
+        length_ = length;
+        header_ = new (p) ShmRingHeader{};
+        header_->version = SHM_RING_VERSION;
+        header_->slot_size = sizeof(T);
+        header_->capacity = slots;
+        header_->data_offset = data_offset;
+        header_->writer_pid = static_cast<int32_t>(getpid());
+        slots_ = reinterpret_cast<T*>(static_cast<uint8_t*>(p) + data_offset);
+        mask_ = slots - 1;
+        write_seq_ = 0;
+        header_->magic.store(SHM_RING_MAGIC, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Mark the ring closed, unmap and unlink it
+     */
+    void close() noexcept {
+        if (!base_) {
+            return;
+        }
+        header_->closed.store(1, std::memory_order_release);
+        munmap(base_, length_);
+        shm_unlink(name_.c_str());
+        base_ = nullptr;
+        header_ = nullptr;
+        slots_ = nullptr;
+    }
+
+    bool is_open() const noexcept { return base_ != nullptr; }
+
+    /**
+     * Reserve the slot for the next item; never fails
+     * Invisible to readers until commit()
+     */
+    T* claim() noexcept {
+        const uint64_t seq = write_seq_;
+
+        // Announce the write before touching the slot; pairs with the
+        // acquire fence in ShmRingReader::try_read
+        header_->claimed.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        write_seq_ = seq + 1;
+        return &slots_[seq & mask_];
+    }
+
+    /**
+     * Publish every slot claimed since the last commit
+     */
+    void commit() noexcept {
+        header_->published.store(write_seq_, std::memory_order_release);
+    }
+
+    void publish(const T& item) noexcept {
+        *claim() = item;
+        commit();
+    }
+
+    uint64_t published() const noexcept { return header_->published.load(std::memory_order_relaxed); }
+    size_t capacity() const noexcept { return mask_ + 1; }
+    const std::string& name() const noexcept { return name_; }
+
+private:
+    std::string name_;
+    void* base_ = nullptr;
+    size_t length_ = 0;
+    ShmRingHeader* header_ = nullptr;
+    T* slots_ = nullptr;
+    size_t mask_ = 0;
+    uint64_t write_seq_ = 0;   // Writer-private
+};
+
+/**
+ * Reader side: the client library for strategy processes
+ *
+ * Attach, then poll try_read(). Each reader has its own cursor, starting
+ * at the writer's current head.
+ */
+template <typename T>
+class ShmRingReader {
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable to cross processes");
+
+public:
+    enum class AttachResult : uint8_t {
+        Ok,
+        NotFound,         // No segment of that name (writer not started)
+        NotReady,         // Segment exists but the writer is still initializing
+        VersionMismatch,  // Built against a different ShmRingHeader layout
+        TypeMismatch,     // Writer's slot size differs from sizeof(T)
+        MapFailed
+    };
+
+    enum class ReadResult : uint8_t {
+        Ok,
+        Empty,      // Nothing new
+        Lagged      // Items were overwritten before this reader got them
+    };
+
+    ShmRingReader() = default;
+    ~ShmRingReader() { detach(); }
+
+    ShmRingReader(const ShmRingReader&) = delete;
+    ShmRingReader& operator=(const ShmRingReader&) = delete;
+
+    AttachResult attach(const std::string& name) {
+        detach();
+
+        const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            return AttachResult::NotFound;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(ShmRingHeader)) {
+            ::close(fd);
+            return AttachResult::NotReady;
+        }
+        const size_t length = static_cast<size_t>(st.st_size);
+        void* p = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            return AttachResult::MapFailed;
+        }
+
+        const auto* header = static_cast<const ShmRingHeader*>(p);
+        AttachResult result = AttachResult::Ok;
+        if (header->magic.load(std::memory_order_acquire) != SHM_RING_MAGIC) {
+            result = AttachResult::NotReady;
+        } else if (header->version != SHM_RING_VERSION) {
+            result = AttachResult::VersionMismatch;
+        } else if (header->slot_size != sizeof(T) ||
+                   header->data_offset + header->capacity * sizeof(T) > length) {
+            result = AttachResult::TypeMismatch;
+        }
+        if (result != AttachResult::Ok) {
+            munmap(p, length);
+            return result;
+        }
+
+        base_ = p;
+        length_ = length;
+        header_ = header;
+        slots_ = reinterpret_cast<const T*>(static_cast<const uint8_t*>(p) + header->data_offset);
+        capacity_ = header->capacity;
+        cursor_ = header->published.load(std::memory_order_acquire);
+        cached_published_ = cursor_;
+        overruns_ = 0;
+        return AttachResult::Ok;
+    }
+
+    void detach() noexcept {
+        if (base_) {
+            munmap(base_, length_);
+            base_ = nullptr;
+            header_ = nullptr;
+            slots_ = nullptr;
+        }
+    }
+
+    bool is_attached() const noexcept { return base_ != nullptr; }
+
+    /**
+     * Copy out the next item and advance the cursor
+     */
+    ReadResult try_read(T& out) noexcept {
+        const uint64_t seq = cursor_;
+
+        if (seq == cached_published_) {
+            cached_published_ = header_->published.load(std::memory_order_acquire);
+            if (seq == cached_published_) {
+                return ReadResult::Empty;
+            }
+        }
+
+        if (cached_published_ - seq > capacity_) {
+            return skip_lost(seq);
+        }
+
+        out = slots_[seq & (capacity_ - 1)];
+
+        // If the writer has started on the item one lap ahead, the copy
+        // may be torn
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (header_->claimed.load(std::memory_order_relaxed) > seq + capacity_) {
+            return skip_lost(seq);
+        }
+
+        cursor_ = seq + 1;
+        return ReadResult::Ok;
+    }
+
+    // Items this reader lost to overwrites
+    uint64_t overruns() const noexcept { return overruns_; }
+
+    // Items the writer has published that this reader has not read yet
+    uint64_t backlog() const noexcept {
+        return header_->published.load(std::memory_order_acquire) - cursor_;
+    }
+
+    // The writer shut down; anything still published can be drained
+    bool writer_closed() const noexcept {
+        return header_->closed.load(std::memory_order_acquire) != 0;
+    }
+
+    int writer_pid() const noexcept { return header_->writer_pid; }
+    size_t capacity() const noexcept { return capacity_; }
+
+private:
+    // Jump to the oldest item that is safe to read
+    ReadResult skip_lost(uint64_t seq) noexcept {
+        // Leave a one-lap margin behind the writer's newest claim
+        const uint64_t claimed = header_->claimed.load(std::memory_order_relaxed);
+        const uint64_t oldest = claimed > capacity_ ? claimed - capacity_ + 1 : 0;
+        uint64_t resume = oldest > seq ? oldest : seq + 1;
+        if (resume > cached_published_) {
+            resume = cached_published_;
+        }
+
+        overruns_ += resume - seq;
+        cursor_ = resume;
+        return ReadResult::Lagged;
+    }
+
+    void* base_ = nullptr;
+    size_t length_ = 0;
+    const ShmRingHeader* header_ = nullptr;
+    const T* slots_ = nullptr;
+    uint64_t capacity_ = 0;
+    uint64_t cursor_ = 0;            // Next sequence to read
+    uint64_t cached_published_ = 0;  // Last view of header_->published
+    uint64_t overruns_ = 0;
+};
+
+// Normalized message stream as exported by FeedHandler (--shm-name)
+using MessageShmWriter = ShmRingWriter<NormalizedMessage>;
+using MessageShmReader = ShmRingReader<NormalizedMessage>;
+
+} // namespace spsc
+} // namespace hft
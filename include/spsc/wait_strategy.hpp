@@ -0,0 +1,259 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#endif
+
+namespace hft {
+namespace spsc {
+
+/**
+ * Wait strategies for ring producers and consumers
+ *
+ * A side that cannot make progress (consumer on empty, producer on full)
+ * calls wait(iteration, word, blocked) in a loop, where word is the peer's
+ * index, blocked the value it holds while no progress is possible, and
+ * iteration the number of consecutive fruitless attempts (reset by the
+ * caller once it makes progress). The peer calls notify() after it
+ * publishes; only strategies with NOTIFIES = true ever do any work there,
+ * so the others cost the publishing side nothing.
+ *
+ * Trade-off, cheapest wake-up first:
+ * - BusySpinWait:   re-check immediately; lowest latency, burns the core
+ * - SpinPauseWait:  spin, then pause each attempt; frees pipeline
+ *                   resources for a hyperthread sibling
+ * - SpinYieldWait:  spin, pause, then sched_yield; lets other threads on
+ *                   the core run
+ * - BlockingWait:   spin, yield, then park on a futex; ~0 CPU while idle,
+ *                   tens of microseconds to wake
+ * - RuntimeWait:    any of the above, selectable (and switchable) at run
+ *                   time, e.g. blocking pre-open, busy-spin in session
+ */
+
+enum class WaitMode : uint8_t {
+    BusySpin,
+    SpinPause,
+    SpinYield,
+    Block
+};
+
+inline const char* wait_mode_name(WaitMode mode) {
+    switch (mode) {
+        case WaitMode::BusySpin:  return "busy-spin";
+        case WaitMode::SpinPause: return "spin-pause";
+        case WaitMode::SpinYield: return "spin-yield";
+        case WaitMode::Block:     return "block";
+    }
+    return "unknown";
+}
+
+/**
+ * Parse a wait mode name (as printed by wait_mode_name, or spin / pause /
+ * yield / block). Returns false on an unknown name.
+ */
+inline bool parse_wait_mode(const char* name, WaitMode& out) {
+    struct Entry { const char* name; WaitMode mode; };
+    static constexpr Entry entries[] = {
+        {"spin", WaitMode::BusySpin}, {"busy-spin", WaitMode::BusySpin},
+        {"pause", WaitMode::SpinPause}, {"spin-pause", WaitMode::SpinPause},
+        {"yield", WaitMode::SpinYield}, {"spin-yield", WaitMode::SpinYield},
+        {"block", WaitMode::Block},
+    };
+    for (const Entry& e : entries) {
+        if (std::strcmp(e.name, name) == 0) {
+            out = e.mode;
+            return true;
+        }
+    }
+    return false;
+}
+
+namespace detail {
+
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(_M_X64)
+    __builtin_ia32_pause();
+#endif
+}
+
+// Iterations of plain re-checking before backing off
+constexpr uint32_t SPIN_ITERATIONS = 64;
+
+// Iterations of pause before yielding
+constexpr uint32_t PAUSE_ITERATIONS = 1024;
+
+// Yields before parking
+constexpr uint32_t YIELD_ITERATIONS = 64;
+
+} // namespace detail
+
+struct BusySpinWait {
+    static constexpr bool NOTIFIES = false;
+
+    void wait(uint32_t, const std::atomic<uint64_t>&, uint64_t) noexcept {}
+    void notify() noexcept {}
+    void wake_all() noexcept {}
+};
+
+struct SpinPauseWait {
+    static constexpr bool NOTIFIES = false;
+
+    void wait(uint32_t iteration, const std::atomic<uint64_t>&, uint64_t) noexcept {
+        if (iteration >= detail::SPIN_ITERATIONS) {
+            detail::cpu_relax();
+        }
+    }
+    void notify() noexcept {}
+    void wake_all() noexcept {}
+};
+
+struct SpinYieldWait {
+    static constexpr bool NOTIFIES = false;
+
+    void wait(uint32_t iteration, const std::atomic<uint64_t>&, uint64_t) noexcept {
+        if (iteration >= detail::SPIN_ITERATIONS + detail::PAUSE_ITERATIONS) {
+            std::this_thread::yield();
+        } else if (iteration >= detail::SPIN_ITERATIONS) {
+            detail::cpu_relax();
+        }
+    }
+    void notify() noexcept {}
+    void wake_all() noexcept {}
+};
+
+/**
+ * Spin, yield, then park on a futex until notified
+ *
+ * Lost-wakeup protocol (Dekker-style):
+ * - Waiter: registers in waiters_ (seq_cst RMW), samples epoch_,
+ *   re-checks the peer's index, then sleeps only if epoch_ is unchanged
+ * - Notifier: publishes its index, seq_cst fence, then bumps epoch_ and
+ *   wakes only if waiters_ is non-zero
+ * Either the notifier sees the waiter, or the waiter's re-check sees the
+ * new index. The fence is the only cost a notify pays while nobody is
+ * parked. Parking is bounded by PARK_TIMEOUT_NS as a backstop so a waiter
+ * also notices shutdown flags.
+ */
+class BlockingWait {
+public:
+    static constexpr bool NOTIFIES = true;
+    static constexpr long PARK_TIMEOUT_NS = 50'000'000;  // 50 ms
+
+    void wait(uint32_t iteration, const std::atomic<uint64_t>& word, uint64_t blocked) noexcept {
+        constexpr uint32_t spin_end = detail::SPIN_ITERATIONS;
+        constexpr uint32_t yield_end = spin_end + detail::YIELD_ITERATIONS;
+
+        if (iteration < spin_end) {
+            detail::cpu_relax();
+            return;
+        }
+        if (iteration < yield_end) {
+            std::this_thread::yield();
+            return;
+        }
+
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        const uint32_t epoch = epoch_.load(std::memory_order_seq_cst);
+        if (word.load(std::memory_order_seq_cst) == blocked) {
+            park(epoch);
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void notify() noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) != 0) {
+            wake_all();
+        }
+    }
+
+    // Unconditional wake, e.g. on shutdown or a mode change
+    void wake_all() noexcept {
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+#ifdef __linux__
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAKE_PRIVATE,
+                INT32_MAX, nullptr, nullptr, 0);
+#endif
+    }
+
+    // Times a waiter actually went to sleep
+    uint64_t parks() const noexcept { return parks_.load(std::memory_order_relaxed); }
+
+private:
+    void park(uint32_t epoch) noexcept {
+        parks_.fetch_add(1, std::memory_order_relaxed);
+#ifdef __linux__
+        static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32 bits");
+        timespec timeout{0, PARK_TIMEOUT_NS};
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAIT_PRIVATE,
+                epoch, &timeout, nullptr, 0);
+#else
+        (void)epoch;
+        std::this_thread::yield();
+#endif
+    }
+
+    std::atomic<uint32_t> epoch_{0};
+    std::atomic<uint32_t> waiters_{0};
+    std::atomic<uint64_t> parks_{0};
+};
+
+/**
+ * Wait strategy chosen at run time
+ *
+ * The mode may be changed from any thread (e.g. a session-state
+ * scheduler switching to Block after the close). A waiter already
+ * parked is woken on the change; notify() costs the producer one
+ * relaxed load and a predictable branch outside Block mode.
+ */
+class RuntimeWait {
+public:
+    static constexpr bool NOTIFIES = true;
+
+    explicit RuntimeWait(WaitMode mode = WaitMode::SpinPause) : mode_(mode) {}
+
+    void set_mode(WaitMode mode) noexcept {
+        mode_.store(mode, std::memory_order_relaxed);
+        blocking_.wake_all();
+    }
+
+    WaitMode mode() const noexcept { return mode_.load(std::memory_order_relaxed); }
+
+    void wait(uint32_t iteration, const std::atomic<uint64_t>& word, uint64_t blocked) noexcept {
+        switch (mode_.load(std::memory_order_relaxed)) {
+            case WaitMode::BusySpin:  busy_.wait(iteration, word, blocked); break;
+            case WaitMode::SpinPause: pause_.wait(iteration, word, blocked); break;
+            case WaitMode::SpinYield: yield_.wait(iteration, word, blocked); break;
+            case WaitMode::Block:     blocking_.wait(iteration, word, blocked); break;
+        }
+    }
+
+    void notify() noexcept {
+        if (mode_.load(std::memory_order_relaxed) == WaitMode::Block) {
+            blocking_.notify();
+        }
+    }
+
+    void wake_all() noexcept { blocking_.wake_all(); }
+
+    uint64_t parks() const noexcept { return blocking_.parks(); }
+
+private:
+    std::atomic<WaitMode> mode_;
+    BusySpinWait busy_;
+    SpinPauseWait pause_;
+    SpinYieldWait yield_;
+    BlockingWait blocking_;
+};
+
+} // namespace spsc
+} // namespace hft
@@ -1,9 +1,12 @@
 #pragma once
 
 #include "../include/common/types.hpp"
+#include "../include/book/order_book.hpp"
 #include "../include/dpdk/config.hpp"
 #include "../include/dpdk/packet_handler.hpp"
 #include "../include/spsc/ring_buffer.hpp"
+#include "../include/spsc/shm_ring.hpp"
+#include "../include/moldudp64/retransmit.hpp"
 
 #include <atomic>
 #include <thread>
@@ -12,6 +15,7 @@
 #include <iomanip>
 #include <fstream>
 #include <cstring>
+#include <memory>
 
 namespace hft {
 
@@ -20,21 +24,44 @@ namespace hft {
  *
  * Architecture:
  * - Producer thread: Polls NIC (or PCAP) and parses packets
- * - Consumer thread: Processes normalized messages from ring buffer
+ * - Consumer thread: Applies normalized messages to the order books
  *
  * The ring buffer decouples packet reception from message processing,
  * allowing each to run at maximum speed on dedicated CPU cores.
  */
 class FeedHandler {
 public:
-    using MessageBuffer = spsc::RingBuffer<NormalizedMessage, 65536>;
+    using MessageBuffer = spsc::MessageBuffer;
 
     explicit FeedHandler(const dpdk::Config& config)
         : config_(config)
-        , packet_handler_(message_buffer_)
+        , message_buffer_(config.ring_capacity, ring_memory(config))
+        , packet_handler_(message_buffer_, config.max_sessions)
         , running_(false)
         , producer_running_(false)
-        , consumer_running_(false) {}
+        , consumer_running_(false)
+        , book_engine_(config.max_orders) {
+        book_engine_.set_top_of_book(&top_of_book_);
+        set_wait_mode(config.wait_mode);
+        message_buffer_.enable_delay_sampling(config.ring_delay_sample);
+
+        if (config.line_b_port != 0) {
+            packet_handler_.enable_arbitration();
+        }
+
+        if (config.reorder_packets > 0) {
+            moldudp64::ReorderConfig reorder;
+            reorder.max_packets = config.reorder_packets;
+            reorder.max_hold_ns = config.reorder_hold_ns;
+            packet_handler_.enable_reordering(reorder);
+        }
+
+        if (config.depth_levels > 0) {
+            depth_buffer_ = std::make_unique<book::DepthFeed::DeltaBuffer>();
+            depth_feed_ = std::make_unique<book::DepthFeed>(config.depth_levels, *depth_buffer_);
+            book_engine_.set_depth_feed(depth_feed_.get());
+        }
+    }
 
     ~FeedHandler() {
         stop();
@@ -44,6 +71,33 @@ public:
      * Initialize DPDK and prepare for packet processing
      */
     bool initialize() {
+        if (!config_.shm_name.empty() &&
+            !shm_writer_.create(config_.shm_name, config_.shm_capacity)) {
+            std::cerr << "Failed to create shared memory ring: " << config_.shm_name << std::endl;
+            return false;
+        }
+
+        if (config_.rewinder_port != 0) {
+            // Recovered messages arrive after the ones past the gap; only
+            // the reorder buffer puts them back in sequence for the books
+            if (config_.reorder_packets == 0) {
+                std::cerr << "--rewinder needs --reorder: recovered messages would reach the books "
+                          << "out of order" << std::endl;
+                return false;
+            }
+            moldudp64::RetransmitConfig retransmit;
+            retransmit.host = config_.rewinder_host;
+            retransmit.port = config_.rewinder_port;
+            retransmit.max_sessions = config_.max_sessions;
+            retransmit_ = std::make_unique<moldudp64::RetransmitClient>(retransmit);
+            if (!retransmit_->start()) {
+                std::cerr << "Failed to reach rewinder " << config_.rewinder_host << ":"
+                          << config_.rewinder_port << std::endl;
+                return false;
+            }
+            retransmit_->attach(packet_handler_.get_sessions());
+        }
+
 #ifdef USE_DPDK
         // Real DPDK initialization would go here
         // For now, we support PCAP/file mode
@@ -83,12 +137,18 @@ public:
         running_.store(false, std::memory_order_release);
         packet_handler_.stop();
 
+        // A parked consumer would otherwise only notice at its park timeout
+        message_buffer_.readable_wait().wake_all();
+
         if (producer_thread_.joinable()) {
             producer_thread_.join();
         }
         if (consumer_thread_.joinable()) {
             consumer_thread_.join();
         }
+        if (retransmit_) {
+            retransmit_->stop();
+        }
     }
 
     /**
@@ -110,6 +170,9 @@ public:
         std::vector<uint8_t> buffer(file_size);
         file.read(reinterpret_cast<char*>(buffer.data()), file_size);
 
+        // Replay must not drop messages while the consumer is building books
+        packet_handler_.set_backpressure(is_running());
+
         // Process the ITCH data
         return packet_handler_.process_itch_file_data(buffer.data(), buffer.size());
     }
@@ -139,6 +202,7 @@ public:
         }
 
         size_t packets_processed = 0;
+        packet_handler_.set_backpressure(is_running());
 
         // Read packets
         while (file) {
@@ -147,11 +211,14 @@ public:
             file.read(reinterpret_cast<char*>(pkt_header), 16);
             if (file.gcount() < 16) break;
 
-            uint32_t incl_len;
+            uint32_t ts_sec, ts_usec, incl_len;
+            std::memcpy(&ts_sec, pkt_header, 4);
+            std::memcpy(&ts_usec, pkt_header + 4, 4);
+            std::memcpy(&incl_len, pkt_header + 8, 4);
             if (swap_bytes) {
-                incl_len = __builtin_bswap32(*reinterpret_cast<uint32_t*>(pkt_header + 8));
-            } else {
-                incl_len = *reinterpret_cast<uint32_t*>(pkt_header + 8);
+                ts_sec = __builtin_bswap32(ts_sec);
+                ts_usec = __builtin_bswap32(ts_usec);
+                incl_len = __builtin_bswap32(incl_len);
             }
 
             // Read packet data
@@ -159,19 +226,55 @@ public:
             file.read(reinterpret_cast<char*>(packet.data()), incl_len);
             if (static_cast<size_t>(file.gcount()) < incl_len) break;
 
-            // Process the packet
-            if (packet_handler_.process_raw_packet(packet.data(), packet.size())) {
+            // Process the packet; with two lines, the capture timestamp
+            // times the race between them
+            bool processed;
+            if (config_.line_b_port != 0) {
+                uint16_t port = 0;
+                dpdk::PacketHandler::udp_destination_port(packet.data(), packet.size(), port);
+                const auto line = port == config_.line_b_port ? moldudp64::Line::B : moldudp64::Line::A;
+                const uint64_t arrival_ns = ts_sec * 1'000'000'000ULL + ts_usec * 1'000ULL;
+                processed = packet_handler_.process_line_packet(line, packet.data(), packet.size(), arrival_ns);
+            } else {
+                processed = packet_handler_.process_raw_packet(packet.data(), packet.size());
+            }
+            if (processed) {
                 ++packets_processed;
             }
+
+            // Recovered messages re-enter on this (the producer) thread
+            if (retransmit_) {
+                retransmit_->poll(packet_handler_.get_sessions());
+            }
         }
 
         return packets_processed;
     }
 
+    /**
+     * Switch how both ring sides wait; safe while running
+     * e.g. Block pre-open and post-close, BusySpin during the session
+     */
+    void set_wait_mode(spsc::WaitMode mode) {
+        message_buffer_.readable_wait().set_mode(mode);
+        message_buffer_.writable_wait().set_mode(mode);
+    }
+
+    spsc::WaitMode wait_mode() const { return message_buffer_.readable_wait().mode(); }
+
     // Getters
     bool is_running() const { return running_.load(std::memory_order_acquire); }
     const MessageBuffer& get_message_buffer() const { return message_buffer_; }
 
+    // Order books are owned by the consumer thread; only inspect after stop()
+    const book::BookEngine& get_book_engine() const { return book_engine_; }
+
+    // Seqlock BBO per locate; safe to read from any thread at any time
+    const book::TopOfBookTable& get_top_of_book() const { return top_of_book_; }
+
+    // Level delta ring for one downstream consumer (nullptr if depth is off)
+    book::DepthFeed::DeltaBuffer* get_depth_buffer() { return depth_buffer_.get(); }
+
     /**
      * Print statistics
      */
@@ -187,28 +290,127 @@ public:
 
         std::cout << "\n--- Parser Statistics ---" << std::endl;
         std::cout << "Total messages:       " << stats.parser_stats.total_messages << std::endl;
-        std::cout << "Add orders:           " << stats.parser_stats.add_orders << std::endl;
-        std::cout << "Order executed:       " << stats.parser_stats.order_executed << std::endl;
-        std::cout << "Order deleted:        " << stats.parser_stats.order_deleted << std::endl;
-        std::cout << "Order cancelled:      " << stats.parser_stats.order_cancelled << std::endl;
-        std::cout << "Order replaced:       " << stats.parser_stats.order_replaced << std::endl;
-        std::cout << "Trades:               " << stats.parser_stats.trades << std::endl;
-        std::cout << "Other messages:       " << stats.parser_stats.other_messages << std::endl;
-        std::cout << "Unknown messages:     " << stats.parser_stats.unknown_messages << std::endl;
+        std::cout << "Add orders:           " << stats.parser_stats.add_orders() << std::endl;
+        std::cout << "Order executed:       " << stats.parser_stats.order_executed() << std::endl;
+        std::cout << "Order deleted:        " << stats.parser_stats.order_deleted() << std::endl;
+        std::cout << "Order cancelled:      " << stats.parser_stats.order_cancelled() << std::endl;
+        std::cout << "Order replaced:       " << stats.parser_stats.order_replaced() << std::endl;
+        std::cout << "Trades:               " << stats.parser_stats.trades() << std::endl;
+        std::cout << "Other messages:       " << stats.parser_stats.other_messages() << std::endl;
+        std::cout << "Unknown messages:     " << stats.parser_stats.unknown_messages() << std::endl;
+        if (stats.parser_stats.order_ref_overflows > 0) {
+            std::cout << "Wide refs dropped:    " << stats.parser_stats.order_ref_overflows << std::endl;
+        }
 
         std::cout << "\n--- Session Statistics ---" << std::endl;
         std::cout << "Session packets:      " << stats.session_stats.packets_received << std::endl;
         std::cout << "Session messages:     " << stats.session_stats.messages_received << std::endl;
         std::cout << "Gaps detected:        " << stats.session_stats.gaps_detected << std::endl;
+        if (stats.session_stats.gap_overflows > 0) {
+            std::cout << "Gap set overflows:    " << stats.session_stats.gap_overflows << std::endl;
+        }
         std::cout << "Heartbeats:           " << stats.session_stats.heartbeats_received << std::endl;
+        const auto manager_stats = packet_handler_.get_sessions().get_stats();
+        if (manager_stats.sessions_created > 1) {
+            std::cout << "Sessions:             " << manager_stats.sessions_created << " ("
+                      << manager_stats.switches << " switches, " << manager_stats.evictions
+                      << " evicted)" << std::endl;
+        }
+        if (packet_handler_.arbitration_enabled()) {
+            std::cout << "\n--- Line Arbitration ---" << std::endl;
+            for (auto line : {moldudp64::Line::A, moldudp64::Line::B}) {
+                const auto ls = packet_handler_.get_line_stats(line);
+                std::cout << "Line " << moldudp64::line_name(line) << " packets:       " << ls.packets
+                          << " (won " << std::fixed << std::setprecision(1) << ls.win_rate() * 100.0
+                          << "%, " << ls.gap_fills << " gap fills)" << std::endl;
+                std::cout << "Line " << moldudp64::line_name(line) << " missed:        "
+                          << ls.missed_messages << " messages" << std::endl;
+                std::cout << "Line " << moldudp64::line_name(line) << " lag when late: "
+                          << std::setprecision(0) << ls.mean_skew_ns() << " ns mean, "
+                          << ls.skew_max_ns << " ns max" << std::endl;
+            }
+        }
+        if (config_.reorder_packets > 0) {
+            std::cout << "Packets held:         " << stats.session_stats.packets_held << std::endl;
+            std::cout << "Duplicates dropped:   " << stats.session_stats.duplicates_dropped << std::endl;
+            std::cout << "Gaps abandoned:       " << stats.session_stats.gaps_abandoned << std::endl;
+            std::cout << "Messages skipped:     " << stats.session_stats.messages_skipped << std::endl;
+        }
 
+        auto book_stats = book_engine_.get_stats();
+        std::cout << "\n--- Order Book Statistics ---" << std::endl;
+        std::cout << "Messages consumed:    " << total_messages_processed_ << std::endl;
+        std::cout << "Directory symbols:    " << book_engine_.symbols().size() << std::endl;
+        std::cout << "Books:                " << book_engine_.book_count() << std::endl;
+        std::cout << "Resting orders:       " << book_engine_.order_count() << std::endl;
+        std::cout << "Adds applied:         " << book_stats.adds << std::endl;
+        std::cout << "Executions applied:   " << book_stats.executions << std::endl;
+        std::cout << "Cancels applied:      " << book_stats.cancels << std::endl;
+        std::cout << "Deletes applied:      " << book_stats.deletes << std::endl;
+        std::cout << "Replaces applied:     " << book_stats.replaces << std::endl;
+        std::cout << "Unknown order refs:   " << book_stats.unknown_orders << std::endl;
+        std::cout << "Order table full:     " << book_stats.table_full << std::endl;
+        std::cout << "Top-of-book updates:  " << top_of_book_.publishes() << std::endl;
+
+        if (depth_feed_) {
+            auto depth_stats = depth_feed_->get_stats();
+            uint64_t generated = depth_stats.inserts + depth_stats.updates + depth_stats.deletes;
+            std::cout << "\n--- Depth Feed Statistics ---" << std::endl;
+            std::cout << "Levels per side:      " << depth_feed_->levels() << std::endl;
+            std::cout << "Book changes:         " << depth_stats.book_updates << std::endl;
+            std::cout << "Level deltas:         " << generated << std::endl;
+            std::cout << "  Inserts:            " << depth_stats.inserts << std::endl;
+            std::cout << "  Updates:            " << depth_stats.updates << std::endl;
+            std::cout << "  Deletes:            " << depth_stats.deletes << std::endl;
+            std::cout << "Deltas pushed:        " << depth_stats.deltas_emitted << std::endl;
+            std::cout << "Deltas dropped:       " << depth_stats.deltas_dropped << std::endl;
+        }
+
+        auto ring_stats = message_buffer_.stats();
         std::cout << "\n--- Ring Buffer Status ---" << std::endl;
+        std::cout << "Messages produced:    " << ring_stats.produced << std::endl;
+        std::cout << "Messages consumed:    " << ring_stats.consumed << std::endl;
+        std::cout << "High-water mark:      " << ring_stats.high_water_mark << std::endl;
+        if (ring_stats.delay_samples > 0) {
+            std::cout << "Queueing delay mean:  " << std::fixed << std::setprecision(0)
+                      << ring_stats.mean_delay_ns() << " ns" << std::endl;
+            std::cout << "Queueing delay max:   " << ring_stats.delay_max_ns << " ns" << std::endl;
+        }
         std::cout << "Buffer size:          " << message_buffer_.size() << std::endl;
         std::cout << "Buffer capacity:      " << message_buffer_.capacity() << std::endl;
         std::cout << "Buffer available:     " << message_buffer_.available() << std::endl;
+        std::cout << "Buffer memory:        " << page_backing_name(message_buffer_.memory().backing())
+                  << (message_buffer_.memory().numa_bound() ? ", NUMA-bound" : "") << std::endl;
+        std::cout << "Consumer parks:       " << message_buffer_.readable_wait().parks() << std::endl;
+
+        if (retransmit_) {
+            auto rs = retransmit_->get_stats();
+            std::cout << "\n--- Retransmission ---" << std::endl;
+            std::cout << "Gaps requested:       " << rs.gaps_received << std::endl;
+            std::cout << "Requests sent:        " << rs.requests_sent << " (" << rs.retries << " retries)" << std::endl;
+            std::cout << "Messages recovered:   " << rs.messages_recovered << std::endl;
+            std::cout << "Messages abandoned:   " << rs.messages_abandoned << std::endl;
+        }
+
+        if (shm_writer_.is_open()) {
+            std::cout << "\n--- Shared Memory Export ---" << std::endl;
+            std::cout << "Segment:              /dev/shm" << shm_writer_.name() << std::endl;
+            std::cout << "Capacity:             " << shm_writer_.capacity() << std::endl;
+            std::cout << "Messages published:   " << shm_writer_.published() << std::endl;
+        }
     }
 
 private:
+    // Ring memory lives on the consumer core's node when cores are pinned
+    static MemoryOptions ring_memory(const dpdk::Config& config) {
+        MemoryOptions memory;
+        memory.huge_pages = config.huge_pages;
+        if (config.pin_to_core) {
+            memory.numa_node = numa_node_of_cpu(config.consumer_core_id);
+        }
+        return memory;
+    }
+
     /**
      * Producer thread: Poll for packets and parse them
      */
@@ -262,13 +464,37 @@ private:
         uint64_t messages_consumed = 0;
         auto last_report = std::chrono::steady_clock::now();
 
-        while (running_.load(std::memory_order_acquire)) {
-            // Try to pop messages from the ring buffer
-            while (auto msg = message_buffer_.try_pop()) {
-                // Process the message
-                process_message(*msg);
-                ++messages_consumed;
+        // Apply messages in place in the ring, no copy out, and free each
+        // burst of up to CONSUMER_BATCH with one tail update
+        // Exported messages are published to shared memory once per drain
+        // and every SHM_PUBLISH_INTERVAL messages in between
+        const bool exporting = shm_writer_.is_open();
+        auto drain = [&]() {
+            size_t exported = 0;
+            const NormalizedMessage* batch;
+            size_t n;
+            while ((n = message_buffer_.front_batch(batch, CONSUMER_BATCH)) != 0) {
+                for (size_t i = 0; i < n; ++i) {
+                    process_message(batch[i]);
+                    if (exporting) {
+                        *shm_writer_.claim() = batch[i];
+                        if (++exported % SHM_PUBLISH_INTERVAL == 0) {
+                            shm_writer_.commit();
+                        }
+                    }
+                }
+                message_buffer_.release(n);
+                messages_consumed += n;
+            }
+            if (exported != 0) {
+                shm_writer_.commit();
             }
+        };
+
+        uint32_t idle_iterations = 0;
+        while (running_.load(std::memory_order_acquire)) {
+            const uint64_t before = messages_consumed;
+            drain();
 
             // Periodic stats report
             auto now = std::chrono::steady_clock::now();
@@ -277,37 +503,42 @@ private:
                 last_report = now;
             }
 
-            // Small pause if buffer was empty
-#if defined(__x86_64__) || defined(_M_X64)
-            __builtin_ia32_pause();
-#endif
+            // Buffer was empty: back off per the configured wait mode
+            if (messages_consumed != before) {
+                idle_iterations = 0;
+            } else {
+                message_buffer_.wait_readable(idle_iterations);
+                if (idle_iterations != UINT32_MAX) {
+                    ++idle_iterations;  // Stay in the deepest back-off stage
+                }
+            }
         }
 
         // Drain remaining messages
-        while (auto msg = message_buffer_.try_pop()) {
-            process_message(*msg);
-            ++messages_consumed;
-        }
+        drain();
 
         consumer_running_.store(false, std::memory_order_release);
     }
 
     /**
      * Process a single normalized message
-     * This is where you'd integrate with order book, strategy, etc.
+     * Applies it to the per-symbol order books on the consumer core
      */
     void process_message(const NormalizedMessage& msg) {
-        // In a real system, this would:
-        // 1. Update order book state
-        // 2. Notify strategy of price changes
-        // 3. Log to persistence layer
-
-        // For now, just count messages
+        book_engine_.apply(msg);
         ++total_messages_processed_;
     }
 
+    // Longest run of exported messages held back from shm readers
+    static constexpr size_t SHM_PUBLISH_INTERVAL = 64;
+
+    // Messages the consumer applies per ring release
+    static constexpr size_t CONSUMER_BATCH = 64;
+
     dpdk::Config config_;
     MessageBuffer message_buffer_;
+    spsc::MessageShmWriter shm_writer_;  // Written by the consumer thread
+    std::unique_ptr<moldudp64::RetransmitClient> retransmit_;  // Null unless a rewinder is set
     dpdk::PacketHandler packet_handler_;
 
     std::atomic<bool> running_;
@@ -317,6 +548,10 @@ private:
     std::thread producer_thread_;
     std::thread consumer_thread_;
 
+    book::TopOfBookTable top_of_book_;
+    book::BookEngine book_engine_;
+    std::unique_ptr<book::DepthFeed::DeltaBuffer> depth_buffer_;
+    std::unique_ptr<book::DepthFeed> depth_feed_;
     uint64_t total_messages_processed_ = 0;
 };
 
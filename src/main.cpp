@@ -54,6 +54,15 @@ void print_usage(const char* program) {
               << "  -c, --producer-core N   CPU core for packet reception (default: 1)\n"
               << "  -C, --consumer-core N   CPU core for message processing (default: 2)\n"
               << "  -n, --no-pin            Disable CPU core pinning\n"
+              << "  -m, --max-orders N      Order arena size (resting orders, default: 4194304)\n"
+              << "  -d, --depth-levels N    Emit top-N price level deltas (default: off)\n"
+              << "  -r, --ring-size N       Message ring slots, rounded to a power of 2 (default: 65536)\n"
+              << "  -H, --no-hugepages      Map the message ring from normal pages\n"
+              << "  -S, --shm-name NAME     Export normalized messages to /dev/shm/NAME\n"
+              << "  -B, --line-b-port PORT  Arbitrate A/B lines; PORT is line B's UDP port\n"
+              << "  -X, --rewinder HOST:PORT Request lost messages from a MoldUDP64 rewinder (needs -R)\n"
+              << "  -R, --reorder N         Hold up to N packets across gaps, deliver in order\n"
+              << "  -w, --wait-mode MODE    Idle wait: spin, pause, yield or block (default: pause)\n"
               << "  -s, --stats             Show statistics after processing\n"
               << "  -v, --verbose           Enable verbose output\n"
               << "  -h, --help              Show this help message\n"
@@ -93,6 +102,15 @@ int main(int argc, char* argv[]) {
         {"producer-core", required_argument, 0, 'c'},
         {"consumer-core", required_argument, 0, 'C'},
         {"no-pin",        no_argument,       0, 'n'},
+        {"max-orders",    required_argument, 0, 'm'},
+        {"depth-levels",  required_argument, 0, 'd'},
+        {"ring-size",     required_argument, 0, 'r'},
+        {"no-hugepages",  no_argument,       0, 'H'},
+        {"shm-name",      required_argument, 0, 'S'},
+        {"line-b-port",   required_argument, 0, 'B'},
+        {"rewinder",      required_argument, 0, 'X'},
+        {"reorder",       required_argument, 0, 'R'},
+        {"wait-mode",     required_argument, 0, 'w'},
         {"stats",         no_argument,       0, 's'},
         {"verbose",       no_argument,       0, 'v'},
         {"help",          no_argument,       0, 'h'},
@@ -107,7 +125,7 @@ int main(int argc, char* argv[]) {
     bool live_mode = false;
 
     int opt;
-    while ((opt = getopt_long(argc, argv, "p:i:P:c:C:nsvh", long_options, nullptr)) != -1) {
+    while ((opt = getopt_long(argc, argv, "p:i:P:c:C:nm:d:r:HS:B:X:R:w:svh", long_options, nullptr)) != -1) {
         switch (opt) {
             case 'p':
                 pcap_file = optarg;
@@ -129,6 +147,47 @@ int main(int argc, char* argv[]) {
             case 'n':
                 config.pin_to_core = false;
                 break;
+            case 'm':
+                config.max_orders = std::stoull(optarg);
+                break;
+            case 'd':
+                config.depth_levels = std::stoull(optarg);
+                break;
+            case 'r':
+                config.ring_capacity = std::stoull(optarg);
+                break;
+            case 'H':
+                config.huge_pages = false;
+                break;
+            case 'S':
+                // POSIX shm names are "/name"
+                config.shm_name = optarg[0] == '/' ? optarg : std::string("/") + optarg;
+                break;
+            case 'B':
+                config.line_b_port = static_cast<uint16_t>(std::stoi(optarg));
+                break;
+            case 'X': {
+                const std::string endpoint = optarg;
+                const size_t colon = endpoint.rfind(':');
+                if (colon == std::string::npos) {
+                    std::cerr << "Error: --rewinder expects HOST:PORT\n" << std::endl;
+                    print_usage(argv[0]);
+                    return 1;
+                }
+                config.rewinder_host = endpoint.substr(0, colon);
+                config.rewinder_port = static_cast<uint16_t>(std::stoi(endpoint.substr(colon + 1)));
+                break;
+            }
+            case 'R':
+                config.reorder_packets = std::stoull(optarg);
+                break;
+            case 'w':
+                if (!spsc::parse_wait_mode(optarg, config.wait_mode)) {
+                    std::cerr << "Error: Unknown wait mode: " << optarg << "\n" << std::endl;
+                    print_usage(argv[0]);
+                    return 1;
+                }
+                break;
             case 's':
                 show_stats = true;
                 break;
@@ -170,18 +229,26 @@ int main(int argc, char* argv[]) {
     size_t result = 0;
 
     // Process input
+    // File modes run the consumer thread too, so the books are built
     if (!itch_file.empty()) {
         std::cout << "Processing ITCH file: " << itch_file << std::endl;
+        feed_handler.start();
         result = feed_handler.process_itch_file(itch_file);
+        feed_handler.stop();
         std::cout << "Processed " << result << " messages" << std::endl;
     } else if (!pcap_file.empty()) {
         std::cout << "Processing PCAP file: " << pcap_file << std::endl;
+        feed_handler.start();
         result = feed_handler.process_pcap_file(pcap_file);
+        feed_handler.stop();
         std::cout << "Processed " << result << " packets" << std::endl;
     } else if (live_mode) {
         std::cout << "Starting live capture on port " << config.port_id << std::endl;
         std::cout << "Producer core: " << config.producer_core_id << std::endl;
         std::cout << "Consumer core: " << config.consumer_core_id << std::endl;
+        std::cout << "Wait mode:     " << spsc::wait_mode_name(config.wait_mode) << std::endl;
+        std::cout << "Ring:          " << feed_handler.get_message_buffer().capacity() << " slots, "
+                  << page_backing_name(feed_handler.get_message_buffer().memory().backing()) << std::endl;
 
         feed_handler.start();
 
@@ -0,0 +1,266 @@
+/**
+ * Benchmark for the broadcast (single-producer multi-consumer) ring
+ *
+ * Measures, with 1, 2, 4 and 8 consumers pinned to separate cores:
+ * - Gated broadcast ring: one publish per message, every consumer reads it
+ * - Baseline: one SPSC RingBuffer per consumer, one push per consumer
+ * - Overwrite mode: producer never waits; items lost by lagging consumers
+ */
+
+#include "../include/spsc/broadcast_ring.hpp"
+#include "../include/spsc/ring_buffer.hpp"
+#include "../include/common/types.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#include <pthread.h>
+#endif
+
+using namespace hft;
+using namespace hft::spsc;
+
+// Configuration
+constexpr size_t RING_SIZE = 65536;
+constexpr size_t NUM_MESSAGES = 5'000'000;
+constexpr int MAX_CONSUMERS = 8;
+
+using Broadcast = BroadcastRing<NormalizedMessage, RING_SIZE, MAX_CONSUMERS>;
+using Spsc = RingBuffer<NormalizedMessage, RING_SIZE>;
+
+// Pin thread to CPU core (Linux only)
+void pin_to_core(int core_id) {
+#ifdef __linux__
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(core_id, &cpuset);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+#else
+    (void)core_id;
+#endif
+}
+
+// Spin with pause, yielding now and then so a shared core still progresses
+inline void backoff(uint32_t& spins) {
+    if (++spins % 64 == 0) {
+        std::this_thread::yield();
+    } else {
+#if defined(__x86_64__) || defined(_M_X64)
+        __builtin_ia32_pause();
+#endif
+    }
+}
+
+inline NormalizedMessage make_message(uint64_t i) {
+    NormalizedMessage msg;
+    msg.set_type(MessageType::AddOrder);
+    msg.set_timestamp(34200000000000ULL + i);
+    msg.set_order_ref(i);
+    msg.set_stock_locate(static_cast<StockLocate>(i & 0xFFF));
+    msg.set_price(1500000);
+    msg.set_quantity(100);
+    return msg;
+}
+
+struct Result {
+    double seconds;
+    uint64_t received;      // Summed over consumers
+    uint64_t lost;          // Overwrite mode only
+};
+
+// Keeps consumer reads from being optimized away
+std::atomic<uint64_t> read_sink{0};
+
+// One broadcast ring shared by all consumers
+Result run_broadcast(int num_consumers, Broadcast::Mode mode) {
+    auto ring = std::make_unique<Broadcast>(mode);
+    std::vector<size_t> ids;
+    for (int i = 0; i < num_consumers; ++i) {
+        ids.push_back(ring->add_consumer());
+    }
+
+    std::atomic<bool> start_flag{false};
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> received{0};
+
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < num_consumers; ++i) {
+        consumers.emplace_back([&, i]() {
+            pin_to_core(2 + i);
+            size_t id = ids[i];
+            uint64_t count = 0;
+            uint64_t sum = 0;
+            uint32_t spins = 0;
+            NormalizedMessage msg;
+
+            while (!start_flag.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            while (true) {
+                auto result = ring->try_read(id, msg);
+                if (result == Broadcast::ReadResult::Ok) {
+                    sum += msg.order_ref();
+                    ++count;
+                } else if (result == Broadcast::ReadResult::Empty) {
+                    if (done.load(std::memory_order_acquire) && ring->backlog(id) == 0) {
+                        break;
+                    }
+                    backoff(spins);
+                }
+            }
+            received.fetch_add(count, std::memory_order_relaxed);
+            read_sink.fetch_add(sum, std::memory_order_relaxed);
+        });
+    }
+
+    pin_to_core(1);
+    start_flag.store(true, std::memory_order_release);
+    auto start = std::chrono::high_resolution_clock::now();
+
+    uint32_t spins = 0;
+    for (uint64_t i = 0; i < NUM_MESSAGES; ++i) {
+        NormalizedMessage msg = make_message(i);
+        while (!ring->try_publish(msg)) {
+            backoff(spins);
+        }
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& t : consumers) {
+        t.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    Result result;
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    result.received = received.load();
+    result.lost = 0;
+    for (size_t id : ids) {
+        result.lost += ring->overruns(id);
+    }
+    return result;
+}
+
+// Today's alternative: a private SPSC ring per consumer
+Result run_spsc_fanout(int num_consumers) {
+    std::vector<std::unique_ptr<Spsc>> rings;
+    for (int i = 0; i < num_consumers; ++i) {
+        rings.push_back(std::make_unique<Spsc>());
+    }
+
+    std::atomic<bool> start_flag{false};
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> received{0};
+
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < num_consumers; ++i) {
+        consumers.emplace_back([&, i]() {
+            pin_to_core(2 + i);
+            Spsc& ring = *rings[i];
+            uint64_t count = 0;
+            uint64_t sum = 0;
+            uint32_t spins = 0;
+
+            while (!start_flag.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            while (true) {
+                if (const NormalizedMessage* msg = ring.front()) {
+                    sum += msg->order_ref();
+                    ring.release();
+                    ++count;
+                } else {
+                    if (done.load(std::memory_order_acquire) && ring.empty()) {
+                        break;
+                    }
+                    backoff(spins);
+                }
+            }
+            received.fetch_add(count, std::memory_order_relaxed);
+            read_sink.fetch_add(sum, std::memory_order_relaxed);
+        });
+    }
+
+    pin_to_core(1);
+    start_flag.store(true, std::memory_order_release);
+    auto start = std::chrono::high_resolution_clock::now();
+
+    uint32_t spins = 0;
+    for (uint64_t i = 0; i < NUM_MESSAGES; ++i) {
+        NormalizedMessage msg = make_message(i);
+        for (auto& ring : rings) {
+            while (!ring->try_push(msg)) {
+                backoff(spins);
+            }
+        }
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& t : consumers) {
+        t.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    Result result;
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    result.received = received.load();
+    result.lost = 0;
+    return result;
+}
+
+int main() {
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  Broadcast Ring Benchmark" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << std::endl;
+
+    unsigned cores = std::thread::hardware_concurrency();
+    std::cout << "Messages:       " << NUM_MESSAGES << std::endl;
+    std::cout << "Ring size:      " << RING_SIZE << " entries" << std::endl;
+    std::cout << "Hardware cores: " << cores << std::endl;
+    if (cores < static_cast<unsigned>(MAX_CONSUMERS + 2)) {
+        std::cout << "Note: consumers share cores with the producer; expect scheduler noise" << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << "=== Producer Rate vs Consumer Count ===" << std::endl;
+    std::cout << "(million messages/sec published; every consumer reads every message)" << std::endl;
+    std::cout << std::endl;
+    std::cout << std::setw(10) << "Consumers"
+              << std::setw(14) << "Broadcast"
+              << std::setw(14) << "SPSC fan-out"
+              << std::setw(10) << "Ratio"
+              << std::setw(14) << "Overwrite"
+              << std::setw(12) << "Lost %" << std::endl;
+
+    for (int n = 1; n <= MAX_CONSUMERS; n *= 2) {
+        Result gated = run_broadcast(n, Broadcast::Mode::Gated);
+        Result fanout = run_spsc_fanout(n);
+        Result overwrite = run_broadcast(n, Broadcast::Mode::Overwrite);
+
+        double gated_rate = NUM_MESSAGES / gated.seconds / 1e6;
+        double fanout_rate = NUM_MESSAGES / fanout.seconds / 1e6;
+        double overwrite_rate = NUM_MESSAGES / overwrite.seconds / 1e6;
+        double lost_pct = 100.0 * overwrite.lost / (static_cast<double>(NUM_MESSAGES) * n);
+
+        bool complete = gated.received == NUM_MESSAGES * n && fanout.received == NUM_MESSAGES * n;
+
+        std::cout << std::setw(10) << n
+                  << std::setw(14) << std::fixed << std::setprecision(2) << gated_rate
+                  << std::setw(14) << fanout_rate
+                  << std::setw(9) << gated_rate / fanout_rate << "x"
+                  << std::setw(14) << overwrite_rate
+                  << std::setw(11) << std::setprecision(2) << lost_pct << "%"
+                  << (complete ? "" : "  (INCOMPLETE)") << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << "==================================================" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,245 @@
+/**
+ * Benchmark for the session's gap tracking
+ *
+ * Replays a synthetic loss trace (gaps detected by a live stream, then
+ * filled packet by packet by retransmissions arriving in random order)
+ * into GapSet and into the sorted std::vector scan it replaced. Measures,
+ * per loss pattern:
+ * - Cost per add/fill event
+ * - Cost of an "is sequence N missing" query
+ * - Gaps left open (the vector cannot split a gap filled in the middle)
+ */
+
+#include "../include/moldudp64/gap_set.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+using namespace hft;
+using namespace hft::moldudp64;
+
+// Configuration
+constexpr size_t NUM_PACKETS = 1'000'000;
+constexpr uint16_t MESSAGES_PER_PACKET = 4;
+constexpr size_t NUM_QUERIES = 1'000'000;
+
+/**
+ * The tracking Session used before GapSet: push on detection, linear
+ * walk-and-erase on every fill
+ */
+class VectorGapTracker {
+public:
+    void add(const Gap& gap) { gaps_.push_back(gap); }
+
+    void fill(SequenceNumber start, SequenceNumber end) {
+        for (auto it = gaps_.begin(); it != gaps_.end(); ) {
+            if (start <= it->start && end >= it->end) {
+                it = gaps_.erase(it);
+            } else if (start <= it->start && end >= it->start) {
+                it->start = end + 1;
+                it = it->start > it->end ? gaps_.erase(it) : it + 1;
+            } else if (start <= it->end && end >= it->end) {
+                it->end = start - 1;
+                it = it->start > it->end ? gaps_.erase(it) : it + 1;
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    bool is_missing(SequenceNumber seq) const {
+        for (const Gap& gap : gaps_) {
+            if (seq >= gap.start && seq <= gap.end) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t size() const { return gaps_.size(); }
+
+private:
+    std::vector<Gap> gaps_;
+};
+
+struct LossPattern {
+    const char* name;
+    double packet_loss;         // Chance a packet starts a loss burst
+    size_t burst;               // Packets lost per burst
+    size_t retransmit_delay;    // Live packets before a lost one is refilled
+};
+
+struct Event {
+    bool add;
+    SequenceNumber start;
+    SequenceNumber end;
+};
+
+/**
+ * Live stream with injected loss; each lost packet is retransmitted on its
+ * own, a random 1..retransmit_delay live packets later (and never before
+ * the gap is detected)
+ */
+std::vector<Event> build_trace(const LossPattern& pattern) {
+    std::mt19937_64 rng(11);
+    std::bernoulli_distribution start_burst(pattern.packet_loss);
+    std::uniform_int_distribution<size_t> delay(1, pattern.retransmit_delay);
+
+    std::vector<Event> trace;
+    std::vector<std::vector<SequenceNumber>> due(NUM_PACKETS + pattern.retransmit_delay + 1);
+    SequenceNumber expected = 1;
+    size_t burst_left = 0;
+
+    for (size_t i = 0; i < due.size(); ++i) {
+        for (SequenceNumber seq : due[i]) {
+            if (seq >= expected && i < NUM_PACKETS) {
+                // Not detected yet (still inside a burst): wait for it
+                due[i + 1].push_back(seq);
+                continue;
+            }
+            trace.push_back({false, seq, seq + MESSAGES_PER_PACKET - 1});
+        }
+        if (i >= NUM_PACKETS) {
+            continue;
+        }
+
+        const SequenceNumber seq = 1 + i * MESSAGES_PER_PACKET;
+        if (burst_left == 0 && start_burst(rng)) {
+            burst_left = pattern.burst;
+        }
+        if (burst_left > 0) {
+            --burst_left;
+            due[i + delay(rng)].push_back(seq);
+            continue;
+        }
+        if (seq > expected) {
+            trace.push_back({true, expected, seq - 1});
+        }
+        expected = seq + MESSAGES_PER_PACKET;
+    }
+    return trace;
+}
+
+// Most gaps open at once during the trace
+size_t peak_open(const std::vector<Event>& trace) {
+    GapSet set(1 << 16);
+    size_t peak = 0;
+    for (const Event& e : trace) {
+        if (e.add) {
+            set.add(Gap{e.start, e.end, 0});
+            peak = std::max(peak, set.size());
+        } else {
+            set.fill(e.start, e.end);
+        }
+    }
+    return peak;
+}
+
+template<typename Tracker>
+double replay(Tracker& tracker, const std::vector<Event>& trace) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const Event& e : trace) {
+        if (e.add) {
+            tracker.add(Gap{e.start, e.end, 0});
+        } else {
+            tracker.fill(e.start, e.end);
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count())
+           / static_cast<double>(trace.size());
+}
+
+/**
+ * Replay the first half of the trace (gaps at their most open), then time
+ * queries against it
+ */
+template<typename Tracker>
+double time_queries(Tracker& tracker, const std::vector<Event>& trace, size_t& hits) {
+    for (size_t i = 0; i < trace.size() / 2; ++i) {
+        if (trace[i].add) {
+            tracker.add(Gap{trace[i].start, trace[i].end, 0});
+        } else {
+            tracker.fill(trace[i].start, trace[i].end);
+        }
+    }
+    std::mt19937_64 rng(5);
+    std::uniform_int_distribution<SequenceNumber> seq(1, NUM_PACKETS * MESSAGES_PER_PACKET);
+    std::vector<SequenceNumber> queries(NUM_QUERIES);
+    for (auto& q : queries) {
+        q = seq(rng);
+    }
+
+    hits = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (SequenceNumber q : queries) {
+        hits += tracker.is_missing(q);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count())
+           / NUM_QUERIES;
+}
+
+void run_pattern(const LossPattern& pattern) {
+    std::cout << "=== " << pattern.name << " ===" << std::endl;
+
+    const auto trace = build_trace(pattern);
+    const size_t adds = static_cast<size_t>(std::count_if(trace.begin(), trace.end(),
+                                                          [](const Event& e) { return e.add; }));
+
+    VectorGapTracker vec;
+    GapSet set(1 << 16);
+    const double vec_ns = replay(vec, trace);
+    const double set_ns = replay(set, trace);
+
+    VectorGapTracker vec_q;
+    GapSet set_q(1 << 16);
+    size_t vec_hits = 0;
+    size_t set_hits = 0;
+    const double vec_query_ns = time_queries(vec_q, trace, vec_hits);
+    const double set_query_ns = time_queries(set_q, trace, set_hits);
+
+    std::cout << "  Gaps / fills:    " << adds << " / " << trace.size() - adds
+              << " (peak " << peak_open(trace) << " open)" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  vector:          " << vec_ns << " ns/event, " << vec_query_ns << " ns/query, "
+              << vec.size() << " gaps left open" << std::endl;
+    std::cout << "  GapSet:          " << set_ns << " ns/event, " << set_query_ns << " ns/query, "
+              << set.size() << " gaps left open" << std::endl;
+    std::cout << "  Speedup:         " << std::setprecision(2) << vec_ns / set_ns << "x events, "
+              << vec_query_ns / set_query_ns << "x queries" << std::endl;
+    if (vec_hits != set_hits) {
+        std::cout << "  (queries disagree: " << vec_hits << " vs " << set_hits
+                  << " missing; the vector kept middle-filled gaps whole)" << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+int main() {
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  MoldUDP64 Gap Tracking Benchmark" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Configuration:" << std::endl;
+    std::cout << "  Packets:         " << NUM_PACKETS << " x " << MESSAGES_PER_PACKET << " messages" << std::endl;
+    std::cout << "  Queries:         " << NUM_QUERIES << " random sequences" << std::endl;
+    std::cout << std::endl;
+
+    const LossPattern patterns[] = {
+        {"0.1% Random Packet Loss", 0.001, 1, 1'000},
+        {"1% Random Packet Loss", 0.01, 1, 5'000},
+        {"Burst Loss (20 packets, 0.5%), filled in pieces", 0.005, 20, 5'000},
+        {"Heavy Loss (10%), slow rewinder", 0.1, 1, 20'000},
+    };
+    for (const auto& pattern : patterns) {
+        run_pattern(pattern);
+    }
+
+    std::cout << "==================================================" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,305 @@
+/**
+ * Benchmark for MoldUDP64 in-order reassembly
+ *
+ * Measures:
+ * - Steady-state cost per packet with no gaps, reordering off vs on
+ * - Hold cost per packet while a gap is open
+ * - Drain speed when the gap fills and held packets are released
+ * - A/B line arbitration cost per packet copy, with independent loss
+ * - SessionManager routing cost: one stream, and channels interleaved
+ */
+
+#include "../include/moldudp64/session.hpp"
+#include "../include/moldudp64/arbiter.hpp"
+#include "../include/common/endian.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <random>
+
+using namespace hft;
+using namespace hft::moldudp64;
+
+// Configuration
+constexpr size_t NUM_PACKETS = 5'000'000;
+constexpr uint16_t MESSAGES_PER_PACKET = 4;
+constexpr size_t MESSAGE_SIZE = 36;           // AddOrder
+constexpr size_t DRAIN_ROUNDS = 2'000;
+constexpr size_t HELD_PER_ROUND = 1'000;
+constexpr double LINE_LOSS = 0.001;           // Per line, independent
+
+/**
+ * A MoldUDP64 packet template whose sequence number is rewritten per send
+ */
+struct PacketTemplate {
+    std::vector<uint8_t> bytes;
+
+    explicit PacketTemplate(const char* session = "NASDAQ") {
+        bytes.resize(sizeof(Header));
+        std::memset(bytes.data(), ' ', 10);
+        std::memcpy(bytes.data(), session, std::min<size_t>(std::strlen(session), 10));
+        uint16_t count_be = endian::hton16(MESSAGES_PER_PACKET);
+        std::memcpy(bytes.data() + 18, &count_be, 2);
+        for (uint16_t i = 0; i < MESSAGES_PER_PACKET; ++i) {
+            bytes.push_back(0);
+            bytes.push_back(MESSAGE_SIZE);
+            bytes.insert(bytes.end(), MESSAGE_SIZE, 'A');
+        }
+    }
+
+    const uint8_t* with_sequence(uint64_t seq) {
+        uint64_t seq_be = endian::hton64(seq);
+        std::memcpy(bytes.data() + 10, &seq_be, 8);
+        return bytes.data();
+    }
+
+    size_t size() const { return bytes.size(); }
+};
+
+// Packet-level callback: counts messages, so the session cost dominates
+size_t g_delivered = 0;
+
+void attach_counter(Session& session) {
+    session.set_packet_callback(
+        [](const uint8_t*, size_t, uint16_t count, SequenceNumber) {
+            g_delivered += count;
+            return static_cast<size_t>(count);
+        }
+    );
+}
+
+double bench_steady_state(bool reorder) {
+    Session session;
+    if (reorder) {
+        session.enable_reordering();
+    }
+    attach_counter(session);
+    PacketTemplate packet;
+    g_delivered = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < NUM_PACKETS; ++i) {
+        session.process_packet(packet.with_sequence(1 + i * MESSAGES_PER_PACKET), packet.size());
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    if (g_delivered != NUM_PACKETS * MESSAGES_PER_PACKET) {
+        std::cerr << "Steady state lost messages" << std::endl;
+    }
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count())
+           / NUM_PACKETS;
+}
+
+/**
+ * Each round drops one packet, holds HELD_PER_ROUND packets behind it,
+ * then delivers the missing one and times the release of the rest
+ */
+void bench_drain() {
+    Session session;
+    ReorderConfig config;
+    config.max_packets = HELD_PER_ROUND;
+    config.max_hold_ns = UINT64_MAX / 2;
+    session.enable_reordering(config);
+    attach_counter(session);
+    PacketTemplate packet;
+    g_delivered = 0;
+
+    uint64_t hold_ns = 0;
+    uint64_t drain_ns = 0;
+    std::vector<uint64_t> drain_samples;
+    drain_samples.reserve(DRAIN_ROUNDS);
+
+    uint64_t seq = 1;
+    for (size_t round = 0; round < DRAIN_ROUNDS; ++round) {
+        const uint64_t missing = seq;
+        seq += MESSAGES_PER_PACKET;
+
+        auto hold_start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < HELD_PER_ROUND; ++i) {
+            session.process_packet(packet.with_sequence(seq), packet.size());
+            seq += MESSAGES_PER_PACKET;
+        }
+        auto drain_start = std::chrono::high_resolution_clock::now();
+        session.process_packet(packet.with_sequence(missing), packet.size());
+        auto drain_end = std::chrono::high_resolution_clock::now();
+
+        hold_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(drain_start - hold_start).count();
+        const uint64_t drain = std::chrono::duration_cast<std::chrono::nanoseconds>(drain_end - drain_start).count();
+        drain_ns += drain;
+        drain_samples.push_back(drain);
+    }
+
+    const size_t expected = DRAIN_ROUNDS * (HELD_PER_ROUND + 1) * MESSAGES_PER_PACKET;
+    if (g_delivered != expected || session.held_packets() != 0) {
+        std::cerr << "Drain lost messages" << std::endl;
+    }
+
+    std::sort(drain_samples.begin(), drain_samples.end());
+    const double held_packets = static_cast<double>(DRAIN_ROUNDS * HELD_PER_ROUND);
+    std::cout << "  Hold:          " << std::fixed << std::setprecision(2)
+              << hold_ns / held_packets << " ns/packet" << std::endl;
+    std::cout << "  Drain:         " << drain_ns / held_packets << " ns/packet released" << std::endl;
+    std::cout << "  Drain P50:     " << drain_samples[drain_samples.size() / 2] / 1000.0
+              << " us per " << HELD_PER_ROUND << " packets" << std::endl;
+    std::cout << "  Drain P99:     " << drain_samples[drain_samples.size() * 99 / 100] / 1000.0
+              << " us per " << HELD_PER_ROUND << " packets" << std::endl;
+}
+
+/**
+ * Both lines carry every packet, PACKET_SPACING_NS apart. Line B's lead
+ * over A drifts between -LINE_SKEW_NS and +LINE_SKEW_NS (1 ns per packet,
+ * so each line stays in order), so either line can win and a packet lost
+ * on the leading line is filled from behind the high-water mark. Each
+ * copy is lost with LINE_LOSS. Times arbitrate() over the pre-built
+ * arrival schedule.
+ */
+void bench_arbitration() {
+    constexpr uint64_t PACKET_SPACING_NS = 100;
+    constexpr int64_t LINE_SKEW_NS = 250;
+
+    struct Arrival {
+        uint64_t time_ns;
+        Line line;
+        uint64_t seq;
+    };
+    std::vector<Arrival> schedule;
+    schedule.reserve(NUM_PACKETS * 2);
+
+    std::mt19937_64 rng(42);
+    std::bernoulli_distribution lost(LINE_LOSS);
+    for (size_t i = 0; i < NUM_PACKETS; ++i) {
+        const uint64_t seq = 1 + i * MESSAGES_PER_PACKET;
+        const uint64_t t = 1'000 + i * PACKET_SPACING_NS;
+        const int64_t phase = static_cast<int64_t>(i % (4 * LINE_SKEW_NS));
+        const int64_t lead = phase < 2 * LINE_SKEW_NS ? phase - LINE_SKEW_NS : 3 * LINE_SKEW_NS - phase;
+        if (!lost(rng)) schedule.push_back({t, Line::A, seq});
+        if (!lost(rng)) schedule.push_back({static_cast<uint64_t>(t - lead), Line::B, seq});
+    }
+    std::stable_sort(schedule.begin(), schedule.end(),
+        [](const Arrival& x, const Arrival& y) { return x.time_ns < y.time_ns; });
+
+    // Headers only: the arbiter never reads past them
+    std::vector<std::array<uint8_t, sizeof(Header)>> headers(schedule.size());
+    for (size_t i = 0; i < schedule.size(); ++i) {
+        PacketTemplate packet;
+        std::memcpy(headers[i].data(), packet.with_sequence(schedule[i].seq), sizeof(Header));
+    }
+
+    LineArbiter arbiter;
+    size_t delivered = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < schedule.size(); ++i) {
+        auto verdict = arbiter.arbitrate(schedule[i].line, headers[i].data(), sizeof(Header),
+                                         schedule[i].time_ns);
+        delivered += verdict == LineArbiter::Verdict::Deliver;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    std::cout << "  Copies:        " << schedule.size() << std::endl;
+    std::cout << "  Delivered:     " << delivered << " of " << NUM_PACKETS << " packets" << std::endl;
+    std::cout << "  Cost:          " << std::fixed << std::setprecision(2)
+              << ns / schedule.size() << " ns/copy" << std::endl;
+    for (auto line : {Line::A, Line::B}) {
+        const auto& ls = arbiter.stats(line);
+        std::cout << "  Line " << line_name(line) << ":        won " << std::setprecision(1)
+                  << ls.win_rate() * 100.0 << "%, " << ls.gap_fills << " gap fills, "
+                  << ls.missed_messages << " messages missed" << std::endl;
+    }
+}
+
+/**
+ * Packets through a SessionManager vs straight into one Session. The
+ * interleaved case switches session on every packet (worst case: three
+ * channels arriving round-robin).
+ */
+void bench_routing() {
+    constexpr size_t CHANNELS = 3;
+    const char* names[CHANNELS] = {"NASDAQ0001", "BX00000001", "PSX0000001"};
+    std::vector<PacketTemplate> packets;
+    for (const char* name : names) {
+        packets.emplace_back(name);
+    }
+
+    auto time_packets = [](auto&& process) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < NUM_PACKETS; ++i) {
+            process(i);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count())
+               / NUM_PACKETS;
+    };
+
+    Session direct;
+    attach_counter(direct);
+    SessionManager single;
+    single.configure([](Session& session) { attach_counter(session); });
+    SessionManager interleaved;
+    interleaved.configure([](Session& session) { attach_counter(session); });
+
+    g_delivered = 0;
+    const double direct_ns = time_packets([&](size_t i) {
+        direct.process_packet(packets[0].with_sequence(1 + i * MESSAGES_PER_PACKET), packets[0].size());
+    });
+    const double single_ns = time_packets([&](size_t i) {
+        single.process_packet(packets[0].with_sequence(1 + i * MESSAGES_PER_PACKET), packets[0].size());
+    });
+    const double interleaved_ns = time_packets([&](size_t i) {
+        PacketTemplate& packet = packets[i % CHANNELS];
+        interleaved.process_packet(packet.with_sequence(1 + (i / CHANNELS) * MESSAGES_PER_PACKET),
+                                   packet.size());
+    });
+
+    if (g_delivered != 3 * NUM_PACKETS * MESSAGES_PER_PACKET || interleaved.has_gaps()) {
+        std::cerr << "Routing lost messages" << std::endl;
+    }
+    std::cout << "  Session direct:  " << std::fixed << std::setprecision(2) << direct_ns << " ns/packet" << std::endl;
+    std::cout << "  Manager, 1 id:   " << single_ns << " ns/packet" << std::endl;
+    std::cout << "  Manager, " << CHANNELS << " ids:  " << interleaved_ns
+              << " ns/packet (switching every packet)" << std::endl;
+}
+
+int main() {
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  MoldUDP64 Reassembly Benchmark" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Configuration:" << std::endl;
+    std::cout << "  Packets:         " << NUM_PACKETS << std::endl;
+    std::cout << "  Messages/packet: " << MESSAGES_PER_PACKET << " x " << MESSAGE_SIZE << " bytes" << std::endl;
+    std::cout << "  Drain rounds:    " << DRAIN_ROUNDS << " x " << HELD_PER_ROUND << " held packets" << std::endl;
+    std::cout << std::endl;
+
+    // Warm up
+    bench_steady_state(false);
+
+    std::cout << "=== Steady State (no gaps) ===" << std::endl;
+    const double off = bench_steady_state(false);
+    const double on = bench_steady_state(true);
+    std::cout << "  Reordering off: " << std::fixed << std::setprecision(2) << off << " ns/packet" << std::endl;
+    std::cout << "  Reordering on:  " << on << " ns/packet" << std::endl;
+    std::cout << "  Overhead:       " << on - off << " ns/packet" << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "=== Gap Fill and Drain ===" << std::endl;
+    bench_drain();
+    std::cout << std::endl;
+
+    std::cout << "=== A/B Line Arbitration (" << LINE_LOSS * 100.0 << "% loss per line) ===" << std::endl;
+    bench_arbitration();
+    std::cout << std::endl;
+
+    std::cout << "=== Session Routing ===" << std::endl;
+    bench_routing();
+    std::cout << std::endl;
+
+    std::cout << "==================================================" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,676 @@
+/**
+ * Benchmark for the order book engine
+ *
+ * Measures:
+ * - Full-day replay throughput through PacketHandler -> SPSC ring -> BookEngine
+ * - Per-message book update latency distribution (P50/P99/P99.9)
+ * - Level storage comparison: dense price ladder vs std::map on the same day
+ * - Depth feed volume: order events vs top-N level deltas
+ *
+ * Usage:
+ *   ./bench_order_book                   # Synthetic day
+ *   ./bench_order_book 01302019.NASDAQ_ITCH50   # Replay a real ITCH file
+ */
+
+#include "../include/book/order_book.hpp"
+#include "../include/dpdk/packet_handler.hpp"
+#include "../include/itch5/messages.hpp"
+#include "../include/spsc/ring_buffer.hpp"
+#include "../include/common/endian.hpp"
+
+#include <array>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <cstring>
+
+#ifdef __linux__
+#include <sched.h>
+#include <pthread.h>
+#endif
+
+using namespace hft;
+using namespace hft::itch5;
+
+// Configuration
+constexpr size_t NUM_MESSAGES = 10'000'000;
+constexpr size_t NUM_SYMBOLS = 512;
+
+// Pin thread to CPU core (Linux only)
+void pin_to_core(int core_id) {
+#ifdef __linux__
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(core_id, &cpuset);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+#else
+    (void)core_id;
+#endif
+}
+
+// Get current time in nanoseconds
+inline uint64_t get_nanos() {
+    auto now = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        now.time_since_epoch()
+    ).count();
+}
+
+// Helper to set timestamp
+void set_timestamp(uint8_t* ts, uint64_t value) {
+    ts[0] = (value >> 40) & 0xFF;
+    ts[1] = (value >> 32) & 0xFF;
+    ts[2] = (value >> 24) & 0xFF;
+    ts[3] = (value >> 16) & 0xFF;
+    ts[4] = (value >> 8) & 0xFF;
+    ts[5] = value & 0xFF;
+}
+
+// Append a message to an ITCH file image (2-byte big-endian length prefix)
+template <typename Msg>
+void append_message(std::vector<uint8_t>& out, const Msg& msg) {
+    uint16_t len = static_cast<uint16_t>(sizeof(Msg));
+    out.push_back(static_cast<uint8_t>(len >> 8));
+    out.push_back(static_cast<uint8_t>(len & 0xFF));
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(&msg);
+    out.insert(out.end(), data, data + sizeof(Msg));
+}
+
+/**
+ * Synthetic trading day generator
+ *
+ * Produces an ITCH 5.0 file image with a message mix close to a real
+ * NASDAQ day: mostly adds and deletes, with replaces, cancels and
+ * executions on a random walk around each symbol's mid price.
+ * Symbol activity is skewed so a handful of names dominate.
+ */
+class SyntheticDay {
+public:
+    struct LiveOrder {
+        OrderRef ref;
+        uint16_t symbol;
+        char side;
+        uint32_t price;     // ITCH 4 decimal places
+        uint32_t shares;
+    };
+
+    explicit SyntheticDay(uint32_t seed = 42) : rng_(seed) {
+        for (size_t i = 0; i < NUM_SYMBOLS; ++i) {
+            char name[9];
+            std::snprintf(name, sizeof(name), "SYM%04zu  ", i);
+            std::memcpy(symbols_[i].data(), name, 8);
+            // Whole-cent mids: Reg NMS tick for stocks priced over $1
+            mids_[i] = 100 * (1000 + static_cast<uint32_t>(rng_() % 50000));  // $10 - $510
+        }
+    }
+
+    std::vector<uint8_t> generate(size_t num_messages) {
+        std::vector<uint8_t> out;
+        out.reserve(num_messages * 34);
+        live_.reserve(num_messages / 4);
+
+        std::uniform_int_distribution<int> mix(1, 100);
+        uint64_t timestamp = 34200000000000ULL;  // 09:30:00
+
+        // Stock directory precedes any order activity
+        for (size_t i = 0; i < NUM_SYMBOLS; ++i) {
+            directory(out, static_cast<uint16_t>(i), timestamp);
+        }
+
+        for (size_t i = 0; i < num_messages; ++i) {
+            timestamp += 1 + rng_() % 2000;
+            int r = mix(rng_);
+
+            if (live_.size() < 1000 || r <= 45) {
+                add(out, timestamp);
+            } else if (r <= 83) {
+                remove(out, timestamp);
+            } else if (r <= 87) {
+                execute(out, timestamp);
+            } else if (r <= 90) {
+                cancel(out, timestamp);
+            } else {
+                replace(out, timestamp);
+            }
+        }
+        return out;
+    }
+
+private:
+    uint16_t pick_symbol() {
+        // Skewed activity: square of a uniform variate favours low indices
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng_);
+        return static_cast<uint16_t>(u * u * NUM_SYMBOLS);
+    }
+
+    uint32_t pick_price(uint16_t sym, char side) {
+        // Random walk the mid by up to one cent
+        int step = static_cast<int>(rng_() % 3) - 1;
+        mids_[sym] = std::max<int64_t>(10000, static_cast<int64_t>(mids_[sym]) + step * 100);
+
+        // Geometric-ish distance from the mid in cents
+        uint32_t ticks = 0;
+        while (ticks < 50 && (rng_() & 3) != 0) {
+            ++ticks;
+        }
+        uint32_t offset = (ticks + 1) * 100;
+        return side == 'B' ? mids_[sym] - std::min(offset, mids_[sym] - 100) : mids_[sym] + offset;
+    }
+
+    size_t pick_live() {
+        // Bias towards recent orders: most are cancelled quickly
+        size_t n = live_.size();
+        size_t back = static_cast<size_t>(rng_() % std::min<size_t>(n, 256));
+        if ((rng_() & 7) == 0) {
+            return rng_() % n;
+        }
+        return n - 1 - back;
+    }
+
+    void drop_live(size_t idx) {
+        live_[idx] = live_.back();
+        live_.pop_back();
+    }
+
+    void directory(std::vector<uint8_t>& out, uint16_t sym, uint64_t ts) {
+        StockDirectory msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.message_type = msg_type::StockDirectory;
+        msg.stock_locate = endian::hton16(sym + 1);
+        set_timestamp(msg.timestamp, ts);
+        std::memcpy(msg.stock, symbols_[sym].data(), 8);
+        msg.market_category = 'Q';
+        msg.round_lot_size = endian::hton32(100);
+        append_message(out, msg);
+    }
+
+    void add(std::vector<uint8_t>& out, uint64_t ts) {
+        LiveOrder o;
+        o.ref = next_ref_++;
+        o.symbol = pick_symbol();
+        o.side = (rng_() & 1) ? 'B' : 'S';
+        o.price = pick_price(o.symbol, o.side);
+        o.shares = 100 * (1 + rng_() % 10);
+        live_.push_back(o);
+
+        AddOrder msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.message_type = msg_type::AddOrder;
+        msg.stock_locate = endian::hton16(o.symbol + 1);
+        set_timestamp(msg.timestamp, ts);
+        msg.order_reference_number = endian::hton64(o.ref);
+        msg.buy_sell_indicator = o.side;
+        msg.shares = endian::hton32(o.shares);
+        std::memcpy(msg.stock, symbols_[o.symbol].data(), 8);
+        msg.price = endian::hton32(o.price);
+        append_message(out, msg);
+    }
+
+    void remove(std::vector<uint8_t>& out, uint64_t ts) {
+        size_t idx = pick_live();
+        OrderDelete msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.message_type = msg_type::OrderDelete;
+        msg.stock_locate = endian::hton16(live_[idx].symbol + 1);
+        set_timestamp(msg.timestamp, ts);
+        msg.order_reference_number = endian::hton64(live_[idx].ref);
+        append_message(out, msg);
+        drop_live(idx);
+    }
+
+    void execute(std::vector<uint8_t>& out, uint64_t ts) {
+        size_t idx = pick_live();
+        LiveOrder& o = live_[idx];
+        uint32_t shares = (rng_() & 1) ? o.shares : std::max<uint32_t>(1, o.shares / 2);
+
+        OrderExecuted msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.message_type = msg_type::OrderExecuted;
+        msg.stock_locate = endian::hton16(o.symbol + 1);
+        set_timestamp(msg.timestamp, ts);
+        msg.order_reference_number = endian::hton64(o.ref);
+        msg.executed_shares = endian::hton32(shares);
+        msg.match_number = endian::hton64(++match_);
+        append_message(out, msg);
+
+        o.shares -= shares;
+        if (o.shares == 0) {
+            drop_live(idx);
+        }
+    }
+
+    void cancel(std::vector<uint8_t>& out, uint64_t ts) {
+        size_t idx = pick_live();
+        LiveOrder& o = live_[idx];
+        uint32_t shares = std::max<uint32_t>(1, o.shares / 2);
+
+        OrderCancel msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.message_type = msg_type::OrderCancel;
+        msg.stock_locate = endian::hton16(o.symbol + 1);
+        set_timestamp(msg.timestamp, ts);
+        msg.order_reference_number = endian::hton64(o.ref);
+        msg.cancelled_shares = endian::hton32(shares);
+        append_message(out, msg);
+
+        o.shares -= shares;
+        if (o.shares == 0) {
+            drop_live(idx);
+        }
+    }
+
+    void replace(std::vector<uint8_t>& out, uint64_t ts) {
+        size_t idx = pick_live();
+        LiveOrder& o = live_[idx];
+        OrderRef new_ref = next_ref_++;
+        uint32_t price = pick_price(o.symbol, o.side);
+
+        OrderReplace msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.message_type = msg_type::OrderReplace;
+        msg.stock_locate = endian::hton16(o.symbol + 1);
+        set_timestamp(msg.timestamp, ts);
+        msg.original_order_reference_number = endian::hton64(o.ref);
+        msg.new_order_reference_number = endian::hton64(new_ref);
+        msg.shares = endian::hton32(o.shares);
+        msg.price = endian::hton32(price);
+        append_message(out, msg);
+
+        o.ref = new_ref;
+        o.price = price;
+    }
+
+    std::mt19937_64 rng_;
+    std::array<StockSymbol, NUM_SYMBOLS> symbols_{};
+    std::array<uint32_t, NUM_SYMBOLS> mids_{};
+    std::vector<LiveOrder> live_;
+    OrderRef next_ref_ = 1;
+    uint64_t match_ = 0;
+};
+
+// Read a raw ITCH file into memory
+std::vector<uint8_t> load_file(const char* path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return {};
+    }
+    file.seekg(0, std::ios::end);
+    size_t size = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    std::vector<uint8_t> data(size);
+    file.read(reinterpret_cast<char*>(data.data()), size);
+    return data;
+}
+
+// Replay an ITCH file image through the ring into the book engine
+void bench_replay(const std::vector<uint8_t>& itch_data) {
+    std::cout << "=== Full-Day Replay Benchmark ===" << std::endl;
+
+    auto buffer = std::make_unique<dpdk::PacketHandler::MessageBuffer>(65536);
+    auto handler = std::make_unique<dpdk::PacketHandler>(*buffer);
+    auto engine = std::make_unique<book::BookEngine>();
+    handler->set_backpressure(true);
+
+    std::vector<uint32_t> latencies;
+    latencies.reserve(itch_data.size() / 20);
+
+    std::atomic<bool> start_flag{false};
+    std::atomic<bool> done{false};
+    uint64_t consumed = 0;
+    uint64_t book_changes = 0;
+
+    // Consumer: the book builder core
+    std::thread consumer([&]() {
+        pin_to_core(2);
+
+        while (!start_flag.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+
+        // Same in-place read as FeedHandler::run_consumer
+        while (true) {
+            const NormalizedMessage* msg = buffer->front();
+            if (!msg) {
+                if (done.load(std::memory_order_acquire) && buffer->empty()) {
+                    break;
+                }
+#if defined(__x86_64__) || defined(_M_X64)
+                __builtin_ia32_pause();
+#endif
+                continue;
+            }
+
+            uint64_t t0 = get_nanos();
+            book_changes += engine->apply(*msg);
+            uint64_t t1 = get_nanos();
+            buffer->release();
+
+            latencies.push_back(static_cast<uint32_t>(t1 - t0));
+            ++consumed;
+        }
+    });
+
+    // Producer: parse the file and normalize into the ring
+    auto start = std::chrono::high_resolution_clock::now();
+    start_flag.store(true, std::memory_order_release);
+
+    pin_to_core(1);
+    size_t parsed = handler->process_itch_file_data(itch_data.data(), itch_data.size());
+    done.store(true, std::memory_order_release);
+
+    consumer.join();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    double msgs_per_sec = static_cast<double>(parsed) * 1e9 / duration;
+    double book_msgs_per_sec = static_cast<double>(consumed) * 1e9 / duration;
+
+    std::cout << "ITCH bytes:     " << itch_data.size() / (1024 * 1024) << " MB" << std::endl;
+    std::cout << "ITCH messages:  " << parsed << std::endl;
+    std::cout << "Book messages:  " << consumed << std::endl;
+    std::cout << "Book changes:   " << book_changes << std::endl;
+    std::cout << "Total time:     " << duration / 1e6 << " ms" << std::endl;
+    std::cout << "Throughput:     " << std::fixed << std::setprecision(2)
+              << msgs_per_sec / 1e6 << " million ITCH msgs/sec" << std::endl;
+    std::cout << "Book rate:      " << std::fixed << std::setprecision(2)
+              << book_msgs_per_sec / 1e6 << " million updates/sec" << std::endl;
+
+    auto stats = engine->get_stats();
+    std::cout << "Books:          " << engine->book_count() << std::endl;
+    std::cout << "Resting orders: " << engine->order_count() << std::endl;
+    std::cout << "Unknown refs:   " << stats.unknown_orders << std::endl;
+
+    if (latencies.empty()) {
+        std::cout << std::endl;
+        return;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    double mean = std::accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size();
+
+    std::cout << std::endl;
+    std::cout << "Update latency (includes clock read overhead):" << std::endl;
+    std::cout << "  Mean:         " << std::fixed << std::setprecision(1) << mean << " ns" << std::endl;
+    std::cout << "  P50:          " << latencies[latencies.size() * 50 / 100] << " ns" << std::endl;
+    std::cout << "  P99:          " << latencies[latencies.size() * 99 / 100] << " ns" << std::endl;
+    std::cout << "  P99.9:        " << latencies[latencies.size() * 999 / 1000] << " ns" << std::endl;
+    std::cout << "  Max:          " << latencies.back() << " ns" << std::endl;
+    std::cout << std::endl;
+}
+
+// Run the day through the normalizer once and keep the book messages
+std::vector<NormalizedMessage> normalize_day(const std::vector<uint8_t>& itch_data) {
+    auto buffer = std::make_unique<dpdk::PacketHandler::MessageBuffer>(65536);
+    auto handler = std::make_unique<dpdk::PacketHandler>(*buffer);
+    handler->set_backpressure(true);
+
+    std::vector<NormalizedMessage> messages;
+    messages.reserve(itch_data.size() / 30);
+    std::atomic<bool> done{false};
+
+    std::thread consumer([&]() {
+        std::array<NormalizedMessage, 64> batch;
+        while (true) {
+            size_t n = buffer->try_pop_batch(batch.data(), batch.size());
+            if (n == 0) {
+                if (done.load(std::memory_order_acquire) && buffer->empty()) {
+                    break;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            messages.insert(messages.end(), batch.begin(), batch.begin() + n);
+        }
+    });
+
+    handler->process_itch_file_data(itch_data.data(), itch_data.size());
+    done.store(true, std::memory_order_release);
+    consumer.join();
+    return messages;
+}
+
+// Apply a normalized day to one engine instantiation, single-threaded
+template <typename LevelStorage>
+double bench_level_storage(const char* name, const std::vector<NormalizedMessage>& messages) {
+    auto engine = std::make_unique<book::BasicBookEngine<LevelStorage>>();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    uint64_t changes = 0;
+    for (const auto& msg : messages) {
+        changes += engine->apply(msg);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    double ns_per_msg = static_cast<double>(duration) / messages.size();
+
+    std::cout << name << std::endl;
+    std::cout << "  Total time:   " << std::fixed << std::setprecision(2)
+              << duration / 1e6 << " ms" << std::endl;
+    std::cout << "  Throughput:   " << std::fixed << std::setprecision(2)
+              << messages.size() * 1e3 / duration << " million updates/sec" << std::endl;
+    std::cout << "  Latency:      " << std::fixed << std::setprecision(1)
+              << ns_per_msg << " ns/update" << std::endl;
+    std::cout << "  Book changes: " << changes << std::endl;
+    return ns_per_msg;
+}
+
+// One price-level operation, extracted from the day's order flow
+struct LevelOp {
+    StockLocate locate;
+    Side side;
+    bool order_removed;
+    bool is_add;
+    Price price;
+    Quantity qty;
+};
+
+std::vector<LevelOp> extract_level_ops(const std::vector<NormalizedMessage>& messages) {
+    struct Resting { StockLocate locate; Side side; Price price; Quantity qty; };
+    std::unordered_map<OrderRef, Resting> orders;
+    orders.reserve(messages.size() / 2);
+
+    std::vector<LevelOp> ops;
+    ops.reserve(messages.size() + messages.size() / 8);
+
+    auto reduce = [&](OrderRef ref, Quantity qty, bool full) -> const Resting* {
+        auto it = orders.find(ref);
+        if (it == orders.end()) return nullptr;
+        Resting& o = it->second;
+        bool removed = full || qty >= o.qty;
+        Quantity delta = removed ? o.qty : qty;
+        ops.push_back({o.locate, o.side, removed, false, o.price, delta});
+        o.qty -= delta;
+        return &o;
+    };
+
+    for (const auto& msg : messages) {
+        switch (msg.type()) {
+            case MessageType::AddOrder:
+            case MessageType::AddOrderMPID:
+                orders[msg.order_ref()] = {msg.stock_locate(), msg.side(), msg.price(), msg.quantity()};
+                ops.push_back({msg.stock_locate(), msg.side(), false, true, msg.price(), msg.quantity()});
+                break;
+            case MessageType::OrderExecuted:
+            case MessageType::OrderExecutedWithPrice:
+                if (reduce(msg.order_ref(), msg.executed_quantity(), false) &&
+                    orders[msg.order_ref()].qty == 0) {
+                    orders.erase(msg.order_ref());
+                }
+                break;
+            case MessageType::OrderCancel:
+                if (reduce(msg.order_ref(), msg.quantity(), false) &&
+                    orders[msg.order_ref()].qty == 0) {
+                    orders.erase(msg.order_ref());
+                }
+                break;
+            case MessageType::OrderDelete:
+                if (reduce(msg.order_ref(), 0, true)) {
+                    orders.erase(msg.order_ref());
+                }
+                break;
+            case MessageType::OrderReplace:
+                if (const Resting* o = reduce(msg.order_ref(), 0, true)) {
+                    Resting fresh{o->locate, o->side, msg.price(), msg.quantity()};
+                    orders.erase(msg.order_ref());
+                    orders[msg.new_order_ref()] = fresh;
+                    ops.push_back({fresh.locate, fresh.side, false, true, fresh.price, fresh.qty});
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return ops;
+}
+
+// Apply only the level operations to per-locate books
+template <typename LevelStorage>
+double bench_level_ops(const char* name, const std::vector<LevelOp>& ops) {
+    using Book = book::BasicOrderBook<LevelStorage>;
+    std::vector<std::unique_ptr<Book>> books(SymbolTable::MAX_LOCATES);
+    for (const auto& op : ops) {
+        if (!books[op.locate]) {
+            books[op.locate] = std::make_unique<Book>(StockSymbol{}, op.locate);
+        }
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    uint64_t checksum = 0;
+    for (const auto& op : ops) {
+        Book& book = *books[op.locate];
+        if (op.is_add) {
+            book.add(op.side, op.price, op.qty);
+        } else {
+            book.reduce(op.side, op.price, op.qty, op.order_removed);
+        }
+        const book::PriceLevel* top = op.side == Side::Buy ? book.best_bid() : book.best_ask();
+        checksum += top ? top->quantity : 0;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    double ns_per_op = static_cast<double>(duration) / ops.size();
+
+    std::cout << name << std::endl;
+    std::cout << "  Total time:   " << std::fixed << std::setprecision(2)
+              << duration / 1e6 << " ms" << std::endl;
+    std::cout << "  Latency:      " << std::fixed << std::setprecision(1)
+              << ns_per_op << " ns/level op (incl. best price read)" << std::endl;
+    std::cout << "  Checksum:     " << checksum << std::endl;
+    return ns_per_op;
+}
+
+void bench_levels(const std::vector<uint8_t>& itch_data) {
+    std::cout << "=== Level Storage Benchmark ===" << std::endl;
+
+    auto messages = normalize_day(itch_data);
+    std::cout << "Book messages:  " << messages.size() << std::endl;
+    std::cout << std::endl;
+
+    double ladder = bench_level_storage<book::LadderLevelStorage>(
+        "Dense price ladder:", messages);
+    double tree = bench_level_storage<book::MapLevelStorage>(
+        "std::map levels:", messages);
+
+    std::cout << std::endl;
+    std::cout << "Ladder speedup: " << std::fixed << std::setprecision(2)
+              << tree / ladder << "x (full engine)" << std::endl;
+    std::cout << std::endl;
+
+    // Same day with the order table factored out: level containers only
+    auto ops = extract_level_ops(messages);
+    std::cout << "Level ops:      " << ops.size() << std::endl;
+    std::cout << std::endl;
+
+    ladder = bench_level_ops<book::LadderLevelStorage>("Dense price ladder:", ops);
+    tree = bench_level_ops<book::MapLevelStorage>("std::map levels:", ops);
+
+    std::cout << std::endl;
+    std::cout << "Ladder speedup: " << std::fixed << std::setprecision(2)
+              << tree / ladder << "x (level storage only)" << std::endl;
+    std::cout << std::endl;
+}
+
+/**
+ * Depth feed volume: order events in vs level deltas out for top N
+ * The delta ring is drained after every message, as a consumer would.
+ */
+void bench_depth(const std::vector<uint8_t>& itch_data) {
+    std::cout << "=== Depth Feed Volume ===" << std::endl;
+
+    auto messages = normalize_day(itch_data);
+    std::cout << "Book messages:  " << messages.size() << std::endl;
+    std::cout << std::endl;
+
+    std::cout << std::setw(8) << "Levels"
+              << std::setw(14) << "Deltas"
+              << std::setw(12) << "Reduction"
+              << std::setw(14) << "ns/msg" << std::endl;
+
+    for (size_t levels : {1, 5, 10}) {
+        auto engine = std::make_unique<book::BookEngine>();
+        auto ring = std::make_unique<book::DepthFeed::DeltaBuffer>();
+        book::DepthFeed feed(levels, *ring);
+        engine->set_depth_feed(&feed);
+
+        uint64_t drained = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const auto& msg : messages) {
+            engine->apply(msg);
+            while (ring->try_pop()) {
+                ++drained;
+            }
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+        std::cout << std::setw(8) << levels
+                  << std::setw(14) << drained
+                  << std::setw(11) << std::fixed << std::setprecision(1)
+                  << (drained ? static_cast<double>(messages.size()) / drained : 0.0) << "x"
+                  << std::setw(14) << std::setprecision(1) << ns / messages.size() << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  Order Book Engine Benchmark" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << std::endl;
+
+    std::vector<uint8_t> itch_data;
+    if (argc > 1) {
+        std::cout << "Input:          " << argv[1] << std::endl;
+        itch_data = load_file(argv[1]);
+        if (itch_data.empty()) {
+            std::cerr << "Failed to read " << argv[1] << std::endl;
+            return 1;
+        }
+    } else {
+        std::cout << "Input:          synthetic day (" << NUM_MESSAGES << " messages, "
+                  << NUM_SYMBOLS << " symbols)" << std::endl;
+        SyntheticDay day;
+        itch_data = day.generate(NUM_MESSAGES);
+    }
+    std::cout << std::endl;
+
+    bench_replay(itch_data);
+    bench_levels(itch_data);
+    bench_depth(itch_data);
+
+    std::cout << "==================================================" << std::endl;
+
+    return 0;
+}
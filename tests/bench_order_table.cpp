@@ -0,0 +1,358 @@
+/**
+ * Benchmark for the order reference table
+ *
+ * Compares book::OrderTable (open addressing + node arena) against
+ * std::unordered_map on the same order-reference operation trace.
+ *
+ * Measures:
+ * - Mixed insert/find/erase throughput on a day-shaped trace
+ * - Steady-state lookup latency against a large resting order set
+ *
+ * Usage:
+ *   ./bench_order_table                  # Synthetic trace
+ *   ./bench_order_table 01302019.NASDAQ_ITCH50   # Trace from a real ITCH file
+ */
+
+#include "../include/book/order_book.hpp"
+#include "../include/book/order_table.hpp"
+#include "../include/itch5/parser.hpp"
+#include "../include/common/endian.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <vector>
+#include <unordered_map>
+#include <random>
+#include <algorithm>
+
+using namespace hft;
+using namespace hft::book;
+
+// Configuration
+constexpr size_t NUM_OPERATIONS = 20'000'000;
+constexpr size_t LOOKUP_OPERATIONS = 20'000'000;
+
+// One step of the order-reference workload
+struct RefOp {
+    enum Kind : uint8_t { Insert, Find, Erase, Replace } kind;
+    OrderRef ref;
+    OrderRef new_ref;   // Replace only
+};
+
+struct Trace {
+    std::vector<RefOp> ops;
+    size_t max_live = 0;
+    size_t inserts = 0;
+};
+
+/**
+ * Synthetic trace with ITCH-like reference behaviour:
+ * - References are assigned sequentially
+ * - Most orders are cancelled within a few hundred messages
+ * - A long tail rests for the whole day
+ */
+Trace synthetic_trace(size_t num_ops) {
+    Trace trace;
+    trace.ops.reserve(num_ops);
+
+    std::mt19937_64 rng(42);
+    std::vector<OrderRef> live;
+    live.reserve(num_ops / 4);
+    OrderRef next_ref = 1;
+
+    auto pick = [&]() -> size_t {
+        size_t n = live.size();
+        if ((rng() & 7) == 0) {
+            return rng() % n;
+        }
+        return n - 1 - rng() % std::min<size_t>(n, 256);
+    };
+
+    for (size_t i = 0; i < num_ops; ++i) {
+        int r = static_cast<int>(rng() % 100);
+
+        if (live.size() < 1000 || r < 45) {
+            live.push_back(next_ref);
+            trace.ops.push_back({RefOp::Insert, next_ref++, 0});
+            ++trace.inserts;
+        } else if (r < 85) {
+            size_t idx = pick();
+            trace.ops.push_back({RefOp::Erase, live[idx], 0});
+            live[idx] = live.back();
+            live.pop_back();
+        } else if (r < 93) {
+            trace.ops.push_back({RefOp::Find, live[pick()], 0});
+        } else {
+            size_t idx = pick();
+            trace.ops.push_back({RefOp::Replace, live[idx], next_ref});
+            live[idx] = next_ref++;
+            ++trace.inserts;
+        }
+        trace.max_live = std::max(trace.max_live, live.size());
+    }
+    return trace;
+}
+
+// Trace extracted from a real ITCH file (2-byte length-prefixed messages)
+Trace file_trace(const char* path) {
+    Trace trace;
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return trace;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)),
+                              std::istreambuf_iterator<char>());
+
+    itch5::Parser parser;
+    size_t live = 0;
+    auto insert = [&](OrderRef ref) {
+        trace.ops.push_back({RefOp::Insert, ref, 0});
+        ++trace.inserts;
+        trace.max_live = std::max(trace.max_live, ++live);
+    };
+    auto erase = [&](OrderRef ref) {
+        trace.ops.push_back({RefOp::Erase, ref, 0});
+        live = live > 0 ? live - 1 : 0;
+    };
+
+    parser.set_add_order_callback([&](const itch5::AddOrder* m, Timestamp, Price, Quantity) {
+        insert(endian::ntoh64(m->order_reference_number));
+    });
+    parser.set_add_order_mpid_callback([&](const itch5::AddOrderMPID* m, Timestamp, Price, Quantity) {
+        insert(endian::ntoh64(m->order_reference_number));
+    });
+    parser.set_order_executed_callback([&](const itch5::OrderExecuted* m, Timestamp) {
+        trace.ops.push_back({RefOp::Find, endian::ntoh64(m->order_reference_number), 0});
+    });
+    parser.set_order_executed_with_price_callback([&](const itch5::OrderExecutedWithPrice* m, Timestamp, Price) {
+        trace.ops.push_back({RefOp::Find, endian::ntoh64(m->order_reference_number), 0});
+    });
+    parser.set_order_cancel_callback([&](const itch5::OrderCancel* m, Timestamp) {
+        trace.ops.push_back({RefOp::Find, endian::ntoh64(m->order_reference_number), 0});
+    });
+    parser.set_order_delete_callback([&](const itch5::OrderDelete* m, Timestamp) {
+        erase(endian::ntoh64(m->order_reference_number));
+    });
+    parser.set_order_replace_callback([&](const itch5::OrderReplace* m, Timestamp, Price, Quantity) {
+        trace.ops.push_back({RefOp::Replace, endian::ntoh64(m->original_order_reference_number),
+                             endian::ntoh64(m->new_order_reference_number)});
+        ++trace.inserts;
+    });
+
+    size_t offset = 0;
+    while (offset + 2 <= data.size()) {
+        uint16_t len = endian::read_be16(data.data() + offset);
+        offset += 2;
+        if (offset + len > data.size()) break;
+        parser.parse_message(data.data() + offset, len);
+        offset += len;
+    }
+    return trace;
+}
+
+// Run a trace against OrderTable
+uint64_t run_order_table(OrderTable<Order>& table, const Trace& trace) {
+    uint64_t checksum = 0;
+    for (const RefOp& op : trace.ops) {
+        switch (op.kind) {
+            case RefOp::Insert: {
+                auto [node, inserted] = table.try_emplace(op.ref);
+                if (inserted) {
+                    node->ref = op.ref;
+                    node->quantity = 100;
+                }
+                break;
+            }
+            case RefOp::Find:
+                if (Order* node = table.find(op.ref)) {
+                    checksum += node->quantity;
+                }
+                break;
+            case RefOp::Erase:
+                checksum += table.erase(op.ref);
+                break;
+            case RefOp::Replace:
+                if (Order* node = table.find(op.ref)) {
+                    Quantity qty = node->quantity;
+                    table.erase(op.ref);
+                    auto [fresh, inserted] = table.try_emplace(op.new_ref);
+                    if (inserted) {
+                        fresh->ref = op.new_ref;
+                        fresh->quantity = qty;
+                    }
+                }
+                break;
+        }
+    }
+    return checksum;
+}
+
+// Run a trace against std::unordered_map
+uint64_t run_unordered_map(std::unordered_map<OrderRef, Order>& map, const Trace& trace) {
+    uint64_t checksum = 0;
+    for (const RefOp& op : trace.ops) {
+        switch (op.kind) {
+            case RefOp::Insert: {
+                auto [it, inserted] = map.try_emplace(op.ref);
+                if (inserted) {
+                    it->second.ref = op.ref;
+                    it->second.quantity = 100;
+                }
+                break;
+            }
+            case RefOp::Find: {
+                auto it = map.find(op.ref);
+                if (it != map.end()) {
+                    checksum += it->second.quantity;
+                }
+                break;
+            }
+            case RefOp::Erase:
+                checksum += map.erase(op.ref);
+                break;
+            case RefOp::Replace: {
+                auto it = map.find(op.ref);
+                if (it != map.end()) {
+                    Quantity qty = it->second.quantity;
+                    map.erase(it);
+                    auto [fresh, inserted] = map.try_emplace(op.new_ref);
+                    if (inserted) {
+                        fresh->second.ref = op.new_ref;
+                        fresh->second.quantity = qty;
+                    }
+                }
+                break;
+            }
+        }
+    }
+    return checksum;
+}
+
+void print_result(const char* name, size_t ops, int64_t duration_ns, uint64_t checksum) {
+    double ops_per_sec = static_cast<double>(ops) * 1e9 / duration_ns;
+    std::cout << name << std::endl;
+    std::cout << "  Total time:   " << std::fixed << std::setprecision(2)
+              << duration_ns / 1e6 << " ms" << std::endl;
+    std::cout << "  Throughput:   " << std::fixed << std::setprecision(2)
+              << ops_per_sec / 1e6 << " million ops/sec" << std::endl;
+    std::cout << "  Latency:      " << std::fixed << std::setprecision(1)
+              << static_cast<double>(duration_ns) / ops << " ns/op" << std::endl;
+    std::cout << "  Checksum:     " << checksum << std::endl;
+}
+
+// Benchmark the full trace on both tables
+void bench_trace(const Trace& trace) {
+    std::cout << "=== Order-Reference Trace Benchmark ===" << std::endl;
+    std::cout << "Operations:     " << trace.ops.size() << std::endl;
+    std::cout << "Inserts:        " << trace.inserts << std::endl;
+    std::cout << "Peak live:      " << trace.max_live << std::endl;
+    std::cout << std::endl;
+
+    size_t capacity = trace.max_live + trace.max_live / 4 + 1024;
+
+    {
+        OrderTable<Order> table(capacity);
+        auto start = std::chrono::high_resolution_clock::now();
+        uint64_t checksum = run_order_table(table, trace);
+        auto end = std::chrono::high_resolution_clock::now();
+        print_result("OrderTable (open addressing + arena):", trace.ops.size(),
+                     std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(),
+                     checksum);
+    }
+
+    {
+        std::unordered_map<OrderRef, Order> map;
+        map.reserve(capacity);
+        auto start = std::chrono::high_resolution_clock::now();
+        uint64_t checksum = run_unordered_map(map, trace);
+        auto end = std::chrono::high_resolution_clock::now();
+        print_result("std::unordered_map (reserved):", trace.ops.size(),
+                     std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(),
+                     checksum);
+    }
+    std::cout << std::endl;
+}
+
+// Benchmark random lookups against a large resting book
+void bench_lookup(size_t resting) {
+    std::cout << "=== Resting-Order Lookup Benchmark ===" << std::endl;
+    std::cout << "Resting orders: " << resting << std::endl;
+    std::cout << "Lookups:        " << LOOKUP_OPERATIONS << std::endl;
+    std::cout << std::endl;
+
+    // References are sequential but with holes, as after a day of deletes
+    std::mt19937_64 rng(7);
+    std::vector<OrderRef> refs(resting);
+    OrderRef ref = 1;
+    for (auto& r : refs) {
+        ref += 1 + rng() % 8;
+        r = ref;
+    }
+    std::vector<OrderRef> probes(LOOKUP_OPERATIONS);
+    for (auto& p : probes) {
+        p = refs[rng() % resting];
+    }
+
+    {
+        OrderTable<Order> table(resting);
+        for (OrderRef r : refs) {
+            table.try_emplace(r).first->quantity = 1;
+        }
+        uint64_t sum = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (OrderRef p : probes) {
+            sum += table.find(p)->quantity;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        print_result("OrderTable:", probes.size(),
+                     std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(), sum);
+    }
+
+    {
+        std::unordered_map<OrderRef, Order> map;
+        map.reserve(resting);
+        for (OrderRef r : refs) {
+            map[r].quantity = 1;
+        }
+        uint64_t sum = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (OrderRef p : probes) {
+            sum += map.find(p)->second.quantity;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        print_result("std::unordered_map:", probes.size(),
+                     std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(), sum);
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  Order Reference Table Benchmark" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << std::endl;
+
+    Trace trace;
+    if (argc > 1) {
+        std::cout << "Input:          " << argv[1] << std::endl;
+        trace = file_trace(argv[1]);
+        if (trace.ops.empty()) {
+            std::cerr << "No order messages read from " << argv[1] << std::endl;
+            return 1;
+        }
+    } else {
+        std::cout << "Input:          synthetic trace" << std::endl;
+        trace = synthetic_trace(NUM_OPERATIONS);
+    }
+    std::cout << "Node size:      " << sizeof(Order) << " bytes" << std::endl;
+    std::cout << std::endl;
+
+    bench_trace(trace);
+    bench_lookup(4'000'000);
+
+    std::cout << "==================================================" << std::endl;
+
+    return 0;
+}
@@ -5,10 +5,14 @@
  * - Message parsing throughput
  * - Different message types
  * - Zero-copy performance
+ * - std::function callbacks vs compile-time handler dispatch
+ * - Per-message loops vs batch parsing of files and MoldUDP64 packets
+ * - Switch vs descriptor-table dispatch on a realistic type mix
  */
 
 #include "../include/itch5/messages.hpp"
 #include "../include/itch5/parser.hpp"
+#include "../include/moldudp64/session.hpp"
 #include "../include/common/endian.hpp"
 
 #include <iostream>
@@ -17,6 +21,7 @@
 #include <chrono>
 #include <cstring>
 #include <random>
+#include <algorithm>
 
 using namespace hft;
 using namespace hft::itch5;
@@ -71,19 +76,108 @@ void create_order_delete(OrderDelete& msg, uint64_t order_ref, uint64_t timestam
     msg.order_reference_number = endian::hton64(order_ref);
 }
 
+// Handler for the compile-time dispatch variant: same work as the lambdas
+struct CountingHandler {
+    uint64_t add_count = 0;
+    uint64_t exec_count = 0;
+    uint64_t del_count = 0;
+
+    void on_add_order(const AddOrder*, Timestamp, Price, Quantity) { ++add_count; }
+    void on_order_executed(const OrderExecuted*, Timestamp) { ++exec_count; }
+    void on_order_delete(const OrderDelete*, Timestamp) { ++del_count; }
+};
+
+// Parse a buffer of back-to-back messages, returning elapsed nanoseconds
+template <typename ParserT>
+uint64_t parse_buffer(ParserT& parser, const std::vector<uint8_t>& buffer, size_t& parsed_count) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    size_t offset = 0;
+    parsed_count = 0;
+    while (offset < buffer.size()) {
+        char msg_type = static_cast<char>(buffer[offset]);
+        size_t msg_size = get_message_size(msg_type);
+        if (msg_size == 0 || offset + msg_size > buffer.size()) break;
+
+        parser.parse_message(buffer.data() + offset, msg_size);
+        offset += msg_size;
+        ++parsed_count;
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+void print_parse_result(const char* name, size_t count, size_t bytes, uint64_t duration) {
+    double msgs_per_sec = static_cast<double>(count) * 1e9 / duration;
+    double ns_per_msg = static_cast<double>(duration) / count;
+    double bytes_per_sec = static_cast<double>(bytes) * 1e9 / duration;
+
+    std::cout << name << std::endl;
+    std::cout << "  Total time:     " << std::fixed << std::setprecision(2)
+              << duration / 1e6 << " ms" << std::endl;
+    std::cout << "  Throughput:     " << std::fixed << std::setprecision(2)
+              << msgs_per_sec / 1e6 << " million msgs/sec" << std::endl;
+    std::cout << "  Bandwidth:      " << std::fixed << std::setprecision(2)
+              << bytes_per_sec / 1e9 << " GB/sec" << std::endl;
+    std::cout << "  Latency:        " << std::fixed << std::setprecision(2)
+              << ns_per_msg << " ns/msg" << std::endl;
+}
+
+// Run the std::function and compile-time dispatch parsers over one buffer
+void compare_dispatch(const std::vector<uint8_t>& buffer) {
+    uint64_t add_count = 0, exec_count = 0, del_count = 0;
+
+    Parser callback_parser;
+    callback_parser.set_add_order_callback(
+        [&](const AddOrder*, Timestamp, Price, Quantity) { ++add_count; });
+    callback_parser.set_order_executed_callback(
+        [&](const OrderExecuted*, Timestamp) { ++exec_count; });
+    callback_parser.set_order_delete_callback(
+        [&](const OrderDelete*, Timestamp) { ++del_count; });
+
+    CountingHandler handler;
+    BasicParser<CountingHandler> static_parser(handler);
+
+    size_t callback_parsed = 0;
+    size_t static_parsed = 0;
+
+    // Warm-up pass so neither variant pays for the first touch of the buffer
+    parse_buffer(callback_parser, buffer, callback_parsed);
+    add_count = exec_count = del_count = 0;
+
+    uint64_t callback_ns = parse_buffer(callback_parser, buffer, callback_parsed);
+    uint64_t static_ns = parse_buffer(static_parser, buffer, static_parsed);
+
+    std::cout << "Messages:       " << static_parsed << std::endl;
+    std::cout << "Buffer size:    " << buffer.size() / 1024 << " KB" << std::endl;
+    std::cout << std::endl;
+    print_parse_result("std::function callbacks:", callback_parsed, buffer.size(), callback_ns);
+    print_parse_result("Compile-time dispatch:", static_parsed, buffer.size(), static_ns);
+    std::cout << std::endl;
+    std::cout << "Speedup:        " << std::fixed << std::setprecision(2)
+              << static_cast<double>(callback_ns) / static_ns << "x" << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "Message distribution:" << std::endl;
+    std::cout << "  AddOrder:      " << handler.add_count << " ("
+              << std::fixed << std::setprecision(1)
+              << 100.0 * handler.add_count / static_parsed << "%)" << std::endl;
+    std::cout << "  OrderExecuted: " << handler.exec_count << " ("
+              << 100.0 * handler.exec_count / static_parsed << "%)" << std::endl;
+    std::cout << "  OrderDelete:   " << handler.del_count << " ("
+              << 100.0 * handler.del_count / static_parsed << "%)" << std::endl;
+    std::cout << "Callback count: " << add_count + exec_count + del_count
+              << " (std::function), "
+              << handler.add_count + handler.exec_count + handler.del_count
+              << " (static)" << std::endl;
+    std::cout << std::endl;
+}
+
 // Benchmark AddOrder parsing only
 void bench_add_order_parsing() {
     std::cout << "=== AddOrder Parsing Benchmark ===" << std::endl;
 
-    Parser parser;
-    uint64_t callback_count = 0;
-
-    parser.set_add_order_callback(
-        [&](const AddOrder* msg, Timestamp ts, Price price, Quantity qty) {
-            ++callback_count;
-        }
-    );
-
     // Create buffer of AddOrder messages
     std::vector<uint8_t> buffer(sizeof(AddOrder) * NUM_MESSAGES);
     uint8_t* ptr = buffer.data();
@@ -96,58 +190,14 @@ void bench_add_order_parsing() {
         timestamp += 1000;
     }
 
-    // Benchmark parsing
-    auto start = std::chrono::high_resolution_clock::now();
-
-    ptr = buffer.data();
-    for (size_t i = 0; i < NUM_MESSAGES; ++i) {
-        parser.parse_message(ptr, sizeof(AddOrder));
-        ptr += sizeof(AddOrder);
-    }
-
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
-
-    double msgs_per_sec = static_cast<double>(NUM_MESSAGES) * 1e9 / duration;
-    double ns_per_msg = static_cast<double>(duration) / NUM_MESSAGES;
-    double bytes_per_sec = static_cast<double>(buffer.size()) * 1e9 / duration;
-
-    std::cout << "Messages:       " << NUM_MESSAGES << std::endl;
     std::cout << "Message size:   " << sizeof(AddOrder) << " bytes" << std::endl;
-    std::cout << "Total time:     " << duration / 1e6 << " ms" << std::endl;
-    std::cout << "Throughput:     " << std::fixed << std::setprecision(2)
-              << msgs_per_sec / 1e6 << " million msgs/sec" << std::endl;
-    std::cout << "Bandwidth:      " << std::fixed << std::setprecision(2)
-              << bytes_per_sec / 1e9 << " GB/sec" << std::endl;
-    std::cout << "Latency:        " << std::fixed << std::setprecision(1)
-              << ns_per_msg << " ns/msg" << std::endl;
-    std::cout << "Callback count: " << callback_count << std::endl;
-    std::cout << std::endl;
+    compare_dispatch(buffer);
 }
 
 // Benchmark mixed message parsing (realistic workload)
 void bench_mixed_messages() {
     std::cout << "=== Mixed Message Parsing Benchmark ===" << std::endl;
 
-    Parser parser;
-    uint64_t add_count = 0, exec_count = 0, del_count = 0;
-
-    parser.set_add_order_callback(
-        [&](const AddOrder* msg, Timestamp ts, Price price, Quantity qty) {
-            ++add_count;
-        }
-    );
-    parser.set_order_executed_callback(
-        [&](const OrderExecuted* msg, Timestamp ts) {
-            ++exec_count;
-        }
-    );
-    parser.set_order_delete_callback(
-        [&](const OrderDelete* msg, Timestamp ts) {
-            ++del_count;
-        }
-    );
-
     // Create buffer with mixed messages
     // Distribution: 60% AddOrder, 30% OrderExecuted, 10% OrderDelete
     std::vector<uint8_t> buffer;
@@ -183,44 +233,7 @@ void bench_mixed_messages() {
         timestamp += 1000;
     }
 
-    // Benchmark parsing
-    auto start = std::chrono::high_resolution_clock::now();
-
-    size_t offset = 0;
-    size_t parsed_count = 0;
-    while (offset < buffer.size()) {
-        char msg_type = static_cast<char>(buffer[offset]);
-        size_t msg_size = get_message_size(msg_type);
-        if (msg_size == 0 || offset + msg_size > buffer.size()) break;
-
-        parser.parse_message(buffer.data() + offset, msg_size);
-        offset += msg_size;
-        ++parsed_count;
-    }
-
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
-
-    double msgs_per_sec = static_cast<double>(parsed_count) * 1e9 / duration;
-    double bytes_per_sec = static_cast<double>(buffer.size()) * 1e9 / duration;
-
-    std::cout << "Messages:       " << parsed_count << std::endl;
-    std::cout << "Buffer size:    " << buffer.size() / 1024 << " KB" << std::endl;
-    std::cout << "Total time:     " << duration / 1e6 << " ms" << std::endl;
-    std::cout << "Throughput:     " << std::fixed << std::setprecision(2)
-              << msgs_per_sec / 1e6 << " million msgs/sec" << std::endl;
-    std::cout << "Bandwidth:      " << std::fixed << std::setprecision(2)
-              << bytes_per_sec / 1e9 << " GB/sec" << std::endl;
-    std::cout << std::endl;
-    std::cout << "Message distribution:" << std::endl;
-    std::cout << "  AddOrder:      " << add_count << " ("
-              << std::fixed << std::setprecision(1)
-              << 100.0 * add_count / parsed_count << "%)" << std::endl;
-    std::cout << "  OrderExecuted: " << exec_count << " ("
-              << 100.0 * exec_count / parsed_count << "%)" << std::endl;
-    std::cout << "  OrderDelete:   " << del_count << " ("
-              << 100.0 * del_count / parsed_count << "%)" << std::endl;
-    std::cout << std::endl;
+    compare_dispatch(buffer);
 }
 
 // Benchmark endianness conversion
@@ -310,6 +323,415 @@ void bench_zero_copy() {
     std::cout << std::endl;
 }
 
+// Benchmark batch parsing of length-prefixed buffers (file chunks and MoldUDP64 packets)
+void bench_batch_parsing() {
+    std::cout << "=== Batch Parsing Benchmark ===" << std::endl;
+
+    constexpr size_t BATCH_MESSAGES = 4'000'000;
+    constexpr uint16_t MESSAGES_PER_PACKET = 24;
+
+    // Length-prefixed mixed stream, same distribution as above
+    std::vector<uint8_t> stream;
+    stream.reserve(BATCH_MESSAGES * (2 + sizeof(AddOrder)));
+    std::mt19937 rng(7);
+    uint64_t timestamp = 34200000000000ULL;
+
+    auto append = [&](const void* msg, size_t size) {
+        stream.push_back(static_cast<uint8_t>(size >> 8));
+        stream.push_back(static_cast<uint8_t>(size & 0xFF));
+        const uint8_t* data = static_cast<const uint8_t*>(msg);
+        stream.insert(stream.end(), data, data + size);
+    };
+
+    std::vector<size_t> block_offsets;
+    block_offsets.reserve(BATCH_MESSAGES + 1);
+    for (size_t i = 0; i < BATCH_MESSAGES; ++i) {
+        block_offsets.push_back(stream.size());
+        int type = static_cast<int>(rng() % 100);
+        if (type < 60) {
+            AddOrder msg;
+            create_add_order(msg, i, timestamp);
+            append(&msg, sizeof(msg));
+        } else if (type < 90) {
+            OrderExecuted msg;
+            create_order_executed(msg, i, timestamp);
+            append(&msg, sizeof(msg));
+        } else {
+            OrderDelete msg;
+            create_order_delete(msg, i, timestamp);
+            append(&msg, sizeof(msg));
+        }
+        timestamp += 1000;
+    }
+    block_offsets.push_back(stream.size());
+
+    // Same stream cut into MoldUDP64 packets
+    std::vector<std::vector<uint8_t>> packets;
+    SequenceNumber seq = 1;
+    for (size_t first = 0; first < BATCH_MESSAGES; first += MESSAGES_PER_PACKET) {
+        size_t last = std::min(first + MESSAGES_PER_PACKET, BATCH_MESSAGES);
+        std::vector<uint8_t> packet(sizeof(moldudp64::Header));
+        std::memcpy(packet.data(), "BENCH     ", 10);
+        uint64_t seq_be = endian::hton64(seq);
+        uint16_t count_be = endian::hton16(static_cast<uint16_t>(last - first));
+        std::memcpy(packet.data() + 10, &seq_be, 8);
+        std::memcpy(packet.data() + 18, &count_be, 2);
+        packet.insert(packet.end(), stream.begin() + block_offsets[first],
+                      stream.begin() + block_offsets[last]);
+        packets.push_back(std::move(packet));
+        seq += last - first;
+    }
+
+    std::cout << "Messages:       " << BATCH_MESSAGES << std::endl;
+    std::cout << "Stream size:    " << stream.size() / 1024 << " KB" << std::endl;
+    std::cout << "Packets:        " << packets.size() << " (" << MESSAGES_PER_PACKET
+              << " msgs each)" << std::endl;
+    std::cout << std::endl;
+
+    CountingHandler handler;
+
+    // File chunk: caller-side loop, one parse_message call per block
+    auto per_message_file = [&]() {
+        BasicParser<CountingHandler> parser(handler);
+        auto start = std::chrono::high_resolution_clock::now();
+        size_t offset = 0;
+        while (offset + 2 < stream.size()) {
+            uint16_t msg_len = endian::read_be16(stream.data() + offset);
+            offset += 2;
+            if (offset + msg_len > stream.size()) break;
+            parser.parse_message(stream.data() + offset, msg_len);
+            offset += msg_len;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    };
+
+    // File chunk: one parse_buffer call
+    auto batch_file = [&]() {
+        BasicParser<CountingHandler> parser(handler);
+        auto start = std::chrono::high_resolution_clock::now();
+        parser.parse_buffer(stream.data(), stream.size());
+        auto end = std::chrono::high_resolution_clock::now();
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    };
+
+    // MoldUDP64: per-message callback from the session
+    auto per_message_session = [&]() {
+        BasicParser<CountingHandler> parser(handler);
+        moldudp64::Session session;
+        session.set_message_callback(
+            [&](const uint8_t* data, uint16_t length, SequenceNumber) {
+                parser.parse_message(data, length);
+            });
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const auto& packet : packets) {
+            session.process_packet(packet.data(), packet.size());
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    };
+
+    // MoldUDP64: one packet callback, parser walks the blocks
+    auto batch_session = [&]() {
+        BasicParser<CountingHandler> parser(handler);
+        moldudp64::Session session;
+        session.set_packet_callback(
+            [&](const uint8_t* blocks, size_t length, uint16_t count, SequenceNumber) {
+                return parser.parse_buffer(blocks, length, count).blocks;
+            });
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const auto& packet : packets) {
+            session.process_packet(packet.data(), packet.size());
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    };
+
+    // Warm-up so the first variant doesn't pay for page faults
+    per_message_file();
+
+    uint64_t file_loop = per_message_file();
+    uint64_t file_batch = batch_file();
+    uint64_t session_loop = per_message_session();
+    uint64_t session_batch = batch_session();
+
+    print_parse_result("File chunk, per-message loop:", BATCH_MESSAGES, stream.size(), file_loop);
+    print_parse_result("File chunk, parse_buffer:", BATCH_MESSAGES, stream.size(), file_batch);
+    std::cout << "  Speedup:        " << std::fixed << std::setprecision(2)
+              << static_cast<double>(file_loop) / file_batch << "x" << std::endl;
+    std::cout << std::endl;
+    print_parse_result("MoldUDP64, per-message callback:", BATCH_MESSAGES, stream.size(), session_loop);
+    print_parse_result("MoldUDP64, packet callback:", BATCH_MESSAGES, stream.size(), session_batch);
+    std::cout << "  Speedup:        " << std::fixed << std::setprecision(2)
+              << static_cast<double>(session_loop) / session_batch << "x" << std::endl;
+    std::cout << std::endl;
+}
+
+// Handler touching every book-relevant type (same work for both dispatchers)
+struct SummingHandler {
+    uint64_t sum = 0;
+
+    void on_add_order(const AddOrder*, Timestamp ts, Price price, Quantity qty) { sum += ts + price + qty; }
+    void on_add_order_mpid(const AddOrderMPID*, Timestamp ts, Price price, Quantity qty) { sum += ts + price + qty; }
+    void on_order_executed(const OrderExecuted*, Timestamp ts) { sum += ts; }
+    void on_order_executed_with_price(const OrderExecutedWithPrice*, Timestamp ts, Price price) { sum += ts + price; }
+    void on_order_cancel(const OrderCancel*, Timestamp ts) { sum += ts; }
+    void on_order_delete(const OrderDelete*, Timestamp ts) { sum += ts; }
+    void on_order_replace(const OrderReplace*, Timestamp ts, Price price, Quantity qty) { sum += ts + price + qty; }
+    void on_trade(const Trade*, Timestamp ts, Price price, Quantity qty) { sum += ts + price + qty; }
+    void on_stock_directory(const StockDirectory*, Timestamp ts) { sum += ts; }
+};
+
+/**
+ * Previous dispatch scheme, kept here as the baseline: a size switch for
+ * validation, a second switch on the type byte, and named counters
+ */
+template <typename Handler>
+class SwitchDispatchParser {
+public:
+    explicit SwitchDispatchParser(Handler& handler) : handler_(handler) {}
+
+    size_t parse_message(const uint8_t* data, size_t len) {
+        if (len < 1) return 0;
+        char type = static_cast<char>(data[0]);
+        size_t expected = message_size(type);
+        if (expected == 0 || len < expected) return 0;
+
+        switch (type) {
+            case msg_type::AddOrder: {
+                ++add_orders_;
+                auto* m = reinterpret_cast<const AddOrder*>(data);
+                handler_.on_add_order(m, endian::read_be48(m->timestamp),
+                                      static_cast<Price>(endian::ntoh32(m->price)) * 100,
+                                      endian::ntoh32(m->shares));
+                break;
+            }
+            case msg_type::AddOrderMPID: {
+                ++add_orders_;
+                auto* m = reinterpret_cast<const AddOrderMPID*>(data);
+                handler_.on_add_order_mpid(m, endian::read_be48(m->timestamp),
+                                           static_cast<Price>(endian::ntoh32(m->price)) * 100,
+                                           endian::ntoh32(m->shares));
+                break;
+            }
+            case msg_type::OrderExecuted: {
+                ++order_executed_;
+                auto* m = reinterpret_cast<const OrderExecuted*>(data);
+                handler_.on_order_executed(m, endian::read_be48(m->timestamp));
+                break;
+            }
+            case msg_type::OrderExecutedWithPrice: {
+                ++order_executed_;
+                auto* m = reinterpret_cast<const OrderExecutedWithPrice*>(data);
+                handler_.on_order_executed_with_price(m, endian::read_be48(m->timestamp),
+                    static_cast<Price>(endian::ntoh32(m->execution_price)) * 100);
+                break;
+            }
+            case msg_type::OrderCancel: {
+                ++order_cancelled_;
+                auto* m = reinterpret_cast<const OrderCancel*>(data);
+                handler_.on_order_cancel(m, endian::read_be48(m->timestamp));
+                break;
+            }
+            case msg_type::OrderDelete: {
+                ++order_deleted_;
+                auto* m = reinterpret_cast<const OrderDelete*>(data);
+                handler_.on_order_delete(m, endian::read_be48(m->timestamp));
+                break;
+            }
+            case msg_type::OrderReplace: {
+                ++order_replaced_;
+                auto* m = reinterpret_cast<const OrderReplace*>(data);
+                handler_.on_order_replace(m, endian::read_be48(m->timestamp),
+                                          static_cast<Price>(endian::ntoh32(m->price)) * 100,
+                                          endian::ntoh32(m->shares));
+                break;
+            }
+            case msg_type::Trade: {
+                ++trades_;
+                auto* m = reinterpret_cast<const Trade*>(data);
+                handler_.on_trade(m, endian::read_be48(m->timestamp),
+                                  static_cast<Price>(endian::ntoh32(m->price)) * 100,
+                                  endian::ntoh32(m->shares));
+                break;
+            }
+            case msg_type::StockDirectory: {
+                ++other_;
+                auto* m = reinterpret_cast<const StockDirectory*>(data);
+                handler_.on_stock_directory(m, endian::read_be48(m->timestamp));
+                break;
+            }
+            case msg_type::SystemEvent:
+            case msg_type::StockTradingAction:
+            case msg_type::RegSHORestriction:
+            case msg_type::MarketParticipantPosition:
+            case msg_type::MWCBDecline:
+            case msg_type::MWCBStatus:
+            case msg_type::IPOQuotingPeriod:
+            case msg_type::LULDAuctionCollar:
+            case msg_type::OperationalHalt:
+            case msg_type::CrossTrade:
+            case msg_type::BrokenTrade:
+            case msg_type::NOII:
+            case msg_type::RPII:
+                ++other_;
+                break;
+            default:
+                ++unknown_;
+                break;
+        }
+        ++total_;
+        return expected;
+    }
+
+    uint64_t total() const { return total_; }
+
+private:
+    static size_t message_size(char type) {
+        switch (type) {
+            case msg_type::SystemEvent:              return sizeof(SystemEvent);
+            case msg_type::StockDirectory:           return sizeof(StockDirectory);
+            case msg_type::StockTradingAction:       return sizeof(StockTradingAction);
+            case msg_type::RegSHORestriction:        return sizeof(RegSHORestriction);
+            case msg_type::MarketParticipantPosition: return sizeof(MarketParticipantPosition);
+            case msg_type::MWCBDecline:              return sizeof(MWCBDecline);
+            case msg_type::MWCBStatus:               return sizeof(MWCBStatus);
+            case msg_type::IPOQuotingPeriod:         return sizeof(IPOQuotingPeriod);
+            case msg_type::LULDAuctionCollar:        return sizeof(LULDAuctionCollar);
+            case msg_type::OperationalHalt:          return sizeof(OperationalHalt);
+            case msg_type::AddOrder:                 return sizeof(AddOrder);
+            case msg_type::AddOrderMPID:             return sizeof(AddOrderMPID);
+            case msg_type::OrderExecuted:            return sizeof(OrderExecuted);
+            case msg_type::OrderExecutedWithPrice:   return sizeof(OrderExecutedWithPrice);
+            case msg_type::OrderCancel:              return sizeof(OrderCancel);
+            case msg_type::OrderDelete:              return sizeof(OrderDelete);
+            case msg_type::OrderReplace:             return sizeof(OrderReplace);
+            case msg_type::Trade:                    return sizeof(Trade);
+            case msg_type::CrossTrade:               return sizeof(CrossTrade);
+            case msg_type::BrokenTrade:              return sizeof(BrokenTrade);
+            case msg_type::NOII:                     return sizeof(NOII);
+            case msg_type::RPII:                     return sizeof(RPII);
+            default:                                 return 0;
+        }
+    }
+
+    Handler& handler_;
+    uint64_t total_ = 0;
+    uint64_t add_orders_ = 0;
+    uint64_t order_executed_ = 0;
+    uint64_t order_cancelled_ = 0;
+    uint64_t order_deleted_ = 0;
+    uint64_t order_replaced_ = 0;
+    uint64_t trades_ = 0;
+    uint64_t other_ = 0;
+    uint64_t unknown_ = 0;
+};
+
+// Benchmark switch vs table dispatch on a realistic message-type mix
+void bench_dispatch_mix() {
+    std::cout << "=== Dispatch Benchmark (realistic type mix) ===" << std::endl;
+
+    // Cache-resident stream replayed many times, so the comparison is
+    // dispatch cost rather than memory bandwidth
+    constexpr size_t MIX_MESSAGES = 16'384;
+    constexpr int MIX_PASSES = 250;
+
+    // Approximate per-mille shares of a full NASDAQ TotalView-ITCH day
+    struct Share { char type; int per_mille; };
+    const Share mix[] = {
+        {'A', 415}, {'D', 396}, {'U', 75}, {'I', 59}, {'E', 21}, {'X', 12},
+        {'F', 6}, {'N', 5}, {'P', 4}, {'L', 2}, {'R', 2}, {'C', 1}, {'H', 1}, {'Y', 1},
+    };
+
+    std::vector<char> pick;
+    for (const Share& share : mix) {
+        pick.insert(pick.end(), share.per_mille, share.type);
+    }
+
+    std::vector<uint8_t> stream;
+    stream.reserve(MIX_MESSAGES * 40);
+    std::mt19937_64 rng(11);
+    uint64_t timestamp = 34200000000000ULL;
+
+    for (size_t i = 0; i < MIX_MESSAGES; ++i) {
+        char type = pick[rng() % pick.size()];
+        size_t size = get_message_size(type);
+
+        uint8_t msg[64] = {};
+        msg[0] = static_cast<uint8_t>(type);
+        set_timestamp(msg + 5, timestamp);
+        uint64_t payload = rng();
+        std::memcpy(msg + 11, &payload, std::min<size_t>(8, size - 11));
+
+        stream.push_back(0);
+        stream.push_back(static_cast<uint8_t>(size));
+        stream.insert(stream.end(), msg, msg + size);
+        timestamp += 500;
+    }
+
+    auto run = [&](auto& parser) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int pass = 0; pass < MIX_PASSES; ++pass) {
+            size_t offset = 0;
+            while (offset + 2 <= stream.size()) {
+                uint16_t msg_len = endian::read_be16(stream.data() + offset);
+                offset += 2;
+                parser.parse_message(stream.data() + offset, msg_len);
+                offset += msg_len;
+            }
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    };
+
+    SummingHandler switch_handler;
+    SummingHandler table_handler;
+    SwitchDispatchParser<SummingHandler> switch_parser(switch_handler);
+    BasicParser<SummingHandler> table_parser(table_handler);
+
+    // Warm-up pass over the stream
+    {
+        SummingHandler warm_handler;
+        BasicParser<SummingHandler> warm(warm_handler);
+        run(warm);
+    }
+
+    uint64_t switch_ns = run(switch_parser);
+    uint64_t table_ns = run(table_parser);
+
+    constexpr size_t total = MIX_MESSAGES * MIX_PASSES;
+    std::cout << "Messages:       " << MIX_MESSAGES << " x " << MIX_PASSES << " passes ("
+              << sizeof(mix) / sizeof(mix[0]) << " types)" << std::endl;
+    std::cout << "Stream size:    " << stream.size() / 1024 << " KB" << std::endl;
+    std::cout << std::endl;
+    print_parse_result("Switch dispatch (size switch + type switch):", total,
+                       stream.size() * MIX_PASSES, switch_ns);
+    print_parse_result("Descriptor table dispatch:", total, stream.size() * MIX_PASSES, table_ns);
+    std::cout << std::endl;
+    std::cout << "Speedup:        " << std::fixed << std::setprecision(2)
+              << static_cast<double>(switch_ns) / table_ns << "x" << std::endl;
+    std::cout << "Checksums:      " << (switch_handler.sum == table_handler.sum ? "match" : "MISMATCH")
+              << std::endl;
+    std::cout << std::endl;
+
+    const auto& stats = table_parser.get_stats();
+    std::cout << "Per-type counts:" << std::endl;
+    for (size_t k = 1; k < MESSAGE_KIND_COUNT; ++k) {
+        uint64_t n = stats.by_type[k];
+        if (n == 0) continue;
+        const MessageDescriptor* desc = find_descriptor(static_cast<MessageKind>(k));
+        std::cout << "  " << desc->type << ": " << std::setw(9) << n << " ("
+                  << std::fixed << std::setprecision(1) << 100.0 * n / stats.total_messages
+                  << "%)" << std::endl;
+    }
+    std::cout << std::endl;
+}
+
 int main() {
     std::cout << "==================================================" << std::endl;
     std::cout << "  ITCH 5.0 Parser Benchmark" << std::endl;
@@ -326,6 +748,8 @@ int main() {
     bench_zero_copy();
     bench_add_order_parsing();
     bench_mixed_messages();
+    bench_batch_parsing();
+    bench_dispatch_mix();
 
     std::cout << "==================================================" << std::endl;
 
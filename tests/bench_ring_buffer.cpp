@@ -5,9 +5,19 @@
  * - Single-threaded throughput
  * - Producer-consumer throughput with core pinning
  * - Latency distribution
+ * - Cross-core throughput and p99, cached vs uncached ring indices
+ * - Compact 32-byte vs previous 64-byte NormalizedMessage layout
+ * - Bulk batch enqueue/dequeue vs item-by-item loops
+ * - In-place claim/commit and front/release vs copying push/pop
+ * - Byte ring throughput for packet-sized raw records
+ * - MPSC queue vs N polled SPSC rings with 2, 4 and 8 producers
+ * - Wait strategies: wake-up latency after an idle gap and idle CPU cost
+ * - Run-time sized ring storage: hugepage vs 4 KB page backing
  */
 
 #include "../include/spsc/ring_buffer.hpp"
+#include "../include/spsc/byte_ring.hpp"
+#include "../include/spsc/mpsc_queue.hpp"
 #include "../include/common/types.hpp"
 
 #include <iostream>
@@ -18,10 +28,15 @@
 #include <vector>
 #include <algorithm>
 #include <numeric>
+#include <memory>
+#include <optional>
+#include <array>
+#include <type_traits>
 
 #ifdef __linux__
 #include <sched.h>
 #include <pthread.h>
+#include <ctime>
 #endif
 
 using namespace hft;
@@ -238,40 +253,262 @@ void bench_latency() {
     std::cout << std::endl;
 }
 
-// Benchmark with NormalizedMessage (realistic workload)
-void bench_normalized_messages() {
-    std::cout << "=== NormalizedMessage Throughput Benchmark ===" << std::endl;
+/**
+ * Previous ring design, kept as the baseline: every push loads the
+ * consumer's tail_ and every pop the producer's head_, so each operation
+ * pulls the other core's cache line
+ */
+template <typename T, size_t Capacity>
+class UncachedRingBuffer {
+public:
+    bool try_push(const T& item) noexcept {
+        const size_t current_head = head_.load(std::memory_order_relaxed);
+        const size_t next_head = (current_head + 1) & (Capacity - 1);
+        if (next_head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        buffer_[current_head] = item;
+        head_.store(next_head, std::memory_order_release);
+        return true;
+    }
+
+    std::optional<T> try_pop() noexcept {
+        const size_t current_tail = tail_.load(std::memory_order_relaxed);
+        if (current_tail == head_.load(std::memory_order_acquire)) {
+            return std::nullopt;
+        }
+        T item = buffer_[current_tail];
+        tail_.store((current_tail + 1) & (Capacity - 1), std::memory_order_release);
+        return item;
+    }
+
+    bool empty() const noexcept {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    alignas(CACHE_LINE_SIZE) std::array<T, Capacity> buffer_{};
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+};
+
+// Spin with pause, yielding now and then so a shared core still progresses
+inline void backoff(uint32_t& spins) {
+    if (++spins % 64 == 0) {
+        std::this_thread::yield();
+    } else {
+#if defined(__x86_64__) || defined(_M_X64)
+        __builtin_ia32_pause();
+#endif
+    }
+}
+
+struct CrossCoreResult {
+    double mops;
+    uint64_t p50;
+    uint64_t p99;
+};
+
+/**
+ * Producer on core 1, consumer on core 2
+ * Throughput: NUM_OPERATIONS back-to-back pushes
+ * Latency: paced pushes carrying their send time, measured at the pop
+ */
+template <typename Ring>
+CrossCoreResult run_cross_core() {
+    CrossCoreResult result{};
+
+    {
+        auto ring = std::make_unique<Ring>();
+        std::atomic<bool> done{false};
+        std::atomic<uint64_t> checksum{0};
+
+        auto start = std::chrono::high_resolution_clock::now();
+        std::thread consumer([&]() {
+            pin_to_core(2);
+            uint64_t sum = 0;
+            uint32_t spins = 0;
+            while (!done.load(std::memory_order_acquire) || !ring->empty()) {
+                if (auto v = ring->try_pop()) {
+                    sum += *v;
+                } else {
+                    backoff(spins);
+                }
+            }
+            checksum.store(sum, std::memory_order_relaxed);
+        });
+
+        pin_to_core(1);
+        uint32_t spins = 0;
+        for (uint64_t i = 0; i < NUM_OPERATIONS; ++i) {
+            while (!ring->try_push(i)) {
+                backoff(spins);
+            }
+        }
+        done.store(true, std::memory_order_release);
+        consumer.join();
+        auto end = std::chrono::high_resolution_clock::now();
+
+        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        result.mops = static_cast<double>(NUM_OPERATIONS) * 1e3 / duration;
+    }
+
+    {
+        auto ring = std::make_unique<Ring>();
+        std::atomic<bool> done{false};
+        std::vector<uint64_t> latencies;
+        latencies.reserve(LATENCY_SAMPLES);
+
+        std::thread consumer([&]() {
+            pin_to_core(2);
+            uint32_t spins = 0;
+            while (!done.load(std::memory_order_acquire) || !ring->empty()) {
+                if (auto sent = ring->try_pop()) {
+                    latencies.push_back(get_nanos() - *sent);
+                } else {
+                    backoff(spins);
+                }
+            }
+        });
+
+        pin_to_core(1);
+        uint32_t spins = 0;
+        for (size_t i = 0; i < LATENCY_SAMPLES; ++i) {
+            while (!ring->try_push(get_nanos())) {
+                backoff(spins);
+            }
+            for (volatile int j = 0; j < 10; ++j) {}
+        }
+        done.store(true, std::memory_order_release);
+        consumer.join();
+
+        std::sort(latencies.begin(), latencies.end());
+        result.p50 = latencies[latencies.size() * 50 / 100];
+        result.p99 = latencies[latencies.size() * 99 / 100];
+    }
+
+    return result;
+}
+
+// Cached-index ring vs the previous design across two cores
+void bench_cross_core() {
+    std::cout << "=== Cross-Core Cached vs Uncached Indices ===" << std::endl;
+    if (std::thread::hardware_concurrency() < 3) {
+        std::cout << "Note: fewer than 3 cores; producer and consumer share a core" << std::endl;
+    }
+
+    CrossCoreResult uncached = run_cross_core<UncachedRingBuffer<uint64_t, BUFFER_SIZE>>();
+    CrossCoreResult cached = run_cross_core<RingBuffer<uint64_t, BUFFER_SIZE>>();
+
+    std::cout << std::setw(12) << "Ring"
+              << std::setw(16) << "Throughput"
+              << std::setw(12) << "P50"
+              << std::setw(12) << "P99" << std::endl;
+
+    auto row = [](const char* name, const CrossCoreResult& r) {
+        std::cout << std::setw(12) << name
+              << std::setw(12) << std::fixed << std::setprecision(2) << r.mops << " M/s"
+              << std::setw(9) << r.p50 << " ns"
+              << std::setw(9) << r.p99 << " ns" << std::endl;
+    };
+    row("Uncached", uncached);
+    row("Cached", cached);
+
+    std::cout << "Speedup:        " << std::fixed << std::setprecision(2)
+              << cached.mops / uncached.mops << "x throughput" << std::endl;
+    std::cout << std::endl;
+}
+
+/**
+ * Previous 64-byte NormalizedMessage layout, kept as the baseline:
+ * generic fields with padding after the type and side bytes
+ */
+struct WideMessage {
+    MessageType type = MessageType::Unknown;
+    StockLocate stock_locate = 0;
+    Timestamp timestamp = 0;
+    OrderRef order_ref = 0;
+    StockSymbol stock{};
+    Side side = Side::Buy;
+    Price price = 0;
+    Quantity quantity = 0;
+    Quantity executed_quantity = 0;
+    OrderRef new_order_ref = 0;
+};
+
+static_assert(sizeof(WideMessage) == 64, "Baseline must match the old layout");
+
+// Build an AddOrder in either layout
+template <typename Msg>
+Msg make_add_order(OrderRef ref) {
+    Msg msg;
+    if constexpr (std::is_same_v<Msg, NormalizedMessage>) {
+        msg.set_type(MessageType::AddOrder);
+        msg.set_timestamp(12345678900000ULL);
+        msg.set_order_ref(ref);
+        msg.set_stock_locate(1);
+        msg.set_side(Side::Buy);
+        msg.set_price(1500000);
+        msg.set_quantity(100);
+    } else {
+        msg.type = MessageType::AddOrder;
+        msg.timestamp = 12345678900000ULL;
+        msg.order_ref = ref;
+        msg.stock_locate = 1;
+        msg.side = Side::Buy;
+        msg.price = 1500000;
+        msg.quantity = 100;
+    }
+    return msg;
+}
+
+template <typename Msg>
+OrderRef order_ref_of(const Msg& msg) {
+    if constexpr (std::is_same_v<Msg, NormalizedMessage>) {
+        return msg.order_ref();
+    } else {
+        return msg.order_ref;
+    }
+}
+
+struct MessageResult {
+    double concurrent_mps;
+    double burst_ns;
+};
 
-    RingBuffer<NormalizedMessage, BUFFER_SIZE> buffer;
+// Producer/consumer throughput plus a single-threaded fill-and-drain pass
+template <typename Msg>
+MessageResult run_message_bench() {
+    auto buffer = std::make_unique<RingBuffer<Msg, BUFFER_SIZE>>();
     std::atomic<bool> done{false};
     std::atomic<uint64_t> consumed{0};
+    std::atomic<uint64_t> checksum{0};
 
-    NormalizedMessage template_msg;
-    template_msg.type = MessageType::AddOrder;
-    template_msg.timestamp = 12345678900000ULL;
-    template_msg.order_ref = 1;
-    template_msg.side = Side::Buy;
-    template_msg.price = 1500000;
-    template_msg.quantity = 100;
+    Msg template_msg = make_add_order<Msg>(1);
 
     std::thread consumer([&]() {
         pin_to_core(2);
+        uint64_t sum = 0;
+        uint64_t count = 0;
 
-        while (!done.load(std::memory_order_acquire) || !buffer.empty()) {
-            if (buffer.try_pop()) {
-                consumed.fetch_add(1, std::memory_order_relaxed);
+        while (!done.load(std::memory_order_acquire) || !buffer->empty()) {
+            if (auto msg = buffer->try_pop()) {
+                sum += order_ref_of(*msg);
+                ++count;
+            } else {
+                std::this_thread::yield();
             }
         }
+        consumed.store(count, std::memory_order_relaxed);
+        checksum.store(sum, std::memory_order_relaxed);
     });
 
     auto start = std::chrono::high_resolution_clock::now();
 
     for (size_t i = 0; i < NUM_OPERATIONS; ++i) {
-        template_msg.order_ref = i;
-        while (!buffer.try_push(template_msg)) {
-#if defined(__x86_64__) || defined(_M_X64)
-            __builtin_ia32_pause();
-#endif
+        template_msg = make_add_order<Msg>(i);
+        while (!buffer->try_push(template_msg)) {
+            std::this_thread::yield();
         }
     }
     done.store(true, std::memory_order_release);
@@ -280,14 +517,555 @@ void bench_normalized_messages() {
 
     auto end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
-    double ops_per_sec = static_cast<double>(NUM_OPERATIONS) * 1e9 / duration;
 
-    std::cout << "Message size:   " << sizeof(NormalizedMessage) << " bytes" << std::endl;
+    // Fill the whole ring, then drain it: the ring's footprint decides
+    // how much of it stays in cache
+    constexpr int BURST_ROUNDS = 50;
+    uint64_t sum = 0;
+    auto burst_start = std::chrono::high_resolution_clock::now();
+    for (int round = 0; round < BURST_ROUNDS; ++round) {
+        size_t pushed = 0;
+        while (buffer->try_push(make_add_order<Msg>(pushed))) {
+            ++pushed;
+        }
+        while (auto msg = buffer->try_pop()) {
+            sum += order_ref_of(*msg);
+        }
+    }
+    auto burst_end = std::chrono::high_resolution_clock::now();
+    auto burst_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(burst_end - burst_start).count();
+
+    MessageResult result;
+    result.concurrent_mps = static_cast<double>(consumed.load()) * 1e3 / duration;
+    result.burst_ns = static_cast<double>(burst_ns) / (BURST_ROUNDS * (BUFFER_SIZE - 1));
+    checksum.fetch_add(sum, std::memory_order_relaxed);
+    return result;
+}
+
+// Benchmark with NormalizedMessage (realistic workload)
+void bench_normalized_messages() {
+    std::cout << "=== NormalizedMessage Throughput Benchmark ===" << std::endl;
+
+    MessageResult wide = run_message_bench<WideMessage>();
+    MessageResult compact = run_message_bench<NormalizedMessage>();
+
     std::cout << "Operations:     " << NUM_OPERATIONS << std::endl;
-    std::cout << "Total time:     " << duration / 1e6 << " ms" << std::endl;
+    std::cout << std::endl;
+    std::cout << std::setw(24) << "Layout"
+              << std::setw(8) << "Size"
+              << std::setw(12) << "Ring"
+              << std::setw(18) << "Producer/consumer"
+              << std::setw(16) << "Fill+drain" << std::endl;
+
+    auto row = [](const char* name, size_t size, const MessageResult& r) {
+        std::cout << std::setw(24) << name
+                  << std::setw(6) << size << " B"
+                  << std::setw(9) << (size * BUFFER_SIZE) / (1024 * 1024) << " MB"
+                  << std::setw(12) << std::fixed << std::setprecision(2) << r.concurrent_mps << " M/s"
+                  << std::setw(11) << std::setprecision(2) << r.burst_ns << " ns/msg" << std::endl;
+    };
+    row("Wide (previous)", sizeof(WideMessage), wide);
+    row("Compact", sizeof(NormalizedMessage), compact);
+
+    std::cout << std::endl;
+    std::cout << "Speedup:        " << std::fixed << std::setprecision(2)
+              << compact.concurrent_mps / wide.concurrent_mps << "x producer/consumer, "
+              << wide.burst_ns / compact.burst_ns << "x fill+drain" << std::endl;
+    std::cout << std::endl;
+}
+
+// Batch size for the bulk enqueue/dequeue comparison
+constexpr size_t BATCH_SIZE = 32;
+
+/**
+ * Producer/consumer NormalizedMessage throughput, moving BATCH_SIZE
+ * messages per step either item by item (the previous BatchRingBuffer
+ * loop) or with one bulk copy and one index publish
+ */
+template <bool Bulk>
+double run_batch_bench() {
+    auto buffer = std::make_unique<RingBuffer<NormalizedMessage, BUFFER_SIZE>>();
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> checksum{0};
+
+    std::array<NormalizedMessage, BATCH_SIZE> in;
+    for (size_t i = 0; i < BATCH_SIZE; ++i) {
+        in[i] = make_add_order<NormalizedMessage>(i);
+    }
+
+    auto push_some = [&](const NormalizedMessage* items, size_t count) -> size_t {
+        if constexpr (Bulk) {
+            return buffer->try_push_batch(items, count);
+        } else {
+            size_t pushed = 0;
+            while (pushed < count && buffer->try_push(items[pushed])) {
+                ++pushed;
+            }
+            return pushed;
+        }
+    };
+
+    auto pop_some = [&](NormalizedMessage* items, size_t max_count) -> size_t {
+        if constexpr (Bulk) {
+            return buffer->try_pop_batch(items, max_count);
+        } else {
+            size_t popped = 0;
+            while (popped < max_count) {
+                auto item = buffer->try_pop();
+                if (!item) {
+                    break;
+                }
+                items[popped++] = *item;
+            }
+            return popped;
+        }
+    };
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::thread consumer([&]() {
+        pin_to_core(2);
+        std::array<NormalizedMessage, BATCH_SIZE> out;
+        uint64_t sum = 0;
+        uint32_t spins = 0;
+        while (!done.load(std::memory_order_acquire) || !buffer->empty()) {
+            size_t n = pop_some(out.data(), out.size());
+            for (size_t i = 0; i < n; ++i) {
+                sum += out[i].order_ref();
+            }
+            if (n == 0) {
+                backoff(spins);
+            }
+        }
+        checksum.store(sum, std::memory_order_relaxed);
+    });
+
+    pin_to_core(1);
+    uint32_t spins = 0;
+    for (size_t sent = 0; sent < NUM_OPERATIONS; sent += BATCH_SIZE) {
+        size_t done_in_batch = 0;
+        while (done_in_batch < BATCH_SIZE) {
+            size_t n = push_some(in.data() + done_in_batch, BATCH_SIZE - done_in_batch);
+            if (n == 0) {
+                backoff(spins);
+            }
+            done_in_batch += n;
+        }
+    }
+    done.store(true, std::memory_order_release);
+    consumer.join();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    return static_cast<double>(NUM_OPERATIONS) * 1e3 / duration;
+}
+
+// Bulk enqueue/dequeue vs item-by-item loops
+void bench_batch() {
+    std::cout << "=== Batch Enqueue/Dequeue Benchmark ===" << std::endl;
+
+    double looped = run_batch_bench<false>();
+    double bulk = run_batch_bench<true>();
+
+    std::cout << "Batch size:     " << BATCH_SIZE << " NormalizedMessages" << std::endl;
+    std::cout << "Per-item loop:  " << std::fixed << std::setprecision(2) << looped << " M msgs/sec" << std::endl;
+    std::cout << "Bulk:           " << std::fixed << std::setprecision(2) << bulk << " M msgs/sec" << std::endl;
+    std::cout << "Speedup:        " << std::fixed << std::setprecision(2) << bulk / looped << "x" << std::endl;
+    std::cout << std::endl;
+}
+
+// Fill an AddOrder in place, as the packet handler's callbacks do
+inline void fill_add_order(NormalizedMessage& msg, uint64_t i) {
+    msg.set_type(MessageType::AddOrder);
+    msg.set_timestamp(34200000000000ULL + i);
+    msg.set_order_ref(i);
+    msg.set_stock_locate(static_cast<StockLocate>(i & 0xFFF));
+    msg.set_side((i & 1) ? Side::Sell : Side::Buy);
+    msg.set_price(1500000);
+    msg.set_quantity(static_cast<Quantity>(100 + (i & 0xFF)));
+}
+
+/**
+ * Producer/consumer NormalizedMessage throughput, one message per ring
+ * operation: stack temporary + try_push / try_pop by value, or
+ * try_claim + commit / front + release in place
+ */
+template <bool InPlace>
+double run_in_place_bench() {
+    auto buffer = std::make_unique<RingBuffer<NormalizedMessage, BUFFER_SIZE>>();
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> checksum{0};
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::thread consumer([&]() {
+        pin_to_core(2);
+        uint64_t sum = 0;
+        uint32_t spins = 0;
+        while (!done.load(std::memory_order_acquire) || !buffer->empty()) {
+            if constexpr (InPlace) {
+                if (const NormalizedMessage* msg = buffer->front()) {
+                    sum += msg->order_ref() + msg->quantity();
+                    buffer->release();
+                    continue;
+                }
+            } else {
+                if (auto msg = buffer->try_pop()) {
+                    sum += msg->order_ref() + msg->quantity();
+                    continue;
+                }
+            }
+            backoff(spins);
+        }
+        checksum.store(sum, std::memory_order_relaxed);
+    });
+
+    pin_to_core(1);
+    uint32_t spins = 0;
+    for (uint64_t i = 0; i < NUM_OPERATIONS; ++i) {
+        if constexpr (InPlace) {
+            NormalizedMessage* slot;
+            while (!(slot = buffer->try_claim())) {
+                backoff(spins);
+            }
+            *slot = NormalizedMessage();
+            fill_add_order(*slot, i);
+            buffer->commit();
+        } else {
+            NormalizedMessage msg;
+            fill_add_order(msg, i);
+            while (!buffer->try_push(msg)) {
+                backoff(spins);
+            }
+        }
+    }
+    done.store(true, std::memory_order_release);
+    consumer.join();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    return static_cast<double>(NUM_OPERATIONS) * 1e3 / duration;
+}
+
+// In-place claim/commit and front/release vs copy in / copy out
+void bench_in_place() {
+    std::cout << "=== In-Place Claim/Commit Benchmark ===" << std::endl;
+
+    double copied = run_in_place_bench<false>();
+    double in_place = run_in_place_bench<true>();
+
+    std::cout << "Copy (push/pop):        " << std::fixed << std::setprecision(2) << copied << " M msgs/sec" << std::endl;
+    std::cout << "In place (claim/front): " << std::fixed << std::setprecision(2) << in_place << " M msgs/sec" << std::endl;
+    std::cout << "Speedup:                " << std::fixed << std::setprecision(2) << in_place / copied << "x" << std::endl;
+    std::cout << std::endl;
+}
+
+/**
+ * Raw passthrough: producer copies packet-sized records (MoldUDP64
+ * message blocks) into the byte ring, consumer touches each and releases
+ */
+void bench_byte_ring() {
+    std::cout << "=== Byte Ring Raw Passthrough Benchmark ===" << std::endl;
+
+    using Ring = ByteRing<1 << 22>;
+    auto ring = std::make_unique<Ring>();
+    constexpr size_t RECORDS = 2'000'000;
+
+    // Typical ITCH packet payloads: a few dozen to ~1400 bytes
+    std::vector<uint8_t> source(1400);
+    for (size_t i = 0; i < source.size(); ++i) {
+        source[i] = static_cast<uint8_t>(i);
+    }
+    auto record_length = [](size_t i) { return 40 + (i * 389) % 1360; };
+
+    std::atomic<uint64_t> checksum{0};
+    uint64_t bytes = 0;
+    for (size_t i = 0; i < RECORDS; ++i) {
+        bytes += record_length(i);
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::thread consumer([&]() {
+        pin_to_core(2);
+        uint64_t sum = 0;
+        uint32_t spins = 0;
+        for (size_t received = 0; received < RECORDS;) {
+            Ring::Record record = ring->front();
+            if (!record) {
+                backoff(spins);
+                continue;
+            }
+            sum += record.data[0] + record.data[record.length - 1] + record.length;
+            ring->release();
+            ++received;
+        }
+        checksum.store(sum, std::memory_order_relaxed);
+    });
+
+    pin_to_core(1);
+    uint32_t spins = 0;
+    for (size_t i = 0; i < RECORDS; ++i) {
+        while (!ring->try_push(source.data(), record_length(i))) {
+            backoff(spins);
+        }
+    }
+    consumer.join();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    std::cout << "Records:        " << RECORDS << " (40-1400 bytes)" << std::endl;
     std::cout << "Throughput:     " << std::fixed << std::setprecision(2)
-              << ops_per_sec / 1e6 << " million msgs/sec" << std::endl;
-    std::cout << "Consumed:       " << consumed.load() << std::endl;
+              << RECORDS * 1e3 / duration << " M records/sec, "
+              << static_cast<double>(bytes) / duration << " GB/s" << std::endl;
+    std::cout << std::endl;
+}
+
+/**
+ * Multi-producer merge: N producers (cores 2..) feeding one consumer
+ * (core 1), either through one MPSC queue or through N SPSC rings the
+ * consumer polls round-robin
+ */
+template <bool Mpsc>
+double run_merge_bench(int num_producers) {
+    using Queue = MpscQueue<uint64_t, BUFFER_SIZE>;
+    using Ring = RingBuffer<uint64_t, BUFFER_SIZE>;
+
+    auto queue = std::make_unique<Queue>();
+    std::vector<std::unique_ptr<Ring>> rings;
+    for (int i = 0; i < num_producers; ++i) {
+        rings.push_back(std::make_unique<Ring>());
+    }
+
+    const uint64_t per_producer = NUM_OPERATIONS / num_producers;
+    const uint64_t total = per_producer * num_producers;
+    std::atomic<bool> start_flag{false};
+    std::atomic<uint64_t> checksum{0};
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&, p]() {
+            pin_to_core(2 + p);
+            while (!start_flag.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            uint32_t spins = 0;
+            for (uint64_t i = 0; i < per_producer; ++i) {
+                if constexpr (Mpsc) {
+                    while (!queue->try_push(i)) {
+                        backoff(spins);
+                    }
+                } else {
+                    while (!rings[p]->try_push(i)) {
+                        backoff(spins);
+                    }
+                }
+            }
+        });
+    }
+
+    pin_to_core(1);
+    auto start = std::chrono::high_resolution_clock::now();
+    start_flag.store(true, std::memory_order_release);
+
+    uint64_t received = 0;
+    uint64_t sum = 0;
+    uint32_t spins = 0;
+    while (received < total) {
+        bool got = false;
+        if constexpr (Mpsc) {
+            while (const uint64_t* v = queue->front()) {
+                sum += *v;
+                queue->release();
+                ++received;
+                got = true;
+            }
+        } else {
+            for (auto& ring : rings) {
+                while (const uint64_t* v = ring->front()) {
+                    sum += *v;
+                    ring->release();
+                    ++received;
+                    got = true;
+                }
+            }
+        }
+        if (!got) {
+            backoff(spins);
+        }
+    }
+
+    for (auto& t : producers) {
+        t.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    checksum.store(sum, std::memory_order_relaxed);
+    return static_cast<double>(total) * 1e3 / duration;
+}
+
+// MPSC queue vs polling one SPSC ring per producer
+void bench_mpsc() {
+    std::cout << "=== Multi-Producer Merge Benchmark ===" << std::endl;
+    if (std::thread::hardware_concurrency() < 10) {
+        std::cout << "Note: fewer cores than producers + consumer; expect scheduler noise" << std::endl;
+    }
+
+    std::cout << std::setw(12) << "Producers"
+              << std::setw(16) << "MPSC queue"
+              << std::setw(16) << "N x SPSC poll"
+              << std::setw(10) << "Ratio" << std::endl;
+
+    for (int n = 2; n <= 8; n *= 2) {
+        double mpsc = run_merge_bench<true>(n);
+        double polled = run_merge_bench<false>(n);
+        std::cout << std::setw(12) << n
+                  << std::setw(12) << std::fixed << std::setprecision(2) << mpsc << " M/s"
+                  << std::setw(12) << polled << " M/s"
+                  << std::setw(9) << mpsc / polled << "x" << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+// Opening-cross sized ring: 32 MB of NormalizedMessage, far past the L2 TLB
+constexpr size_t LARGE_RING_SIZE = size_t{1} << 20;
+
+// Fill-and-drain ns per message through a run-time sized ring
+double run_storage_bench(const MemoryOptions& memory, PageBacking& backing) {
+    RingBuffer<NormalizedMessage, DYNAMIC_CAPACITY> ring(LARGE_RING_SIZE, memory);
+    backing = ring.memory().backing();
+
+    constexpr int ROUNDS = 10;
+    uint64_t sum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int round = 0; round < ROUNDS; ++round) {
+        uint64_t pushed = 0;
+        while (NormalizedMessage* slot = ring.try_claim()) {
+            fill_add_order(*slot, pushed++);
+        }
+        ring.commit();
+        while (const NormalizedMessage* msg = ring.front()) {
+            sum += msg->order_ref();
+            ring.release();
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    volatile uint64_t sink = sum;
+    (void)sink;
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    return static_cast<double>(duration) / (ROUNDS * (LARGE_RING_SIZE - 1));
+}
+
+// Hugepage-backed vs 4 KB page ring storage
+void bench_ring_storage() {
+    std::cout << "=== Run-Time Sized Ring Storage ===" << std::endl;
+    std::cout << "Ring: " << LARGE_RING_SIZE << " x " << sizeof(NormalizedMessage) << " bytes" << std::endl;
+
+    MemoryOptions plain;
+    plain.huge_pages = false;
+    PageBacking plain_backing;
+    PageBacking huge_backing;
+    double plain_ns = run_storage_bench(plain, plain_backing);
+    double huge_ns = run_storage_bench(MemoryOptions{}, huge_backing);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::setw(24) << page_backing_name(plain_backing) << ": " << plain_ns << " ns/msg" << std::endl;
+    std::cout << std::setw(24) << page_backing_name(huge_backing) << ": " << huge_ns << " ns/msg" << std::endl;
+    std::cout << "Speedup:        " << plain_ns / huge_ns << "x" << std::endl;
+    std::cout << std::endl;
+}
+
+// Idle gap before each wake-up sample, long enough to reach the deepest stage
+constexpr auto WAKE_GAP = std::chrono::microseconds(200);
+constexpr size_t WAKE_SAMPLES = 2'000;
+
+// CPU time consumed by the calling thread, in nanoseconds
+inline uint64_t thread_cpu_nanos() {
+#ifdef __linux__
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000ULL + ts.tv_nsec;
+#else
+    return 0;
+#endif
+}
+
+struct WakeResult {
+    uint64_t p50;
+    uint64_t p99;
+    double cpu_percent;  // Consumer CPU time / wall time, mostly idle
+    uint64_t parks;
+};
+
+/**
+ * Consumer blocks in pop(); the producer sleeps WAKE_GAP, then pushes its
+ * send time. Latency is send-to-pop; CPU cost is what the consumer burned
+ * while waiting out the gaps.
+ */
+template <typename Wait>
+WakeResult run_wake_bench() {
+    using Ring = RingBuffer<uint64_t, 1024, Wait>;
+    auto ring = std::make_unique<Ring>();
+    std::vector<uint64_t> latencies;
+    latencies.reserve(WAKE_SAMPLES);
+    uint64_t cpu_nanos = 0;
+    uint64_t wall_nanos = 0;
+
+    std::thread consumer([&]() {
+        pin_to_core(2);
+        const uint64_t cpu_start = thread_cpu_nanos();
+        const uint64_t wall_start = get_nanos();
+        for (size_t i = 0; i < WAKE_SAMPLES; ++i) {
+            const uint64_t sent = ring->pop();
+            latencies.push_back(get_nanos() - sent);
+        }
+        cpu_nanos = thread_cpu_nanos() - cpu_start;
+        wall_nanos = get_nanos() - wall_start;
+    });
+
+    pin_to_core(1);
+    for (size_t i = 0; i < WAKE_SAMPLES; ++i) {
+        std::this_thread::sleep_for(WAKE_GAP);
+        ring->push(get_nanos());
+    }
+    consumer.join();
+
+    WakeResult result{};
+    std::sort(latencies.begin(), latencies.end());
+    result.p50 = latencies[latencies.size() * 50 / 100];
+    result.p99 = latencies[latencies.size() * 99 / 100];
+    result.cpu_percent = wall_nanos ? 100.0 * cpu_nanos / wall_nanos : 0.0;
+    if constexpr (std::is_same_v<Wait, BlockingWait>) {
+        result.parks = ring->readable_wait().parks();
+    }
+    return result;
+}
+
+// Wake-up latency vs idle CPU cost for each wait strategy
+void bench_wait_strategies() {
+    std::cout << "=== Wait Strategy Wake-Up Latency and Idle CPU ===" << std::endl;
+    std::cout << "Idle gap: " << WAKE_GAP.count() << " us, samples: " << WAKE_SAMPLES << std::endl;
+
+    std::cout << std::setw(12) << "Strategy"
+              << std::setw(12) << "P50"
+              << std::setw(12) << "P99"
+              << std::setw(12) << "CPU"
+              << std::setw(10) << "Parks" << std::endl;
+
+    auto row = [](const char* name, const WakeResult& r) {
+        std::cout << std::setw(12) << name
+                  << std::setw(9) << r.p50 << " ns"
+                  << std::setw(9) << r.p99 << " ns"
+                  << std::setw(10) << std::fixed << std::setprecision(1) << r.cpu_percent << " %"
+                  << std::setw(10) << r.parks << std::endl;
+    };
+    row(wait_mode_name(WaitMode::BusySpin), run_wake_bench<BusySpinWait>());
+    row(wait_mode_name(WaitMode::SpinPause), run_wake_bench<SpinPauseWait>());
+    row(wait_mode_name(WaitMode::SpinYield), run_wake_bench<SpinYieldWait>());
+    row(wait_mode_name(WaitMode::Block), run_wake_bench<BlockingWait>());
     std::cout << std::endl;
 }
 
@@ -306,7 +1084,14 @@ int main() {
     bench_single_threaded();
     bench_concurrent();
     bench_latency();
+    bench_cross_core();
     bench_normalized_messages();
+    bench_batch();
+    bench_in_place();
+    bench_byte_ring();
+    bench_mpsc();
+    bench_wait_strategies();
+    bench_ring_storage();
 
     std::cout << "==================================================" << std::endl;
 
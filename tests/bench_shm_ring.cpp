@@ -0,0 +1,189 @@
+/**
+ * Benchmark for the shared-memory broadcast ring
+ *
+ * The parent process is the writer (the feed handler's role); a forked
+ * child attaches read-only through ShmRingReader, as a strategy process
+ * would. Measures:
+ * - Cross-process latency: paced publishes stamped with CLOCK_MONOTONIC,
+ *   measured at the reader's try_read
+ * - Back-to-back throughput, with items lost to overwrites if the reader
+ *   falls a lap behind
+ */
+
+#include "../include/spsc/shm_ring.hpp"
+#include "../include/common/types.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sched.h>
+#include <pthread.h>
+#endif
+
+using namespace hft;
+using namespace hft::spsc;
+
+// Configuration
+constexpr size_t RING_SIZE = 65536;
+constexpr size_t LATENCY_SAMPLES = 100'000;
+constexpr size_t NUM_MESSAGES = 10'000'000;
+constexpr uint64_t TIMESTAMP_MASK = (1ULL << 48) - 1;
+
+// Pin thread to CPU core (Linux only)
+void pin_to_core(int core_id) {
+#ifdef __linux__
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(core_id, &cpuset);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+#else
+    (void)core_id;
+#endif
+}
+
+// steady_clock is CLOCK_MONOTONIC, shared by every process on the host
+inline uint64_t get_nanos() {
+    auto now = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        now.time_since_epoch()
+    ).count();
+}
+
+/**
+ * Reader process: attach, tell the parent over ready_fd, read count items
+ * (or until the writer closes), then report
+ */
+int run_reader(const std::string& name, int ready_fd, size_t count, bool latency) {
+    pin_to_core(2);
+
+    MessageShmReader reader;
+    if (reader.attach(name) != MessageShmReader::AttachResult::Ok) {
+        std::cerr << "Reader failed to attach to " << name << std::endl;
+        return 1;
+    }
+    const char ready = 1;
+    if (write(ready_fd, &ready, 1) != 1) {
+        return 1;
+    }
+    close(ready_fd);
+
+    std::vector<uint64_t> latencies;
+    if (latency) {
+        latencies.reserve(count);
+    }
+
+    NormalizedMessage msg;
+    size_t received = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (received + reader.overruns() < count) {
+        auto r = reader.try_read(msg);
+        if (r == MessageShmReader::ReadResult::Ok) {
+            if (latency) {
+                latencies.push_back((get_nanos() - msg.timestamp()) & TIMESTAMP_MASK);
+            }
+            ++received;
+        } else if (r == MessageShmReader::ReadResult::Empty && reader.writer_closed()) {
+            break;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    if (latency) {
+        std::sort(latencies.begin(), latencies.end());
+        auto pct = [&](size_t p) { return latencies[latencies.size() * p / 100]; };
+        std::cout << "  Samples: " << latencies.size() << std::endl;
+        std::cout << "  P50:     " << pct(50) << " ns" << std::endl;
+        std::cout << "  P90:     " << pct(90) << " ns" << std::endl;
+        std::cout << "  P99:     " << pct(99) << " ns" << std::endl;
+        std::cout << "  Max:     " << latencies.back() << " ns" << std::endl;
+    } else {
+        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        std::cout << "  Received:   " << received << std::endl;
+        std::cout << "  Overwritten: " << reader.overruns() << std::endl;
+        std::cout << "  Throughput: " << std::fixed << std::setprecision(2)
+                  << static_cast<double>(received) * 1e3 / duration << " M msg/sec" << std::endl;
+    }
+    return 0;
+}
+
+/**
+ * Fork a reader, wait until it has attached, then publish count messages
+ * (paced and stamped when measuring latency)
+ */
+bool run_phase(const char* title, size_t count, bool latency) {
+    std::cout << "=== " << title << " ===" << std::endl;
+
+    const std::string name = "/itch5_bench_" + std::to_string(getpid());
+    MessageShmWriter writer;
+    if (!writer.create(name, RING_SIZE)) {
+        std::cerr << "Failed to create /dev/shm" << name << std::endl;
+        return false;
+    }
+
+    int ready[2];
+    if (pipe(ready) != 0) {
+        return false;
+    }
+
+    std::cout.flush();
+    const pid_t child = fork();
+    if (child == 0) {
+        close(ready[0]);
+        _exit(run_reader(name, ready[1], count, latency));
+    }
+    close(ready[1]);
+
+    char byte;
+    const bool attached = read(ready[0], &byte, 1) == 1;
+    close(ready[0]);
+
+    pin_to_core(1);
+    if (attached) {
+        NormalizedMessage msg;
+        msg.set_type(MessageType::AddOrder);
+        for (size_t i = 0; i < count; ++i) {
+            msg.set_order_ref(i);
+            if (latency) {
+                msg.set_timestamp(get_nanos());
+                writer.publish(msg);
+                for (volatile int j = 0; j < 200; ++j) {}
+            } else {
+                writer.publish(msg);
+            }
+        }
+    }
+    writer.close();
+
+    int status = 0;
+    waitpid(child, &status, 0);
+    std::cout << std::endl;
+    return attached && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int main() {
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  Shared-Memory Ring Cross-Process Benchmark" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Configuration:" << std::endl;
+    std::cout << "  Ring size:       " << RING_SIZE << " entries" << std::endl;
+    std::cout << "  Message size:    " << sizeof(NormalizedMessage) << " bytes" << std::endl;
+    std::cout << "  Latency samples: " << LATENCY_SAMPLES << std::endl;
+    std::cout << "  Messages:        " << NUM_MESSAGES << std::endl;
+    std::cout << std::endl;
+
+    bool ok = run_phase("Cross-Process Latency", LATENCY_SAMPLES, true);
+    ok = run_phase("Cross-Process Throughput", NUM_MESSAGES, false) && ok;
+
+    std::cout << "==================================================" << std::endl;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,248 @@
+/**
+ * Benchmark for seqlock top-of-book publishing
+ *
+ * Measures:
+ * - Writer (book engine) update latency with 0, 1, 2, 4 and 8 readers
+ *   spinning on the same instruments
+ * - Reader throughput and seqlock retry rate
+ *
+ * The writer's latency should stay flat as readers are added: readers
+ * never write to the record's cache line.
+ */
+
+#include "../include/book/order_book.hpp"
+#include "../include/book/top_of_book.hpp"
+#include "../include/common/types.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <cstring>
+
+#ifdef __linux__
+#include <sched.h>
+#include <pthread.h>
+#endif
+
+using namespace hft;
+using namespace hft::book;
+
+// Configuration
+constexpr size_t NUM_MESSAGES = 2'000'000;
+constexpr size_t NUM_LOCATES = 64;          // Hot instruments shared with readers
+constexpr int MAX_READERS = 8;
+
+// Pin thread to CPU core (Linux only)
+void pin_to_core(int core_id) {
+#ifdef __linux__
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(core_id, &cpuset);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+#else
+    (void)core_id;
+#endif
+}
+
+// Get current time in nanoseconds
+inline uint64_t get_nanos() {
+    auto now = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        now.time_since_epoch()
+    ).count();
+}
+
+/**
+ * Touch-heavy order flow: adds and deletes within a few cents of the
+ * mid, so most messages move the top of book and trigger a publish
+ */
+std::vector<NormalizedMessage> generate_messages(size_t count) {
+    std::mt19937_64 rng(42);
+    std::vector<NormalizedMessage> messages;
+    messages.reserve(count + NUM_LOCATES);
+
+    std::vector<std::vector<OrderRef>> live(NUM_LOCATES + 1);
+    OrderRef next_ref = 1;
+
+    for (size_t i = 1; i <= NUM_LOCATES; ++i) {
+        NormalizedMessage dir;
+        dir.set_type(MessageType::StockDirectory);
+        dir.set_stock_locate(static_cast<StockLocate>(i));
+        char name[9];
+        std::snprintf(name, sizeof(name), "SYM%04zu  ", i);
+        StockSymbol stock;
+        std::memcpy(stock.data(), name, 8);
+        dir.set_stock(stock);
+        messages.push_back(dir);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        StockLocate locate = static_cast<StockLocate>(1 + rng() % NUM_LOCATES);
+        auto& orders = live[locate];
+
+        NormalizedMessage msg;
+        msg.set_stock_locate(locate);
+        msg.set_timestamp(34200000000000ULL + i * 100);
+
+        if (orders.size() < 8 || (rng() % 100 < 50 && orders.size() < 200)) {
+            msg.set_type(MessageType::AddOrder);
+            msg.set_order_ref(next_ref++);
+            msg.set_side((rng() & 1) ? Side::Buy : Side::Sell);
+            Price offset = static_cast<Price>(1 + rng() % 4) * (PRICE_SCALE / 100);
+            Price mid = 100 * PRICE_SCALE + static_cast<Price>(locate) * PRICE_SCALE;
+            msg.set_price(msg.side() == Side::Buy ? mid - offset : mid + offset);
+            msg.set_quantity(100 * static_cast<Quantity>(1 + rng() % 5));
+            orders.push_back(msg.order_ref());
+        } else {
+            size_t idx = rng() % orders.size();
+            msg.set_type(MessageType::OrderDelete);
+            msg.set_order_ref(orders[idx]);
+            orders[idx] = orders.back();
+            orders.pop_back();
+        }
+        messages.push_back(msg);
+    }
+    return messages;
+}
+
+// Keeps reader loads from being optimized away
+std::atomic<uint64_t> read_sink{0};
+
+struct Result {
+    double mean;
+    uint32_t p50;
+    uint32_t p99;
+    uint32_t p999;
+    uint64_t publishes;
+    uint64_t reads;
+    uint64_t retries;
+    double seconds;
+};
+
+// Replay the flow on the writer with num_readers threads reading the tops
+Result run(const std::vector<NormalizedMessage>& messages, int num_readers) {
+    auto engine = std::make_unique<BookEngine>(1 << 16);
+    auto table = std::make_unique<TopOfBookTable>();
+    engine->set_top_of_book(table.get());
+
+    std::atomic<bool> start_flag{false};
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> total_reads{0};
+    std::atomic<uint64_t> total_retries{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < num_readers; ++r) {
+        readers.emplace_back([&, r]() {
+            pin_to_core(2 + r);
+            uint64_t reads = 0;
+            uint64_t retries = 0;
+            uint64_t checksum = 0;
+            StockLocate locate = static_cast<StockLocate>(1 + r % NUM_LOCATES);
+
+            while (!start_flag.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            while (!done.load(std::memory_order_acquire)) {
+                TopOfBook top;
+                const SeqlockTopOfBook& slot = table->slot(locate);
+                retries += slot.load(top);
+                checksum += static_cast<uint64_t>(top.bid_price);
+                ++reads;
+                locate = static_cast<StockLocate>(1 + (locate % NUM_LOCATES));
+            }
+            total_reads.fetch_add(reads, std::memory_order_relaxed);
+            read_sink.fetch_add(checksum, std::memory_order_relaxed);
+            total_retries.fetch_add(retries, std::memory_order_relaxed);
+        });
+    }
+
+    std::vector<uint32_t> latencies;
+    latencies.reserve(messages.size());
+
+    pin_to_core(1);
+    start_flag.store(true, std::memory_order_release);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const auto& msg : messages) {
+        uint64_t t0 = get_nanos();
+        engine->apply(msg);
+        uint64_t t1 = get_nanos();
+        latencies.push_back(static_cast<uint32_t>(t1 - t0));
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    done.store(true, std::memory_order_release);
+    for (auto& t : readers) {
+        t.join();
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+
+    Result result;
+    result.mean = std::accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size();
+    result.p50 = latencies[latencies.size() * 50 / 100];
+    result.p99 = latencies[latencies.size() * 99 / 100];
+    result.p999 = latencies[latencies.size() * 999 / 1000];
+    result.publishes = table->publishes();
+    result.reads = total_reads.load();
+    result.retries = total_retries.load();
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    return result;
+}
+
+int main() {
+    std::cout << "==================================================" << std::endl;
+    std::cout << "  Seqlock Top-of-Book Benchmark" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << std::endl;
+
+    unsigned cores = std::thread::hardware_concurrency();
+    std::cout << "Messages:       " << NUM_MESSAGES << std::endl;
+    std::cout << "Instruments:    " << NUM_LOCATES << std::endl;
+    std::cout << "Hardware cores: " << cores << std::endl;
+    if (cores < 3) {
+        std::cout << "Note: readers share cores with the writer; expect scheduler noise" << std::endl;
+    }
+    std::cout << std::endl;
+
+    auto messages = generate_messages(NUM_MESSAGES);
+
+    std::cout << "=== Writer Update Latency vs Reader Count ===" << std::endl;
+    std::cout << "(includes clock read overhead)" << std::endl;
+    std::cout << std::endl;
+    std::cout << std::setw(8) << "Readers"
+              << std::setw(10) << "Mean"
+              << std::setw(8) << "P50"
+              << std::setw(8) << "P99"
+              << std::setw(9) << "P99.9"
+              << std::setw(12) << "Publishes"
+              << std::setw(14) << "Reads/sec"
+              << std::setw(12) << "Retry %" << std::endl;
+
+    for (int readers = 0; readers <= MAX_READERS; readers = readers == 0 ? 1 : readers * 2) {
+        Result r = run(messages, readers);
+        double reads_per_sec = r.reads / r.seconds;
+        double retry_pct = r.reads ? 100.0 * r.retries / r.reads : 0.0;
+
+        std::cout << std::setw(8) << readers
+                  << std::setw(8) << std::fixed << std::setprecision(1) << r.mean << "ns"
+                  << std::setw(6) << r.p50 << "ns"
+                  << std::setw(6) << r.p99 << "ns"
+                  << std::setw(7) << r.p999 << "ns"
+                  << std::setw(12) << r.publishes
+                  << std::setw(14) << std::setprecision(0) << reads_per_sec
+                  << std::setw(11) << std::setprecision(3) << retry_pct << "%" << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << "==================================================" << std::endl;
+
+    return 0;
+}
@@ -6,15 +6,26 @@
  * - Session tracking
  * - Gap detection
  * - Heartbeat handling
+ * - Packet-level message delivery
+ * - In-order reassembly across gaps
+ * - A/B line arbitration
+ * - Retransmission request planning and loopback recovery
  */
 
 #include "../include/moldudp64/header.hpp"
 #include "../include/moldudp64/session.hpp"
+#include "../include/moldudp64/arbiter.hpp"
+#include "../include/moldudp64/retransmit.hpp"
+#include "../include/moldudp64/rewinder.hpp"
 #include "../include/common/endian.hpp"
+#include "../include/dpdk/packet_handler.hpp"
 
 #include <iostream>
 #include <cstring>
 #include <vector>
+#include <memory>
+#include <chrono>
+#include <thread>
 
 using namespace hft;
 using namespace hft::moldudp64;
@@ -318,6 +329,161 @@ bool test_session_is_healthy() {
     return true;
 }
 
+// Test GapSet merge, trim and split
+bool test_gap_set() {
+    GapSet gaps(8);
+
+    gaps.add({10, 19, 5});
+    gaps.add({30, 39, 7});
+    TEST_ASSERT(gaps.size() == 2 && gaps.missing() == 20, "Two gaps");
+
+    // Adjacent and overlapping gaps merge, keeping the earliest detection
+    gaps.add({20, 25, 9});
+    gaps.add({24, 31, 3});
+    TEST_ASSERT(gaps.size() == 1, "Merged into one gap");
+    TEST_ASSERT(gaps.front().start == 10 && gaps.front().end == 39, "Merged gap 10-39");
+    TEST_ASSERT(gaps.front().detected_at_ns == 3, "Earliest detection kept");
+
+    // Filling the middle splits it
+    TEST_ASSERT(gaps.fill(15, 24) == 10, "Ten sequences filled");
+    auto v = gaps.to_vector();
+    TEST_ASSERT(v.size() == 2, "Split in two");
+    TEST_ASSERT(v[0].start == 10 && v[0].end == 14, "Head 10-14");
+    TEST_ASSERT(v[1].start == 25 && v[1].end == 39, "Tail 25-39");
+    TEST_ASSERT(gaps.is_missing(14) && !gaps.is_missing(15) && !gaps.is_missing(24), "Split edges");
+    TEST_ASSERT(gaps.is_missing(25) && !gaps.is_missing(9) && !gaps.is_missing(40), "Outer edges");
+
+    // A range spanning both trims one and removes the other's head
+    TEST_ASSERT(gaps.fill(12, 30) == 9, "Spanning fill");
+    v = gaps.to_vector();
+    TEST_ASSERT(v.size() == 2 && v[0].end == 11 && v[1].start == 31, "Trimmed 10-11 and 31-39");
+
+    // Already received ranges fill nothing
+    TEST_ASSERT(gaps.fill(12, 30) == 0, "Nothing left to fill");
+
+    gaps.fill(1, 100);
+    TEST_ASSERT(gaps.empty() && gaps.missing() == 0, "All filled");
+
+    // Storage is reused once gaps close
+    for (int round = 0; round < 3; ++round) {
+        for (SequenceNumber s = 0; s < 8; ++s) {
+            gaps.add({s * 10, s * 10 + 4, 0});
+        }
+        TEST_ASSERT(gaps.size() == 8 && gaps.overflows() == 0, "Arena filled without overflow");
+        gaps.fill(0, 1000);
+    }
+    TEST_ASSERT(gaps.empty(), "Arena drained");
+
+    TEST_PASS("test_gap_set");
+    return true;
+}
+
+// Test GapSet behaviour when its storage is exhausted
+bool test_gap_set_overflow() {
+    GapSet gaps(2);
+    gaps.add({10, 10, 0});
+    gaps.add({20, 20, 0});
+
+    // No room: widens the previous gap rather than dropping this one
+    gaps.add({30, 30, 0});
+    TEST_ASSERT(gaps.overflows() == 1, "Overflow counted");
+    TEST_ASSERT(gaps.size() == 2 && gaps.is_missing(30), "New gap still missing");
+    TEST_ASSERT(gaps.is_missing(25), "Over-reported, never under-reported");
+
+    // A split that needs a node leaves the gap whole
+    TEST_ASSERT(gaps.fill(24, 24) == 0, "Split refused");
+    TEST_ASSERT(gaps.is_missing(24) && gaps.overflows() == 2, "Gap kept whole");
+
+    // Trimming needs no node
+    TEST_ASSERT(gaps.fill(20, 29) == 10, "Head trimmed");
+    TEST_ASSERT(gaps.is_missing(10) && !gaps.is_missing(20) && gaps.is_missing(30), "Trimmed");
+
+    TEST_PASS("test_gap_set_overflow");
+    return true;
+}
+
+// Test a retransmission filling the middle of a gap
+bool test_session_gap_split() {
+    Session session;
+    std::vector<uint8_t> msg = {'A', 0x00};
+
+    auto p1 = create_moldudp_packet("NASDAQ", 1, 1, {msg});
+    auto p2 = create_moldudp_packet("NASDAQ", 11, 1, {msg});  // Gap 2-10
+    session.process_packet(p1.data(), p1.size());
+    session.process_packet(p2.data(), p2.size());
+    TEST_ASSERT(session.is_missing(2) && session.is_missing(10), "Gap 2-10 missing");
+
+    auto fill = create_moldudp_packet("NASDAQ", 5, 3, {msg, msg, msg});
+    session.process_retransmission(5, fill.data() + 20, fill.size() - 20, 3);
+    auto gaps = session.get_pending_gaps().to_vector();
+    TEST_ASSERT(gaps.size() == 2, "Gap split in two");
+    TEST_ASSERT(gaps[0].start == 2 && gaps[0].end == 4, "Head 2-4");
+    TEST_ASSERT(gaps[1].start == 8 && gaps[1].end == 10, "Tail 8-10");
+    TEST_ASSERT(!session.is_missing(6) && session.get_state() == SessionState::Stale, "Still stale");
+
+    // Late live packets close the rest
+    auto late1 = create_moldudp_packet("NASDAQ", 2, 3, {msg, msg, msg});
+    auto late2 = create_moldudp_packet("NASDAQ", 8, 3, {msg, msg, msg});
+    session.process_packet(late1.data(), late1.size());
+    session.process_packet(late2.data(), late2.size());
+    TEST_ASSERT(!session.has_gaps() && session.is_healthy(), "All gaps closed");
+
+    TEST_PASS("test_session_gap_split");
+    return true;
+}
+
+// Test that a retransmission only delivers the messages still missing
+bool test_session_retransmission_duplicates() {
+    Session session;
+    std::vector<SequenceNumber> delivered;
+    session.set_message_callback(
+        [&](const uint8_t* data, uint16_t, SequenceNumber seq) {
+            delivered.push_back(data[1] == seq ? seq : 0);
+        }
+    );
+    auto msg = [](uint8_t seq) { return std::vector<uint8_t>{'X', seq}; };
+
+    // 2 and 4 lost
+    for (uint8_t seq : {1, 3, 5}) {
+        auto packet = create_moldudp_packet("NASDAQ", seq, 1, {msg(seq)});
+        session.process_packet(packet.data(), packet.size());
+    }
+    TEST_ASSERT(session.get_pending_gaps().size() == 2, "Two gaps");
+
+    // One coalesced request answered with 2-5: only 2 and 4 are new
+    auto fill = create_moldudp_packet("NASDAQ", 2, 4, {msg(2), msg(3), msg(4), msg(5)});
+    session.process_retransmission(2, fill.data() + 20, fill.size() - 20, 4);
+    TEST_ASSERT((delivered == std::vector<SequenceNumber>{1, 3, 5, 2, 4}),
+                "Messages already received not delivered again");
+    TEST_ASSERT(!session.has_gaps() && session.get_state() == SessionState::Active, "Gaps closed");
+
+    // A late answer to a re-request repeats everything
+    session.process_retransmission(2, fill.data() + 20, fill.size() - 20, 4);
+    TEST_ASSERT(delivered.size() == 5, "Repeated response delivers nothing");
+
+    // Packet callbacks get each missing run as its own packet
+    Session packets;
+    std::vector<std::pair<SequenceNumber, uint16_t>> runs;
+    packets.set_packet_callback(
+        [&](const uint8_t*, size_t, uint16_t count, SequenceNumber first) {
+            runs.emplace_back(first, count);
+            return count;
+        }
+    );
+    for (uint8_t seq : {1, 4, 6}) {
+        auto packet = create_moldudp_packet("NASDAQ", seq, 1, {msg(seq)});
+        packets.process_packet(packet.data(), packet.size());
+    }
+    runs.clear();
+    auto span = create_moldudp_packet("NASDAQ", 2, 4, {msg(2), msg(3), msg(4), msg(5)});
+    packets.process_retransmission(2, span.data() + 20, span.size() - 20, 4);
+    TEST_ASSERT((runs == std::vector<std::pair<SequenceNumber, uint16_t>>{{2, 2}, {5, 1}}),
+                "Missing runs delivered around the received message");
+
+    TEST_PASS("test_session_retransmission_duplicates");
+    return true;
+}
+
 // Test truncated packet handling
 bool test_truncated_packet() {
     Session session;
@@ -335,6 +501,779 @@ bool test_truncated_packet() {
     return true;
 }
 
+// Test packet-level delivery of message blocks
+bool test_session_packet_callback() {
+    Session session;
+
+    int calls = 0;
+    uint16_t last_count = 0;
+    SequenceNumber last_seq = 0;
+    std::vector<uint8_t> last_blocks;
+    bool message_callback_called = false;
+
+    session.set_message_callback(
+        [&](const uint8_t*, uint16_t, SequenceNumber) { message_callback_called = true; }
+    );
+    session.set_packet_callback(
+        [&](const uint8_t* blocks, size_t length, uint16_t count, SequenceNumber seq) {
+            ++calls;
+            last_count = count;
+            last_seq = seq;
+            last_blocks.assign(blocks, blocks + length);
+            return static_cast<size_t>(count);
+        }
+    );
+
+    std::vector<uint8_t> msg1 = {'A', 0x00, 0x01};
+    std::vector<uint8_t> msg2 = {'E', 0x00};
+
+    auto packet = create_moldudp_packet("NASDAQ", 1, 2, {msg1, msg2});
+    session.process_packet(packet.data(), packet.size());
+
+    TEST_ASSERT(calls == 1, "One call per packet");
+    TEST_ASSERT(!message_callback_called, "Packet callback takes precedence");
+    TEST_ASSERT(last_count == 2, "Message count passed through");
+    TEST_ASSERT(last_seq == 1, "First sequence passed through");
+    TEST_ASSERT(last_blocks.size() == 2 + msg1.size() + 2 + msg2.size(), "All message blocks passed");
+    TEST_ASSERT(last_blocks[0] == 0 && last_blocks[1] == 3 && last_blocks[2] == 'A',
+                "Blocks start with the first length prefix");
+    TEST_ASSERT(session.get_stats().messages_received == 2, "Messages counted from return value");
+    TEST_ASSERT(session.get_expected_sequence() == 3, "Sequence advanced");
+
+    TEST_PASS("test_session_packet_callback");
+    return true;
+}
+
+// Packet whose messages are one byte each, tagged with their sequence
+std::vector<uint8_t> create_tagged_packet(uint64_t first_seq, uint16_t count) {
+    std::vector<std::vector<uint8_t>> messages;
+    for (uint16_t i = 0; i < count; ++i) {
+        messages.push_back({static_cast<uint8_t>(first_seq + i)});
+    }
+    return create_moldudp_packet("NASDAQ", first_seq, count, messages);
+}
+
+// Test holding packets behind a gap and releasing them in order
+bool test_session_reorder() {
+    Session session;
+    session.enable_reordering();
+
+    std::vector<SequenceNumber> delivered;
+    session.set_message_callback(
+        [&](const uint8_t* data, uint16_t, SequenceNumber seq) {
+            if (data[0] != static_cast<uint8_t>(seq)) {
+                delivered.push_back(0);   // Payload does not match its sequence
+            }
+            delivered.push_back(seq);
+        }
+    );
+
+    auto p1 = create_tagged_packet(1, 2);    // 1-2
+    auto p2 = create_tagged_packet(3, 2);    // 3-4 (lost, arrives late)
+    auto p3 = create_tagged_packet(5, 1);    // 5
+    auto p4 = create_tagged_packet(6, 2);    // 6-7
+
+    session.process_packet(p1.data(), p1.size());
+    session.process_packet(p3.data(), p3.size());
+    session.process_packet(p4.data(), p4.size());
+
+    TEST_ASSERT(delivered.size() == 2, "Packets past the gap should be held");
+    TEST_ASSERT(session.held_packets() == 2, "Two packets held");
+    TEST_ASSERT(session.get_state() == SessionState::Stale, "Gap still detected");
+    TEST_ASSERT(session.get_delivery_sequence() == 3, "Delivery waits at the gap");
+
+    session.process_packet(p2.data(), p2.size());
+
+    std::vector<SequenceNumber> expected = {1, 2, 3, 4, 5, 6, 7};
+    TEST_ASSERT(delivered == expected, "Messages delivered once, in sequence order");
+    TEST_ASSERT(session.held_packets() == 0, "Held packets released");
+    TEST_ASSERT(session.get_state() == SessionState::Active, "Gap filled");
+
+    // Duplicates of delivered packets are dropped
+    session.process_packet(p3.data(), p3.size());
+    session.process_packet(p1.data(), p1.size());
+    TEST_ASSERT(delivered.size() == 7, "Duplicates not delivered again");
+
+    auto stats = session.get_stats();
+    TEST_ASSERT(stats.packets_held == 2, "Held packets counted");
+    TEST_ASSERT(stats.duplicates_dropped == 2, "Duplicates counted");
+    TEST_ASSERT(stats.messages_received == 7, "Each message counted once");
+    TEST_ASSERT(stats.gaps_abandoned == 0, "Nothing abandoned");
+
+    TEST_PASS("test_session_reorder");
+    return true;
+}
+
+// Test filling a gap from a retransmission that overlaps delivered messages
+bool test_session_reorder_retransmission() {
+    Session session;
+    session.enable_reordering();
+
+    std::vector<SequenceNumber> delivered;
+    session.set_message_callback(
+        [&](const uint8_t*, uint16_t, SequenceNumber seq) { delivered.push_back(seq); }
+    );
+
+    auto p1 = create_tagged_packet(1, 2);    // 1-2
+    auto p3 = create_tagged_packet(6, 1);    // 6
+    session.process_packet(p1.data(), p1.size());
+    session.process_packet(p3.data(), p3.size());
+
+    // Rewinder sends 2-5; 2 was already delivered
+    auto fill = create_tagged_packet(2, 4);
+    session.process_retransmission(2, fill.data() + 20, fill.size() - 20, 4);
+
+    std::vector<SequenceNumber> expected = {1, 2, 3, 4, 5, 6};
+    TEST_ASSERT(delivered == expected, "Overlap trimmed, held packet released");
+    TEST_ASSERT(session.get_state() == SessionState::Active, "Gap filled");
+    TEST_ASSERT(session.get_delivery_sequence() == 7, "Cursor past the held packet");
+
+    TEST_PASS("test_session_reorder_retransmission");
+    return true;
+}
+
+// Test abandoning a gap when the slab fills or the hold time runs out
+bool test_session_reorder_abandon() {
+    Session session;
+    ReorderConfig config;
+    config.max_packets = 2;
+    config.max_hold_ns = 1'000'000'000;
+    session.enable_reordering(config);
+
+    std::vector<SequenceNumber> delivered;
+    session.set_message_callback(
+        [&](const uint8_t*, uint16_t, SequenceNumber seq) { delivered.push_back(seq); }
+    );
+
+    auto p1 = create_tagged_packet(1, 1);
+    session.process_packet(p1.data(), p1.size());
+
+    // 2 is lost; 3 and 4 fill the slab, 5 forces the gap to be abandoned
+    for (uint64_t seq = 3; seq <= 5; ++seq) {
+        auto p = create_tagged_packet(seq, 1);
+        session.process_packet(p.data(), p.size());
+    }
+
+    std::vector<SequenceNumber> expected = {1, 3, 4, 5};
+    TEST_ASSERT(delivered == expected, "Delivery resumes past the abandoned gap");
+    auto stats = session.get_stats();
+    TEST_ASSERT(stats.gaps_abandoned == 1, "Abandoned gap counted");
+    TEST_ASSERT(stats.messages_skipped == 1, "Skipped message counted");
+    TEST_ASSERT(session.get_state() == SessionState::Active, "Abandoned gap no longer pending");
+
+    // Late arrival of the abandoned message is a duplicate
+    auto late = create_tagged_packet(2, 1);
+    session.process_packet(late.data(), late.size());
+    TEST_ASSERT(delivered.size() == 4, "Abandoned message not delivered late");
+
+    // Hold-time expiry, driven from a timer
+    auto p7 = create_tagged_packet(7, 1);
+    session.process_packet(p7.data(), p7.size());
+    TEST_ASSERT(session.held_packets() == 1, "Packet held behind the new gap");
+    session.expire_held(0);
+    TEST_ASSERT(session.held_packets() == 1, "Not expired before max_hold_ns");
+    session.expire_held(UINT64_MAX);
+    TEST_ASSERT(session.held_packets() == 0, "Expired gap releases held packets");
+    TEST_ASSERT(delivered.back() == 7, "Held packet delivered after expiry");
+    TEST_ASSERT(session.get_stats().messages_skipped == 2, "Expired message counted");
+
+    // No slots at all: a packet past a gap skips it instead of looping
+    Session unbuffered;
+    ReorderConfig none;
+    none.max_packets = 0;
+    unbuffered.enable_reordering(none);
+    std::vector<SequenceNumber> unbuffered_delivered;
+    unbuffered.set_message_callback(
+        [&](const uint8_t*, uint16_t, SequenceNumber seq) { unbuffered_delivered.push_back(seq); }
+    );
+    for (uint64_t seq : {1, 3, 4}) {
+        auto p = create_tagged_packet(seq, 1);
+        unbuffered.process_packet(p.data(), p.size());
+    }
+    TEST_ASSERT((unbuffered_delivered == std::vector<SequenceNumber>{1, 3, 4}),
+                "Zero-slot reordering delivers past the gap");
+    TEST_ASSERT(unbuffered.get_stats().gaps_abandoned == 1, "Gap abandoned at once");
+
+    TEST_PASS("test_session_reorder_abandon");
+    return true;
+}
+
+// Test first-arrival-wins arbitration and cross-line gap fill
+bool test_line_arbiter() {
+    LineArbiter arbiter(1024);
+    using Verdict = LineArbiter::Verdict;
+
+    auto p1 = create_tagged_packet(1, 2);    // 1-2
+    auto p2 = create_tagged_packet(3, 2);    // 3-4
+    auto p3 = create_tagged_packet(5, 1);    // 5
+
+    // A wins packet 1, B's copy is a duplicate 300 ns later
+    TEST_ASSERT(arbiter.arbitrate(Line::A, p1.data(), p1.size(), 1000) == Verdict::Deliver,
+                "First copy delivered");
+    TEST_ASSERT(arbiter.arbitrate(Line::B, p1.data(), p1.size(), 1300) == Verdict::Duplicate,
+                "Second copy dropped");
+
+    // A loses packet 2; B delivers 2, then A's 3 arrives first
+    TEST_ASSERT(arbiter.arbitrate(Line::B, p2.data(), p2.size(), 2000) == Verdict::Deliver,
+                "B delivers what A lost");
+    TEST_ASSERT(arbiter.arbitrate(Line::A, p3.data(), p3.size(), 2900) == Verdict::Deliver,
+                "A wins packet 3");
+    TEST_ASSERT(arbiter.arbitrate(Line::B, p3.data(), p3.size(), 3000) == Verdict::Duplicate,
+                "B's copy of 3 dropped");
+    TEST_ASSERT(arbiter.next_sequence() == 6, "High-water mark past packet 3");
+
+    // B loses 6-7 and jumps to 8; A then fills 6-7 from behind the mark
+    auto p4 = create_tagged_packet(6, 2);
+    auto p5 = create_tagged_packet(8, 1);
+    TEST_ASSERT(arbiter.arbitrate(Line::B, p5.data(), p5.size(), 4000) == Verdict::Deliver,
+                "B races ahead");
+    TEST_ASSERT(arbiter.arbitrate(Line::A, p4.data(), p4.size(), 4100) == Verdict::Deliver,
+                "A fills B's gap");
+    TEST_ASSERT(arbiter.arbitrate(Line::A, p5.data(), p5.size(), 4200) == Verdict::Duplicate,
+                "A's copy of 8 dropped");
+
+    // Heartbeats always pass; garbage does not
+    auto heartbeat = create_moldudp_packet("NASDAQ", 0, 0);
+    TEST_ASSERT(arbiter.arbitrate(Line::B, heartbeat.data(), heartbeat.size(), 5000) == Verdict::Deliver,
+                "Heartbeat passes");
+    TEST_ASSERT(arbiter.arbitrate(Line::A, p1.data(), 10, 5000) == Verdict::Invalid,
+                "Truncated header rejected");
+
+    const auto& a = arbiter.stats(Line::A);
+    const auto& b = arbiter.stats(Line::B);
+    TEST_ASSERT(a.wins == 3 && b.wins == 2, "Wins counted per line");
+    TEST_ASSERT(a.gap_fills == 1 && b.gap_fills == 0, "Gap fill credited to A");
+    TEST_ASSERT(a.duplicates == 1 && b.duplicates == 2, "Duplicates counted per line");
+    TEST_ASSERT(a.missed_messages == 2, "A missed packet 2");
+    TEST_ASSERT(b.missed_messages == 2, "B missed 6-7");
+    TEST_ASSERT(b.skew_samples == 2 && b.skew_max_ns == 300, "B's lag recorded");
+    TEST_ASSERT(a.skew_samples == 1 && a.skew_total_ns == 200, "A's lag recorded");
+    TEST_ASSERT(a.win_rate() > 0.5 && a.win_rate() < 0.8, "Win rate is wins over packets");
+
+    // Far behind the window
+    auto old = create_tagged_packet(1, 1);
+    auto far = create_tagged_packet(5000, 1);
+    arbiter.arbitrate(Line::A, far.data(), far.size(), 6000);
+    TEST_ASSERT(arbiter.arbitrate(Line::B, old.data(), old.size(), 6100) == Verdict::Stale,
+                "Packets older than the window are stale");
+
+    TEST_PASS("test_line_arbiter");
+    return true;
+}
+
+// Test request coalescing, splitting, retry and rate limiting
+bool test_request_planner() {
+    RetransmitConfig config;
+    config.coalesce_distance = 4;
+    config.max_request_count = 100;
+    config.request_burst = 2;
+    config.max_requests_per_sec = 1000;     // One token per ms
+    config.retry_ns = 5'000'000;
+    config.max_attempts = 2;
+    RequestPlanner planner(config);
+    RequestPlanner::Request request;
+
+    const uint64_t ms = 1'000'000;
+    uint64_t now = 1000 * ms;
+
+    // 10-12 and 15-20 are close enough to share a request; 40-49 is not
+    planner.add(10, 12);
+    planner.add(15, 20);
+    planner.add(40, 49);
+    planner.add(16, 18);    // Already outstanding
+    TEST_ASSERT(planner.outstanding_ranges() == 2, "Nearby gaps coalesced");
+
+    TEST_ASSERT(planner.next(now, request), "First request due");
+    TEST_ASSERT(request.start == 10 && request.count == 11, "Coalesced range requested");
+    TEST_ASSERT(planner.next(now, request), "Second request due");
+    TEST_ASSERT(request.start == 40 && request.count == 10, "Separate range requested");
+    TEST_ASSERT(!planner.next(now, request), "Nothing else due");
+
+    // A gap next to an in-flight range is not folded into it
+    planner.add(21, 22);
+    TEST_ASSERT(planner.outstanding_ranges() == 3, "In-flight range not widened");
+    TEST_ASSERT(!planner.next(now, request), "Rate limit holds the new gap");
+    now += 1 * ms;
+    TEST_ASSERT(planner.next(now, request) && request.start == 21, "New gap sent after a token");
+
+    // A response filling the middle splits the range, and the rest is due at once
+    planner.fill(13, 14);
+    planner.fill(10, 11);
+    TEST_ASSERT(planner.outstanding_ranges() == 4, "Middle fill splits the range");
+    now += 2 * ms;
+    TEST_ASSERT(planner.next(now, request) && request.start == 12 && request.count == 1,
+                "Remainder re-requested after progress");
+    TEST_ASSERT(planner.next(now, request) && request.start == 15 && request.count == 6,
+                "Split tail re-requested after progress");
+
+    // No progress: retried after retry_ns, abandoned after max_attempts
+    planner.fill(12, 22);
+    TEST_ASSERT(planner.outstanding_ranges() == 1, "Only 40-49 left");
+    now += 5 * ms;
+    TEST_ASSERT(planner.next(now, request) && request.start == 40, "Retried after retry_ns");
+    TEST_ASSERT(planner.retries() == 1, "Retry counted");
+    now += 5 * ms;
+    TEST_ASSERT(!planner.next(now, request), "Given up after max_attempts");
+    TEST_ASSERT(planner.idle() && planner.abandoned_messages() == 10, "Abandoned range counted");
+
+    TEST_PASS("test_request_planner");
+    return true;
+}
+
+// Test recovering a gap from a loopback rewinder
+bool test_retransmit_recovery() {
+    Rewinder rewinder("NASDAQ");
+    for (uint8_t i = 1; i <= 40; ++i) {
+        uint8_t message[3] = {'X', i, 0};
+        rewinder.add_message(message, sizeof(message));
+    }
+    if (!rewinder.start()) {
+        std::cout << "SKIP: test_retransmit_recovery (no loopback socket)" << std::endl;
+        return true;
+    }
+
+    RetransmitConfig config;
+    config.port = rewinder.port();
+    config.max_request_count = 8;   // Several round trips for one gap
+    RetransmitClient client(config);
+    TEST_ASSERT(client.start(), "Client should connect");
+
+    Session session;
+    session.enable_reordering();
+    client.attach(session);
+    std::vector<SequenceNumber> delivered;
+    session.set_message_callback(
+        [&](const uint8_t* data, uint16_t, SequenceNumber seq) {
+            delivered.push_back(data[1] == seq ? seq : 0);
+        }
+    );
+
+    // Live stream loses 6-25
+    std::vector<uint8_t> packet;
+    rewinder.build_packet(1, 5, Rewinder::DEFAULT_MAX_PAYLOAD, packet);
+    session.process_packet(packet.data(), packet.size());
+    rewinder.build_packet(26, 15, Rewinder::DEFAULT_MAX_PAYLOAD, packet);
+    session.process_packet(packet.data(), packet.size());
+    TEST_ASSERT(delivered.size() == 5, "Delivery stops at the gap");
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (delivered.size() < 40 && std::chrono::steady_clock::now() < deadline) {
+        if (client.poll(session) == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+    std::vector<SequenceNumber> expected;
+    for (SequenceNumber seq = 1; seq <= 40; ++seq) {
+        expected.push_back(seq);
+    }
+    TEST_ASSERT(delivered == expected, "Gap recovered and delivered in order");
+    TEST_ASSERT(session.get_state() == SessionState::Active, "Session active again");
+
+    auto stats = client.get_stats();
+    TEST_ASSERT(stats.gaps_received == 1, "One gap handed over");
+    TEST_ASSERT(stats.requests_sent >= 3, "Large gap takes several requests");
+    TEST_ASSERT(stats.messages_recovered == 20, "Every missing message recovered");
+    TEST_ASSERT(rewinder.requests_served() == stats.requests_sent, "Rewinder answered each request");
+
+    client.stop();
+    rewinder.stop();
+
+    TEST_PASS("test_retransmit_recovery");
+    return true;
+}
+
+// Test recovering gaps on two interleaved sessions from one rewinder address
+bool test_retransmit_two_sessions() {
+    Rewinder nasdaq("NASDAQ");
+    Rewinder bx("BX");
+    for (uint8_t i = 1; i <= 40; ++i) {
+        uint8_t message[3] = {'X', i, 0};
+        nasdaq.add_message(message, sizeof(message));
+        bx.add_message(message, sizeof(message));
+    }
+
+    // Answer for both sessions from this thread, like a rewinder serving
+    // every channel of the feed
+    const int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    if (fd < 0 || bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &addr_len) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        std::cout << "SKIP: test_retransmit_two_sessions (no loopback socket)" << std::endl;
+        return true;
+    }
+
+    RetransmitConfig config;
+    config.port = ntohs(addr.sin_port);
+    config.max_request_count = 8;
+    RetransmitClient client(config);
+    TEST_ASSERT(client.start(), "Client should connect");
+
+    SessionManager sessions;
+    sessions.configure([](Session& session) { session.enable_reordering(); });
+    client.attach(sessions);
+    std::vector<SequenceNumber> delivered[2];
+    sessions.get_session(nasdaq.session()).set_message_callback(
+        [&](const uint8_t* data, uint16_t, SequenceNumber seq) {
+            delivered[0].push_back(data[1] == seq ? seq : 0);
+        }
+    );
+    sessions.get_session(bx.session()).set_message_callback(
+        [&](const uint8_t* data, uint16_t, SequenceNumber seq) {
+            delivered[1].push_back(data[1] == seq ? seq : 0);
+        }
+    );
+
+    // NASDAQ loses 6-25, then BX loses 6-20 while NASDAQ's gap is open
+    std::vector<uint8_t> packet;
+    nasdaq.build_packet(1, 5, Rewinder::DEFAULT_MAX_PAYLOAD, packet);
+    sessions.process_packet(packet.data(), packet.size());
+    bx.build_packet(1, 5, Rewinder::DEFAULT_MAX_PAYLOAD, packet);
+    sessions.process_packet(packet.data(), packet.size());
+    nasdaq.build_packet(26, 15, Rewinder::DEFAULT_MAX_PAYLOAD, packet);
+    sessions.process_packet(packet.data(), packet.size());
+    bx.build_packet(21, 20, Rewinder::DEFAULT_MAX_PAYLOAD, packet);
+    sessions.process_packet(packet.data(), packet.size());
+    TEST_ASSERT(delivered[0].size() == 5 && delivered[1].size() == 5, "Both stop at their gaps");
+
+    uint64_t served = 0;
+    uint8_t request[64];
+    std::vector<uint8_t> response;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while ((delivered[0].size() < 40 || delivered[1].size() < 40) &&
+           std::chrono::steady_clock::now() < deadline) {
+        sockaddr_in from{};
+        socklen_t from_len = sizeof(from);
+        const ssize_t n = recvfrom(fd, request, sizeof(request), MSG_DONTWAIT,
+                                   reinterpret_cast<sockaddr*>(&from), &from_len);
+        Header header;
+        if (n > 0 && HeaderParser::parse(request, static_cast<size_t>(n), header)) {
+            const Rewinder& rewinder =
+                std::memcmp(header.session, bx.session().data(), 10) == 0 ? bx : nasdaq;
+            rewinder.build_packet(header.sequence_number, header.message_count,
+                                  Rewinder::DEFAULT_MAX_PAYLOAD, response);
+            sendto(fd, response.data(), response.size(), 0,
+                   reinterpret_cast<const sockaddr*>(&from), from_len);
+            ++served;
+        }
+        if (client.poll(sessions) == 0 && n <= 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+    std::vector<SequenceNumber> expected;
+    for (SequenceNumber seq = 1; seq <= 40; ++seq) {
+        expected.push_back(seq);
+    }
+    TEST_ASSERT(delivered[0] == expected, "NASDAQ's gap recovered after BX's arrived");
+    TEST_ASSERT(delivered[1] == expected, "BX's gap recovered");
+
+    auto stats = client.get_stats();
+    TEST_ASSERT(stats.gaps_received == 2, "One gap per session handed over");
+    TEST_ASSERT(stats.messages_recovered == 35, "Every missing message recovered");
+    TEST_ASSERT(stats.messages_abandoned == 0, "Nothing given up");
+    TEST_ASSERT(served == stats.requests_sent, "Every request answered");
+
+    client.stop();
+    close(fd);
+
+    TEST_PASS("test_retransmit_two_sessions");
+    return true;
+}
+
+// Wrap a MoldUDP64 payload in Ethernet/IPv4/UDP headers
+std::vector<uint8_t> wrap_udp(const std::vector<uint8_t>& payload) {
+    constexpr size_t headers = 14 + 20 + 8;
+    std::vector<uint8_t> frame(headers + payload.size(), 0);
+    frame[12] = 0x08;   // EtherType IPv4
+    frame[13] = 0x00;
+    frame[14] = 0x45;   // IPv4, 20-byte header
+    frame[14 + 9] = 17; // UDP
+    if (!payload.empty()) {
+        std::memcpy(frame.data() + headers, payload.data(), payload.size());
+    }
+    return frame;
+}
+
+// Counts decoded messages from forwarded raw blocks
+struct RawCounter {
+    int adds = 0;
+    int deletes = 0;
+    OrderRef last_ref = 0;
+
+    void on_add_order(const itch5::AddOrder* msg, Timestamp, Price, Quantity) {
+        ++adds;
+        last_ref = endian::ntoh64(msg->order_reference_number);
+    }
+    void on_order_delete(const itch5::OrderDelete*, Timestamp) { ++deletes; }
+};
+
+// Test forwarding the original message blocks to the raw byte ring
+bool test_raw_passthrough() {
+    auto messages = std::make_unique<dpdk::PacketHandler::MessageBuffer>(65536);
+    auto raw = std::make_unique<dpdk::PacketHandler::RawBuffer>();
+    auto handler = std::make_unique<dpdk::PacketHandler>(*messages);
+    handler->set_raw_output(raw.get());
+
+    std::vector<uint8_t> add(sizeof(itch5::AddOrder), 0);
+    add[0] = 'A';
+    uint64_t ref_be = endian::hton64(77);
+    std::memcpy(add.data() + 11, &ref_be, 8);
+    add[19] = 'B';
+    std::vector<uint8_t> del(sizeof(itch5::OrderDelete), 0);
+    del[0] = 'D';
+
+    auto payload = create_moldudp_packet("NASDAQ", 1, 2, {add, del});
+    auto frame = wrap_udp(payload);
+    TEST_ASSERT(handler->process_raw_packet(frame.data(), frame.size()), "Packet should be accepted");
+
+    // Normalized path still runs
+    TEST_ASSERT(messages->size() == 2, "Both messages should be normalized");
+
+    // Raw path: one record with the packet's blocks, byte for byte
+    auto record = raw->front();
+    TEST_ASSERT(record, "Raw record should be forwarded");
+    TEST_ASSERT(record.length == sizeof(dpdk::RawPacketHeader) + payload.size() - 20,
+                "Record should hold the header and every block");
+
+    dpdk::RawPacketHeader header;
+    std::memcpy(&header, record.data, sizeof(header));
+    TEST_ASSERT(header.first_sequence == 1, "First sequence should be recorded");
+    TEST_ASSERT(header.message_count == 2, "Message count should be recorded");
+
+    const uint8_t* blocks = record.data + sizeof(header);
+    size_t blocks_length = record.length - sizeof(header);
+    TEST_ASSERT(std::memcmp(blocks, payload.data() + 20, blocks_length) == 0,
+                "Blocks should be the original wire bytes");
+
+    RawCounter counter;
+    itch5::BasicParser<RawCounter> parser(counter);
+    auto result = parser.parse_buffer(blocks, blocks_length);
+    TEST_ASSERT(result.blocks == 2, "Consumer should decode both blocks");
+    TEST_ASSERT(counter.adds == 1 && counter.deletes == 1, "Consumer should see each message");
+    TEST_ASSERT(counter.last_ref == 77, "Raw fields should be intact");
+    raw->release();
+
+    // Raw only: the parser is skipped, the session still advances
+    handler->set_raw_output(raw.get(), false);
+    auto payload2 = create_moldudp_packet("NASDAQ", 3, 1, {del});
+    auto frame2 = wrap_udp(payload2);
+    TEST_ASSERT(handler->process_raw_packet(frame2.data(), frame2.size()), "Packet should be accepted");
+    TEST_ASSERT(messages->size() == 2, "Raw-only mode should not normalize");
+    TEST_ASSERT(raw->front() && raw->front().length == sizeof(dpdk::RawPacketHeader) + 2 + del.size(),
+                "Raw-only mode should forward the packet");
+    raw->release();
+
+    auto stats = handler->get_stats();
+    TEST_ASSERT(stats.raw_packets_forwarded == 2, "Forwarded packets counted");
+    TEST_ASSERT(stats.raw_full_count == 0, "Nothing dropped");
+    TEST_ASSERT(stats.session_stats.messages_received == 3, "Session counts raw-only messages");
+
+    TEST_PASS("test_raw_passthrough");
+    return true;
+}
+
+// Test that messages with order refs wider than 48 bits are dropped and counted
+bool test_packet_handler_wide_order_ref() {
+    auto messages = std::make_unique<dpdk::PacketHandler::MessageBuffer>(65536);
+    auto handler = std::make_unique<dpdk::PacketHandler>(*messages);
+
+    std::vector<uint8_t> add(sizeof(itch5::AddOrder), 0);
+    add[0] = 'A';
+    uint64_t ref_be = endian::hton64((1ULL << 48) | 77);
+    std::memcpy(add.data() + 11, &ref_be, 8);
+    add[19] = 'B';
+    std::vector<uint8_t> del(sizeof(itch5::OrderDelete), 0);
+    del[0] = 'D';
+    ref_be = endian::hton64(77);
+    std::memcpy(del.data() + 11, &ref_be, 8);
+
+    auto frame = wrap_udp(create_moldudp_packet("NASDAQ", 1, 2, {add, del}));
+    TEST_ASSERT(handler->process_raw_packet(frame.data(), frame.size()), "Packet should be accepted");
+    TEST_ASSERT(handler->get_stats().parser_stats.order_ref_overflows == 1, "Wide ref counted");
+
+    // The add would have collided with order 77 (masked) or every other
+    // wide ref (clamped); only the delete is published
+    TEST_ASSERT(messages->size() == 1, "Wide-ref message dropped");
+    auto published = messages->try_pop();
+    TEST_ASSERT(published && published->type() == MessageType::OrderDelete, "Delete published");
+    TEST_ASSERT(published->order_ref() == 77, "In-range ref unchanged");
+
+    TEST_PASS("test_packet_handler_wide_order_ref");
+    return true;
+}
+
+// Test that the packet handler parses each sequence once across both lines
+bool test_packet_handler_arbitration() {
+    auto messages = std::make_unique<dpdk::PacketHandler::MessageBuffer>(65536);
+    auto handler = std::make_unique<dpdk::PacketHandler>(*messages);
+    handler->enable_arbitration();
+
+    std::vector<uint8_t> del(sizeof(itch5::OrderDelete), 0);
+    del[0] = 'D';
+    auto frame1 = wrap_udp(create_moldudp_packet("NASDAQ", 1, 1, {del}));
+    auto frame2 = wrap_udp(create_moldudp_packet("NASDAQ", 2, 2, {del, del}));
+    auto frame3 = wrap_udp(create_moldudp_packet("NASDAQ", 4, 1, {del}));
+
+    // A: 1, 3 (lost 2)   B: 1, 2, 3
+    handler->process_line_packet(Line::A, frame1.data(), frame1.size(), 10);
+    handler->process_line_packet(Line::B, frame1.data(), frame1.size(), 20);
+    handler->process_line_packet(Line::A, frame3.data(), frame3.size(), 30);
+    handler->process_line_packet(Line::B, frame2.data(), frame2.size(), 40);
+    handler->process_line_packet(Line::B, frame3.data(), frame3.size(), 50);
+
+    TEST_ASSERT(messages->size() == 4, "Each message normalized exactly once");
+    auto stats = handler->get_stats();
+    TEST_ASSERT(stats.packets_processed == 3, "Duplicates not processed");
+    TEST_ASSERT(stats.session_stats.messages_received == 4, "Session saw each message once");
+    TEST_ASSERT(!handler->has_gaps(), "B's copy filled A's gap");
+
+    const auto* arbiter = handler->get_arbiter();
+    TEST_ASSERT(arbiter && arbiter->stats(Line::B).gap_fills == 1, "Gap fill from line B");
+
+    uint16_t port = 1;
+    TEST_ASSERT(dpdk::PacketHandler::udp_destination_port(frame1.data(), frame1.size(), port) && port == 0,
+                "Destination port read from the frame");
+
+    TEST_PASS("test_packet_handler_arbitration");
+    return true;
+}
+
+// Test that each session id gets its own sequence tracking
+bool test_session_manager() {
+    SessionManager manager(3);
+    std::vector<uint8_t> msg = {'A', 0x00};
+
+    // Ids that differ only in the last byte (the packed low half)
+    auto a1 = create_moldudp_packet("000001234A", 1, 1, {msg});
+    auto b1 = create_moldudp_packet("000001234B", 1, 1, {msg});
+    auto a2 = create_moldudp_packet("000001234A", 2, 1, {msg});
+    auto b3 = create_moldudp_packet("000001234B", 3, 1, {msg});
+    TEST_ASSERT(manager.process_packet(a1.data(), a1.size()), "A seq 1");
+    TEST_ASSERT(manager.process_packet(b1.data(), b1.size()), "B seq 1 is not a duplicate");
+    TEST_ASSERT(manager.process_packet(a2.data(), a2.size()), "A seq 2");
+    TEST_ASSERT(manager.process_packet(b3.data(), b3.size()), "B seq 3");
+    TEST_ASSERT(manager.size() == 2, "Two sessions");
+
+    std::array<char, 10> id_a, id_b;
+    std::memcpy(id_a.data(), "000001234A", 10);
+    std::memcpy(id_b.data(), "000001234B", 10);
+    Session* a = manager.find(id_a);
+    Session* b = manager.find(id_b);
+    TEST_ASSERT(a && b && a != b, "Found both");
+    TEST_ASSERT(a->is_healthy() && a->get_expected_sequence() == 3, "A in sequence");
+    TEST_ASSERT(b->has_gaps() && b->is_missing(2), "B has its own gap");
+    TEST_ASSERT(&manager.get_session(id_a) == a, "get_session returns the existing session");
+    TEST_ASSERT(manager.get_stale_sessions().size() == 1, "Only B is stale");
+    TEST_ASSERT(manager.get_session_stats().messages_received == 4, "Stats summed");
+
+    // Short packets have no session id
+    TEST_ASSERT(manager.route(a1.data(), 9) == nullptr, "Too short to route");
+
+    // Full: a third and fourth id evict the least recently active session
+    auto c1 = create_moldudp_packet("000001234C", 1, 1, {msg});
+    auto d1 = create_moldudp_packet("000001234D", 1, 1, {msg});
+    manager.process_packet(a2.data(), a2.size());   // A more recent than B
+    manager.process_packet(c1.data(), c1.size());
+    manager.process_packet(d1.data(), d1.size());
+    TEST_ASSERT(manager.size() == 3, "Capacity kept");
+    TEST_ASSERT(manager.find(id_b) == nullptr, "B evicted");
+    TEST_ASSERT(manager.find(id_a) == a, "A kept in its slot");
+    TEST_ASSERT(manager.get_stats().evictions == 1, "One eviction");
+
+    // The evicted id comes back as a fresh session in a reused slot
+    auto b4 = create_moldudp_packet("000001234B", 4, 1, {msg});
+    manager.process_packet(b4.data(), b4.size());
+    Session* b_again = manager.find(id_b);
+    TEST_ASSERT(b_again && b_again->get_stats().packets_received == 1, "Fresh session for B");
+    TEST_ASSERT(b_again->has_gaps(), "Expects sequence 1 again");
+    TEST_ASSERT(manager.get_stats().sessions_created == 5, "Five sessions created");
+
+    TEST_PASS("test_session_manager");
+    return true;
+}
+
+// Test that a PacketHandler follows a session rollover and a second channel
+bool test_packet_handler_sessions() {
+    auto messages = std::make_unique<dpdk::PacketHandler::MessageBuffer>(65536);
+    auto handler = std::make_unique<dpdk::PacketHandler>(*messages);
+    handler->enable_arbitration();
+
+    std::vector<uint8_t> del(sizeof(itch5::OrderDelete), 0);
+    del[0] = 'D';
+    auto old1 = wrap_udp(create_moldudp_packet("SESSION001", 1, 2, {del, del}));
+    auto bx1 = wrap_udp(create_moldudp_packet("BX00000001", 1, 1, {del}));
+    auto new1 = wrap_udp(create_moldudp_packet("SESSION002", 1, 1, {del}));
+    auto new2 = wrap_udp(create_moldudp_packet("SESSION002", 2, 1, {del}));
+
+    handler->process_raw_packet(old1.data(), old1.size());
+    handler->process_raw_packet(bx1.data(), bx1.size());
+    // Rollover: sequence numbers start over; the arbiter must not call them duplicates
+    handler->process_line_packet(Line::A, new1.data(), new1.size(), 10);
+    handler->process_line_packet(Line::B, new1.data(), new1.size(), 20);
+    handler->process_line_packet(Line::A, new2.data(), new2.size(), 30);
+
+    auto stats = handler->get_stats();
+    TEST_ASSERT(stats.invalid_packets == 0, "No session mismatch errors");
+    TEST_ASSERT(messages->size() == 5, "Every message normalized once");
+    TEST_ASSERT(stats.session_stats.messages_received == 5, "Summed over sessions");
+    TEST_ASSERT(!handler->has_gaps(), "No gaps in any session");
+    TEST_ASSERT(handler->get_sessions().size() == 3, "Three sessions tracked");
+    TEST_ASSERT(std::memcmp(handler->get_session().get_session_id().data(), "SESSION002", 10) == 0,
+                "Current session is the last one routed");
+
+    TEST_PASS("test_packet_handler_sessions");
+    return true;
+}
+
+// Test A/B arbitration with two channels interleaved packet by packet
+bool test_packet_handler_interleaved_lines() {
+    auto messages = std::make_unique<dpdk::PacketHandler::MessageBuffer>(65536);
+    auto handler = std::make_unique<dpdk::PacketHandler>(*messages);
+    handler->enable_arbitration();
+
+    std::vector<uint8_t> del(sizeof(itch5::OrderDelete), 0);
+    del[0] = 'D';
+    const char* channels[2] = {"NASDAQ0001", "BX00000001"};
+
+    // Per sequence: A:CH1, A:CH2, B:CH1, B:CH2 (B duplicating A), so the
+    // session switches on every packet. A loses CH2#3, B loses CH1#2.
+    uint64_t t = 0;
+    for (uint64_t seq = 1; seq <= 4; ++seq) {
+        for (Line line : {Line::A, Line::B}) {
+            for (int ch = 0; ch < 2; ++ch) {
+                if ((line == Line::A && ch == 1 && seq == 3) || (line == Line::B && ch == 0 && seq == 2)) {
+                    continue;
+                }
+                auto frame = wrap_udp(create_moldudp_packet(channels[ch], seq, 1, {del}));
+                handler->process_line_packet(line, frame.data(), frame.size(), ++t);
+            }
+        }
+    }
+
+    TEST_ASSERT(messages->size() == 8, "Each message of each channel normalized exactly once");
+    auto stats = handler->get_stats();
+    TEST_ASSERT(stats.session_stats.messages_received == 8, "Sessions saw each message once");
+    TEST_ASSERT(!handler->has_gaps(), "Line B filled A's loss on CH2");
+    TEST_ASSERT(handler->get_sessions().get_stats().switches == 12, "Switched session on every change of channel");
+
+    // Counters survive the switches
+    auto a = handler->get_line_stats(Line::A);
+    auto b = handler->get_line_stats(Line::B);
+    TEST_ASSERT(a.packets == 7 && a.wins == 7 && a.duplicates == 0, "A won every copy it carried");
+    TEST_ASSERT(b.packets == 7 && b.wins == 1 && b.duplicates == 6, "B's copies dropped but one");
+    TEST_ASSERT(b.skew_samples == 6, "Lag measured on every duplicate");
+
+    TEST_PASS("test_packet_handler_interleaved_lines");
+    return true;
+}
+
 int main() {
     std::cout << "=== MoldUDP64 Session Layer Tests ===" << std::endl;
     std::cout << std::endl;
@@ -366,7 +1305,25 @@ int main() {
     run_test(test_session_multiple_gaps, "test_session_multiple_gaps");
     run_test(test_session_reset, "test_session_reset");
     run_test(test_session_is_healthy, "test_session_is_healthy");
+    run_test(test_gap_set, "test_gap_set");
+    run_test(test_gap_set_overflow, "test_gap_set_overflow");
+    run_test(test_session_gap_split, "test_session_gap_split");
+    run_test(test_session_retransmission_duplicates, "test_session_retransmission_duplicates");
     run_test(test_truncated_packet, "test_truncated_packet");
+    run_test(test_session_packet_callback, "test_session_packet_callback");
+    run_test(test_session_reorder, "test_session_reorder");
+    run_test(test_session_reorder_retransmission, "test_session_reorder_retransmission");
+    run_test(test_session_reorder_abandon, "test_session_reorder_abandon");
+    run_test(test_line_arbiter, "test_line_arbiter");
+    run_test(test_request_planner, "test_request_planner");
+    run_test(test_retransmit_recovery, "test_retransmit_recovery");
+    run_test(test_retransmit_two_sessions, "test_retransmit_two_sessions");
+    run_test(test_raw_passthrough, "test_raw_passthrough");
+    run_test(test_packet_handler_wide_order_ref, "test_packet_handler_wide_order_ref");
+    run_test(test_packet_handler_arbitration, "test_packet_handler_arbitration");
+    run_test(test_session_manager, "test_session_manager");
+    run_test(test_packet_handler_sessions, "test_packet_handler_sessions");
+    run_test(test_packet_handler_interleaved_lines, "test_packet_handler_interleaved_lines");
 
     std::cout << std::endl;
     std::cout << "=== Results ===" << std::endl;
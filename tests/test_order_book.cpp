@@ -0,0 +1,788 @@
+/**
+ * Unit tests for the order book engine
+ *
+ * Tests:
+ * - Add/Execute/Cancel/Delete/Replace application
+ * - Price level aggregation and best price tracking
+ * - Per-symbol book separation
+ * - Stock locate symbol table
+ * - Unknown and duplicate order references
+ * - Open-addressing order table and node arena
+ * - Dense price ladder vs std::map level storage
+ * - Seqlock top-of-book publishing and torn-read safety
+ * - Market-by-price level deltas
+ */
+
+#include "../include/book/order_book.hpp"
+#include "../include/book/order_table.hpp"
+#include "../include/book/top_of_book.hpp"
+#include "../include/book/depth_feed.hpp"
+#include "../include/common/types.hpp"
+
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <memory>
+
+using namespace hft;
+using namespace hft::book;
+
+// Test helper
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "FAIL: " << message << " at " << __FILE__ << ":" << __LINE__ << std::endl; \
+            return false; \
+        } \
+    } while(0)
+
+#define TEST_PASS(name) \
+    std::cout << "PASS: " << name << std::endl
+
+// Helpers to build normalized messages
+StockSymbol make_symbol(const char* name) {
+    StockSymbol sym;
+    std::memset(sym.data(), ' ', sym.size());
+    std::memcpy(sym.data(), name, std::min(std::strlen(name), sym.size()));
+    return sym;
+}
+
+// Stable locate code per test symbol (assigned in order of first use)
+StockLocate make_locate(const char* name) {
+    static std::vector<StockSymbol> seen;
+    StockSymbol sym = make_symbol(name);
+    for (size_t i = 0; i < seen.size(); ++i) {
+        if (seen[i] == sym) {
+            return static_cast<StockLocate>(i + 1);
+        }
+    }
+    seen.push_back(sym);
+    return static_cast<StockLocate>(seen.size());
+}
+
+NormalizedMessage make_add(OrderRef ref, const char* stock, Side side, Price price, Quantity qty) {
+    NormalizedMessage msg;
+    msg.set_type(MessageType::AddOrder);
+    msg.set_timestamp(1000 + ref);
+    msg.set_order_ref(ref);
+    msg.set_stock_locate(make_locate(stock));
+    msg.set_side(side);
+    msg.set_price(price);
+    msg.set_quantity(qty);
+    return msg;
+}
+
+NormalizedMessage make_execute(OrderRef ref, Quantity executed) {
+    NormalizedMessage msg;
+    msg.set_type(MessageType::OrderExecuted);
+    msg.set_order_ref(ref);
+    msg.set_executed_quantity(executed);
+    return msg;
+}
+
+NormalizedMessage make_cancel(OrderRef ref, Quantity cancelled) {
+    NormalizedMessage msg;
+    msg.set_type(MessageType::OrderCancel);
+    msg.set_order_ref(ref);
+    msg.set_quantity(cancelled);
+    return msg;
+}
+
+NormalizedMessage make_delete(OrderRef ref) {
+    NormalizedMessage msg;
+    msg.set_type(MessageType::OrderDelete);
+    msg.set_order_ref(ref);
+    return msg;
+}
+
+NormalizedMessage make_replace(OrderRef ref, OrderRef new_ref, Price price, Quantity qty) {
+    NormalizedMessage msg;
+    msg.set_type(MessageType::OrderReplace);
+    msg.set_order_ref(ref);
+    msg.set_new_order_ref(new_ref);
+    msg.set_price(price);
+    msg.set_quantity(qty);
+    return msg;
+}
+
+constexpr Price px(int64_t cents) { return cents * PRICE_SCALE / 100; }
+
+// Test adding orders builds aggregated levels
+bool test_add_orders() {
+    BookEngine engine(1024);
+
+    TEST_ASSERT(engine.apply(make_add(1, "AAPL", Side::Buy, px(15000), 100)), "Add should change book");
+    TEST_ASSERT(engine.apply(make_add(2, "AAPL", Side::Buy, px(15000), 200)), "Add should change book");
+    TEST_ASSERT(engine.apply(make_add(3, "AAPL", Side::Buy, px(14999), 50)), "Add should change book");
+    TEST_ASSERT(engine.apply(make_add(4, "AAPL", Side::Sell, px(15001), 300)), "Add should change book");
+
+    const OrderBook* book = engine.find_book(make_locate("AAPL"));
+    TEST_ASSERT(book != nullptr, "Book should exist");
+    TEST_ASSERT(book->bid_depth() == 2, "Two bid levels");
+    TEST_ASSERT(book->ask_depth() == 1, "One ask level");
+
+    const PriceLevel* bid = book->best_bid();
+    TEST_ASSERT(bid && bid->price == px(15000), "Best bid should be 150.00");
+    TEST_ASSERT(bid->quantity == 300, "Best bid quantity should aggregate");
+    TEST_ASSERT(bid->order_count == 2, "Best bid should have 2 orders");
+
+    const PriceLevel* ask = book->best_ask();
+    TEST_ASSERT(ask && ask->price == px(15001), "Best ask should be 150.01");
+    TEST_ASSERT(engine.order_count() == 4, "Four resting orders");
+
+    TEST_PASS("test_add_orders");
+    return true;
+}
+
+// Test partial and full executions
+bool test_executions() {
+    BookEngine engine(1024);
+    engine.apply(make_add(1, "MSFT", Side::Sell, px(30000), 100));
+    engine.apply(make_add(2, "MSFT", Side::Sell, px(30000), 100));
+
+    TEST_ASSERT(engine.apply(make_execute(1, 40)), "Partial execution should apply");
+    const OrderBook* book = engine.find_book(make_locate("MSFT"));
+    TEST_ASSERT(book->best_ask()->quantity == 160, "Level should drop by executed shares");
+    TEST_ASSERT(book->best_ask()->order_count == 2, "Order still resting");
+    TEST_ASSERT(engine.find_order(1)->quantity == 60, "Order quantity reduced");
+
+    TEST_ASSERT(engine.apply(make_execute(1, 60)), "Full execution should apply");
+    TEST_ASSERT(engine.find_order(1) == nullptr, "Fully executed order removed");
+    TEST_ASSERT(book->best_ask()->quantity == 100, "Level keeps other order");
+    TEST_ASSERT(book->best_ask()->order_count == 1, "One order left");
+
+    NormalizedMessage exec_px = make_execute(2, 100);
+    exec_px.set_type(MessageType::OrderExecutedWithPrice);
+    exec_px.set_price(px(29990));
+    TEST_ASSERT(engine.apply(exec_px), "Execution with price should apply");
+    TEST_ASSERT(book->best_ask() == nullptr, "Ask side should be empty");
+
+    TEST_PASS("test_executions");
+    return true;
+}
+
+// Test cancels and deletes
+bool test_cancel_delete() {
+    BookEngine engine(1024);
+    engine.apply(make_add(1, "TSLA", Side::Buy, px(20000), 500));
+    engine.apply(make_add(2, "TSLA", Side::Buy, px(19900), 100));
+
+    TEST_ASSERT(engine.apply(make_cancel(1, 200)), "Cancel should apply");
+    const OrderBook* book = engine.find_book(make_locate("TSLA"));
+    TEST_ASSERT(book->best_bid()->quantity == 300, "Cancel reduces level");
+
+    TEST_ASSERT(engine.apply(make_delete(1)), "Delete should apply");
+    TEST_ASSERT(book->best_bid()->price == px(19900), "Best bid moves down after delete");
+    TEST_ASSERT(book->bid_depth() == 1, "Deleted level removed");
+
+    TEST_ASSERT(engine.apply(make_cancel(2, 100)), "Full cancel should apply");
+    TEST_ASSERT(book->empty(), "Book should be empty");
+    TEST_ASSERT(engine.order_count() == 0, "No orders resting");
+
+    TEST_PASS("test_cancel_delete");
+    return true;
+}
+
+// Test replace keeps side and symbol, moves price
+bool test_replace() {
+    BookEngine engine(1024);
+    engine.apply(make_add(10, "NVDA", Side::Sell, px(50000), 100));
+
+    TEST_ASSERT(engine.apply(make_replace(10, 11, px(49990), 250)), "Replace should apply");
+    TEST_ASSERT(engine.find_order(10) == nullptr, "Original order removed");
+
+    const Order* replaced = engine.find_order(11);
+    TEST_ASSERT(replaced != nullptr, "New order inserted");
+    TEST_ASSERT(replaced->side == Side::Sell, "Replace keeps side");
+    TEST_ASSERT(replaced->quantity == 250, "Replace sets new quantity");
+
+    const OrderBook* book = engine.find_book(make_locate("NVDA"));
+    TEST_ASSERT(book->ask_depth() == 1, "Old level removed");
+    TEST_ASSERT(book->best_ask()->price == px(49990), "New level is best ask");
+    TEST_ASSERT(book->best_ask()->quantity == 250, "New level quantity");
+
+    TEST_PASS("test_replace");
+    return true;
+}
+
+// Test books are kept per symbol
+bool test_multiple_symbols() {
+    BookEngine engine(1024);
+    engine.apply(make_add(1, "AAPL", Side::Buy, px(15000), 100));
+    engine.apply(make_add(2, "MSFT", Side::Buy, px(30000), 100));
+    engine.apply(make_add(3, "AAPL", Side::Buy, px(15010), 100));
+
+    TEST_ASSERT(engine.book_count() == 2, "Two books");
+    TEST_ASSERT(engine.find_book(make_locate("AAPL"))->best_bid()->price == px(15010),
+                "AAPL best bid");
+    TEST_ASSERT(engine.find_book(make_locate("MSFT"))->best_bid()->price == px(30000),
+                "MSFT best bid");
+
+    // Delete carries no symbol - order table resolves the book
+    engine.apply(make_delete(3));
+    TEST_ASSERT(engine.find_book(make_locate("AAPL"))->best_bid()->price == px(15000),
+                "Delete routed to AAPL");
+    TEST_ASSERT(engine.find_book(make_locate("GOOG")) == nullptr, "Unknown symbol has no book");
+
+    TEST_PASS("test_multiple_symbols");
+    return true;
+}
+
+// Test StockDirectory messages populate the locate table
+bool test_stock_directory() {
+    BookEngine engine(1024);
+
+    NormalizedMessage dir;
+    dir.set_type(MessageType::StockDirectory);
+    dir.set_stock_locate(42);
+    dir.set_stock(make_symbol("IBM"));
+    dir.set_quantity(100);
+    engine.apply(dir);
+
+    const SymbolTable& symbols = engine.symbols();
+    TEST_ASSERT(symbols.size() == 1, "One directory entry");
+    TEST_ASSERT(symbols.find(42) != nullptr, "Locate 42 registered");
+    TEST_ASSERT(symbols.find(42)->round_lot_size == 100, "Round lot size kept");
+    TEST_ASSERT(symbols.symbol(42) == make_symbol("IBM"), "Symbol by locate");
+    TEST_ASSERT(symbols.locate_of(make_symbol("IBM")) == 42, "Locate by symbol");
+    TEST_ASSERT(symbols.find(43) == nullptr, "Unregistered locate");
+
+    // Books are indexed by the locate carried on every message
+    NormalizedMessage add = make_add(1, "IBM", Side::Sell, px(12000), 300);
+    add.set_stock_locate(42);
+    engine.apply(add);
+
+    TEST_ASSERT(engine.find_book(42) != nullptr, "Book by locate");
+    TEST_ASSERT(engine.find_book(42) == engine.find_book(make_symbol("IBM")),
+                "Locate and symbol resolve to the same book");
+    TEST_ASSERT(engine.find_book(42)->locate() == 42, "Book knows its locate");
+    TEST_ASSERT(engine.find_book(42)->stock() == make_symbol("IBM"), "Book named from the directory");
+    TEST_ASSERT(symbols.size() == 1, "Add did not duplicate the entry");
+
+    engine.clear();
+    TEST_ASSERT(engine.symbols().size() == 0, "Directory cleared");
+    TEST_ASSERT(engine.find_book(42) == nullptr, "Books cleared");
+
+    TEST_PASS("test_stock_directory");
+    return true;
+}
+
+// Test unknown and duplicate references are counted, not applied
+bool test_unknown_orders() {
+    BookEngine engine(1024);
+    engine.apply(make_add(1, "AAPL", Side::Buy, px(15000), 100));
+
+    TEST_ASSERT(!engine.apply(make_delete(99)), "Unknown delete ignored");
+    TEST_ASSERT(!engine.apply(make_execute(99, 10)), "Unknown execute ignored");
+    TEST_ASSERT(!engine.apply(make_add(1, "AAPL", Side::Buy, px(15000), 100)), "Duplicate add ignored");
+
+    NormalizedMessage trade;
+    trade.set_type(MessageType::Trade);
+    TEST_ASSERT(!engine.apply(trade), "Non-cross trade leaves book unchanged");
+
+    auto stats = engine.get_stats();
+    TEST_ASSERT(stats.unknown_orders == 2, "Two unknown references");
+    TEST_ASSERT(stats.duplicate_orders == 1, "One duplicate add");
+    TEST_ASSERT(stats.trades == 1, "One trade counted");
+    TEST_ASSERT(engine.find_book(make_locate("AAPL"))->best_bid()->quantity == 100,
+                "Book unchanged");
+
+    TEST_PASS("test_unknown_orders");
+    return true;
+}
+
+// Test order table insert/find/erase including backward-shift deletion
+bool test_order_table_basic() {
+    OrderTable<Order> table(64);
+
+    TEST_ASSERT(table.slot_count() >= 128, "Table should stay at most half full");
+    TEST_ASSERT(table.find(1) == nullptr, "Empty table finds nothing");
+
+    for (OrderRef ref = 1; ref <= 64; ++ref) {
+        auto [node, inserted] = table.try_emplace(ref);
+        TEST_ASSERT(inserted && node != nullptr, "Insert should succeed");
+        node->ref = ref;
+        node->quantity = static_cast<Quantity>(ref * 10);
+    }
+    TEST_ASSERT(table.size() == 64, "Size should be 64");
+
+    auto [dup, dup_inserted] = table.try_emplace(7);
+    TEST_ASSERT(!dup_inserted && dup != nullptr && dup->ref == 7, "Duplicate returns existing node");
+
+    // Erase every other reference, then verify all survivors are still reachable
+    for (OrderRef ref = 1; ref <= 64; ref += 2) {
+        TEST_ASSERT(table.erase(ref), "Erase should succeed");
+    }
+    TEST_ASSERT(!table.erase(1), "Second erase should fail");
+    TEST_ASSERT(table.size() == 32, "Size should be 32");
+
+    for (OrderRef ref = 1; ref <= 64; ++ref) {
+        Order* node = table.find(ref);
+        if (ref % 2 == 1) {
+            TEST_ASSERT(node == nullptr, "Erased reference not found");
+        } else {
+            TEST_ASSERT(node != nullptr && node->quantity == ref * 10, "Survivor found intact");
+        }
+    }
+
+    TEST_PASS("test_order_table_basic");
+    return true;
+}
+
+// Test arena exhaustion and node recycling
+bool test_order_table_arena() {
+    OrderTable<Order> table(8);
+
+    for (OrderRef ref = 100; ref < 108; ++ref) {
+        TEST_ASSERT(table.try_emplace(ref).second, "Insert within capacity");
+    }
+
+    auto [node, inserted] = table.try_emplace(200);
+    TEST_ASSERT(!inserted && node == nullptr, "Exhausted arena returns nullptr");
+
+    TEST_ASSERT(table.erase(103), "Erase frees a node");
+    TEST_ASSERT(table.try_emplace(200).second, "Freed node is reused");
+    TEST_ASSERT(table.size() == 8, "Table full again");
+
+    // Long churn: far more inserts than capacity, as over a trading day
+    std::vector<OrderRef> live = {100, 101, 102, 104, 105, 106, 107, 200};
+    for (OrderRef ref = 1000; ref < 100000; ++ref) {
+        size_t victim = ref % live.size();
+        TEST_ASSERT(table.erase(live[victim]), "Churn erase");
+        TEST_ASSERT(table.try_emplace(ref).second, "Churn insert");
+        live[victim] = ref;
+    }
+    for (OrderRef ref : live) {
+        TEST_ASSERT(table.find(ref) != nullptr, "Live references survive churn");
+    }
+    TEST_ASSERT(table.size() == 8, "Size stable after churn");
+
+    TEST_PASS("test_order_table_arena");
+    return true;
+}
+
+// Test book engine counts adds dropped by a full arena
+bool test_order_table_full_engine() {
+    BookEngine engine(4);
+    for (OrderRef ref = 1; ref <= 5; ++ref) {
+        engine.apply(make_add(ref, "AAPL", Side::Buy, px(15000), 100));
+    }
+
+    TEST_ASSERT(engine.order_count() == 4, "Only capacity orders rest");
+    TEST_ASSERT(engine.get_stats().table_full == 1, "Overflow counted");
+    TEST_ASSERT(engine.find_book(make_locate("AAPL"))->best_bid()->order_count == 4,
+                "Dropped add does not reach the book");
+
+    TEST_PASS("test_order_table_full_engine");
+    return true;
+}
+
+// Collect a side's levels best-to-worst
+template <typename Levels>
+std::vector<std::pair<Price, uint64_t>> snapshot(const Levels& levels) {
+    std::vector<std::pair<Price, uint64_t>> out;
+    levels.for_each([&](const PriceLevel& lvl) {
+        out.emplace_back(lvl.price, lvl.quantity);
+        return true;
+    });
+    return out;
+}
+
+// Test dense ladder best-price tracking and ordered scan
+bool test_ladder_levels() {
+    LadderLevels<true> bids;
+    LadderLevels<false> asks;
+
+    bids.add(px(10000), 100);
+    bids.add(px(10002), 200);
+    bids.add(px(9990), 300);
+    bids.add(px(10002), 50);
+
+    TEST_ASSERT(bids.best()->price == px(10002), "Best bid is highest");
+    TEST_ASSERT(bids.best()->quantity == 250, "Best bid aggregated");
+    TEST_ASSERT(bids.best()->order_count == 2, "Best bid order count");
+    TEST_ASSERT(bids.depth() == 3, "Three bid levels");
+
+    auto levels = snapshot(bids);
+    TEST_ASSERT(levels.size() == 3, "Scan visits all levels");
+    TEST_ASSERT(levels[0].first == px(10002) && levels[1].first == px(10000) &&
+                levels[2].first == px(9990), "Bids scanned high to low");
+
+    bids.reduce(px(10002), 200, true);
+    bids.reduce(px(10002), 50, true);
+    TEST_ASSERT(bids.best()->price == px(10000), "Best bid falls back");
+    TEST_ASSERT(bids.find(px(10002)) == nullptr, "Empty level removed");
+
+    asks.add(px(10010), 100);
+    asks.add(px(10005), 100);
+    TEST_ASSERT(asks.best()->price == px(10005), "Best ask is lowest");
+
+    // Sub-penny price is off-tick and lives in overflow, but still ranks
+    asks.add(px(10005) - 100 * 50, 10);
+    TEST_ASSERT(asks.best()->price == px(10005) - 100 * 50, "Off-tick best ask");
+    TEST_ASSERT(asks.overflow_depth() == 1, "Off-tick level in overflow");
+
+    TEST_PASS("test_ladder_levels");
+    return true;
+}
+
+// Test ladder window recentring as the price walks away
+bool test_ladder_recenter() {
+    LadderLevels<true> bids;
+    constexpr Price tick = LadderLevels<true>::TICK;
+    constexpr Price span = tick * static_cast<Price>(LadderLevels<true>::WINDOW);
+
+    bids.add(px(5000), 100);
+    Price far_below = px(5000) - 2 * span;
+    bids.add(far_below, 100);
+    TEST_ASSERT(bids.overflow_depth() == 1, "Far worse level goes to overflow");
+    TEST_ASSERT(bids.window_depth() == 1, "Touch stays dense");
+
+    // Bid improves past the top of the window
+    uint64_t before = bids.recenters();
+    bids.add(px(5000) + span, 100);
+    TEST_ASSERT(bids.recenters() == before + 1, "Improvement recentres");
+    TEST_ASSERT(bids.best()->price == px(5000) + span, "New best bid");
+    TEST_ASSERT(bids.depth() == 3, "No levels lost in recentre");
+
+    // Removing the dense levels pulls the overflow touch back into the window
+    bids.reduce(px(5000) + span, 100, true);
+    bids.reduce(px(5000), 100, true);
+    TEST_ASSERT(bids.best()->price == far_below, "Overflow level becomes best");
+    TEST_ASSERT(bids.window_depth() == 1, "Touch moved back into window");
+    TEST_ASSERT(bids.overflow_depth() == 0, "Overflow drained");
+
+    TEST_PASS("test_ladder_recenter");
+    return true;
+}
+
+// Test ladder against the std::map reference under a random walk
+template <bool IsBid>
+bool ladder_matches_map() {
+    LadderLevels<IsBid> ladder;
+    MapLevels<IsBid> reference;
+    std::vector<std::pair<Price, Quantity>> live;
+
+    uint32_t seed = 12345;
+    auto next = [&]() {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 8) & 0xFFFF;
+    };
+
+    Price mid = px(2000);
+    for (int i = 0; i < 50000; ++i) {
+        if (live.empty() || next() % 100 < 55) {
+            // Walk the mid, occasionally jumping several windows
+            mid += static_cast<Price>(next() % 3) * px(1) - px(1);
+            if (next() % 1000 == 0) {
+                mid += (next() % 2 ? 1 : -1) * px(900);
+            }
+            mid = std::max(mid, px(1000));
+
+            Price price = mid + (IsBid ? -1 : 1) * static_cast<Price>(next() % 64) * px(1);
+            if (next() % 50 == 0) {
+                price += 100;  // Off-tick
+            }
+            Quantity qty = 1 + next() % 500;
+            ladder.add(price, qty);
+            reference.add(price, qty);
+            live.emplace_back(price, qty);
+        } else {
+            size_t idx = next() % live.size();
+            ladder.reduce(live[idx].first, live[idx].second, true);
+            reference.reduce(live[idx].first, live[idx].second, true);
+            live[idx] = live.back();
+            live.pop_back();
+        }
+
+        if (i % 97 == 0) {
+            TEST_ASSERT(snapshot(ladder) == snapshot(reference), "Ladder matches map");
+            TEST_ASSERT(ladder.depth() == reference.depth(), "Depth matches map");
+        }
+    }
+    return true;
+}
+
+bool test_ladder_matches_map() {
+    TEST_ASSERT(ladder_matches_map<true>(), "Bid side");
+    TEST_ASSERT(ladder_matches_map<false>(), "Ask side");
+
+    // Both storages behind the same engine produce the same book
+    BasicBookEngine<MapLevelStorage> map_engine(1024);
+    BookEngine ladder_engine(1024);
+    for (OrderRef ref = 1; ref <= 200; ++ref) {
+        Price price = px(10000) + static_cast<Price>(ref % 17) * px(3);
+        Side side = (ref % 2) ? Side::Buy : Side::Sell;
+        if (side == Side::Sell) price += px(100);
+        map_engine.apply(make_add(ref, "AAPL", side, price, 100));
+        ladder_engine.apply(make_add(ref, "AAPL", side, price, 100));
+    }
+    for (OrderRef ref = 1; ref <= 200; ref += 3) {
+        map_engine.apply(make_delete(ref));
+        ladder_engine.apply(make_delete(ref));
+    }
+
+    const auto* a = map_engine.find_book(make_locate("AAPL"));
+    const auto* b = ladder_engine.find_book(make_locate("AAPL"));
+    TEST_ASSERT(snapshot(a->bids()) == snapshot(b->bids()), "Engine bids match");
+    TEST_ASSERT(snapshot(a->asks()) == snapshot(b->asks()), "Engine asks match");
+
+    TEST_PASS("test_ladder_matches_map");
+    return true;
+}
+
+// Test top-of-book publishing from the engine
+bool test_top_of_book() {
+    BookEngine engine(1024);
+    TopOfBookTable tob;
+    engine.set_top_of_book(&tob);
+
+    NormalizedMessage add = make_add(1, "AAPL", Side::Buy, px(15000), 100);
+    StockLocate locate = add.stock_locate();
+
+    TopOfBook top;
+    TEST_ASSERT(!tob.read(locate, top), "Nothing published yet");
+
+    engine.apply(add);
+    engine.apply(make_add(2, "AAPL", Side::Sell, px(15010), 200));
+    engine.apply(make_add(3, "AAPL", Side::Buy, px(15000), 50));
+
+    TEST_ASSERT(tob.read(locate, top), "Top published");
+    TEST_ASSERT(top.bid_price == px(15000) && top.bid_quantity == 150 && top.bid_orders == 2,
+                "Bid side of top");
+    TEST_ASSERT(top.ask_price == px(15010) && top.ask_quantity == 200 && top.ask_orders == 1,
+                "Ask side of top");
+    TEST_ASSERT(top.timestamp == 1003, "Timestamp of last top change");
+
+    // A change behind the touch does not republish
+    uint64_t published = tob.publishes();
+    engine.apply(make_add(4, "AAPL", Side::Buy, px(14990), 100));
+    TEST_ASSERT(tob.publishes() == published, "Level behind the touch skipped");
+
+    engine.apply(make_delete(2));
+    TEST_ASSERT(tob.read(locate, top), "Top still readable");
+    TEST_ASSERT(top.ask_price == 0 && top.ask_quantity == 0, "Empty ask side");
+
+    TEST_PASS("test_top_of_book");
+    return true;
+}
+
+// Test readers never observe a torn top-of-book record
+bool test_top_of_book_concurrent() {
+    SeqlockTopOfBook slot;
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> torn{0};
+    std::atomic<uint64_t> reads{0};
+
+    // Every published record satisfies ask = bid + 1 and sizes = timestamp
+    auto reader = [&]() {
+        TopOfBook top;
+        while (!done.load(std::memory_order_acquire)) {
+            if (slot.version() == 0) {
+                // Nothing published yet: the zeroed record is not a top
+                std::this_thread::yield();
+                continue;
+            }
+            slot.load(top);
+            if (top.ask_price != top.bid_price + 1 || top.bid_quantity != top.timestamp ||
+                top.ask_quantity != top.timestamp || top.bid_orders != top.ask_orders) {
+                torn.fetch_add(1, std::memory_order_relaxed);
+            }
+            reads.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::yield();
+        }
+    };
+
+    std::thread r1(reader);
+    std::thread r2(reader);
+
+    for (uint64_t i = 1; i <= 200000; ++i) {
+        TopOfBook top;
+        top.bid_price = static_cast<Price>(i * 7);
+        top.ask_price = top.bid_price + 1;
+        top.bid_quantity = i;
+        top.ask_quantity = i;
+        top.bid_orders = static_cast<uint32_t>(i);
+        top.ask_orders = static_cast<uint32_t>(i);
+        top.timestamp = i;
+        slot.store(top);
+        if ((i & 1023) == 0) {
+            std::this_thread::yield();
+        }
+    }
+    done.store(true, std::memory_order_release);
+    r1.join();
+    r2.join();
+
+    TEST_ASSERT(reads.load() > 0, "Readers ran");
+    TEST_ASSERT(torn.load() == 0, "No torn reads");
+    TEST_ASSERT(slot.version() == 400000, "Two sequence steps per store");
+
+    TEST_PASS("test_top_of_book_concurrent");
+    return true;
+}
+
+// Drain a delta ring into a rebuilt depth book
+size_t drain_deltas(DepthFeed::DeltaBuffer& ring, DepthBook& book) {
+    size_t n = 0;
+    while (auto delta = ring.try_pop()) {
+        book.apply(*delta);
+        ++n;
+    }
+    return n;
+}
+
+// Top N levels of a side, as the depth book should hold them
+template <typename Levels>
+std::vector<std::pair<Price, uint64_t>> top_levels(const Levels& levels, size_t n) {
+    auto all = snapshot(levels);
+    if (all.size() > n) all.resize(n);
+    return all;
+}
+
+std::vector<std::pair<Price, uint64_t>> depth_side(const std::vector<PriceLevel>& levels) {
+    std::vector<std::pair<Price, uint64_t>> out;
+    for (const auto& lvl : levels) out.emplace_back(lvl.price, lvl.quantity);
+    return out;
+}
+
+// Test level deltas for inserts, updates and deletes
+bool test_depth_feed() {
+    auto ring = std::make_unique<DepthFeed::DeltaBuffer>();
+    DepthFeed feed(2, *ring);
+    BookEngine engine(1024);
+    engine.set_depth_feed(&feed);
+
+    engine.apply(make_add(1, "AAPL", Side::Buy, px(10000), 100));
+    auto d = ring->try_pop();
+    TEST_ASSERT(d && d->action == LevelDelta::Action::Insert && d->level == 0 &&
+                d->side == Side::Buy && d->price == px(10000) && d->quantity == 100,
+                "Insert at level 0");
+
+    engine.apply(make_add(2, "AAPL", Side::Buy, px(10000), 50));
+    d = ring->try_pop();
+    TEST_ASSERT(d && d->action == LevelDelta::Action::Update && d->quantity == 150 &&
+                d->order_count == 2, "Update at level 0");
+
+    engine.apply(make_add(3, "AAPL", Side::Buy, px(10010), 10));
+    d = ring->try_pop();
+    TEST_ASSERT(d && d->action == LevelDelta::Action::Insert && d->level == 0 &&
+                d->price == px(10010), "Better price inserted at the top");
+    TEST_ASSERT(ring->empty(), "Old best shifts down implicitly");
+
+    // Third level is outside the top 2: no output
+    engine.apply(make_add(4, "AAPL", Side::Buy, px(9990), 10));
+    TEST_ASSERT(ring->empty(), "Change below top N is silent");
+
+    // Removing the best pulls level 3 into view
+    engine.apply(make_delete(3));
+    d = ring->try_pop();
+    TEST_ASSERT(d && d->action == LevelDelta::Action::Delete && d->level == 0, "Delete at 0");
+    d = ring->try_pop();
+    TEST_ASSERT(d && d->action == LevelDelta::Action::Insert && d->level == 1 &&
+                d->price == px(9990), "Next level inserted at the bottom");
+
+    TEST_PASS("test_depth_feed");
+    return true;
+}
+
+// Test a rebuilt depth book tracks the engine under random flow
+bool test_depth_feed_random() {
+    constexpr size_t N = 5;
+    auto ring = std::make_unique<DepthFeed::DeltaBuffer>();
+    DepthFeed feed(N, *ring);
+    BookEngine engine(1 << 14);
+    engine.set_depth_feed(&feed);
+    DepthBook rebuilt(N);
+
+    uint32_t seed = 777;
+    auto next = [&]() {
+        seed = seed * 1664525 + 1013904223;
+        return seed >> 8;
+    };
+
+    std::vector<OrderRef> live;
+    OrderRef next_ref = 1;
+    size_t events = 0;
+    size_t deltas = 0;
+
+    for (int i = 0; i < 20000; ++i) {
+        uint32_t r = next() % 100;
+        if (live.size() < 20 || r < 45) {
+            Side side = (next() & 1) ? Side::Buy : Side::Sell;
+            Price price = side == Side::Buy ? px(10000) - static_cast<Price>(next() % 40) * px(1)
+                                            : px(10001) + static_cast<Price>(next() % 40) * px(1);
+            engine.apply(make_add(next_ref, "MSFT", side, price, 100 * (1 + next() % 5)));
+            live.push_back(next_ref++);
+        } else if (r < 85) {
+            size_t idx = next() % live.size();
+            engine.apply(make_delete(live[idx]));
+            live[idx] = live.back();
+            live.pop_back();
+        } else {
+            size_t idx = next() % live.size();
+            engine.apply(make_cancel(live[idx], 50));
+        }
+        ++events;
+        deltas += drain_deltas(*ring, rebuilt);
+
+        const OrderBook* book = engine.find_book(make_locate("MSFT"));
+        TEST_ASSERT(depth_side(rebuilt.bids()) == top_levels(book->bids(), N), "Bids match");
+        TEST_ASSERT(depth_side(rebuilt.asks()) == top_levels(book->asks(), N), "Asks match");
+    }
+
+    TEST_ASSERT(deltas < events, "Fewer deltas than order events");
+    TEST_ASSERT(feed.get_stats().deltas_dropped == 0, "No drops");
+
+    TEST_PASS("test_depth_feed_random");
+    return true;
+}
+
+int main() {
+    std::cout << "=== Order Book Engine Tests ===" << std::endl;
+    std::cout << std::endl;
+
+    int passed = 0;
+    int failed = 0;
+
+    auto run_test = [&](bool (*test)(), const char* name) {
+        try {
+            if (test()) {
+                ++passed;
+            } else {
+                ++failed;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "FAIL: " << name << " threw exception: " << e.what() << std::endl;
+            ++failed;
+        }
+    };
+
+    run_test(test_add_orders, "test_add_orders");
+    run_test(test_executions, "test_executions");
+    run_test(test_cancel_delete, "test_cancel_delete");
+    run_test(test_replace, "test_replace");
+    run_test(test_multiple_symbols, "test_multiple_symbols");
+    run_test(test_stock_directory, "test_stock_directory");
+    run_test(test_unknown_orders, "test_unknown_orders");
+    run_test(test_order_table_basic, "test_order_table_basic");
+    run_test(test_order_table_arena, "test_order_table_arena");
+    run_test(test_order_table_full_engine, "test_order_table_full_engine");
+    run_test(test_ladder_levels, "test_ladder_levels");
+    run_test(test_ladder_recenter, "test_ladder_recenter");
+    run_test(test_ladder_matches_map, "test_ladder_matches_map");
+    run_test(test_top_of_book, "test_top_of_book");
+    run_test(test_top_of_book_concurrent, "test_top_of_book_concurrent");
+    run_test(test_depth_feed, "test_depth_feed");
+    run_test(test_depth_feed_random, "test_depth_feed_random");
+
+    std::cout << std::endl;
+    std::cout << "=== Results ===" << std::endl;
+    std::cout << "Passed: " << passed << std::endl;
+    std::cout << "Failed: " << failed << std::endl;
+
+    return failed == 0 ? 0 : 1;
+}
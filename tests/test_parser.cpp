@@ -6,6 +6,8 @@
  * - Parsing of all message types
  * - Endianness handling
  * - Callback invocation
+ * - Compile-time handler dispatch
+ * - Batch parsing of length-prefixed buffers
  */
 
 #include "../include/itch5/messages.hpp"
@@ -153,7 +155,7 @@ bool test_parse_add_order() {
 
     auto stats = parser.get_stats();
     TEST_ASSERT(stats.total_messages == 1, "Total message count should be 1");
-    TEST_ASSERT(stats.add_orders == 1, "Add order count should be 1");
+    TEST_ASSERT(stats.add_orders() == 1, "Add order count should be 1");
 
     TEST_PASS("test_parse_add_order");
     return true;
@@ -271,7 +273,7 @@ bool test_parse_multiple_messages() {
 
     auto stats = parser.get_stats();
     TEST_ASSERT(stats.total_messages == 10, "Total message count should be 10");
-    TEST_ASSERT(stats.add_orders == 10, "Add order count should be 10");
+    TEST_ASSERT(stats.add_orders() == 10, "Add order count should be 10");
 
     TEST_PASS("test_parse_multiple_messages");
     return true;
@@ -290,20 +292,61 @@ bool test_normalize_add_order() {
     std::memcpy(msg.stock, "MSFT    ", 8);
     msg.price = endian::hton32(2500000);  // $250.0000
 
-    NormalizedMessage norm = Parser::normalize_add_order(&msg);
-
-    TEST_ASSERT(norm.type == MessageType::AddOrder, "Type should be AddOrder");
-    TEST_ASSERT(norm.timestamp == 34200000000000ULL, "Timestamp should match");
-    TEST_ASSERT(norm.order_ref == 12345ULL, "Order ref should match");
-    TEST_ASSERT(norm.side == Side::Sell, "Side should be Sell");
-    TEST_ASSERT(norm.price == 250000000, "Price should be $250 * 1000000");
-    TEST_ASSERT(norm.quantity == 500, "Quantity should match");
-    TEST_ASSERT(std::memcmp(norm.stock.data(), "MSFT    ", 8) == 0, "Stock symbol should match");
+    Parser parser;
+    NormalizedMessage norm;
+    TEST_ASSERT(parser.normalize_add_order(&msg, norm), "In-range ref normalized");
+
+    TEST_ASSERT(norm.type() == MessageType::AddOrder, "Type should be AddOrder");
+    TEST_ASSERT(norm.stock_locate() == 1, "Stock locate should be carried");
+    TEST_ASSERT(norm.timestamp() == 34200000000000ULL, "Timestamp should match");
+    TEST_ASSERT(norm.order_ref() == 12345ULL, "Order ref should match");
+    TEST_ASSERT(norm.side() == Side::Sell, "Side should be Sell");
+    TEST_ASSERT(norm.price() == 250000000, "Price should be $250 * 1000000");
+    TEST_ASSERT(norm.quantity() == 500, "Quantity should match");
+    TEST_ASSERT(parser.get_stats().order_ref_overflows == 0, "In-range ref not counted");
+
+    // Wider than 48 bits: dropped and counted, never masked or clamped
+    msg.order_reference_number = endian::hton64((1ULL << 48) + 7);
+    TEST_ASSERT(!parser.normalize_add_order(&msg, norm), "Wide ref rejected");
+    TEST_ASSERT(norm.order_ref() == 12345ULL, "Output left untouched");
+    TEST_ASSERT(parser.get_stats().order_ref_overflows == 1, "Wide ref counted");
 
     TEST_PASS("test_normalize_add_order");
     return true;
 }
 
+// Test Stock Directory callback
+bool test_parse_stock_directory() {
+    Parser parser;
+    uint16_t locate = 0;
+    uint32_t round_lot = 0;
+    char symbol[8] = {};
+
+    parser.set_stock_directory_callback([&](const StockDirectory* msg, Timestamp) {
+        locate = endian::ntoh16(msg->stock_locate);
+        round_lot = endian::ntoh32(msg->round_lot_size);
+        std::memcpy(symbol, msg->stock, 8);
+    });
+
+    StockDirectory msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.message_type = 'R';
+    msg.stock_locate = endian::hton16(8007);
+    set_timestamp(msg.timestamp, 10000000000ULL);
+    std::memcpy(msg.stock, "AAPL    ", 8);
+    msg.round_lot_size = endian::hton32(100);
+
+    size_t consumed = parser.parse_message(reinterpret_cast<uint8_t*>(&msg), sizeof(msg));
+
+    TEST_ASSERT(consumed == sizeof(StockDirectory), "Should consume 39 bytes");
+    TEST_ASSERT(locate == 8007, "Locate should match");
+    TEST_ASSERT(round_lot == 100, "Round lot should match");
+    TEST_ASSERT(std::memcmp(symbol, "AAPL    ", 8) == 0, "Symbol should match");
+
+    TEST_PASS("test_parse_stock_directory");
+    return true;
+}
+
 // Test incomplete message handling
 bool test_incomplete_message() {
     Parser parser;
@@ -340,6 +383,200 @@ bool test_unknown_message() {
     return true;
 }
 
+// Handler implementing only AddOrder and OrderDelete
+struct PartialHandler {
+    int adds = 0;
+    int deletes = 0;
+    Price last_price = 0;
+    Quantity last_qty = 0;
+    Timestamp last_ts = 0;
+
+    void on_add_order(const AddOrder*, Timestamp ts, Price price, Quantity qty) {
+        ++adds;
+        last_ts = ts;
+        last_price = price;
+        last_qty = qty;
+    }
+
+    void on_order_delete(const OrderDelete*, Timestamp ts) {
+        ++deletes;
+        last_ts = ts;
+    }
+};
+
+static_assert(detail::detect<PartialHandler, detail::on_add_order_t>::value,
+              "on_add_order should be detected");
+static_assert(!detail::detect<PartialHandler, detail::on_trade_t>::value,
+              "Missing on_trade should not be detected");
+
+// Test compile-time dispatch to a handler
+bool test_static_dispatch() {
+    PartialHandler handler;
+    BasicParser<PartialHandler> parser(handler);
+
+    AddOrder add;
+    std::memset(&add, 0, sizeof(add));
+    add.message_type = 'A';
+    set_timestamp(add.timestamp, 34200000000000ULL);
+    add.order_reference_number = endian::hton64(42);
+    add.buy_sell_indicator = 'S';
+    add.shares = endian::hton32(300);
+    add.price = endian::hton32(1234500);
+
+    OrderExecuted exec;
+    std::memset(&exec, 0, sizeof(exec));
+    exec.message_type = 'E';
+    exec.order_reference_number = endian::hton64(42);
+    exec.executed_shares = endian::hton32(100);
+
+    OrderDelete del;
+    std::memset(&del, 0, sizeof(del));
+    del.message_type = 'D';
+    set_timestamp(del.timestamp, 34200000000500ULL);
+    del.order_reference_number = endian::hton64(42);
+
+    TEST_ASSERT(parser.parse_message(reinterpret_cast<uint8_t*>(&add), sizeof(add)) == sizeof(add),
+                "AddOrder consumed");
+    TEST_ASSERT(handler.adds == 1, "on_add_order called");
+    TEST_ASSERT(handler.last_price == 123450000, "Price converted to 6 decimals");
+    TEST_ASSERT(handler.last_qty == 300, "Quantity decoded");
+    TEST_ASSERT(handler.last_ts == 34200000000000ULL, "Timestamp decoded");
+
+    // No on_order_executed: consumed and counted, nothing called
+    TEST_ASSERT(parser.parse_message(reinterpret_cast<uint8_t*>(&exec), sizeof(exec)) == sizeof(exec),
+                "Unhandled type still consumed");
+
+    parser.parse_message(reinterpret_cast<uint8_t*>(&del), sizeof(del));
+    TEST_ASSERT(handler.deletes == 1, "on_order_delete called");
+    TEST_ASSERT(handler.last_ts == 34200000000500ULL, "Delete timestamp decoded");
+
+    auto stats = parser.get_stats();
+    TEST_ASSERT(stats.total_messages == 3, "All messages counted");
+    TEST_ASSERT(stats.add_orders() == 1, "Add counted");
+    TEST_ASSERT(stats.order_executed() == 1, "Unhandled execution still counted");
+    TEST_ASSERT(stats.order_deleted() == 1, "Delete counted");
+
+    TEST_PASS("test_static_dispatch");
+    return true;
+}
+
+// Append a 2-byte length-prefixed block
+template <typename Msg>
+void append_block(std::vector<uint8_t>& buffer, const Msg& msg) {
+    buffer.push_back(static_cast<uint8_t>(sizeof(Msg) >> 8));
+    buffer.push_back(static_cast<uint8_t>(sizeof(Msg) & 0xFF));
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(&msg);
+    buffer.insert(buffer.end(), data, data + sizeof(Msg));
+}
+
+// Test batch parsing of length-prefixed blocks
+bool test_parse_buffer() {
+    PartialHandler handler;
+    BasicParser<PartialHandler> parser(handler);
+
+    std::vector<uint8_t> buffer;
+    for (int i = 0; i < 10; ++i) {
+        AddOrder add;
+        std::memset(&add, 0, sizeof(add));
+        add.message_type = 'A';
+        add.order_reference_number = endian::hton64(i + 1);
+        add.shares = endian::hton32(100);
+        append_block(buffer, add);
+
+        OrderDelete del;
+        std::memset(&del, 0, sizeof(del));
+        del.message_type = 'D';
+        del.order_reference_number = endian::hton64(i + 1);
+        append_block(buffer, del);
+    }
+
+    // Unknown message type: walked over, not counted as parsed
+    buffer.push_back(0);
+    buffer.push_back(3);
+    buffer.push_back('Z');
+    buffer.push_back(0);
+    buffer.push_back(0);
+    size_t complete = buffer.size();
+
+    // Truncated trailing block
+    buffer.push_back(0);
+    buffer.push_back(static_cast<uint8_t>(sizeof(AddOrder)));
+    buffer.push_back('A');
+
+    BatchResult result = parser.parse_buffer(buffer.data(), buffer.size());
+    TEST_ASSERT(result.messages == 20, "Should parse 20 messages");
+    TEST_ASSERT(result.blocks == 21, "Should walk 21 complete blocks");
+    TEST_ASSERT(result.consumed == complete, "Should stop before the truncated block");
+    TEST_ASSERT(handler.adds == 10 && handler.deletes == 10, "Handlers called per message");
+
+    // Bounded by a message count (MoldUDP64 header count)
+    PartialHandler bounded_handler;
+    BasicParser<PartialHandler> bounded(bounded_handler);
+    result = bounded.parse_buffer(buffer.data(), buffer.size(), 3);
+    TEST_ASSERT(result.blocks == 3, "Should stop at max_messages");
+    TEST_ASSERT(bounded_handler.adds == 2 && bounded_handler.deletes == 1, "First three blocks only");
+
+    // Resuming from consumed covers the rest
+    BatchResult rest = bounded.parse_buffer(buffer.data() + result.consumed,
+                                            buffer.size() - result.consumed);
+    TEST_ASSERT(result.messages + rest.messages == 20, "Resume parses the remainder");
+
+    TEST_PASS("test_parse_buffer");
+    return true;
+}
+
+// Test the type-byte descriptor table and per-type counters
+bool test_message_table() {
+    const char types[] = {'S', 'R', 'H', 'Y', 'L', 'V', 'W', 'K', 'J', 'h', 'A',
+                          'F', 'E', 'C', 'X', 'D', 'U', 'P', 'Q', 'B', 'I', 'N'};
+
+    size_t known = 0;
+    for (int b = 0; b < 256; ++b) {
+        const MessageDescriptor& desc = describe_message(static_cast<char>(b));
+        if (desc.size != 0) {
+            ++known;
+            TEST_ASSERT(desc.type == static_cast<char>(b), "Descriptor type byte matches index");
+            TEST_ASSERT(desc.kind != MessageKind::Unknown, "Known type has a kind");
+            TEST_ASSERT(find_descriptor(desc.kind) == &desc, "Kind maps back to its descriptor");
+        } else {
+            TEST_ASSERT(desc.kind == MessageKind::Unknown, "Unknown type byte has no kind");
+        }
+    }
+    TEST_ASSERT(known == sizeof(types), "Exactly the ITCH 5.0 types are known");
+    TEST_ASSERT(known == MESSAGE_KIND_COUNT - 1, "One kind per type");
+
+    TEST_ASSERT(describe_message('A').category == MessageCategory::Order, "AddOrder is an order message");
+    TEST_ASSERT(describe_message('P').category == MessageCategory::Trade, "Trade category");
+    TEST_ASSERT(describe_message('R').category == MessageCategory::Reference, "Directory category");
+    TEST_ASSERT(describe_message('I').category == MessageCategory::Imbalance, "NOII category");
+
+    // Per-type counters
+    Parser parser;
+    OrderCancel cancel;
+    std::memset(&cancel, 0, sizeof(cancel));
+    cancel.message_type = 'X';
+    SystemEvent event;
+    std::memset(&event, 0, sizeof(event));
+    event.message_type = 'S';
+    uint8_t bogus[8] = {'z'};
+
+    parser.parse_message(reinterpret_cast<uint8_t*>(&cancel), sizeof(cancel));
+    parser.parse_message(reinterpret_cast<uint8_t*>(&cancel), sizeof(cancel));
+    parser.parse_message(reinterpret_cast<uint8_t*>(&event), sizeof(event));
+    parser.parse_message(bogus, sizeof(bogus));
+
+    auto stats = parser.get_stats();
+    TEST_ASSERT(stats.count(MessageKind::OrderCancel) == 2, "Cancel slot");
+    TEST_ASSERT(stats.order_cancelled() == 2, "Cancel aggregate");
+    TEST_ASSERT(stats.count(MessageKind::SystemEvent) == 1, "System event slot");
+    TEST_ASSERT(stats.other_messages() == 1, "System event is an other message");
+    TEST_ASSERT(stats.unknown_messages() == 1, "Unknown type byte counted");
+    TEST_ASSERT(stats.total_messages == 3, "Unknown type not in the total");
+
+    TEST_PASS("test_message_table");
+    return true;
+}
+
 int main() {
     std::cout << "=== ITCH 5.0 Parser Tests ===" << std::endl;
     std::cout << std::endl;
@@ -362,14 +599,18 @@ int main() {
 
     run_test(test_message_sizes, "test_message_sizes");
     run_test(test_get_message_size, "test_get_message_size");
+    run_test(test_message_table, "test_message_table");
     run_test(test_endian_utils, "test_endian_utils");
     run_test(test_parse_add_order, "test_parse_add_order");
     run_test(test_parse_order_executed, "test_parse_order_executed");
     run_test(test_parse_order_delete, "test_parse_order_delete");
     run_test(test_parse_multiple_messages, "test_parse_multiple_messages");
     run_test(test_normalize_add_order, "test_normalize_add_order");
+    run_test(test_parse_stock_directory, "test_parse_stock_directory");
     run_test(test_incomplete_message, "test_incomplete_message");
     run_test(test_unknown_message, "test_unknown_message");
+    run_test(test_static_dispatch, "test_static_dispatch");
+    run_test(test_parse_buffer, "test_parse_buffer");
 
     std::cout << std::endl;
     std::cout << "=== Results ===" << std::endl;
@@ -4,11 +4,19 @@
  * Tests:
  * - Basic push/pop operations
  * - Boundary conditions (empty, full)
+ * - Run-time sized, mapped storage
+ * - Sequence totals and lag metrics
  * - Thread safety (producer/consumer)
+ * - Wait strategies (blocking park/wake, runtime mode)
+ * - Shared-memory ring (attach checks, lapping readers)
  * - Performance characteristics
  */
 
 #include "../include/spsc/ring_buffer.hpp"
+#include "../include/spsc/byte_ring.hpp"
+#include "../include/spsc/broadcast_ring.hpp"
+#include "../include/spsc/mpsc_queue.hpp"
+#include "../include/spsc/shm_ring.hpp"
 #include "../include/common/types.hpp"
 
 #include <iostream>
@@ -17,6 +25,11 @@
 #include <chrono>
 #include <cassert>
 #include <cstring>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <unistd.h>
 
 using namespace hft;
 using namespace hft::spsc;
@@ -134,6 +147,109 @@ bool test_wraparound() {
     return true;
 }
 
+// Run-time capacity: rounding, mapped storage, wrap with batch copies
+bool test_dynamic_capacity() {
+    RingBuffer<uint64_t, DYNAMIC_CAPACITY> buffer(100);
+    TEST_ASSERT(buffer.capacity() == 128, "Capacity should round up to a power of 2");
+    TEST_ASSERT(buffer.memory().data() != nullptr, "Storage should be mapped");
+    TEST_ASSERT(buffer.memory().size() >= 128 * sizeof(uint64_t), "Mapping should cover every slot");
+
+    // Default options still work where no hugepages are reserved
+    MemoryOptions plain;
+    plain.huge_pages = false;
+    RingBuffer<uint64_t, DYNAMIC_CAPACITY> small(8, plain);
+    TEST_ASSERT(small.memory().backing() == PageBacking::Normal, "Opt-out should use normal pages");
+
+    uint64_t next_push = 0;
+    uint64_t next_pop = 0;
+    uint64_t batch[5];
+    for (int round = 0; round < 10; ++round) {
+        for (uint64_t& v : batch) {
+            v = next_push++;
+        }
+        TEST_ASSERT(small.try_push_batch(batch, 5) == 5, "Batch push should fit");
+        TEST_ASSERT(small.try_pop_batch(batch, 5) == 5, "Batch pop should drain");
+        for (uint64_t v : batch) {
+            TEST_ASSERT(v == next_pop++, "Values should survive the wrap");
+        }
+    }
+    TEST_ASSERT(small.empty() && small.available() == 7, "Ring should be empty");
+
+    TEST_PASS("test_dynamic_capacity");
+    return true;
+}
+
+// Monotonic sequences, high-water mark and sampled queueing delay
+bool test_ring_stats() {
+    RingBuffer<uint64_t, 8> buffer;
+    buffer.enable_delay_sampling(2);
+
+    // Several laps: totals keep counting past the capacity
+    for (uint64_t round = 0; round < 5; ++round) {
+        for (uint64_t i = 0; i < 5; ++i) {
+            TEST_ASSERT(buffer.try_push(round * 5 + i), "Push should succeed");
+        }
+        for (uint64_t i = 0; i < 5; ++i) {
+            auto val = buffer.try_pop();
+            TEST_ASSERT(val.has_value() && *val == round * 5 + i, "Pop should return in order");
+        }
+    }
+
+    RingStats stats = buffer.stats();
+    TEST_ASSERT(stats.produced == 25 && buffer.produced() == 25, "Produced should be a running total");
+    TEST_ASSERT(stats.consumed == 25 && buffer.consumed() == 25, "Consumed should be a running total");
+    TEST_ASSERT(stats.backlog == 0, "Backlog should be zero when drained");
+    TEST_ASSERT(stats.high_water_mark == 5, "High-water mark should be the largest burst seen");
+    TEST_ASSERT(stats.delay_samples == 13, "Every second sequence should be timed");
+
+    // A full ring is the new high-water mark, batch paths are sampled too
+    uint64_t items[7] = {};
+    TEST_ASSERT(buffer.try_push_batch(items, 7) == 7, "Batch should fill the ring");
+    TEST_ASSERT(buffer.try_pop_batch(items, 7) == 7, "Batch should drain the ring");
+    stats = buffer.stats();
+    TEST_ASSERT(stats.high_water_mark == 7, "Full ring should raise the high-water mark");
+    TEST_ASSERT(stats.delay_samples == 16, "Batch items should be timed");
+    TEST_ASSERT(stats.delay_max_ns >= stats.mean_delay_ns(), "Max delay should bound the mean");
+
+    TEST_PASS("test_ring_stats");
+    return true;
+}
+
+// Test that stale cached indices are refreshed at full and empty
+bool test_cached_indices() {
+    RingBuffer<uint64_t, 8> buffer;
+
+    for (int round = 0; round < 4; ++round) {
+        // Fill: the producer's cached tail goes stale at the last slot
+        for (uint64_t i = 0; i < 7; ++i) {
+            TEST_ASSERT(buffer.try_push(round * 100 + i), "Push should succeed until full");
+        }
+        TEST_ASSERT(!buffer.try_push(999), "Push should fail when full");
+
+        // One pop must be visible to the producer through the refresh
+        auto val = buffer.try_pop();
+        TEST_ASSERT(val.has_value() && *val == static_cast<uint64_t>(round * 100), "Pop should return oldest");
+        TEST_ASSERT(buffer.try_push(round * 100 + 7), "Push should see the freed slot");
+        TEST_ASSERT(!buffer.try_push(999), "Push should fail when full again");
+
+        // Drain: the consumer's cached head goes stale at empty
+        for (uint64_t i = 1; i <= 7; ++i) {
+            auto v = buffer.try_pop();
+            TEST_ASSERT(v.has_value() && *v == round * 100 + i, "Drain should preserve order");
+        }
+        TEST_ASSERT(!buffer.try_pop().has_value(), "Pop should fail when empty");
+        TEST_ASSERT(!buffer.peek().has_value(), "Peek should fail when empty");
+
+        // A push after empty must be visible to the consumer through the refresh
+        TEST_ASSERT(buffer.try_push(42), "Push after drain should succeed");
+        TEST_ASSERT(buffer.peek().has_value() && *buffer.peek() == 42, "Peek should see new item");
+        TEST_ASSERT(buffer.try_pop().value_or(0) == 42, "Pop should see new item");
+    }
+
+    TEST_PASS("test_cached_indices");
+    return true;
+}
+
 // Test peek operation
 bool test_peek() {
     RingBuffer<uint64_t, BUFFER_SIZE> buffer;
@@ -207,33 +323,807 @@ bool test_concurrent_spsc() {
     return true;
 }
 
+// Test bulk push/pop across the wrap point
+bool test_batch_operations() {
+    RingBuffer<uint64_t, 16> buffer;  // 15 usable slots
+    uint64_t in[32];
+    uint64_t out[32];
+    for (uint64_t i = 0; i < 32; ++i) {
+        in[i] = i;
+    }
+
+    TEST_ASSERT(buffer.try_pop_batch(out, 8) == 0, "Pop batch on empty should return 0");
+
+    // Partial push when the batch exceeds free space
+    TEST_ASSERT(buffer.try_push_batch(in, 20) == 15, "Push batch should stop at capacity - 1");
+    TEST_ASSERT(buffer.full(), "Buffer should be full");
+    TEST_ASSERT(buffer.try_push_batch(in, 1) == 0, "Push batch on full should return 0");
+
+    TEST_ASSERT(buffer.try_pop_batch(out, 10) == 10, "Pop batch should return requested count");
+    for (uint64_t i = 0; i < 10; ++i) {
+        TEST_ASSERT(out[i] == i, "Popped batch should be in order");
+    }
+
+    // This push wraps: 1 slot before the end, the rest from index 0
+    TEST_ASSERT(buffer.try_push_batch(in + 15, 10) == 10, "Wrapping push batch should succeed");
+    TEST_ASSERT(buffer.size() == 15, "Size should count both segments");
+
+    // This pop wraps too
+    TEST_ASSERT(buffer.try_pop_batch(out, 32) == 15, "Pop batch should return all available");
+    for (uint64_t i = 0; i < 15; ++i) {
+        TEST_ASSERT(out[i] == 10 + i, "Wrapped batch should be in order");
+    }
+    TEST_ASSERT(buffer.empty(), "Buffer should be empty");
+
+    // Batch and single-item operations interleave
+    TEST_ASSERT(buffer.try_push(100), "Single push should succeed");
+    TEST_ASSERT(buffer.try_push_batch(in, 3) == 3, "Push batch should succeed");
+    TEST_ASSERT(buffer.try_pop().value_or(0) == 100, "Single pop should see first item");
+    TEST_ASSERT(buffer.try_pop_batch(out, 3) == 3 && out[2] == 2, "Pop batch should see the rest");
+
+    TEST_PASS("test_batch_operations");
+    return true;
+}
+
+// Test concurrent producer/consumer using batch operations
+bool test_concurrent_batch() {
+    RingBuffer<uint64_t, BUFFER_SIZE> buffer;
+    std::atomic<bool> producer_done{false};
+    std::atomic<bool> ordered{true};
+    uint64_t received = 0;
+
+    std::thread consumer([&]() {
+        uint64_t out[37];
+        while (received < NUM_MESSAGES) {
+            size_t n = buffer.try_pop_batch(out, 37);
+            for (size_t i = 0; i < n; ++i) {
+                if (out[i] != received + i) {
+                    ordered.store(false, std::memory_order_relaxed);
+                }
+            }
+            received += n;
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::thread producer([&]() {
+        uint64_t in[53];
+        uint64_t next = 0;
+        while (next < NUM_MESSAGES) {
+            size_t count = std::min<uint64_t>(53, NUM_MESSAGES - next);
+            for (size_t i = 0; i < count; ++i) {
+                in[i] = next + i;
+            }
+            size_t sent = 0;
+            while (sent < count) {
+                size_t n = buffer.try_push_batch(in + sent, count - sent);
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+                sent += n;
+            }
+            next += count;
+        }
+        producer_done.store(true, std::memory_order_release);
+    });
+
+    producer.join();
+    consumer.join();
+
+    TEST_ASSERT(producer_done.load(), "Producer should finish");
+    TEST_ASSERT(received == NUM_MESSAGES, "All messages should be received");
+    TEST_ASSERT(ordered.load(), "Batches should preserve FIFO order");
+
+    TEST_PASS("test_concurrent_batch");
+    return true;
+}
+
+// Test in-place claim/commit and front/release
+bool test_claim_commit() {
+    RingBuffer<uint64_t, 8> buffer;  // 7 usable slots
+
+    // Claimed slots are invisible until commit
+    uint64_t* a = buffer.try_claim();
+    uint64_t* b = buffer.try_claim();
+    TEST_ASSERT(a && b && a != b, "Claims should return distinct slots");
+    *a = 1;
+    *b = 2;
+    TEST_ASSERT(buffer.front() == nullptr, "Uncommitted claims should not be readable");
+    TEST_ASSERT(buffer.empty(), "Uncommitted claims should not count");
+
+    buffer.commit();
+    TEST_ASSERT(buffer.size() == 2, "Commit should publish all claims");
+
+    // try_push after a claim publishes both, in claim order
+    uint64_t* c = buffer.try_claim();
+    TEST_ASSERT(c != nullptr, "Claim should succeed");
+    *c = 3;
+    TEST_ASSERT(buffer.try_push(4), "Push should succeed");
+
+    for (uint64_t expected = 1; expected <= 4; ++expected) {
+        const uint64_t* item = buffer.front();
+        TEST_ASSERT(item && *item == expected, "Front should read items in order");
+        TEST_ASSERT(buffer.front() == item, "Front should not advance without release");
+        buffer.release();
+    }
+    TEST_ASSERT(buffer.front() == nullptr, "Front on empty should return nullptr");
+
+    // Claims stop at capacity - 1 and resume after a release
+    for (int i = 0; i < 7; ++i) {
+        uint64_t* slot = buffer.try_claim();
+        TEST_ASSERT(slot != nullptr, "Claim should succeed until full");
+        *slot = 10 + i;
+    }
+    TEST_ASSERT(buffer.try_claim() == nullptr, "Claim on full should return nullptr");
+    buffer.commit();
+    TEST_ASSERT(buffer.full(), "Buffer should be full after commit");
+
+    TEST_ASSERT(*buffer.front() == 10, "Front should see the oldest claim");
+    buffer.release();
+    uint64_t* slot = buffer.try_claim();
+    TEST_ASSERT(slot != nullptr, "Claim should see the released slot");
+    *slot = 17;
+    buffer.commit();
+
+    uint64_t out[8];
+    TEST_ASSERT(buffer.try_pop_batch(out, 8) == 7, "Batch pop should drain claimed items");
+    TEST_ASSERT(out[0] == 11 && out[6] == 17, "Claimed items should keep order across the wrap");
+
+    TEST_PASS("test_claim_commit");
+    return true;
+}
+
+// Test reading runs in place with front_batch/release(n)
+bool test_front_batch() {
+    RingBuffer<uint64_t, 8> buffer;  // 7 usable slots
+    const uint64_t* run = nullptr;
+    TEST_ASSERT(buffer.front_batch(run, 8) == 0, "Empty ring should have no run");
+
+    for (uint64_t i = 0; i < 6; ++i) {
+        buffer.try_push(i);
+    }
+    TEST_ASSERT(buffer.front_batch(run, 4) == 4, "Run should stop at max_count");
+    TEST_ASSERT(run[0] == 0 && run[3] == 3, "Run should read items in place, in order");
+    buffer.release(4);
+    TEST_ASSERT(buffer.size() == 2, "Release should free the whole run");
+
+    // Items 4..9 now wrap: slots 4-7, then 0-1
+    for (uint64_t i = 6; i < 10; ++i) {
+        buffer.try_push(i);
+    }
+    TEST_ASSERT(buffer.front_batch(run, 8) == 4, "Run should stop at the wrap");
+    TEST_ASSERT(run[0] == 4 && run[3] == 7, "Run before the wrap");
+    buffer.release(4);
+    TEST_ASSERT(buffer.front_batch(run, 8) == 2, "Next call should return the rest");
+    TEST_ASSERT(run[0] == 8 && run[1] == 9, "Run after the wrap");
+    buffer.release(2);
+    TEST_ASSERT(buffer.empty() && buffer.front() == nullptr, "Ring should be drained");
+
+    TEST_PASS("test_front_batch");
+    return true;
+}
+
+// Test concurrent producer/consumer with in-place NormalizedMessages
+bool test_concurrent_claim_commit() {
+    RingBuffer<NormalizedMessage, BUFFER_SIZE> buffer;
+    std::atomic<bool> ordered{true};
+
+    std::thread consumer([&]() {
+        uint64_t expected = 0;
+        while (expected < NUM_MESSAGES) {
+            const NormalizedMessage* msg = buffer.front();
+            if (!msg) {
+                std::this_thread::yield();
+                continue;
+            }
+            if (msg->order_ref() != expected || msg->quantity() != expected % 1000) {
+                ordered.store(false, std::memory_order_relaxed);
+            }
+            buffer.release();
+            ++expected;
+        }
+    });
+
+    std::thread producer([&]() {
+        for (uint64_t i = 0; i < NUM_MESSAGES; ++i) {
+            NormalizedMessage* slot;
+            while (!(slot = buffer.try_claim())) {
+                buffer.commit();
+                std::this_thread::yield();
+            }
+            *slot = NormalizedMessage();
+            slot->set_type(MessageType::AddOrder);
+            slot->set_order_ref(i);
+            slot->set_quantity(static_cast<Quantity>(i % 1000));
+
+            // Publish in bursts, like one commit per packet
+            if (i % 16 == 15) {
+                buffer.commit();
+            }
+        }
+        buffer.commit();
+    });
+
+    producer.join();
+    consumer.join();
+
+    TEST_ASSERT(ordered.load(), "Messages should arrive complete and in order");
+    TEST_ASSERT(buffer.empty(), "Buffer should be drained");
+
+    TEST_PASS("test_concurrent_claim_commit");
+    return true;
+}
+
+// Test variable-length records, alignment and wrap markers
+// Blocking push()/pop(): both sides park on a futex and are woken by the peer
+bool test_blocking_wait() {
+    constexpr uint64_t count = 20000;
+    RingBuffer<uint64_t, 16, BlockingWait> buffer;
+    std::atomic<bool> ordered{true};
+
+    std::thread consumer([&]() {
+        for (uint64_t expected = 0; expected < count; ++expected) {
+            if (buffer.pop() != expected) {
+                ordered.store(false, std::memory_order_relaxed);
+            }
+            // Stall now and then so the producer fills the ring and parks
+            if (expected % 4096 == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        }
+    });
+
+    // Start late so the consumer parks on the empty ring first
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    for (uint64_t i = 0; i < count; ++i) {
+        buffer.push(i);
+    }
+    consumer.join();
+
+    TEST_ASSERT(ordered.load(), "Items should arrive in order");
+    TEST_ASSERT(buffer.empty(), "Buffer should be drained");
+    TEST_ASSERT(buffer.readable_wait().parks() > 0, "Consumer should have parked on the empty ring");
+    TEST_ASSERT(buffer.writable_wait().parks() > 0, "Producer should have parked on the full ring");
+
+    TEST_PASS("test_blocking_wait");
+    return true;
+}
+
+// Runtime wait mode: parsing, and a mode switch releases a parked consumer
+bool test_runtime_wait() {
+    WaitMode mode = WaitMode::BusySpin;
+    TEST_ASSERT(parse_wait_mode("block", mode) && mode == WaitMode::Block, "block should parse");
+    TEST_ASSERT(parse_wait_mode("yield", mode) && mode == WaitMode::SpinYield, "yield should parse");
+    TEST_ASSERT(parse_wait_mode(wait_mode_name(WaitMode::SpinPause), mode) &&
+                mode == WaitMode::SpinPause, "Printed names should parse back");
+    TEST_ASSERT(!parse_wait_mode("sleep", mode), "Unknown mode should be rejected");
+
+    RingBuffer<uint64_t, BUFFER_SIZE, RuntimeWait> buffer;
+    buffer.readable_wait().set_mode(WaitMode::Block);
+    TEST_ASSERT(buffer.readable_wait().mode() == WaitMode::Block, "Mode should be stored");
+
+    std::atomic<uint64_t> received{0};
+    std::thread consumer([&]() {
+        for (int i = 0; i < 2; ++i) {
+            received.fetch_add(buffer.pop(), std::memory_order_relaxed);
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    buffer.push(1);  // Wakes the parked consumer through notify()
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    buffer.readable_wait().set_mode(WaitMode::BusySpin);
+    buffer.push(2);
+    consumer.join();
+
+    TEST_ASSERT(received.load() == 3, "Both items should be received");
+    TEST_ASSERT(buffer.readable_wait().parks() > 0, "Consumer should have parked in Block mode");
+
+    TEST_PASS("test_runtime_wait");
+    return true;
+}
+
+bool test_byte_ring() {
+    using Ring = ByteRing<1024>;  // 16 cache lines
+    auto ring = std::make_unique<Ring>();
+
+    TEST_ASSERT(!ring->front(), "Front on empty should return no record");
+    TEST_ASSERT(Ring::record_footprint(0) == CACHE_LINE_SIZE, "Header-only record is one line");
+    TEST_ASSERT(Ring::record_footprint(CACHE_LINE_SIZE) == 2 * CACHE_LINE_SIZE,
+                "Header pushes a full-line payload onto a second line");
+
+    // Records of varying length round-trip byte for byte, across many wraps
+    uint8_t data[Ring::MAX_RECORD_SIZE];
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    size_t lengths[] = {1, 21, 36, 100, 200, 0, 300, 57};
+    for (int round = 0; round < 50; ++round) {
+        size_t length = lengths[round % 8] + round;
+        TEST_ASSERT(ring->try_push(data + round, length), "Push should succeed on a drained ring");
+
+        Ring::Record record = ring->front();
+        TEST_ASSERT(record, "Front should return the record");
+        TEST_ASSERT(record.length == length, "Length should round-trip");
+        TEST_ASSERT(std::memcmp(record.data, data + round, length) == 0, "Payload should round-trip");
+        TEST_ASSERT(reinterpret_cast<uintptr_t>(record.data - Ring::HEADER_SIZE) % CACHE_LINE_SIZE == 0,
+                    "Records should start on a cache line");
+        ring->release();
+        TEST_ASSERT(ring->empty(), "Ring should be empty after release");
+    }
+
+    // Fill: several claims published by one commit, then a refusal
+    size_t pushed = 0;
+    while (uint8_t* payload = ring->try_claim(100)) {
+        std::memset(payload, static_cast<int>(pushed), 100);
+        ++pushed;
+    }
+    TEST_ASSERT(!ring->front(), "Claims should be invisible before commit");
+    ring->commit();
+    TEST_ASSERT(pushed >= 5, "A 1 KB ring should hold several 100-byte records");
+    TEST_ASSERT(ring->used_bytes() <= Ring::capacity(), "Used bytes should not exceed capacity");
+    TEST_ASSERT(!ring->try_push(data, 100), "Push should fail when full");
+    TEST_ASSERT(!ring->try_claim(Ring::MAX_RECORD_SIZE + 1), "Oversized record should be refused");
+
+    for (size_t i = 0; i < pushed; ++i) {
+        Ring::Record record = ring->front();
+        TEST_ASSERT(record && record.length == 100, "Record should be readable");
+        TEST_ASSERT(record.data[0] == i && record.data[99] == i, "Records should stay in order");
+        ring->release();
+    }
+    TEST_ASSERT(!ring->front(), "Ring should be drained");
+
+    // A maximum-size record fits whatever the wrap position
+    TEST_ASSERT(ring->try_push(data, Ring::MAX_RECORD_SIZE), "Max-size record should fit when empty");
+    TEST_ASSERT(ring->front().length == Ring::MAX_RECORD_SIZE, "Max-size record should be readable");
+    ring->release();
+
+    TEST_PASS("test_byte_ring");
+    return true;
+}
+
+// Test concurrent producer/consumer of variable-length records
+bool test_concurrent_byte_ring() {
+    using Ring = ByteRing<4096>;
+    auto ring = std::make_unique<Ring>();
+    constexpr uint32_t RECORDS = 20000;
+    std::atomic<bool> intact{true};
+
+    std::thread consumer([&]() {
+        uint32_t expected = 0;
+        while (expected < RECORDS) {
+            Ring::Record record = ring->front();
+            if (!record) {
+                std::this_thread::yield();
+                continue;
+            }
+            uint32_t seq;
+            std::memcpy(&seq, record.data, sizeof(seq));
+            bool ok = seq == expected && record.length == 4 + seq % 300;
+            for (size_t i = 4; ok && i < record.length; ++i) {
+                ok = record.data[i] == static_cast<uint8_t>(seq + i);
+            }
+            if (!ok) {
+                intact.store(false, std::memory_order_relaxed);
+            }
+            ring->release();
+            ++expected;
+        }
+    });
+
+    std::thread producer([&]() {
+        uint8_t record[4 + 300];
+        for (uint32_t seq = 0; seq < RECORDS; ++seq) {
+            size_t length = 4 + seq % 300;
+            std::memcpy(record, &seq, sizeof(seq));
+            for (size_t i = 4; i < length; ++i) {
+                record[i] = static_cast<uint8_t>(seq + i);
+            }
+            while (!ring->try_push(record, length)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    TEST_ASSERT(intact.load(), "Records should arrive complete and in order");
+    TEST_ASSERT(ring->empty(), "Ring should be drained");
+
+    TEST_PASS("test_concurrent_byte_ring");
+    return true;
+}
+
+// Test broadcast ring gating on the slowest consumer
+bool test_broadcast_gated() {
+    using Ring = BroadcastRing<uint64_t, 8, 4>;
+    Ring ring;
+
+    size_t fast = ring.add_consumer();
+    size_t slow = ring.add_consumer();
+    TEST_ASSERT(fast != Ring::INVALID_CONSUMER && slow != Ring::INVALID_CONSUMER,
+                "Consumers should register");
+    TEST_ASSERT(fast != slow, "Consumers should get distinct ids");
+
+    uint64_t value = 0;
+    TEST_ASSERT(ring.try_read(fast, value) == Ring::ReadResult::Empty, "Read on empty should return Empty");
+
+    // All Capacity slots are usable; the next publish waits for the slowest
+    for (uint64_t i = 0; i < 8; ++i) {
+        TEST_ASSERT(ring.try_publish(i), "Publish should succeed until a lap ahead");
+    }
+    TEST_ASSERT(!ring.try_publish(8), "Publish should be gated by the slowest consumer");
+
+    // The fast consumer draining does not help
+    for (uint64_t i = 0; i < 8; ++i) {
+        TEST_ASSERT(ring.try_read(fast, value) == Ring::ReadResult::Ok && value == i,
+                    "Fast consumer should read every item in order");
+    }
+    TEST_ASSERT(!ring.try_publish(8), "Publish should still wait for the slow consumer");
+
+    // Each item read by the slow consumer frees one slot
+    TEST_ASSERT(ring.try_read(slow, value) == Ring::ReadResult::Ok && value == 0,
+                "Slow consumer should read the oldest item");
+    TEST_ASSERT(ring.try_publish(8), "Publish should succeed once the slow consumer moves");
+    TEST_ASSERT(!ring.try_publish(9), "Only one slot was freed");
+
+    // Removing the slow consumer stops gating on it
+    ring.remove_consumer(slow);
+    TEST_ASSERT(ring.try_publish(9), "Removed consumer should not gate");
+    TEST_ASSERT(ring.try_read(fast, value) == Ring::ReadResult::Ok && value == 8, "Fast consumer sees 8");
+    TEST_ASSERT(ring.try_read(fast, value) == Ring::ReadResult::Ok && value == 9, "Fast consumer sees 9");
+
+    // A late consumer joins at the head
+    size_t late = ring.add_consumer();
+    TEST_ASSERT(late != Ring::INVALID_CONSUMER, "Freed slot should be reusable");
+    TEST_ASSERT(ring.try_read(late, value) == Ring::ReadResult::Empty, "Late consumer starts at the head");
+    TEST_ASSERT(ring.try_publish(10), "Publish should succeed");
+    TEST_ASSERT(ring.try_read(late, value) == Ring::ReadResult::Ok && value == 10, "Late consumer sees new items");
+
+    // Registration is bounded
+    Ring full;
+    for (size_t i = 0; i < Ring::max_consumers(); ++i) {
+        TEST_ASSERT(full.add_consumer() != Ring::INVALID_CONSUMER, "Registration should succeed");
+    }
+    TEST_ASSERT(full.add_consumer() == Ring::INVALID_CONSUMER, "Registration should fail when full");
+
+    TEST_PASS("test_broadcast_gated");
+    return true;
+}
+
+// Test broadcast ring overwrite mode flagging a lagging consumer
+bool test_broadcast_overwrite() {
+    using Ring = BroadcastRing<uint64_t, 8, 2>;
+    Ring ring(Ring::Mode::Overwrite);
+    size_t id = ring.add_consumer();
+
+    for (uint64_t i = 0; i < 20; ++i) {
+        TEST_ASSERT(ring.try_publish(i), "Overwrite mode should never refuse a publish");
+    }
+    TEST_ASSERT(ring.backlog(id) == 20, "Backlog should count unread items");
+
+    uint64_t value = 0;
+    TEST_ASSERT(ring.try_read(id, value) == Ring::ReadResult::Lagged, "Lagging consumer should be flagged");
+    TEST_ASSERT(ring.overruns(id) > 0, "Lost items should be counted");
+
+    // After the skip the consumer reads intact, in-order items up to the head
+    uint64_t expected = ring.overruns(id);
+    uint64_t read = 0;
+    while (ring.try_read(id, value) == Ring::ReadResult::Ok) {
+        TEST_ASSERT(value == expected, "Items after the skip should be in order");
+        ++expected;
+        ++read;
+    }
+    TEST_ASSERT(expected == 20, "Consumer should catch up to the head");
+    TEST_ASSERT(ring.overruns(id) + read == 20, "Every item is either read or counted lost");
+
+    // Keeping up loses nothing
+    uint64_t lost = ring.overruns(id);
+    for (uint64_t i = 20; i < 40; ++i) {
+        ring.try_publish(i);
+        TEST_ASSERT(ring.try_read(id, value) == Ring::ReadResult::Ok && value == i, "Prompt reads are intact");
+    }
+    TEST_ASSERT(ring.overruns(id) == lost, "No further losses");
+
+    TEST_PASS("test_broadcast_overwrite");
+    return true;
+}
+
+// Test every consumer sees every item with concurrent gated readers
+bool test_concurrent_broadcast() {
+    using Ring = BroadcastRing<NormalizedMessage, 1024, 4>;
+    auto ring = std::make_unique<Ring>();
+    constexpr int CONSUMERS = 3;
+
+    size_t ids[CONSUMERS];
+    for (int i = 0; i < CONSUMERS; ++i) {
+        ids[i] = ring->add_consumer();
+    }
+
+    std::atomic<int> intact{0};
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < CONSUMERS; ++i) {
+        consumers.emplace_back([&, i]() {
+            uint64_t expected = 0;
+            bool ok = true;
+            NormalizedMessage msg;
+            while (expected < NUM_MESSAGES) {
+                if (ring->try_read(ids[i], msg) != Ring::ReadResult::Ok) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                ok = ok && msg.order_ref() == expected && msg.quantity() == expected % 1000;
+                ++expected;
+            }
+            if (ok) {
+                intact.fetch_add(1);
+            }
+        });
+    }
+
+    for (uint64_t i = 0; i < NUM_MESSAGES; ++i) {
+        NormalizedMessage msg;
+        msg.set_order_ref(i);
+        msg.set_quantity(static_cast<Quantity>(i % 1000));
+        while (!ring->try_publish(msg)) {
+            std::this_thread::yield();
+        }
+    }
+
+    for (auto& t : consumers) {
+        t.join();
+    }
+
+    TEST_ASSERT(intact.load() == CONSUMERS, "Every consumer should see every message in order");
+    TEST_ASSERT(ring->published() == NUM_MESSAGES, "Producer should publish every message");
+
+    TEST_PASS("test_concurrent_broadcast");
+    return true;
+}
+
+// Test MPSC queue basic operations and per-slot sequences across laps
+bool test_mpsc_basic() {
+    MpscQueue<uint64_t, 8> queue;
+
+    TEST_ASSERT(queue.empty(), "Queue should start empty");
+    TEST_ASSERT(queue.front() == nullptr, "Front on empty should return nullptr");
+    TEST_ASSERT(!queue.try_pop().has_value(), "Pop on empty should fail");
+
+    for (int round = 0; round < 5; ++round) {
+        // Every slot is usable (no reserved empty slot)
+        for (uint64_t i = 0; i < 8; ++i) {
+            TEST_ASSERT(queue.try_push(round * 10 + i), "Push should succeed until full");
+        }
+        TEST_ASSERT(!queue.try_push(999), "Push should fail when full");
+
+        const uint64_t* item = queue.front();
+        TEST_ASSERT(item && *item == static_cast<uint64_t>(round * 10), "Front should read the oldest");
+        queue.release();
+        TEST_ASSERT(queue.try_push(round * 10 + 8), "Released slot should be reusable");
+
+        uint64_t out[16];
+        TEST_ASSERT(queue.try_pop_batch(out, 16) == 8, "Batch pop should drain everything");
+        for (uint64_t i = 0; i < 8; ++i) {
+            TEST_ASSERT(out[i] == round * 10 + 1 + i, "Items should stay in order across laps");
+        }
+        TEST_ASSERT(queue.empty(), "Queue should be empty after draining");
+    }
+
+    TEST_PASS("test_mpsc_basic");
+    return true;
+}
+
+// Test MPSC queue with concurrent producers
+bool test_concurrent_mpsc() {
+    constexpr int PRODUCERS = 4;
+    constexpr uint64_t PER_PRODUCER = NUM_MESSAGES / PRODUCERS;
+    auto queue = std::make_unique<MpscQueue<uint64_t, BUFFER_SIZE>>();
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&, p]() {
+            for (uint64_t i = 0; i < PER_PRODUCER; ++i) {
+                // Producer id in the top byte, per-producer sequence below
+                uint64_t value = (static_cast<uint64_t>(p) << 56) | i;
+                while (!queue->try_push(value)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    uint64_t next[PRODUCERS] = {};
+    bool ordered = true;
+    uint64_t received = 0;
+    while (received < PER_PRODUCER * PRODUCERS) {
+        auto value = queue->try_pop();
+        if (!value) {
+            std::this_thread::yield();
+            continue;
+        }
+        int p = static_cast<int>(*value >> 56);
+        uint64_t seq = *value & ((1ULL << 56) - 1);
+        if (p >= PRODUCERS || seq != next[p]) {
+            ordered = false;
+        } else {
+            ++next[p];
+        }
+        ++received;
+    }
+
+    for (auto& t : producers) {
+        t.join();
+    }
+
+    TEST_ASSERT(ordered, "Each producer's items should arrive in its order");
+    for (int p = 0; p < PRODUCERS; ++p) {
+        TEST_ASSERT(next[p] == PER_PRODUCER, "Every producer's items should arrive");
+    }
+    TEST_ASSERT(queue->empty(), "Queue should be drained");
+
+    TEST_PASS("test_concurrent_mpsc");
+    return true;
+}
+
 // Test with NormalizedMessage type
+// Shared-memory ring: attach validation, in-order reads, lap detection
+bool test_shm_ring() {
+    const std::string name = "/itch5_test_" + std::to_string(getpid());
+
+    MessageShmReader reader;
+    TEST_ASSERT(reader.attach(name) == MessageShmReader::AttachResult::NotFound,
+                "Attach should fail before the writer exists");
+
+    MessageShmWriter writer;
+    TEST_ASSERT(writer.create(name, 10), "Writer should create the segment");
+    TEST_ASSERT(writer.capacity() == 16, "Capacity should round up to a power of 2");
+
+    ShmRingReader<uint64_t> wrong_type;
+    TEST_ASSERT(wrong_type.attach(name) == ShmRingReader<uint64_t>::AttachResult::TypeMismatch,
+                "Slot size mismatch should be rejected");
+
+    TEST_ASSERT(reader.attach(name) == MessageShmReader::AttachResult::Ok, "Reader should attach");
+    TEST_ASSERT(reader.capacity() == 16 && reader.writer_pid() == getpid(), "Header should describe the writer");
+
+    NormalizedMessage msg;
+    TEST_ASSERT(reader.try_read(msg) == MessageShmReader::ReadResult::Empty, "New ring should be empty");
+
+    // Claimed but uncommitted items stay invisible
+    NormalizedMessage* slot = writer.claim();
+    *slot = NormalizedMessage();
+    slot->set_order_ref(0);
+    TEST_ASSERT(reader.try_read(msg) == MessageShmReader::ReadResult::Empty, "Uncommitted item should be hidden");
+    writer.commit();
+
+    for (uint64_t i = 1; i < 10; ++i) {
+        NormalizedMessage out;
+        out.set_order_ref(i);
+        writer.publish(out);
+    }
+    for (uint64_t i = 0; i < 10; ++i) {
+        TEST_ASSERT(reader.try_read(msg) == MessageShmReader::ReadResult::Ok, "Published item should be readable");
+        TEST_ASSERT(msg.order_ref() == i, "Items should arrive in order");
+    }
+
+    // Writer laps the reader: the reader is flagged and resumes intact
+    for (uint64_t i = 10; i < 50; ++i) {
+        NormalizedMessage out;
+        out.set_order_ref(i);
+        writer.publish(out);
+    }
+    TEST_ASSERT(reader.try_read(msg) == MessageShmReader::ReadResult::Lagged, "Lapped reader should be flagged");
+    TEST_ASSERT(reader.overruns() > 0, "Lost items should be counted");
+    uint64_t last = 0;
+    size_t read = 0;
+    while (reader.try_read(msg) == MessageShmReader::ReadResult::Ok) {
+        TEST_ASSERT(read == 0 || msg.order_ref() == last + 1, "Reads after a lag should be contiguous");
+        last = msg.order_ref();
+        ++read;
+    }
+    TEST_ASSERT(last == 49, "Reader should catch up to the newest item");
+    TEST_ASSERT(reader.overruns() + read == 40, "Every item should be read or counted lost");
+
+    TEST_ASSERT(!reader.writer_closed(), "Writer should be live");
+    writer.close();
+    TEST_ASSERT(reader.writer_closed(), "Reader should see the writer close");
+
+    TEST_PASS("test_shm_ring");
+    return true;
+}
+
 bool test_normalized_message() {
     RingBuffer<NormalizedMessage, BUFFER_SIZE> buffer;
 
     NormalizedMessage msg;
-    msg.type = MessageType::AddOrder;
-    msg.timestamp = 123456789;
-    msg.order_ref = 42;
-    msg.side = Side::Buy;
-    msg.price = 1000000;  // $1.00
-    msg.quantity = 100;
+    msg.set_type(MessageType::AddOrder);
+    msg.set_timestamp(123456789);
+    msg.set_order_ref(42);
+    msg.set_side(Side::Buy);
+    msg.set_price(1000000);  // $1.00
+    msg.set_quantity(100);
 
     TEST_ASSERT(buffer.try_push(msg), "Push should succeed");
 
     auto popped = buffer.try_pop();
     TEST_ASSERT(popped.has_value(), "Pop should succeed");
-    TEST_ASSERT(popped->type == MessageType::AddOrder, "Type should match");
-    TEST_ASSERT(popped->timestamp == 123456789, "Timestamp should match");
-    TEST_ASSERT(popped->order_ref == 42, "Order ref should match");
-    TEST_ASSERT(popped->side == Side::Buy, "Side should match");
-    TEST_ASSERT(popped->price == 1000000, "Price should match");
-    TEST_ASSERT(popped->quantity == 100, "Quantity should match");
+    TEST_ASSERT(popped->type() == MessageType::AddOrder, "Type should match");
+    TEST_ASSERT(popped->timestamp() == 123456789, "Timestamp should match");
+    TEST_ASSERT(popped->order_ref() == 42, "Order ref should match");
+    TEST_ASSERT(popped->side() == Side::Buy, "Side should match");
+    TEST_ASSERT(popped->price() == 1000000, "Price should match");
+    TEST_ASSERT(popped->quantity() == 100, "Quantity should match");
 
     TEST_PASS("test_normalized_message");
     return true;
 }
 
+// Test the compact NormalizedMessage layout round-trips every field
+bool test_normalized_message_layout() {
+    TEST_ASSERT(sizeof(NormalizedMessage) == 32, "NormalizedMessage should be 32 bytes");
+    TEST_ASSERT(alignof(NormalizedMessage) == 32, "NormalizedMessage should be 32-byte aligned");
+    TEST_ASSERT(CACHE_LINE_SIZE / sizeof(NormalizedMessage) >= 2, "Two messages per cache line");
+
+    NormalizedMessage empty;
+    TEST_ASSERT(empty.type() == MessageType::Unknown, "Default type should be Unknown");
+    TEST_ASSERT(empty.side() == Side::Buy, "Default side should be Buy");
+    TEST_ASSERT(empty.order_ref() == 0 && empty.stock_locate() == 0, "Default ids should be zero");
+
+    // Largest ITCH timestamp and order refs sharing words with type/side/locate
+    const Timestamp max_ts = 86'400'000'000'000ULL - 1;
+    NormalizedMessage replace;
+    replace.set_type(MessageType::OrderReplace);
+    replace.set_timestamp(max_ts);
+    replace.set_side(Side::Sell);
+    TEST_ASSERT(replace.set_order_ref(NormalizedMessage::MAX_ORDER_REF), "Largest ref should fit");
+    replace.set_stock_locate(0xFFFF);
+    replace.set_price(9'999'999'900);   // $9999.9999
+    replace.set_quantity(0xFFFFFFFFu);
+    TEST_ASSERT(replace.set_new_order_ref(NormalizedMessage::MAX_ORDER_REF), "Largest new ref should fit");
+
+    TEST_ASSERT(replace.type() == MessageType::OrderReplace, "Type should survive neighbours");
+    TEST_ASSERT(replace.timestamp() == max_ts, "Timestamp should round-trip");
+    TEST_ASSERT(replace.side() == Side::Sell, "Side should round-trip");
+    TEST_ASSERT(replace.order_ref() == NormalizedMessage::MAX_ORDER_REF, "Order ref should round-trip");
+    TEST_ASSERT(replace.stock_locate() == 0xFFFF, "Locate should round-trip");
+    TEST_ASSERT(replace.price() == 9'999'999'900, "Price should round-trip");
+    TEST_ASSERT(replace.itch_price() == 99'999'999, "ITCH price should be in 1e-4 units");
+    TEST_ASSERT(replace.quantity() == 0xFFFFFFFFu, "Quantity should round-trip");
+    TEST_ASSERT(replace.new_order_ref() == NormalizedMessage::MAX_ORDER_REF, "New order ref should round-trip");
+
+    // Wider refs are clamped and reported, never masked
+    NormalizedMessage wide;
+    TEST_ASSERT(!wide.set_order_ref(NormalizedMessage::MAX_ORDER_REF + 2), "Wide ref should be reported");
+    TEST_ASSERT(wide.order_ref() == NormalizedMessage::MAX_ORDER_REF, "Wide ref should clamp, not wrap");
+    TEST_ASSERT(!wide.set_new_order_ref(0xFFFFFFFFFFFFFFFFULL), "Wide new ref should be reported");
+    TEST_ASSERT(wide.new_order_ref() == NormalizedMessage::MAX_ORDER_REF, "Wide new ref should clamp");
+
+    // Overwriting one packed field must not disturb the others
+    replace.set_timestamp(1);
+    replace.set_order_ref(2);
+    TEST_ASSERT(replace.type() == MessageType::OrderReplace && replace.side() == Side::Sell,
+                "Header bits should be preserved");
+    TEST_ASSERT(replace.stock_locate() == 0xFFFF, "Locate bits should be preserved");
+
+    NormalizedMessage dir;
+    dir.set_type(MessageType::StockDirectory);
+    dir.set_stock_locate(7);
+    StockSymbol sym;
+    std::memcpy(sym.data(), "MSFT    ", 8);
+    dir.set_stock(sym);
+    dir.set_quantity(100);
+    TEST_ASSERT(dir.stock() == sym, "Directory symbol should round-trip");
+    TEST_ASSERT(dir.quantity() == 100, "Round lot should round-trip");
+    TEST_ASSERT(dir.stock_locate() == 7, "Directory locate should round-trip");
+
+    TEST_PASS("test_normalized_message_layout");
+    return true;
+}
+
 // Test cache line alignment
 bool test_alignment() {
     RingBuffer<uint64_t, BUFFER_SIZE> buffer;
@@ -278,8 +1168,27 @@ int main() {
     run_test(test_fifo_ordering, "test_fifo_ordering");
     run_test(test_wraparound, "test_wraparound");
     run_test(test_peek, "test_peek");
+    run_test(test_dynamic_capacity, "test_dynamic_capacity");
+    run_test(test_ring_stats, "test_ring_stats");
+    run_test(test_cached_indices, "test_cached_indices");
     run_test(test_concurrent_spsc, "test_concurrent_spsc");
+    run_test(test_batch_operations, "test_batch_operations");
+    run_test(test_concurrent_batch, "test_concurrent_batch");
+    run_test(test_claim_commit, "test_claim_commit");
+    run_test(test_front_batch, "test_front_batch");
+    run_test(test_concurrent_claim_commit, "test_concurrent_claim_commit");
+    run_test(test_blocking_wait, "test_blocking_wait");
+    run_test(test_runtime_wait, "test_runtime_wait");
+    run_test(test_byte_ring, "test_byte_ring");
+    run_test(test_concurrent_byte_ring, "test_concurrent_byte_ring");
+    run_test(test_broadcast_gated, "test_broadcast_gated");
+    run_test(test_broadcast_overwrite, "test_broadcast_overwrite");
+    run_test(test_concurrent_broadcast, "test_concurrent_broadcast");
+    run_test(test_mpsc_basic, "test_mpsc_basic");
+    run_test(test_concurrent_mpsc, "test_concurrent_mpsc");
+    run_test(test_shm_ring, "test_shm_ring");
     run_test(test_normalized_message, "test_normalized_message");
+    run_test(test_normalized_message_layout, "test_normalized_message_layout");
     run_test(test_alignment, "test_alignment");
 
     std::cout << std::endl;